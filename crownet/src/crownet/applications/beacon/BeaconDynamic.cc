@@ -9,6 +9,7 @@
 #include "crownet/applications/beacon/BeaconDynamic.h"
 #include "crownet/applications/beacon/Beacon_m.h"
 #include "crownet/applications/common/info/InfoTags_m.h"
+#include "crownet/common/converter/OsgCoordConverter.h"
 #include "crownet/crownet.h"
 #include <cmath>
 
@@ -30,22 +31,51 @@ void BeaconDynamic::initialize(int stage) {
         maxSentFrequyncy = par("maxSentFrequency");
         maxBandwidth = par("maxBandwidth");
         appendResourceSharingDomainId = par("appendResourceSharingDomainId");
+        std::string positionEncoding = par("positionEncoding").stdstringValue();
+        if (positionEncoding != "full" && positionEncoding != "compact"){
+            throw cRuntimeError("Unknown positionEncoding '%s'. Use full or compact", positionEncoding.c_str());
+        }
+        compactEncoding = positionEncoding == "compact";
+        beaconLength = compactEncoding ? CompactDynamicBeaconPacket().getChunkLength() : DynamicBeaconPacket().getChunkLength();
     }
 }
 
 BurstInfo BeaconDynamic::getBurstInfo(inet::b data) const{
-    DynamicBeaconPacket p;
-    int pkt_count = (int)std::floor((double)data.get()/p.getChunkLength().get());
-    return BurstInfo{pkt_count, inet::b(pkt_count*p.getChunkLength().get())};
+    int pkt_count = (int)std::floor((double)data.get()/beaconLength.get());
+    return BurstInfo{pkt_count, inet::b(pkt_count*beaconLength.get())};
+}
+
+std::shared_ptr<PositionQuantizer> BeaconDynamic::getQuantizer(){
+    if (!quantizer){
+        auto converter = inet::getModuleFromPar<OsgCoordConverterProvider>(
+                par("coordConverterModule"), this)->getConverter();
+        quantizer = std::make_shared<PositionQuantizer>(converter, par("positionResolution").doubleValue());
+    }
+    return quantizer;
+}
+
+void BeaconDynamic::setCompactData(Ptr<DynamicBeaconPacket> beacon){
+    beacon->setPos(getQuantizer()->quantize(beacon->getPos()));
+    beacon->setNumberOfNeighbours(std::min((int)beacon->getNumberOfNeighbours(), 0xFFF));
+    auto v = getMobility()->getCurrentVelocity();
+    beacon->setSpeed(quantizeSpeed(v.length()));
+    // 0 = north (OCS -y), clockwise. Standing nodes keep heading 0.
+    beacon->setHeading(v.length() > 0.0 ? quantizeHeading(std::atan2(v.x, -v.y)) : 0);
+    if (appendResourceSharingDomainId){
+        beacon->setChunkLength(beaconLength + b(16));
+    }
 }
 
 
 Packet *BeaconDynamic::createPacket() {
     Ptr<DynamicBeaconPacket> beacon;
     if (appendResourceSharingDomainId){
+        // compact: same class with compact chunk length (see setCompactData)
         beacon = makeShared<DynamicBeaconPacketWithSharingDominId>();
         //todo: assume same domain, i.e. one eNB, for now.
         dynamicPtrCast<DynamicBeaconPacketWithSharingDominId>(beacon)->setSharingDominId(0);
+    } else if (compactEncoding){
+        beacon = makeShared<CompactDynamicBeaconPacket>();
     } else {
         beacon = makeShared<DynamicBeaconPacket>();
     }
@@ -61,6 +91,9 @@ Packet *BeaconDynamic::createPacket() {
     beacon->setEpsilon({0.0, 0.0, 0.0});
     // nTable contains current node thus #neighbors = size() - 1
     beacon->setNumberOfNeighbours(std::max(0, nTable->getSize()-1));
+    if (compactEncoding){
+        setCompactData(beacon);
+    }
 
     auto packet = buildPacket(beacon);
 
@@ -70,14 +103,15 @@ Packet *BeaconDynamic::createPacket() {
 
 
 FsmState BeaconDynamic::handleDataArrived(Packet *packet){
-    auto infoTag = packet->findTagForUpdate<AppRxInfoPerSourceTag>();
+    auto infoTag = packet->findTag<AppRxInfoPerSourceTag>();
     if (infoTag == nullptr){
         throw cRuntimeError("No AppInfoTag found. Application needs an ApplicationMeter to manage AppInfoObjects.");
     }
-    auto info = dynamic_cast<BeaconReceptionInfo*>(infoTag->getPacketInfoForUpdate());
+    auto info = std::dynamic_pointer_cast<BeaconReceptionInfo>(shareState(infoTag->getPacketInfo()));
     if (info == nullptr){
         throw cRuntimeError("Provided AppInfo object cannot be cast to BeaconReceptionInfo");
     }
+    // the neighborhood table keeps the meter state of the source (no copy).
     tablePktProcessor->processInfo(info);
 
     return FsmRootStates::WAIT_ACTIVE;
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "crownet/applications/common/BaseApp.h"
+#include "crownet/common/converter/PositionQuantizer.h"
 #include "crownet/neighbourhood/NeighborhoodTable.h"
 #include "inet/mobility/contract/IMobility.h"
 
@@ -30,6 +31,11 @@ public:
     // FSM
     virtual FsmState handleDataArrived(Packet *packet) override;
 
+protected:
+    // positionEncoding compact: quantize position, speed and heading
+    virtual void setCompactData(Ptr<DynamicBeaconPacket> beacon);
+    std::shared_ptr<PositionQuantizer> getQuantizer();
+
 private:
     INeighborhoodTable* nTable = nullptr;
     INeighborhoodTablePacketProcessor* tablePktProcessor = nullptr;
@@ -37,6 +43,10 @@ private:
     double maxSentFrequyncy;
     double maxBandwidth;
     bool appendResourceSharingDomainId;
+    bool compactEncoding;
+    inet::b beaconLength;
+    // created on first use (converter might not be ready at initialization)
+    std::shared_ptr<PositionQuantizer> quantizer;
 };
 
 } /* namespace crownet */
@@ -110,9 +110,17 @@ void BeaconReceptionInfo::processInbound(Packet *packetIn,
     if (currentPkt->getOutOfOrder()){
         // do not update Beacon Data.
     } else {
-        if (currentData == nullptr){
+        // last data becomes prio data. Reuse the old prio object.
+        auto next = removePrioData();
+        if (currentData != nullptr){
+            setPrioData(removeCurrentData());
+        }
+        if (next == nullptr){
             initAppData();
+        } else {
+            setCurrentData(next);
         }
+        currentData->setOutOfOrder(false);
         currentData->setBeaconValue(1.0); // Always 1 for this kind of beacon
         currentData->setPosition(beacon->getPos());
         currentData->setEpsilon(beacon->getEpsilon());
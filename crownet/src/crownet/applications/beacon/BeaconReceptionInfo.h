@@ -25,7 +25,8 @@ public:
 
     virtual BeaconReceptionInfo *dup() const override {return new BeaconReceptionInfo(*this);} ;
 
-    // override for granular handling of packet types
+    // override for granular handling of packet types. In order packets move
+    // currentData to prioData.
     virtual void processInbound(Packet *packetIn, const int rcvStationId,
             const simtime_t arrivalTime) override;
     virtual void updateCurrentPktInfo(Packet *packetIn, const int rcvStationId, const simtime_t arrivalTime) override;
@@ -11,6 +11,26 @@ namespace crownet {
 
 Register_Class(AppRxInfoPerSource);
 
+namespace {
+// deleter of snapshots. Holds the state until the last snapshot is gone.
+struct SnapshotOwner {
+    std::shared_ptr<AppRxInfoPerSource> state;
+    void operator()(const AppRxInfoPerSource*) { state.reset(); }
+};
+}
+
+AppRxInfoPerSourceSnapshot makeSnapshot(const std::shared_ptr<AppRxInfoPerSource>& state){
+    return AppRxInfoPerSourceSnapshot(state.get(), SnapshotOwner{state});
+}
+
+std::shared_ptr<AppRxInfoPerSource> shareState(const AppRxInfoPerSourceSnapshot& snapshot){
+    auto owner = std::get_deleter<SnapshotOwner>(snapshot);
+    if (owner == nullptr){
+        throw cRuntimeError("snapshot not created by makeSnapshot()");
+    }
+    return owner->state;
+}
+
 AppRxInfoPerSource::~AppRxInfoPerSource() {
     // TODO Auto-generated destructor stub
 }
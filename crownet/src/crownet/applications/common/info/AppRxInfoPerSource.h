@@ -8,6 +8,8 @@
 #ifndef CROWNET_APPLICATIONS_COMMON_INFO_BAR_H_
 #define CROWNET_APPLICATIONS_COMMON_INFO_BAR_H_
 
+#include <memory>
+
 #include "AppRxInfo.h"
 #include "AppRxInfoPerSource_m.h"
 
@@ -28,6 +30,23 @@ private:
 
 };
 
+/**
+ * Read only view of the per source statistics handed to received packets
+ * (AppRxInfoPerSourceTag). A snapshot keeps the state alive but has its own
+ * reference count. The meter copies the state before the next update only if
+ * a packet still holds a snapshot (copy on write).
+ */
+using AppRxInfoPerSourceSnapshot = std::shared_ptr<const AppRxInfoPerSource>;
+
+AppRxInfoPerSourceSnapshot makeSnapshot(const std::shared_ptr<AppRxInfoPerSource>& state);
+
+/**
+ * State behind snapshot for consumers which keep the latest state of a
+ * source (i.e. the neighborhood table). These references do not cause a copy
+ * in the meter, thus the state changes with the next packet of the source.
+ */
+std::shared_ptr<AppRxInfoPerSource> shareState(const AppRxInfoPerSourceSnapshot& snapshot);
+
 } /* namespace crownet */
 
 #endif /* CROWNET_APPLICATIONS_COMMON_INFO_BAR_H_ */
@@ -14,20 +14,25 @@
 // 
 
 #include "crownet/applications/dmap/BaseDensityMapApp.h"
+#include "crownet/applications/dmap/MapPacketBuild.h"
+#include "crownet/applications/dmap/MapPacketMerge.h"
 #include "crownet/applications/dmap/dmap_m.h"
 #include "inet/common/TimeTag_m.h"
 
+#include <cmath>
 #include <omnetpp/cwatch.h>
 #include <omnetpp/cstlwatch.h>
 
 #include "crownet/common/GlobalDensityMap.h"
 #include "crownet/applications/beacon/PositionMapPacket_m.h"
+#include "crownet/common/util/Profiler.h"
 #include "crownet/common/GlobalDensityMap.h"
 #include "crownet/dcd/regularGrid/RegularDcdMapPrinter.h"
 #include "crownet/crownet.h"
 
 namespace crownet {
 
+simsignal_t BaseDensityMapApp::deltaMapSavedBytes = cComponent::registerSignal("deltaMapSavedBytes");
 
 BaseDensityMapApp::~BaseDensityMapApp(){
     cancelAndDelete(mainAppTimer);
@@ -40,6 +45,14 @@ void BaseDensityMapApp::initialize(int stage) {
     if (stage == INITSTAGE_LOCAL) {
       mapCfg = (MapCfg*)(par("mapCfg").objectValue()->dup());
       take(mapCfg);
+      if (std::string(mapCfg->getPacketEncoding()) == "delta"){
+          deltaEncoder = std::make_shared<DeltaMapEncoder>(mapCfg->getDeltaKeyframeInterval());
+      }
+      std::string positionEncoding = mapCfg->getPositionEncoding();
+      if (positionEncoding != "full" && positionEncoding != "compact"){
+          throw cRuntimeError("Unknown positionEncoding '%s'. Use full or compact", positionEncoding.c_str());
+      }
+      compactPosition = positionEncoding == "compact";
       hostId = getContainingNode(this)->getId();
       WATCH(hostId);
 
@@ -108,11 +121,11 @@ void BaseDensityMapApp::initDcdMap(){
     }
 
     if (!dcdMapFactory){
-        EV_WARN << "Density map factory not set. This will impact the performance because each map has a separate distance cache!" << endl;
+        EV_WARN << "Density map factory not set. Create separate factory for this map." << endl;
         dcdMapFactory = std::make_shared<RegularDcdMapFactory>(converter);
     }
     
-    dcdMap = dcdMapFactory->create_shared_ptr(IntIdentifer(hostId), mapCfg->getIdStreamType());
+    dcdMap = dcdMapFactory->create_shared_ptr(IntIdentifer(hostId), mapCfg->getIdStreamType(), mapCfg->getCellStoreType());
     dcdMapWatcher = new RegularDcdMapWatcher("dcdMap", dcdMap);
     WATCH_MAP(dcdMap->getNeighborhood());
     cellProvider = dcdMapFactory->getCellKeyProvider();
@@ -214,57 +227,104 @@ Ptr<Chunk>  BaseDensityMapApp::buildHeader(){
 
     header->setCellIdOffsetX(0);
     header->setCellIdOffsetY(0);
-    header->setSourcePosition(getPosition());
+    if (compactPosition){
+        if (!positionQuantizer){
+            positionQuantizer = std::make_shared<PositionQuantizer>(converter, mapCfg->getPositionResolution());
+        }
+        header->setSourcePosition(positionQuantizer->quantize(getPosition()));
+        header->setCompactSourcePosition(true);
+        header->setChunkLength(header->getChunkLength() - B(2*8) + B(2*2));
+    } else {
+        header->setSourcePosition(getPosition());
+    }
     return header;
 }
 
-Ptr<Chunk>  BaseDensityMapApp::buildPayload(b maxData){
+Ptr<Chunk>  BaseDensityMapApp::buildPayload(b maxData, Ptr<MapHeader> header){
+    CROWNET_PROFILE_MODULE_SCOPE("map.buildPayload", this);
     if (mapCfg->getAppendRessourceSharingDomoinId()){
+        // DENSE does not carry the resource sharing domain id.
         return buildPayload(maxData, makeShared<SparseMapPacketWithSharingDomainId>());
-    } else {
-        return buildPayload(maxData, makeShared<SparseMapPacket>());
     }
+    if (deltaEncoder){
+        return buildPayload(maxData, header, makeShared<DeltaMapPacket>());
+    }
+    if (std::string(mapCfg->getPacketEncoding()) == "auto"){
+        auto candidates = dcdMap->getCellKeyStream()->peekCellIds(simTime(), maxDenseMapCells(maxData));
+        auto bbox = DenseMapBoundingBox::fromPrefix(candidates, maxData);
+        if (preferDenseMapPacket(bbox, (int)candidates.size(), maxData)){
+            header->setVersion(MapType::DENSE);
+            header->setCellIdOffsetX((uint16_t)bbox.getOffsetX());
+            header->setCellIdOffsetY((uint16_t)bbox.getOffsetY());
+            return buildPayload(bbox);
+        }
+    }
+    return buildPayload(maxData, makeShared<SparseMapPacket>());
 }
 
-Ptr<Chunk>  BaseDensityMapApp::buildPayload(b maxData, Ptr<SparseMapPacket> payload){
-    // todo check map capacity and switch to DENSE Packet if needed.
-    maxData -= payload->getChunkLength();
-
-    int maxCellCount;
-    int cellSize;
-    maxCellCount = (int)(maxData.get()/payload->getCellSize().get());
-    cellSize = payload->getCellSize().get();
-
-    int usedSpace = 0;
+Ptr<Chunk>  BaseDensityMapApp::buildPayload(const DenseMapBoundingBox& bbox){
+    auto payload = createDenseMapPacket(bbox);
     auto stream = dcdMap->getCellKeyStream();
     simtime_t now = simTime();
 
-    payload->setCellsArraySize(maxCellCount);
-
-    for (; usedSpace < maxCellCount; usedSpace++){
-        if(!stream->hasNext(now)){
-            break; // no more data present for transmission.
-        }
+    // bbox covers the first getDataCellCount() cells of the stream (see peekCellIds)
+    for (int i = 0; i < bbox.getDataCellCount(); i++){
         auto& cell = stream->nextCell(now);
         cell.sentAt(now);
-        auto count_100 = cell.val()->getCount()*100;
+        auto count_100 = std::min(cell.val()->getCount()*100, (double)DENSE_CELL_MAX_COUNT);
 
-        LocatedDcDCell c {
-            (uint16_t)count_100,    //count
-            (uint16_t)cell.getCellId().x(), // offsetX
-            (uint16_t)cell.getCellId().y()  // offsetY
-        };
-        auto delta_t = now-cell.val()->getMeasureTime();
-        c.setDeltaCreation(delta_t);
-        c.setSourceEntryDist(cell.val()->getEntryDist().sourceEntry); // todo size
-        payload->setCells(usedSpace, c);
+        DenseDcDCell c {(uint16_t)count_100};
+        c.setDeltaCreation(now-cell.val()->getMeasureTime());
+        c.setSourceEntryDist(cell.val()->getEntryDist().sourceEntry);
+        setDenseMapCell(payload.get(), bbox, cell.getCellId(), c);
     }
+    return payload;
+}
 
-    if (usedSpace < maxCellCount ){
-        payload->setCellsArraySize(usedSpace);
+Ptr<Chunk>  BaseDensityMapApp::buildPayload(b maxData, Ptr<MapHeader> header, Ptr<DeltaMapPacket> payload){
+    auto stream = dcdMap->getCellKeyStream();
+    simtime_t now = simTime();
+    payload->setKeyframe(deltaEncoder->nextPacket(header->getSequenceNumber()));
+    payload->setKeyframeSeq(deltaEncoder->getKeyframeSeq());
+
+    // A cell needs at least 5B. Cells unchanged since the keyframe are not
+    // sent, thus look further ahead than a full packet.
+    int maxCellCount = std::max(0, (int)((maxData - payload->getChunkLength()).get()/b(B(5)).get()));
+    auto candidates = stream->peekCellIds(now, 4*maxCellCount);
+
+    DeltaMapPacketBuilder builder;
+    int consumed = 0;
+    for (const auto& cellId : candidates){
+        auto& cell = dcdMap->getCell(cellId);
+        int count_100 = (int)std::lround(cell.val()->getCount()*100);
+        DeltaDcDCell c;
+        if (deltaEncoder->encode(cellId, count_100, c)){
+            c.setDeltaCreation(now-cell.val()->getMeasureTime());
+            c.setSourceEntryDist(cell.val()->getEntryDist().sourceEntry);
+            if (builder.getLengthWith(cellId, c) > maxData){
+                break;
+            }
+            builder.add(cellId, c);
+            deltaEncoder->commit(cellId, count_100);
+        }
+        consumed++;
     }
-    auto chunkLength = b(payload->getChunkLength().get() + payload->getCellsArraySize() *cellSize);
-    payload->setChunkLength(chunkLength);
+    // candidates are the next cells of the stream (see peekCellIds)
+    for (int i = 0; i < consumed; i++){
+        stream->nextCell(now).sentAt(now);
+    }
+
+    auto offset = builder.fill(payload.get());
+    header->setVersion(MapType::DELTA);
+    header->setCellIdOffsetX((uint16_t)offset.x());
+    header->setCellIdOffsetY((uint16_t)offset.y());
+    // compared to a SparseMapPacket with all consumed cells
+    emit(deltaMapSavedBytes, (long)B(sparseMapPacketLength(consumed) - payload->getChunkLength()).get());
+    return payload;
+}
+
+Ptr<Chunk>  BaseDensityMapApp::buildPayload(b maxData, Ptr<SparseMapPacket> payload){
+    fillSparseMapPacket(*dcdMap, *payload, maxData, simTime());
     return payload;
 }
 
@@ -323,15 +383,16 @@ Packet *BaseDensityMapApp::createPacket() {
     // that can be transmitted in one packet.
     b maxData = getAvailablePduLenght();
 
-    auto header = buildHeader();
+    auto header = staticPtrCast<MapHeader>(buildHeader());
     maxData -= header->getChunkLength();
 
-    auto payload = buildPayload(maxData);
+    auto payload = buildPayload(maxData, header);
 
     return buildPacket(payload, header);
 }
 
 bool BaseDensityMapApp::mergeReceivedMap(Packet *packet) {
+  CROWNET_PROFILE_MODULE_SCOPE("map.merge", this);
 
   auto header = packet->popAtFront<MapHeader>();
   if (header->getSourceId() == getHostId()){
@@ -347,6 +408,12 @@ bool BaseDensityMapApp::mergeReceivedMap(Packet *packet) {
   case MapType::SPARSE_RSD:
       ret = mergeReceivedMap(header, packet->popAtFront<SparseMapPacketWithSharingDomainId>());
       break;
+  case MapType::DENSE:
+      ret = mergeReceivedMap(header, packet->popAtFront<DenseMapPacket>());
+      break;
+  case MapType::DELTA:
+      ret = mergeReceivedMap(header, packet->popAtFront<DeltaMapPacket>());
+      break;
   default:
       throw cRuntimeError("Map version '%i' not implemented", header->getVersion());
   }
@@ -374,26 +441,8 @@ bool BaseDensityMapApp::mergeReceivedMap(Ptr<const MapHeader> header, const Ptr<
         GridCellID entryCellId{
             baseX + cell.getIdOffsetX(),
             baseY + cell.getIdOffsetY()};
-        /**
-         *  extract sourceEntryDist from packet. This distance is the distance
-         *  from which the Entry was generated by the
-         *  original 'node'. The sender might be the original node but does not
-         *  have to be. Further more the
-         *  sender might have moved between measuring and sending the value.
-         *  Other distances (i.e. hostEntry, sourceHost) must be calculated.
-         */
-        EntryDist entryDist = cellProvider->getExactDist(senderPosition, getPosition(), entryCellId, cell.getSourceEntryDist());
-        simtime_t _measured = cell.getCreationTime(packetCreationTime);
-        if (_measured > simTime()){
-            throw cRuntimeError("!!");
-        }
-        // get or create entry shared pointer
-        auto _entry = dcdMap->getEntry<GridEntry>(entryCellId, sourceNodeId);
-        _entry->setCount((double)cell.getCount()/100.0);
-        _entry->setMeasureTime(_measured);
-        _entry->setReceivedTime(_received);
-        _entry->setEntryDist(std::move(entryDist));
-        _entry->setSource(sourceNodeId);
+        mergeReceivedCell(senderPosition, sourceNodeId, entryCellId, (double)cell.getCount()/100.0,
+                cell.getCreationTime(packetCreationTime), _received, cell.getSourceEntryDist());
     }
 
     return true;
@@ -419,26 +468,8 @@ bool BaseDensityMapApp::mergeReceivedMap(Ptr<const MapHeader> header, const Ptr<
         GridCellID entryCellId{
             baseX + cell.getIdOffsetX(),
             baseY + cell.getIdOffsetY()};
-        /**
-         *  extract sourceEntryDist from packet. This distance is the distance
-         *  from which the Entry was generated by the
-         *  original 'node'. The sender might be the original node but does not
-         *  have to be. Further more the
-         *  sender might have moved between measuring and sending the value.
-         *  Other distances (i.e. hostEntry, sourceHost) must be calculated.
-         */
-        EntryDist entryDist = cellProvider->getExactDist(senderPosition, getPosition(), entryCellId, cell.getSourceEntryDist());
-        simtime_t _measured = cell.getCreationTime(packetCreationTime);
-        if (_measured > simTime()){
-            throw cRuntimeError("!!");
-        }
-        // get or create entry shared pointer
-        auto _entry = dcdMap->getEntry<GridEntry>(entryCellId, sourceNodeId);
-        _entry->setCount((double)cell.getCount()/100.0);
-        _entry->setMeasureTime(_measured);
-        _entry->setReceivedTime(_received);
-        _entry->setEntryDist(std::move(entryDist));
-        _entry->setSource(sourceNodeId);
+        auto _entry = mergeReceivedCell(senderPosition, sourceNodeId, entryCellId, (double)cell.getCount()/100.0,
+                cell.getCreationTime(packetCreationTime), _received, cell.getSourceEntryDist());
         _entry->setResourceSharingDomainId(cell.getSharingDominId());
     }
 
@@ -446,11 +477,50 @@ bool BaseDensityMapApp::mergeReceivedMap(Ptr<const MapHeader> header, const Ptr<
 }
 
 
+bool BaseDensityMapApp::mergeReceivedMap(Ptr<const MapHeader> header, const Ptr<const DenseMapPacket> body){
+    simtime_t _received = simTime();
+    auto packetCreationTime = body->getTag<CreationTimeTag>()->getCreationTime();
+    int sourceNodeId = (int)header->getSourceId();
+    Coord senderPosition = header->getSourcePosition();
+
+    // cell ids are given implicitly by the bounding box (header offset + row-major index)
+    forEachDenseMapCell(*header, *body, [&](const GridCellID& entryCellId, const DenseDcDCell& cell){
+        mergeReceivedCell(senderPosition, sourceNodeId, entryCellId, (double)cell.getCount()/100.0,
+                cell.getCreationTime(packetCreationTime), _received, cell.getSourceEntryDist());
+    });
+
+    return true;
+}
+
+bool BaseDensityMapApp::mergeReceivedMap(Ptr<const MapHeader> header, const Ptr<const DeltaMapPacket> body){
+    simtime_t _received = simTime();
+    auto packetCreationTime = body->getTag<CreationTimeTag>()->getCreationTime();
+    int sourceNodeId = (int)header->getSourceId();
+
+    // counts are relative to the last keyframe of the sender (see DeltaMapDecoder)
+    int skipped = mergeDeltaMapPacket(*dcdMap, *cellProvider, deltaDecoder, *header, *body,
+            getPosition(), packetCreationTime, _received);
+    if (skipped > 0){
+        EV_INFO << getHostId() << " missing keyframe of " << sourceNodeId << ". Skipped "
+                << skipped << " cells." << endl;
+    }
+
+    return true;
+}
+
+std::shared_ptr<GridEntry> BaseDensityMapApp::mergeReceivedCell(const Coord& senderPosition, const int sourceNodeId,
+        const GridCellID& entryCellId, const double count, const simtime_t& measured,
+        const simtime_t& received, const double sourceEntryDist){
+    return crownet::mergeReceivedCell(*dcdMap, *cellProvider, senderPosition, getPosition(), sourceNodeId,
+            entryCellId, count, measured, received, sourceEntryDist);
+}
+
 void BaseDensityMapApp::updateLocalMap() {
     throw omnetpp::cRuntimeError("Not Implemented in Base* class. Use child class");
 }
 
 void BaseDensityMapApp::writeMap() {
+    CROWNET_PROFILE_MODULE_SCOPE("map.write", this);
     fileWriter->writeData();
 }
 
@@ -472,19 +542,38 @@ void BaseDensityMapApp::setCoordinateConverter(std::shared_ptr<OsgCoordinateConv
 
 
 void BaseDensityMapApp::computeValues() {
-   simtime_t now = simTime();
+  prepareComputeValues();
+  computeMapValues();
+  finishComputeValues();
+}
+
+void BaseDensityMapApp::prepareComputeValues() {
+  computeTime = simTime();
+  appendRsdId = mapCfg->getAppendRessourceSharingDomoinId();
+  if (appendRsdId){
+      computeRsdId = getResourceSharingDomainId();
+  }
+}
+
+void BaseDensityMapApp::computeMapValues() {
+   CROWNET_PROFILE_MODULE_SCOPE("map.computeValues", this);
+   // no simTime() here. This may run on a worker thread.
+   const simtime_t now = computeTime;
    // cellAgeHandler is Idempotent
   cellAgeHandler->setTime(now);
-  dcdMap->visitCells(*cellAgeHandler); //reference to cellAgeHandler needed
+  dcdMap->visitCellsAt(*cellAgeHandler, now); //reference to cellAgeHandler needed
 
 
   valueVisitor->setTime(now);
   // dcdMap->computeValues is Idempotent
-  dcdMap->computeValues(valueVisitor);
+  dcdMap->computeValuesAt(valueVisitor, now);
+}
 
-  if (mapCfg->getAppendRessourceSharingDomoinId()){
-      rsdVisitor->reset(now, getResourceSharingDomainId());
-      dcdMap->visitCells(*rsdVisitor); //reference to cellAgeHandler needed
+void BaseDensityMapApp::finishComputeValues() {
+  // may throw cRuntimeError, thus on the simulation thread.
+  if (appendRsdId){
+      rsdVisitor->reset(computeTime, computeRsdId);
+      dcdMap->visitCellsAt(*rsdVisitor, computeTime); //reference to cellAgeHandler needed
   }
 }
 
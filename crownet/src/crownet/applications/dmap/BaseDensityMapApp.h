@@ -22,8 +22,11 @@
 #include "crownet/applications/common/AppFsm.h"
 #include "crownet/applications/common/BaseApp.h"
 #include "crownet/applications/dmap/dmap_m.h"
+#include "crownet/applications/dmap/DeltaMapEncoding.h"
+#include "crownet/applications/dmap/DenseMapEncoding.h"
 #include "crownet/common/IDensityMapHandler.h"
 #include "crownet/common/converter/OsgCoordConverter.h"
+#include "crownet/common/converter/PositionQuantizer.h"
 #include "crownet/common/util/Writer.h"
 #include "crownet/dcd/regularGrid/RegularDcdMap.h"
 #include "crownet/dcd/generic/CellVisitors.h"
@@ -56,10 +59,13 @@ protected:
  //
  virtual Packet *createPacket() override;
  virtual Ptr<Chunk>  buildHeader();
- virtual Ptr<Chunk>  buildPayload(b maxData);
+ // select SPARSE, DENSE or DELTA encoding and update header (version, cell offset) accordingly.
+ virtual Ptr<Chunk>  buildPayload(b maxData, Ptr<MapHeader> header);
+ virtual Ptr<Chunk> buildPayload(b maxData, Ptr<MapHeader> header, Ptr<DeltaMapPacket> payload);
 
  virtual Ptr<Chunk> buildPayload(b maxData, Ptr<SparseMapPacket> pyload);
  virtual Ptr<Chunk> buildPayload(b maxData, Ptr<SparseMapPacketWithSharingDomainId> pyload);
+ virtual Ptr<Chunk> buildPayload(const DenseMapBoundingBox& bbox);
 
 
  virtual BurstInfo getBurstInfo(inet::b) const override;
@@ -75,6 +81,12 @@ protected:
 
  virtual bool mergeReceivedMap(Ptr<const MapHeader> header, const Ptr<const SparseMapPacket> body);
  virtual bool mergeReceivedMap(Ptr<const MapHeader> header, const Ptr<const SparseMapPacketWithSharingDomainId> body);
+ virtual bool mergeReceivedMap(Ptr<const MapHeader> header, const Ptr<const DenseMapPacket> body);
+ virtual bool mergeReceivedMap(Ptr<const MapHeader> header, const Ptr<const DeltaMapPacket> body);
+ // update (or create) entry of sourceNodeId in cell entryCellId with received measurement.
+ virtual std::shared_ptr<GridEntry> mergeReceivedCell(const Coord& senderPosition, const int sourceNodeId,
+         const GridCellID& entryCellId, const double count, const simtime_t& measured,
+         const simtime_t& received, const double sourceEntryDist);
 
 
  virtual void initLocalMap() {/*do nothing on default*/};
@@ -83,6 +95,10 @@ protected:
  // update map with data from neighborhood table
  virtual void updateLocalMap() override;
  virtual void computeValues() override;
+ virtual bool supportsConcurrentCompute() const override { return true; }
+ virtual void prepareComputeValues() override;
+ virtual void computeMapValues() override;
+ virtual void finishComputeValues() override;
  virtual void writeMap() override;
  virtual std::shared_ptr<RegularDcdMap> getMap() override;
  virtual void setCoordinateConverter(std::shared_ptr<OsgCoordinateConverter> converter) override;
@@ -112,7 +128,19 @@ protected:
  std::shared_ptr<TTLCellAgeHandler> cellAgeHandler;
  std::shared_ptr<ApplyRessourceSharingDomainIdVisitor> rsdVisitor;
  simtime_t lastUpdate = -1.0;
+ // set by prepareComputeValues() for use in computeMapValues()
+ simtime_t computeTime;
+ int computeRsdId = -1;
+ bool appendRsdId = false;
  MapCfg *mapCfg;
+ // packetEncoding delta only
+ std::shared_ptr<DeltaMapEncoder> deltaEncoder;
+ DeltaMapDecoder deltaDecoder;
+ static simsignal_t deltaMapSavedBytes;
+ // positionEncoding compact (checked in initialize)
+ bool compactPosition = false;
+ // positionEncoding compact only (created on first use)
+ std::shared_ptr<PositionQuantizer> positionQuantizer;
  std::string mapDataType; //todo switch for PedestrianVsEntropy data
 
 
@@ -0,0 +1,178 @@
+/*
+ * DeltaMapEncoding.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/applications/dmap/DeltaMapEncoding.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <omnetpp/cexception.h>
+
+using namespace inet;
+
+namespace crownet {
+
+namespace {
+
+uint32_t countField(const DeltaDcDCell& cell) {
+  return (zigzagEncode(cell.getCountDelta()) << 1) | (cell.getAbsolute() ? 1u : 0u);
+}
+
+uint32_t distField(const DeltaDcDCell& cell) {
+  return (uint32_t)std::min(std::max(std::round(cell.getSourceEntryDist()), 0.0), (double)0xFFFF);
+}
+
+B idDeltaLength(int dx, int dy) {
+  return B(varintLength(zigzagEncode(dx)) + varintLength(zigzagEncode(dy)));
+}
+
+B valueLength(const DeltaDcDCell& cell) {
+  return B(varintLength(countField(cell)) + varintLength(cell.getDeltaCreation()) +
+           varintLength(distField(cell)));
+}
+
+}  // namespace
+
+int varintLength(uint32_t v) {
+  int n = 1;
+  while (v >= 0x80) {
+    v >>= 7;
+    n++;
+  }
+  return n;
+}
+
+B deltaMapCellLength(const DeltaDcDCell& cell) {
+  return idDeltaLength(cell.getIdDeltaX(), cell.getIdDeltaY()) + valueLength(cell);
+}
+
+DeltaMapPacketBuilder::DeltaMapPacketBuilder() : length(DeltaMapPacket().getChunkLength()) {}
+
+B DeltaMapPacketBuilder::lengthDelta(const GridCellID& cellId, const DeltaDcDCell& cell) const {
+  auto next = cells.lower_bound(cellId);
+  if (next != cells.end() && next->first == cellId) {
+    throw omnetpp::cRuntimeError("cell already part of the packet");
+  }
+  bool hasPrev = next != cells.begin();
+  GridCellID prev = hasPrev ? std::prev(next)->first : cellId;  // first cell: delta 0
+  B ret = valueLength(cell) + idDeltaLength(cellId.x() - prev.x(), cellId.y() - prev.y());
+  if (next != cells.end()) {
+    // successor is now relative to cellId
+    GridCellID oldPrev = hasPrev ? prev : next->first;
+    ret += idDeltaLength(next->first.x() - cellId.x(), next->first.y() - cellId.y());
+    ret -= idDeltaLength(next->first.x() - oldPrev.x(), next->first.y() - oldPrev.y());
+  }
+  return ret;
+}
+
+b DeltaMapPacketBuilder::getLengthWith(const GridCellID& cellId, const DeltaDcDCell& cell) const {
+  return length + lengthDelta(cellId, cell);
+}
+
+void DeltaMapPacketBuilder::add(const GridCellID& cellId, const DeltaDcDCell& cell) {
+  length += lengthDelta(cellId, cell);
+  cells.emplace(cellId, cell);
+}
+
+GridCellID DeltaMapPacketBuilder::fill(DeltaMapPacket* packet) const {
+  packet->setCellsArraySize(cells.size());
+  packet->setChunkLength(length);
+  if (cells.empty()) {
+    return GridCellID(0, 0);
+  }
+  GridCellID prev = cells.begin()->first;
+  int i = 0;
+  for (const auto& e : cells) {
+    DeltaDcDCell c = e.second;
+    c.setIdDeltaX(e.first.x() - prev.x());
+    c.setIdDeltaY(e.first.y() - prev.y());
+    packet->setCells(i++, c);
+    prev = e.first;
+  }
+  return cells.begin()->first;
+}
+
+DeltaMapEncoder::DeltaMapEncoder(int keyframeInterval) : keyframeInterval(keyframeInterval) {
+  if (keyframeInterval < 1) {
+    throw omnetpp::cRuntimeError("deltaKeyframeInterval must be >= 1 got %d", keyframeInterval);
+  }
+}
+
+bool DeltaMapEncoder::nextPacket(uint16_t sequenceNumber) {
+  packetsSinceKeyframe++;
+  keyframe = packetsSinceKeyframe == 0 || packetsSinceKeyframe >= keyframeInterval;
+  if (keyframe) {
+    packetsSinceKeyframe = 0;
+    keyframeSeq = sequenceNumber;
+    keyframeCounts.clear();
+  }
+  return keyframe;
+}
+
+bool DeltaMapEncoder::encode(const GridCellID& cellId, int count100, DeltaDcDCell& cell) const {
+  cell.setAbsolute(true);
+  cell.setCountDelta(count100);
+  if (keyframe) {
+    return true;
+  }
+  auto sent = sentCounts.find(cellId);
+  if (sent != sentCounts.end() && sent->second == count100) {
+    return false;  // unchanged since last sent
+  }
+  auto it = keyframeCounts.find(cellId);
+  if (it == keyframeCounts.end()) {
+    return true;
+  }
+  cell.setAbsolute(false);
+  cell.setCountDelta(count100 - it->second);
+  return true;
+}
+
+void DeltaMapEncoder::commit(const GridCellID& cellId, int count100) {
+  if (keyframe) {
+    keyframeCounts[cellId] = count100;
+  }
+  sentCounts[cellId] = count100;
+}
+
+int DeltaMapDecoder::decode(int sourceId, const MapHeader& header, const DeltaMapPacket& packet,
+                            std::function<void(const GridCellID&, int, const DeltaDcDCell&)> fn) {
+  Keyframe* base = nullptr;
+  if (packet.getKeyframe()) {
+    base = &keyframes[sourceId];
+    base->seq = packet.getKeyframeSeq();
+    base->counts.clear();
+  } else {
+    auto it = keyframes.find(sourceId);
+    if (it != keyframes.end() && it->second.seq == packet.getKeyframeSeq()) {
+      base = &it->second;
+    }
+  }
+
+  int skipped = 0;
+  int x = header.getCellIdOffsetX();
+  int y = header.getCellIdOffsetY();
+  for (size_t i = 0; i < packet.getCellsArraySize(); i++) {
+    const auto& cell = packet.getCells(i);
+    x += cell.getIdDeltaX();
+    y += cell.getIdDeltaY();
+    GridCellID cellId(x, y);
+    if (packet.getKeyframe()) {
+      base->counts[cellId] = cell.getCountDelta();
+      fn(cellId, cell.getCountDelta(), cell);
+    } else if (cell.getAbsolute()) {
+      fn(cellId, cell.getCountDelta(), cell);
+    } else if (base && base->counts.find(cellId) != base->counts.end()) {
+      fn(cellId, base->counts[cellId] + cell.getCountDelta(), cell);
+    } else {
+      skipped++;  // keyframe not received
+    }
+  }
+  return skipped;
+}
+
+}  // namespace crownet
@@ -0,0 +1,127 @@
+/*
+ * DeltaMapEncoding.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+
+#include "inet/common/Units.h"
+#include "crownet/applications/dmap/dmap_m.h"
+#include "crownet/dcd/identifier/Identifiers.h"
+
+namespace crownet {
+
+/**
+ * Size of variable length integers (LEB128, 7 bit per byte) with zigzag
+ * coding for signed values. Used for the chunk length of DeltaMapPacket
+ * cells (the simulation does not serialize packets).
+ */
+inline uint32_t zigzagEncode(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+inline int32_t zigzagDecode(uint32_t v) { return (int32_t)(v >> 1) ^ -(int32_t)(v & 1); }
+int varintLength(uint32_t v);
+
+/**
+ * Encoded size of one cell:
+ *   idDeltaX, idDeltaY (zigzag), countDelta (zigzag, absolute flag in the
+ *   lowest bit), deltaCreation, sourceEntryDist (meter)
+ */
+inet::B deltaMapCellLength(const DeltaDcDCell& cell);
+
+/**
+ * Cells of a DeltaMapPacket under construction in row-major order. Adding a
+ * cell only changes the id delta of its successor, thus the packet length
+ * is kept up to date in O(log n).
+ */
+class DeltaMapPacketBuilder {
+ public:
+  DeltaMapPacketBuilder();
+
+  // packet length if cell would be added (cell id deltas are ignored).
+  inet::b getLengthWith(const GridCellID& cellId, const DeltaDcDCell& cell) const;
+  void add(const GridCellID& cellId, const DeltaDcDCell& cell);
+
+  inet::b getLength() const { return length; }
+  int size() const { return (int)cells.size(); }
+
+  /**
+   * Set cells (with id deltas) and chunk length of packet. Returns the
+   * offset for the MapHeader (cellIdOffsetX/Y), i.e. the first cell.
+   */
+  GridCellID fill(DeltaMapPacket* packet) const;
+
+ private:
+  struct RowMajor {
+    bool operator()(const GridCellID& a, const GridCellID& b) const {
+      return a.y() != b.y() ? a.y() < b.y() : a.x() < b.x();
+    }
+  };
+  inet::B lengthDelta(const GridCellID& cellId, const DeltaDcDCell& cell) const;
+
+  std::map<GridCellID, DeltaDcDCell, RowMajor> cells;
+  inet::B length;
+};
+
+/**
+ * Sender side of the DELTA encoding. Every keyframeInterval-th packet is a
+ * keyframe with absolute counts of all its cells. All other packets only
+ * carry cells whose count changed since it was last sent. The count is
+ * encoded as delta to the last keyframe. Cells not part of the keyframe are
+ * sent with absolute counts. Deltas do not depend on each other, thus
+ * receivers only need the last keyframe.
+ */
+class DeltaMapEncoder {
+ public:
+  DeltaMapEncoder(int keyframeInterval = 10);
+
+  // start the next packet. Returns true if it is a keyframe.
+  bool nextPacket(uint16_t sequenceNumber);
+  bool isKeyframe() const { return keyframe; }
+  uint16_t getKeyframeSeq() const { return keyframeSeq; }
+
+  /**
+   * Cell for the current count (count * 100) of cellId. Returns false if the
+   * count did not change since the cell was last sent (nothing to send).
+   */
+  bool encode(const GridCellID& cellId, int count100, DeltaDcDCell& cell) const;
+  // cellId is sent with count100 (part of the keyframe if isKeyframe()).
+  void commit(const GridCellID& cellId, int count100);
+
+ private:
+  int keyframeInterval;
+  int packetsSinceKeyframe = -1;
+  bool keyframe = false;
+  uint16_t keyframeSeq = 0;
+  std::unordered_map<GridCellID, int> keyframeCounts;
+  std::unordered_map<GridCellID, int> sentCounts;  // last sent count of each cell
+};
+
+/**
+ * Receiver side. Keeps the last keyframe of each source.
+ */
+class DeltaMapDecoder {
+ public:
+  /**
+   * Call fn with the absolute count (count * 100) of each cell. Deltas based
+   * on a keyframe which was not received are skipped. Returns the number of
+   * skipped cells.
+   */
+  int decode(int sourceId, const MapHeader& header, const DeltaMapPacket& packet,
+             std::function<void(const GridCellID&, int, const DeltaDcDCell&)> fn);
+  bool hasKeyframe(int sourceId) const { return keyframes.find(sourceId) != keyframes.end(); }
+
+ private:
+  struct Keyframe {
+    uint16_t seq;
+    std::unordered_map<GridCellID, int> counts;
+  };
+  std::unordered_map<int, Keyframe> keyframes;
+};
+
+}  // namespace crownet
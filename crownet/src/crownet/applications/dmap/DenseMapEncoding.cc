@@ -0,0 +1,146 @@
+/*
+ * DenseMapEncoding.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/applications/dmap/DenseMapEncoding.h"
+
+#include <algorithm>
+#include <omnetpp/cexception.h>
+
+using namespace inet;
+
+namespace crownet {
+
+DenseMapBoundingBox::DenseMapBoundingBox(int offsetX, int offsetY, int cellCountX, int cellCountY)
+    : offsetX(offsetX), offsetY(offsetY), cellCountX(cellCountX), cellCountY(cellCountY) {
+  if (cellCountX < 0 || cellCountY < 0 || cellCountX > DENSE_MAX_CELL_COUNT_XY ||
+      cellCountY > DENSE_MAX_CELL_COUNT_XY) {
+    throw omnetpp::cRuntimeError("invalid dense map size [%d, %d]", cellCountX, cellCountY);
+  }
+}
+
+DenseMapBoundingBox DenseMapBoundingBox::fromPrefix(const std::vector<GridCellID>& cellIds, b maxData) {
+  DenseMapBoundingBox ret;
+  int minX = 0, minY = 0, maxX = -1, maxY = -1;
+  for (const auto& id : cellIds) {
+    int _minX = id.x(), _minY = id.y(), _maxX = id.x(), _maxY = id.y();
+    if (ret.dataCellCount > 0) {
+      _minX = std::min(minX, _minX);
+      _minY = std::min(minY, _minY);
+      _maxX = std::max(maxX, _maxX);
+      _maxY = std::max(maxY, _maxY);
+    }
+    int countX = _maxX - _minX + 1;
+    int countY = _maxY - _minY + 1;
+    if (_minX < 0 || _minY < 0 || _maxX > 0xFFFF || _maxY > 0xFFFF ||
+        countX > DENSE_MAX_CELL_COUNT_XY || countY > DENSE_MAX_CELL_COUNT_XY) {
+      break;  // not representable in MapHeader/DenseMapPacket
+    }
+    DenseMapBoundingBox next(_minX, _minY, countX, countY);
+    if (next.getPacketLength() > maxData) {
+      break;
+    }
+    next.dataCellCount = ret.dataCellCount + 1;
+    ret = next;
+    minX = _minX;
+    minY = _minY;
+    maxX = _maxX;
+    maxY = _maxY;
+  }
+  return ret;
+}
+
+DenseMapBoundingBox DenseMapBoundingBox::fromPacket(const MapHeader& header, const DenseMapPacket& packet) {
+  DenseMapBoundingBox ret(header.getCellIdOffsetX(), header.getCellIdOffsetY(),
+                          packet.getCellCountX(), packet.getCellCountY());
+  if ((int)packet.getCellsArraySize() != ret.getArea()) {
+    throw omnetpp::cRuntimeError("dense map size [%d, %d] does not match number of cells %d",
+                                 ret.cellCountX, ret.cellCountY, (int)packet.getCellsArraySize());
+  }
+  return ret;
+}
+
+bool DenseMapBoundingBox::contains(const GridCellID& cellId) const {
+  return cellId.x() >= offsetX && cellId.x() < offsetX + cellCountX &&
+         cellId.y() >= offsetY && cellId.y() < offsetY + cellCountY;
+}
+
+int DenseMapBoundingBox::index(const GridCellID& cellId) const {
+  if (!contains(cellId)) {
+    throw omnetpp::cRuntimeError("cell [%d, %d] not part of dense map", cellId.x(), cellId.y());
+  }
+  return (cellId.y() - offsetY) * cellCountX + (cellId.x() - offsetX);
+}
+
+GridCellID DenseMapBoundingBox::cellId(const int index) const {
+  return GridCellID(offsetX + index % cellCountX, offsetY + index / cellCountX);
+}
+
+b DenseMapBoundingBox::getPacketLength() const {
+  DenseMapPacket p;
+  return b(p.getChunkLength().get() + getArea() * p.getCellSize().get());
+}
+
+b sparseMapPacketLength(int numCells) {
+  SparseMapPacket p;
+  return b(p.getChunkLength().get() + numCells * p.getCellSize().get());
+}
+
+int maxSparseMapCells(b maxData) {
+  SparseMapPacket p;
+  return std::max(0, (int)((maxData - p.getChunkLength()).get() / p.getCellSize().get()));
+}
+
+int maxDenseMapCells(b maxData) {
+  DenseMapPacket p;
+  return std::max(0, (int)((maxData - p.getChunkLength()).get() / p.getCellSize().get()));
+}
+
+bool preferDenseMapPacket(const DenseMapBoundingBox& bbox, int numCandidates, b maxData) {
+  int sparseCells = std::min(numCandidates, maxSparseMapCells(maxData));
+  int denseCells = bbox.getDataCellCount();
+  if (denseCells == 0) {
+    return false;
+  }
+  if (denseCells != sparseCells) {
+    return denseCells > sparseCells;
+  }
+  return bbox.getPacketLength() < sparseMapPacketLength(sparseCells);
+}
+
+Ptr<DenseMapPacket> createDenseMapPacket(const DenseMapBoundingBox& bbox) {
+  auto packet = makeShared<DenseMapPacket>();
+  packet->setCellCountX((uint8_t)bbox.getCellCountX());
+  packet->setCellCountY((uint8_t)bbox.getCellCountY());
+  packet->setCellsArraySize(bbox.getArea());
+  DenseDcDCell empty{DENSE_CELL_EMPTY};
+  for (int i = 0; i < bbox.getArea(); i++) {
+    packet->setCells(i, empty);
+  }
+  packet->setChunkLength(bbox.getPacketLength());
+  return packet;
+}
+
+void setDenseMapCell(DenseMapPacket* packet, const DenseMapBoundingBox& bbox,
+                     const GridCellID& cellId, const DenseDcDCell& cell) {
+  if (cell.getCount() == DENSE_CELL_EMPTY) {
+    throw omnetpp::cRuntimeError("count value 0x%X is reserved for empty cells", DENSE_CELL_EMPTY);
+  }
+  packet->setCells(bbox.index(cellId), cell);
+}
+
+void forEachDenseMapCell(const MapHeader& header, const DenseMapPacket& packet,
+                         std::function<void(const GridCellID&, const DenseDcDCell&)> fn) {
+  auto bbox = DenseMapBoundingBox::fromPacket(header, packet);
+  for (int i = 0; i < bbox.getArea(); i++) {
+    const auto& cell = packet.getCells(i);
+    if (cell.getCount() != DENSE_CELL_EMPTY) {
+      fn(bbox.cellId(i), cell);
+    }
+  }
+}
+
+}  // namespace crownet
@@ -0,0 +1,97 @@
+/*
+ * DenseMapEncoding.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "inet/common/Units.h"
+#include "crownet/applications/dmap/dmap_m.h"
+#include "crownet/dcd/identifier/Identifiers.h"
+
+namespace crownet {
+
+// count value of cells in a DenseMapPacket without data.
+static constexpr uint16_t DENSE_CELL_EMPTY = 0xFFFF;
+// largest count value (count * 100) which can be encoded in a DenseMapPacket.
+static constexpr uint16_t DENSE_CELL_MAX_COUNT = 0xFFFE;
+// max number of cells in x or y direction (uint8_t in DenseMapPacket)
+static constexpr int DENSE_MAX_CELL_COUNT_XY = 0xFF;
+
+/**
+ * Bounding box of a DenseMapPacket. The origin is transmitted in the
+ * MapHeader (cellIdOffsetX/Y) and the size in the DenseMapPacket
+ * (cellCountX/Y). Cells are indexed in row-major order.
+ */
+class DenseMapBoundingBox {
+ public:
+  DenseMapBoundingBox() {}
+  DenseMapBoundingBox(int offsetX, int offsetY, int cellCountX, int cellCountY);
+
+  /**
+   * Largest prefix of cellIds (stream order) which fits into a
+   * DenseMapPacket of at most maxData. getDataCellCount() returns the length
+   * of this prefix (0 if not even one cell fits).
+   */
+  static DenseMapBoundingBox fromPrefix(const std::vector<GridCellID>& cellIds, inet::b maxData);
+  static DenseMapBoundingBox fromPacket(const MapHeader& header, const DenseMapPacket& packet);
+
+  bool contains(const GridCellID& cellId) const;
+  int index(const GridCellID& cellId) const;
+  GridCellID cellId(const int index) const;
+
+  int getOffsetX() const { return offsetX; }
+  int getOffsetY() const { return offsetY; }
+  int getCellCountX() const { return cellCountX; }
+  int getCellCountY() const { return cellCountY; }
+  int getArea() const { return cellCountX * cellCountY; }
+  int getDataCellCount() const { return dataCellCount; }
+
+  // encoded size of a DenseMapPacket with this bounding box.
+  inet::b getPacketLength() const;
+
+ private:
+  int offsetX = 0;
+  int offsetY = 0;
+  int cellCountX = 0;
+  int cellCountY = 0;
+  int dataCellCount = 0;
+};
+
+/**
+ * Encoded size of a SparseMapPacket with numCells cells.
+ */
+inet::b sparseMapPacketLength(int numCells);
+/**
+ * Max number of cells a SparseMapPacket resp. DenseMapPacket (best case, i.e.
+ * no empty cells) can hold with at most maxData.
+ */
+int maxSparseMapCells(inet::b maxData);
+int maxDenseMapCells(inet::b maxData);
+
+/**
+ * Select DENSE if the bounding box carries more cells than a SparseMapPacket
+ * of the same budget, or the same number of cells with fewer bytes.
+ */
+bool preferDenseMapPacket(const DenseMapBoundingBox& bbox, int numCandidates, inet::b maxData);
+
+/**
+ * Create DenseMapPacket for bbox with all cells marked as empty and the
+ * chunk length set to the encoded size.
+ */
+inet::Ptr<DenseMapPacket> createDenseMapPacket(const DenseMapBoundingBox& bbox);
+void setDenseMapCell(DenseMapPacket* packet, const DenseMapBoundingBox& bbox,
+                     const GridCellID& cellId, const DenseDcDCell& cell);
+
+/**
+ * Call fn for each non empty cell of the DenseMapPacket in row-major order.
+ */
+void forEachDenseMapCell(const MapHeader& header, const DenseMapPacket& packet,
+        std::function<void(const GridCellID&, const DenseDcDCell&)> fn);
+
+}  // namespace crownet
@@ -32,20 +32,15 @@ void DensityMapAppSimple::initialize(int stage) {
         nTable = inet::getModuleFromPar<INeighborhoodTable>(par("neighborhoodTableMobdule"), inet::getContainingNode(this));
         nTable->setOwnerId(hostId);
         nTable->registerEntryListner(this);
-
-        if (mapCfg->getAppendRessourceSharingDomoinId()){
-            // only count inside RSD
-            rsdCountVisitor = std::make_shared<RsdNeighborhoodCountVisitor>();
-        } else {
-            // count full map
-            rsdCountVisitor = std::make_shared<FullNeighborhoodCountVisitor>();
-        }
+        nCountCheck = par("checkNeighborhoodSize").boolValue();
     }
 }
 
-void DensityMapAppSimple::computeValues() {
+void DensityMapAppSimple::prepareComputeValues() {
+    // may trigger neighborhoodEntryRemoved (signals, Enter_Method) thus
+    // must run on the simulation thread.
     nTable->checkAllTimeToLive();
-    BaseDensityMapApp::computeValues();
+    BaseDensityMapApp::prepareComputeValues();
 }
 
 void DensityMapAppSimple::updateLocalMap() {
@@ -77,7 +72,7 @@ void DensityMapAppSimple::initLocalMap(){
 }
 
 const int DensityMapAppSimple::getNeighborhoodSize() {
-    computeValues();
+    updateNeighborhoodCount();
     const RsdIdPair& rsd = getRsdIdPair();
     int rsdid = rsd.getId();
     if (!rsd.valid() && mapCfg->getAppendRessourceSharingDomoinId()){
@@ -89,12 +84,141 @@ const int DensityMapAppSimple::getNeighborhoodSize() {
         rsdid = rsd.getPrevId();
     }
 
-    rsdCountVisitor->reset(simTime(), rsdid);
-    dcdMap->visitCells(*rsdCountVisitor);
+    int count;
+    if (incrementalCount()){
+        if (!mapCfg->getAppendRessourceSharingDomoinId()){
+            count = nCount;
+        } else if (rsdid < 0){
+            // ego count only (if the map contains any cell), same as NeighborhoodCountByRsdVisitor
+            count = dcdMap->getCells().empty() ? 0 : 1;
+        } else {
+            auto it = nRsdCount.find(rsdid);
+            count = it == nRsdCount.end() ? 0 : it->second;
+        }
+    } else if (mapCfg->getAppendRessourceSharingDomoinId()){
+        // only count inside RSD
+        count = nCountVisitor.getCount(rsdid);
+    } else {
+        // count full map
+        count = nCountVisitor.getCount();
+    }
+    if (nCountCheck){
+        checkNeighborhoodSize(rsdid, count);
+    }
+
+    EV_INFO << LOG_MOD << hostId  << " in RSD " << rsdid << " with neighborhood estimate:" << count << endl;
 
-    EV_INFO << LOG_MOD << hostId  << " in RSD " << rsdid << " with neighborhood estimate:" << rsdCountVisitor->getCount() << endl;
+    return count;
+}
 
-    return rsdCountVisitor->getCount();
+bool DensityMapAppSimple::incrementalCount() const {
+    return !receivedMap || valueVisitor->getVisitorName() == "local";
+}
+
+void DensityMapAppSimple::updateNeighborhoodCount(){
+    if (incrementalCount()){
+        const simtime_t now = simTime();
+        nTable->checkAllTimeToLive(); // may trigger neighborhoodEntryRemoved
+        for (const auto& cellId : nDirty){
+            refreshLocalCount(cellId, now);
+        }
+        nDirty.clear();
+        // counted entries reaching the TTL of the cell age handler
+        while (!nAgeQueue.empty() && now > nAgeQueue.top().first){
+            GridCellID cellId = nAgeQueue.top().second;
+            nAgeQueue.pop();
+            refreshLocalCount(cellId, now);
+        }
+        return;
+    }
+    // received entries can be selected as cell value thus the count is the
+    // sum of the computed cell values. These are computed at most once per
+    // time step, hence one pass per time step and RSD.
+    if (nCountValid && nCountTime == simTime()){
+        if (!mapCfg->getAppendRessourceSharingDomoinId() || nCountRsdId == getResourceSharingDomainId()){
+            return;
+        }
+    }
+    computeValues(); // may trigger neighborhoodEntryRemoved
+    nCountVisitor.reset();
+    dcdMap->visitCells(nCountVisitor);
+    nCountTime = simTime();
+    nCountRsdId = computeRsdId;
+    nCountValid = true;
+}
+
+DensityMapAppSimple::LocalCount DensityMapAppSimple::localCountOf(const GridCellID& cellId, const simtime_t& now){
+    LocalCount ret;
+    auto& cell = dcdMap->getCell(cellId);
+    if (cell.hasLocal()){
+        auto e = cell.getLocal();
+        const simtime_t ttl = mapCfg->getCellAgeTTL();
+        // see TTLCellAgeHandler::applyIfChanged
+        bool aged = ttl > 0.0 && now > (ttl + e->getMeasureTime());
+        if (e->valid() && !aged){
+            ret.count = (int)e->getCount();
+            ret.rsdId = e->getResourceSharingDomainId();
+        }
+    }
+    return ret;
+}
+
+void DensityMapAppSimple::refreshLocalCount(const GridCellID& cellId, const simtime_t& now){
+    LocalCount current = localCountOf(cellId, now);
+    LocalCount& counted = nLocalCount[cellId];
+    nCount += current.count - counted.count;
+    nRsdCount[counted.rsdId] -= counted.count;
+    nRsdCount[current.rsdId] += current.count;
+    counted = current;
+    const simtime_t ttl = mapCfg->getCellAgeTTL();
+    if (ttl > 0.0 && current.count != 0){
+        nAgeQueue.emplace(ttl + dcdMap->getCell(cellId).getLocal()->getMeasureTime(), cellId);
+    }
+}
+
+void DensityMapAppSimple::localEntryChanged(const GridCellID& cellId){
+    if (incrementalCount()){
+        nDirty.push_back(cellId);
+    }
+}
+
+void DensityMapAppSimple::checkNeighborhoodSize(int rsdid, int count){
+    if (incrementalCount()){
+        // recount all local entries
+        const simtime_t now = simTime();
+        int full = (rsdid < 0 && mapCfg->getAppendRessourceSharingDomoinId() && !dcdMap->getCells().empty()) ? 1 : 0;
+        for (const auto& c : dcdMap->getCells()){
+            LocalCount local = localCountOf(c.first, now);
+            if (!mapCfg->getAppendRessourceSharingDomoinId() || (rsdid >= 0 && local.rsdId == rsdid)){
+                full += local.count;
+            }
+        }
+        if (full != count){
+            throw cRuntimeError("Neighborhood size of node %d in RSD %d differs. Incremental count: %d full count: %d",
+                    hostId, rsdid, count, full);
+        }
+        return;
+    }
+    // new visitor each time. Count visitors are idempotent per time step.
+    std::shared_ptr<RsdNeighborhoodCountVisitor> v;
+    if (mapCfg->getAppendRessourceSharingDomoinId()){
+        v = std::make_shared<RsdNeighborhoodCountVisitor>(simTime(), rsdid);
+    } else {
+        v = std::make_shared<FullNeighborhoodCountVisitor>(simTime(), rsdid);
+    }
+    dcdMap->visitCells(*v);
+    if (v->getCount() != count){
+        throw cRuntimeError("Neighborhood size of node %d in RSD %d differs. Cached count: %d full count: %d",
+                hostId, rsdid, count, v->getCount());
+    }
+}
+
+bool DensityMapAppSimple::mergeReceivedMap(Packet *packet){
+    if (packet->peekAtFront<MapHeader>()->getSourceId() != getHostId()){
+        // received entries may be selected as cell value from now on.
+        receivedMap = true;
+    }
+    return BaseDensityMapApp::mergeReceivedMap(packet);
 }
 
 void DensityMapAppSimple::neighborhoodEntryRemoved(INeighborhoodTable* table, BeaconReceptionInfo* info){
@@ -116,6 +240,7 @@ void DensityMapAppSimple::neighborhoodEntryRemoved(INeighborhoodTable* table, Be
                 1.0
         );
         cellEntryLocal->setResourceSharingDomainId(getRsdIdPair());
+        localEntryChanged(cellId);
         dcdMap->removeFromNeighborhood((int)info->getNodeId());
         EV_INFO << LOG_MOD << hostId << " removes:" << cellId << " " << info->logShort() << " " << cellEntryLocal->logShort() << endl;
     }
@@ -158,6 +283,7 @@ void DensityMapAppSimple::neighborhoodEntryLeaveCell(INeighborhoodTable* table,
         cellEntryLocal->setResourceSharingDomainId(getRsdIdPair());
         cellEntryLocal->setEntryDist(std::move(dist));
         // remove node from Map NT
+        localEntryChanged(cellId);
         dcdMap->removeFromNeighborhood((int)info->getNodeId());
         EV_INFO << LOG_MOD << hostId << " leave-cell:" << cellId << " " << info->logShort() << " " << cellEntryLocal->logShort() << endl;
     }
@@ -193,6 +319,7 @@ void DensityMapAppSimple::neighborhoodEntryEnterCell(INeighborhoodTable* table,
         );
         cellEntryLocal->setEntryDist(std::move(dist));
         cellEntryLocal->setResourceSharingDomainId(getRsdIdPair());
+        localEntryChanged(cellId);
         // add node to neighborhood
         dcdMap->addToNeighborhood((int)info->getNodeId(), cellId);
         EV_INFO << LOG_MOD << hostId << " enter-cell: " << cellId << " " << info->logShort() << " " << cellEntryLocal->logShort() << endl;
@@ -238,6 +365,7 @@ void DensityMapAppSimple::neighborhoodEntryStayInCell(INeighborhoodTable* table,
         );
         cellEntryLocal->setEntryDist(std::move(dist));
         cellEntryLocal->setResourceSharingDomainId(getRsdIdPair());
+        localEntryChanged(cellId_current);
         EV_INFO << LOG_MOD << hostId << " stay-in-cell: " << cellId_current << " " << info->logShort() << " " << cellEntryLocal->logShort() << endl;
     }
 }
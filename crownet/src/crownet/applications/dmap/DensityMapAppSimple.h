@@ -15,6 +15,10 @@
 
 #pragma once
 
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
 #include "crownet/neighbourhood/contract/INeighborhoodTable.h"
 
 #include "inet/mobility/contract/IMobility.h"
@@ -46,7 +50,7 @@ protected:
 
  // IDensityMapHandler
  virtual void updateLocalMap() override;
- virtual void computeValues() override;
+ virtual void prepareComputeValues() override;
 
  // App logic
  virtual void initLocalMap() override;
@@ -57,12 +61,52 @@ protected:
  virtual void neighborhoodEntryEnterCell(INeighborhoodTable* table, BeaconReceptionInfo* info)override;
  virtual void neighborhoodEntryStayInCell(INeighborhoodTable* table, BeaconReceptionInfo* info)override;
 
- //
+ using BaseDensityMapApp::mergeReceivedMap;
+ virtual bool mergeReceivedMap(Packet *packet) override;
+
+ // Neighborhood size of the current (or previous) RSD. If the selected cell
+ // value is the local entry (see incrementalCount()) the count is kept up to
+ // date from the neighborhood events and a query only refreshes the cells
+ // changed or aged since the last query. Otherwise computeValues() and one
+ // pass over all cells (O(cells)) once per time step and RSD.
  virtual const int getNeighborhoodSize() override;
+ virtual void updateNeighborhoodCount();
+ virtual void checkNeighborhoodSize(int rsdid, int count);
+ // contribution of the local entry of a cell to the incremental count.
+ // Same rules as the computed cell values with LocalSelector: count of the
+ // valid local entry, zero once TTLCellAgeHandler would reset it.
+ struct LocalCount {
+     int count = 0;
+     int rsdId = -1;
+ };
+ // true if only local entries can be selected as cell value, i.e. local
+ // selection or no received map merged yet.
+ bool incrementalCount() const;
+ void localEntryChanged(const GridCellID& cellId);
+ void refreshLocalCount(const GridCellID& cellId, const simtime_t& now);
+ LocalCount localCountOf(const GridCellID& cellId, const simtime_t& now);
 private:
   // application
  INeighborhoodTable *nTable  = nullptr;
- std::shared_ptr<RsdNeighborhoodCountVisitor> rsdCountVisitor;
+ bool nCountCheck = false;
+ bool receivedMap = false;
+
+ // incremental count and the contribution of each cell counted in it.
+ int nCount = 0;
+ std::unordered_map<int, int> nRsdCount;
+ std::unordered_map<GridCellID, LocalCount> nLocalCount;
+ std::vector<GridCellID> nDirty; // changed by neighborhood events
+ // (TTL + measure time, cell) of counted entries, earliest first
+ using AgeItem = std::pair<simtime_t, GridCellID>;
+ std::priority_queue<AgeItem, std::vector<AgeItem>, std::greater<AgeItem>> nAgeQueue;
+
+ // full count: sum of the selected cell values of all RSDs (valueVisitor over
+ // local and received entries after aging). Valid for nCountTime and
+ // nCountRsdId. Cell values are computed at most once per time step.
+ NeighborhoodCountByRsdVisitor nCountVisitor;
+ simtime_t nCountTime;
+ int nCountRsdId = -1;
+ bool nCountValid = false;
 };
 
 } // namespace crownet
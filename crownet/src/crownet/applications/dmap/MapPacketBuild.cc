@@ -0,0 +1,52 @@
+/*
+ * MapPacketBuild.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/applications/dmap/MapPacketBuild.h"
+
+namespace crownet {
+
+int fillSparseMapPacket(RegularDcdMap& map, SparseMapPacket& payload, inet::b maxData,
+        const simtime_t& now){
+    // todo check map capacity and switch to DENSE Packet if needed.
+    maxData -= payload.getChunkLength();
+
+    int maxCellCount = (int)(maxData.get()/payload.getCellSize().get());
+    int cellSize = payload.getCellSize().get();
+
+    int usedSpace = 0;
+    auto stream = map.getCellKeyStream();
+
+    payload.setCellsArraySize(maxCellCount);
+
+    for (; usedSpace < maxCellCount; usedSpace++){
+        if(!stream->hasNext(now)){
+            break; // no more data present for transmission.
+        }
+        auto& cell = stream->nextCell(now);
+        cell.sentAt(now);
+        auto count_100 = cell.val()->getCount()*100;
+
+        LocatedDcDCell c {
+            (uint16_t)count_100,    //count
+            (uint16_t)cell.getCellId().x(), // offsetX
+            (uint16_t)cell.getCellId().y()  // offsetY
+        };
+        auto delta_t = now-cell.val()->getMeasureTime();
+        c.setDeltaCreation(delta_t);
+        c.setSourceEntryDist(cell.val()->getEntryDist().sourceEntry); // todo size
+        payload.setCells(usedSpace, c);
+    }
+
+    if (usedSpace < maxCellCount ){
+        payload.setCellsArraySize(usedSpace);
+    }
+    auto chunkLength = inet::b(payload.getChunkLength().get() + payload.getCellsArraySize() *cellSize);
+    payload.setChunkLength(chunkLength);
+    return usedSpace;
+}
+
+}  // namespace crownet
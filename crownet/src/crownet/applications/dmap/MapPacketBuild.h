@@ -0,0 +1,31 @@
+/*
+ * MapPacketBuild.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include "inet/common/Units.h"
+#include "crownet/applications/dmap/dmap_m.h"
+#include "crownet/dcd/regularGrid/RegularDcdMap.h"
+
+namespace crownet {
+
+/**
+ * Map operations of BaseDensityMapApp to build map packets. Free functions
+ * to allow tests and benchmarks to use the same code as the app (see
+ * MapPacketMerge.h for the receiving side).
+ */
+
+/**
+ * Fill payload with the next cells of the cell id stream of map until
+ * maxData (including the payload header) is used or the stream has no more
+ * cells at now. Taken cells are marked as sent at now. Sets the chunk length
+ * and returns the number of cells.
+ */
+int fillSparseMapPacket(RegularDcdMap& map, SparseMapPacket& payload, inet::b maxData,
+        const simtime_t& now);
+
+}  // namespace crownet
@@ -0,0 +1,54 @@
+/*
+ * MapPacketMerge.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/applications/dmap/MapPacketMerge.h"
+
+#include <omnetpp/cexception.h>
+
+namespace crownet {
+
+std::shared_ptr<GridEntry> mergeReceivedCell(RegularDcdMap& map, GridCellIDKeyProvider& provider,
+        const inet::Coord& senderPosition, const inet::Coord& ownerPosition, const int sourceNodeId,
+        const GridCellID& entryCellId, const double count, const simtime_t& measured,
+        const simtime_t& received, const double sourceEntryDist){
+    /**
+     *  extract sourceEntryDist from packet. This distance is the distance
+     *  from which the Entry was generated by the
+     *  original 'node'. The sender might be the original node but does not
+     *  have to be. Further more the
+     *  sender might have moved between measuring and sending the value.
+     *  Other distances (i.e. hostEntry, sourceHost) must be calculated.
+     */
+    EntryDist entryDist = provider.getExactDist(senderPosition, ownerPosition, entryCellId, sourceEntryDist);
+    if (measured > received){
+        throw omnetpp::cRuntimeError("measure time %s after receive time %s",
+                measured.str().c_str(), received.str().c_str());
+    }
+    // get or create entry shared pointer
+    auto _entry = map.getEntry<GridEntry>(entryCellId, sourceNodeId);
+    _entry->setCount(count);
+    _entry->setMeasureTime(measured);
+    _entry->setReceivedTime(received);
+    _entry->setEntryDist(std::move(entryDist));
+    _entry->setSource(sourceNodeId);
+    return _entry;
+}
+
+int mergeDeltaMapPacket(RegularDcdMap& map, GridCellIDKeyProvider& provider, DeltaMapDecoder& decoder,
+        const MapHeader& header, const DeltaMapPacket& body, const inet::Coord& ownerPosition,
+        const simtime_t& packetCreationTime, const simtime_t& received){
+    int sourceNodeId = (int)header.getSourceId();
+    inet::Coord senderPosition = header.getSourcePosition();
+    return decoder.decode(sourceNodeId, header, body,
+            [&](const GridCellID& entryCellId, int count_100, const DeltaDcDCell& cell){
+        mergeReceivedCell(map, provider, senderPosition, ownerPosition, sourceNodeId, entryCellId,
+                (double)count_100/100.0, cell.getCreationTime(packetCreationTime), received,
+                cell.getSourceEntryDist());
+    });
+}
+
+}  // namespace crownet
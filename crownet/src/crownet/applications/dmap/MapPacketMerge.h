@@ -0,0 +1,45 @@
+/*
+ * MapPacketMerge.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "inet/common/geometry/common/Coord.h"
+#include "crownet/applications/dmap/DeltaMapEncoding.h"
+#include "crownet/applications/dmap/dmap_m.h"
+#include "crownet/dcd/regularGrid/RegularDcdMap.h"
+
+namespace crownet {
+
+/**
+ * Map operations of BaseDensityMapApp on received map packets. Free
+ * functions to allow tests and benchmarks to use the same code as the app.
+ * No access to the simulation kernel (the receive time is passed in).
+ */
+
+/**
+ * Set entry of sourceNodeId in entryCellId (created if missing). The entry
+ * distance is computed from the sender position (senderPosition), the own
+ * position (ownerPosition) and the distance of the original measurement
+ * (sourceEntryDist).
+ */
+std::shared_ptr<GridEntry> mergeReceivedCell(RegularDcdMap& map, GridCellIDKeyProvider& provider,
+        const inet::Coord& senderPosition, const inet::Coord& ownerPosition, const int sourceNodeId,
+        const GridCellID& entryCellId, const double count, const simtime_t& measured,
+        const simtime_t& received, const double sourceEntryDist);
+
+/**
+ * Merge all cells of a DeltaMapPacket. Counts are resolved with the last
+ * keyframe of the sender kept by decoder. Returns the number of skipped cells
+ * (keyframe not received).
+ */
+int mergeDeltaMapPacket(RegularDcdMap& map, GridCellIDKeyProvider& provider, DeltaMapDecoder& decoder,
+        const MapHeader& header, const DeltaMapPacket& body, const inet::Coord& ownerPosition,
+        const simtime_t& packetCreationTime, const simtime_t& received);
+
+}  // namespace crownet
@@ -0,0 +1,122 @@
+/*
+ * NodeModulePool.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/artery/traci/NodeModulePool.h"
+
+#include <algorithm>
+
+using namespace omnetpp;
+
+namespace crownet {
+
+void NodeModulePool::setup(cModule* parent, const std::string& vectorName,
+                           int poolSize, bool reuseSlots) {
+  if (poolSize < 0) {
+    throw cRuntimeError("node pool size must not be negative. Got %d",
+                        poolSize);
+  }
+  this->parent = parent;
+  this->vectorName = vectorName;
+  this->poolSize = poolSize;
+  this->reuseSlots = reuseSlots;
+  nextIndex = 0;
+  freeIndices.clear();
+  capacity = parent->hasSubmoduleVector(vectorName.c_str())
+                 ? (unsigned)parent->getSubmoduleVectorSize(vectorName.c_str())
+                 : 0;
+  idle.clear();
+}
+
+int NodeModulePool::reserveIndex() {
+  if (reuseSlots && !freeIndices.empty()) {
+    int index = *freeIndices.begin();
+    freeIndices.erase(freeIndices.begin());
+    return index;
+  }
+  if (nextIndex >= capacity) {
+    capacity = std::max(2 * capacity, nextIndex + 1);
+    if (!parent->hasSubmoduleVector(vectorName.c_str())) {
+      parent->addSubmoduleVector(vectorName.c_str(), capacity);
+    } else {
+      parent->setSubmoduleVectorSize(vectorName.c_str(), capacity);
+    }
+  }
+  return (int)nextIndex++;
+}
+
+cModule* NodeModulePool::build(cModuleType* type) {
+  cModule* module = type->create(vectorName.c_str(), parent, reserveIndex());
+  module->finalizeParameters();
+  module->buildInside();
+  return module;
+}
+
+cModule* NodeModulePool::acquire(cModuleType* type) {
+  auto& modules = idle[type];  // remember type for refill()
+  if (modules.empty()) {
+    return build(type);
+  }
+  cModule* module = modules.front();
+  modules.pop_front();
+  return module;
+}
+
+int NodeModulePool::warmUp(cModuleType* type, int count) {
+  auto& modules = idle[type];
+  for (int i = 0; i < count; i++) {
+    modules.push_back(build(type));
+  }
+  return count;
+}
+
+void NodeModulePool::release(cModule* module) {
+  if (module->getParentModule() != parent ||
+      vectorName != module->getName() || !module->isVector()) {
+    throw cRuntimeError("module %s is not part of node pool %s",
+                        module->getFullPath().c_str(), vectorName.c_str());
+  }
+  int index = module->getIndex();
+  module->deleteModule();
+  freeIndices.insert(index);
+}
+
+int NodeModulePool::refill(int budget) {
+  int built = 0;
+  for (auto& entry : idle) {
+    int missing = poolSize - (int)entry.second.size();
+    int n = std::min(missing, budget - built);
+    if (n > 0) {
+      built += warmUp(entry.first, n);
+    }
+  }
+  return built;
+}
+
+void NodeModulePool::clear() {
+  for (auto& entry : idle) {
+    for (auto module : entry.second) {
+      freeIndices.insert(module->getIndex());
+      module->deleteModule();
+    }
+    entry.second.clear();
+  }
+}
+
+std::size_t NodeModulePool::getIdleCount() const {
+  std::size_t count = 0;
+  for (const auto& entry : idle) {
+    count += entry.second.size();
+  }
+  return count;
+}
+
+std::size_t NodeModulePool::getIdleCount(cModuleType* type) const {
+  auto found = idle.find(type);
+  return found != idle.end() ? found->second.size() : 0;
+}
+
+}  // namespace crownet
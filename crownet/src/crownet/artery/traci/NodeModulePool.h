@@ -0,0 +1,93 @@
+/*
+ * NodeModulePool.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <omnetpp.h>
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+
+namespace crownet {
+
+/**
+ * Lifecycle pool for dynamically created host modules of one submodule
+ * vector of the system module.
+ *
+ * - The submodule vector grows geometrically (capacity doubles) instead of
+ *   by one element per node. Unused slots stay empty (nullptr).
+ * - Idle modules are created and built (buildInside) ahead of time, i.e.
+ *   during warm-up or between TraCI steps, and handed out by acquire(). The
+ *   caller initializes them.
+ * - Departed (finished) hosts are handed back with release(). The module is
+ *   deleted and its slot stays empty. Indices are handed out monotonically,
+ *   thus each node gets a unique module path (and unique result names).
+ * - With reuseSlots the free slots are recycled (lowest first) and the vector
+ *   size follows the peak number of concurrent nodes instead of the total
+ *   number of nodes. Consecutive nodes then share a module path and their
+ *   per-module results (scalars, vectors, statistics) are mixed up. Only use
+ *   it if no per-path results are recorded.
+ *
+ * Idle modules are part of the submodule vector (parameters are assigned
+ * based on the module path) but are not initialized. Code iterating over the
+ * vector must skip modules with !initialized(). Initialized hosts can not be
+ * reset (OMNeT++ does not call initialize() twice and INET/Simu5G register
+ * global state on initialization) thus a released host is deleted and only
+ * its slot can be reused.
+ */
+class NodeModulePool {
+ public:
+  NodeModulePool() = default;
+  NodeModulePool(const NodeModulePool&) = delete;
+  NodeModulePool& operator=(const NodeModulePool&) = delete;
+
+  // poolSize: number of idle modules kept per module type
+  // reuseSlots: recycle slots of released modules. Breaks unique module
+  //             paths and thus per-path results (see class comment).
+  void setup(omnetpp::cModule* parent, const std::string& vectorName,
+             int poolSize, bool reuseSlots = false);
+
+  // created and built module of the given type. Not initialized.
+  omnetpp::cModule* acquire(omnetpp::cModuleType* type);
+  // build count idle modules of the given type. Returns number built.
+  int warmUp(omnetpp::cModuleType* type, int count);
+  // delete finished module. Its vector slot is only recycled with reuseSlots.
+  void release(omnetpp::cModule* module);
+  // top up idle modules of all used types to poolSize. At most budget
+  // modules are built. Returns number built.
+  int refill(int budget);
+  // delete all idle modules (must not be initialized or finished).
+  void clear();
+
+  const std::string& getVectorName() const { return vectorName; }
+  int getPoolSize() const { return poolSize; }
+  bool getReuseSlots() const { return reuseSlots; }
+  std::size_t getIdleCount() const;
+  std::size_t getIdleCount(omnetpp::cModuleType* type) const;
+  // used slots (idle and acquired modules) and current size of the
+  // submodule vector
+  unsigned getSize() const { return nextIndex - (unsigned)freeIndices.size(); }
+  unsigned getCapacity() const { return capacity; }
+
+ private:
+  int reserveIndex();
+  omnetpp::cModule* build(omnetpp::cModuleType* type);
+
+  omnetpp::cModule* parent = nullptr;
+  std::string vectorName;
+  int poolSize = 0;
+  bool reuseSlots = false;
+  unsigned nextIndex = 0;
+  unsigned capacity = 0;
+  // slots of deleted modules. Handed out again only with reuseSlots.
+  std::set<int> freeIndices;
+  std::map<omnetpp::cModuleType*, std::deque<omnetpp::cModule*>> idle;
+};
+
+}  // namespace crownet
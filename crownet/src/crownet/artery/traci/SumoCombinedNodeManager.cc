@@ -14,6 +14,7 @@
 // 
 
 #include "SumoCombinedNodeManager.h"
+#include <chrono>
 #include <omnetpp/ccomponent.h>
 #include <omnetpp/csimplemodule.h>
 #include <inet/common/ModuleAccess.h>
@@ -26,6 +27,7 @@
 #include "traci/VariableCache.h"
 #include "traci/VehicleSink.h"
 #include "inet/common/scenario/ScenarioManager.h"
+#include "crownet/common/util/Profiler.h"
 
 using namespace omnetpp;
 using namespace traci;
@@ -85,6 +87,7 @@ const simsignal_t SumoCombinedNodeManager::removePersonSignal = cComponent::regi
 const simsignal_t SumoCombinedNodeManager::addVehicleSignal = cComponent::registerSignal("traci.vehicle.add");
 const simsignal_t SumoCombinedNodeManager::updateVehicleSignal = cComponent::registerSignal("traci.vehicle.update");
 const simsignal_t SumoCombinedNodeManager::removeVehicleSignal = cComponent::registerSignal("traci.vehicle.remove");
+const simsignal_t SumoCombinedNodeManager::createTimeSignal = cComponent::registerSignal("traci.node.createTime");
 
 
 
@@ -112,12 +115,17 @@ void SumoCombinedNodeManager::initialize()
     m_vehicle_module_vector = par("vehicleNode").stringValue();
     m_destroy_vehicles_on_crash = par("destroyVehiclesOnCrash");
 
-    m_nodeIndex[m_vehicle_module_vector] = 0;
-    m_nodeIndex[m_person_module_vector] = 0;
+    int poolSize = par("nodePoolSize").intValue();
+    bool reuseSlots = par("nodePoolReuseSlots").boolValue();
+    m_personPool.setup(getSystemModule(), m_person_module_vector, poolSize, reuseSlots);
+    m_vehiclePool.setup(getSystemModule(), m_vehicle_module_vector, poolSize, reuseSlots);
+    m_poolRefill = par("nodePoolRefill").intValue();
 }
 
 void SumoCombinedNodeManager::finish()
 {
+    m_personPool.clear();
+    m_vehiclePool.clear();
     unsubscribeTraCI();
     cSimpleModule::finish();
 }
@@ -133,11 +141,13 @@ void SumoCombinedNodeManager::traciInit()
             addVehicle(id);
         }
         m_subscriptions->subscribeVehicleVariables(sVehicleVariables);
+        warmUpPool(m_vehiclePool, par("vehiclePoolType").stringValue());
     }
 
     // initialize persons if enabled
     if (!m_ignore_persons) {
         m_subscriptions->subscribePersonVariables(sPersonVariables);
+        warmUpPool(m_personPool, par("personPoolType").stringValue());
 
         // insert already running persons
         for (const std::string& id : m_api->person.getIDList()) {
@@ -152,6 +162,7 @@ void SumoCombinedNodeManager::traciInit()
 
 void SumoCombinedNodeManager::traciStep()
 {
+    CROWNET_PROFILE_MODULE_SCOPE("traci.nodeStep", this);
     if (!m_ignore_vehicle){
         processVehicles();
     }
@@ -159,6 +170,8 @@ void SumoCombinedNodeManager::traciStep()
         processPersons();
     }
     emit(updateNodeSignal, getNumberOfNodes());
+    int built = m_personPool.refill(m_poolRefill);
+    m_vehiclePool.refill(m_poolRefill - built);
 }
 
 
@@ -166,6 +179,9 @@ void SumoCombinedNodeManager::traciClose()
 {
     // Note: modules are removed/unregistered but not deleted - otherwise opp will complain
     //       (deletion is done later by opp environment)
+    //       Idle pool modules were never initialized and must not be finished.
+    m_personPool.clear();
+    m_vehiclePool.clear();
 
     for (unsigned i = m_personNodes.size(); i > 0; --i) {
         removePersonNodeModule(m_persons.begin()->first, false);
@@ -296,25 +312,14 @@ void SumoCombinedNodeManager::removePerson(const std::string& id)
 
 cModule* SumoCombinedNodeManager::createModule(const std::string&, cModuleType* type, const std::string& moduleVector)
 {
-    cModule* parentModule = getSystemModule();
-
-    if (!parentModule->hasSubmoduleVector(moduleVector.c_str())) {
-        parentModule->addSubmoduleVector(moduleVector.c_str(), m_nodeIndex[moduleVector] + 1);
-    }
-    else
-        parentModule->setSubmoduleVectorSize(moduleVector.c_str(), m_nodeIndex[moduleVector] + 1);
-    cModule* module = type->create(moduleVector.c_str(), parentModule, m_nodeIndex[moduleVector]);
-
-    ++m_nodeIndex[moduleVector];
-
-    return module;
+    // finalized and built, either from the pool or created on demand
+    return getNodePool(moduleVector).acquire(type);
 }
 
 cModule* SumoCombinedNodeManager::addNodeModule(const std::string& id, cModuleType* type, NodeInitializer& init, const std::string& moduleVector)
 {
+    auto t0 = std::chrono::steady_clock::now();
     cModule* module = createModule(id, type, moduleVector);
-    module->finalizeParameters();
-    module->buildInside();
     getNodeVector(moduleVector)[id] = module;
     init(module);
     module->scheduleStart(simTime());
@@ -327,6 +332,7 @@ cModule* SumoCombinedNodeManager::addNodeModule(const std::string& id, cModuleTy
     post.module = module;
     emit(POST_MODEL_CHANGE, &post);
 
+    emit(createTimeSignal, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
     emit(addNodeSignal, id.c_str(), module);
 
     return module;
@@ -352,7 +358,7 @@ void SumoCombinedNodeManager::removePersonNodeModule(const std::string& id, bool
         emit(removeNodeSignal, id.c_str(), module);
         module->callFinish();
         if (deleteModule)
-            module->deleteModule();
+            m_personPool.release(module);  // slot only reused with nodePoolReuseSlots
         m_personNodes.erase(id);
     } else {
         EV_DEBUG << "Node with id " << id << " does not exist, no removal\n";
@@ -366,7 +372,7 @@ void SumoCombinedNodeManager::removeVehicleNodeModule(const std::string& id, boo
         emit(removeNodeSignal, id.c_str(), module);
         module->callFinish();
         if (deleteModule)
-            module->deleteModule();
+            m_vehiclePool.release(module);  // slot only reused with nodePoolReuseSlots
         m_vehicleNodes.erase(id);
     } else {
         EV_DEBUG << "Node with id " << id << " does not exist, no removal\n";
@@ -416,6 +422,23 @@ std::map<std::string, omnetpp::cModule*>& SumoCombinedNodeManager::getNodeVector
     }
 }
 
+NodeModulePool& SumoCombinedNodeManager::getNodePool(const std::string& vectorName){
+    if (vectorName == m_person_module_vector){
+        return m_personPool;
+    } else if (vectorName == m_vehicle_module_vector){
+        return m_vehiclePool;
+    } else {
+        throw cRuntimeError("wrong vector node name");
+    }
+}
+
+void SumoCombinedNodeManager::warmUpPool(NodeModulePool& pool, const char* typeName)
+{
+    if (pool.getPoolSize() > 0 && typeName[0] != '\0') {
+        pool.warmUp(cModuleType::get(typeName), pool.getPoolSize());
+    }
+}
+
 VehicleSink* SumoCombinedNodeManager::getVehicleSink(cModule* node)
 {
     ASSERT(node);
@@ -21,6 +21,7 @@
 #include <traci/NodeManager.h>
 #include "traci/Position.h"
 #include "traci/SubscriptionManager.h"
+#include "crownet/artery/traci/NodeModulePool.h"
 #include "crownet/artery/traci/TraCiNodeVisitorAcceptor.h"
 //#include "traci/PersonSink.h"
 
@@ -50,6 +51,7 @@ public:
     static const omnetpp::simsignal_t addVehicleSignal;
     static const omnetpp::simsignal_t updateVehicleSignal;
     static const omnetpp::simsignal_t removeVehicleSignal;
+    static const omnetpp::simsignal_t createTimeSignal;
 
     std::shared_ptr<API> getAPI() override { return m_api; }
     SubscriptionManager* getSubscriptions() { return m_subscriptions; }
@@ -115,6 +117,8 @@ protected:
 private:
     virtual void eraseNode(const std::string& id);
     virtual std::map<std::string, omnetpp::cModule*>& getNodeVector(const std::string& vectorName);
+    virtual NodeModulePool& getNodePool(const std::string& vectorName);
+    void warmUpPool(NodeModulePool& pool, const char* typeName);
 
 protected:
     std::shared_ptr<API> m_api;
@@ -138,7 +142,9 @@ protected:
     bool m_destroy_vehicles_on_crash;
 
     omnetpp::SimTime m_offset = omnetpp::SimTime::ZERO;
-    std::map<std::string, unsigned> m_nodeIndex;
+    NodeModulePool m_personPool;
+    NodeModulePool m_vehiclePool;
+    int m_poolRefill;
 
 };
 
@@ -12,6 +12,65 @@ using namespace libsumo;
 
 namespace crownet {
 
+libsumo::TraCIPosition VadereBulkState::getPosition(std::size_t i) const {
+  libsumo::TraCIPosition pos;
+  pos.x = values[i * STRIDE];
+  pos.y = values[i * STRIDE + 1];
+  pos.z = values[i * STRIDE + 2];
+  return pos;
+}
+
+int VadereBulkState::indexOf(const std::string& id) const {
+  if (index.size() != ids.size()) {
+    index.clear();
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      index[ids[i]] = (int)i;
+    }
+  }
+  auto found = index.find(id);
+  return found == index.end() ? -1 : found->second;
+}
+
+void VadereBulkState::read(tcpip::Storage& in) {
+  if (in.readInt() != 3) {
+    throw libsumo::TraCIException("bulk state: expected compound with 3 items");
+  }
+  in.readUnsignedByte();
+  ids = in.readStringList();
+  in.readUnsignedByte();
+  int stride = in.readInt();
+  in.readUnsignedByte();
+  int count = in.readInt();
+  if (stride < STRIDE || count != (int)ids.size() * stride) {
+    throw libsumo::TraCIException("bulk state: wrong number of values");
+  }
+  values.resize(ids.size() * STRIDE);
+  auto out = values.begin();
+  for (std::size_t i = 0; i < ids.size(); ++i) {
+    for (int k = 0; k < stride; ++k) {
+      double v = in.readDouble();
+      if (k < STRIDE) {
+        *out++ = v;
+      }
+    }
+  }
+  index.clear();
+}
+
+void VadereBulkState::write(tcpip::Storage& out) const {
+  out.writeUnsignedByte(TYPE_COMPOUND);
+  out.writeInt(3);
+  out.writeUnsignedByte(TYPE_STRINGLIST);
+  out.writeStringList(ids);
+  out.writeUnsignedByte(TYPE_INTEGER);
+  out.writeInt(STRIDE);
+  out.writeUnsignedByte(TYPE_DOUBLELIST);
+  out.writeInt((int)values.size());
+  for (const auto v : values) {
+    out.writeDouble(v);
+  }
+}
+
 TraCIGeoPosition VadereApi::convertGeo(const TraCIPosition& pos) const {
   if (converter == nullptr) {
     return API::convertGeo(pos);
@@ -83,6 +142,16 @@ std::vector<std::string> VadereApi::VaderePersonScope::getTargetList(
   return getStringVector(VAR_TARGET_LIST, personID);
 }
 
+void VadereApi::VaderePersonScope::getBulkState(
+    const std::vector<std::string>& personIDs, VadereBulkState& state) const {
+  tcpip::Storage content;
+  content.writeUnsignedByte(TYPE_STRINGLIST);
+  content.writeStringList(personIDs);
+  createGetCommand(VAR_BULK_STATE, "", &content);
+  processGet(TYPE_COMPOUND);
+  state.read(getInput());
+}
+
 void VadereApi::VaderePersonScope::setSpeed(const std::string& personID,
                                             double speed) const {
   tcpip::Storage content;
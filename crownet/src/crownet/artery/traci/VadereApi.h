@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include <traci/API.h>
 #include <traci/VariableTraits.h>
 #include <traci/sumo/utils/traci/TraCIAPI.h>
@@ -30,6 +32,8 @@ constexpr int CMD_FILE_SEND = 0x75;
 constexpr int VAR_ARRIVED_PEDESTRIANS_IDS = 0x7a;
 constexpr int VAR_DEPARTED_PEDESTRIANS_IDS = 0x74;
 constexpr int VAR_COORD_REF = 0x90;
+// person domain: positions, speeds and angles of many persons in one response
+constexpr int VAR_BULK_STATE = 0xfc;
 //todo: (CM) add constexpr for sensor  VAR_ID
 
 }  // namespace constants
@@ -56,6 +60,36 @@ struct CoordRef {
   traci::TraCIPosition offset;
 };
 
+/**
+ * State of many persons received with one VAR_BULK_STATE request. All values
+ * are stored in one buffer with STRIDE values (x, y, z, speed, angle) per
+ * person in the order of ids.
+ *
+ * Wire format (TYPE_COMPOUND, 3 items):
+ *   TYPE_STRINGLIST ids, TYPE_INTEGER stride, TYPE_DOUBLELIST values
+ * A stride larger than STRIDE is accepted, additional values are skipped.
+ */
+struct VadereBulkState {
+  static constexpr int STRIDE = 5;
+
+  std::vector<std::string> ids;
+  std::vector<double> values;
+
+  std::size_t size() const { return ids.size(); }
+  libsumo::TraCIPosition getPosition(std::size_t i) const;
+  double getSpeed(std::size_t i) const { return values[i * STRIDE + 3]; }
+  double getAngle(std::size_t i) const { return values[i * STRIDE + 4]; }
+  // index of person id or -1 if not part of the state.
+  int indexOf(const std::string& id) const;
+
+  // read compound (type byte already consumed)
+  void read(tcpip::Storage& in);
+  void write(tcpip::Storage& out) const;
+
+ private:
+  mutable std::unordered_map<std::string, int> index;
+};
+
 class VadereApi : public API, public TraCiForwarder {
  public:
   VadereApi();
@@ -96,6 +130,10 @@ class VadereApi : public API, public TraCiForwarder {
     double getAngle(const std::string& personID) const;
     libsumo::TraCIColor getColor(const std::string& personID) const;
     std::vector<std::string> getTargetList(const std::string& personID) const;
+    // state of all given persons (all persons if personIDs is empty) with one
+    // request. state is reused to avoid allocations.
+    void getBulkState(const std::vector<std::string>& personIDs,
+                      VadereBulkState& state) const;
 
     // add?
 
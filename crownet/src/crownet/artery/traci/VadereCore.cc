@@ -11,6 +11,7 @@
 #include <traci/SubscriptionManager.h>
 
 #include "crownet/artery/traci/VadereSubscriptionManager.h"
+#include "crownet/common/util/Profiler.h"
 #include "VadereLauncher.h"
 
 using namespace traci;
@@ -32,9 +33,12 @@ void VadereCore::handleMessage(omnetpp::cMessage* msg) {
     // mobility provider is ahead dt = updateInterval
     // needed to interpolate between NOW(=simTime()) and NOW+updateInterval
     simtime_t targetTime = simTime() + m_updateInterval;
-    m_traci->simulationStep(targetTime.dbl());
-    if (m_subscriptions) {
-      m_subscriptions->step();
+    {
+      CROWNET_PROFILE_MODULE_SCOPE("traci.step", this);
+      m_traci->simulationStep(targetTime.dbl());
+      if (m_subscriptions) {
+        m_subscriptions->step();
+      }
     }
     emit(stepSignal, simTime());
 
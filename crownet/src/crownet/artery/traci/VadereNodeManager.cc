@@ -6,9 +6,11 @@
  */
 
 #include "VadereNodeManager.h"
+#include <chrono>
 #include <inet/common/ModuleAccess.h>
 #include "inet/common/scenario/ScenarioManager.h"
 #include "crownet/artery/traci/VadereCore.h"
+#include "crownet/common/util/Profiler.h"
 
 using namespace crownet::constants;
 using namespace libsumo;
@@ -40,6 +42,30 @@ class VaderePersonObjectImpl : public VadereNodeManager::VaderePersonObject {
  private:
   std::shared_ptr<VaderePersonCache> m_cache;
 };
+
+// MovingObject view on one entry of the bulk state buffer.
+class VadereBulkPersonObject : public VadereNodeManager::VaderePersonObject {
+ public:
+  VadereBulkPersonObject(VadereSubscriptionManager* subscriptions,
+                         const VadereBulkState& state, std::size_t index)
+      : m_subscriptions(subscriptions), m_state(state), m_index(index),
+        m_position(state.getPosition(index)) {}
+
+  std::shared_ptr<VaderePersonCache> getCache() const override {
+    return m_subscriptions->getPersonCache(m_state.ids[m_index]);
+  }
+  const TraCIPosition& getPosition() const override { return m_position; }
+  TraCIAngle getHeading() const override {
+    return TraCIAngle{m_state.getAngle(m_index)};
+  }
+  double getSpeed() const override { return m_state.getSpeed(m_index); }
+
+ private:
+  VadereSubscriptionManager* m_subscriptions;
+  const VadereBulkState& m_state;
+  std::size_t m_index;
+  TraCIPosition m_position;
+};
 }  // namespace
 
 Define_Module(VadereNodeManager);
@@ -56,6 +82,8 @@ const simsignal_t VadereNodeManager::updatePersonSignal =
     cComponent::registerSignal("traci.person.update");
 const simsignal_t VadereNodeManager::removePersonSignal =
     cComponent::registerSignal("traci.person.remove");
+const simsignal_t VadereNodeManager::createTimeSignal =
+    cComponent::registerSignal("traci.node.createTime");
 
 void VadereNodeManager::initialize() {
   VadereCore* core =
@@ -63,14 +91,18 @@ void VadereNodeManager::initialize() {
   subscribeTraCI(core);
   m_api = std::dynamic_pointer_cast<VadereApi>(core->getAPI());
   m_mapper = inet::getModuleFromPar<ModuleMapper>(par("mapperModule"), this);
-  m_nodeIndex = 0;
   m_personSinkModule = par("personSinkModule").stringValue();
   m_subscriptions = inet::getModuleFromPar<VadereSubscriptionManager>(
       par("subscriptionsModule"), this);
   m_personModuleVectorName = par("personNode").stdstringValue();
+  m_pool.setup(getSystemModule(), m_personModuleVectorName,
+               par("nodePoolSize").intValue(),
+               par("nodePoolReuseSlots").boolValue());
+  m_poolRefill = par("nodePoolRefill").intValue();
 }
 
 void VadereNodeManager::finish() {
+  m_pool.clear();
   m_api = nullptr;
   unsubscribeTraCI();
   cSimpleModule::finish();
@@ -80,7 +112,16 @@ void VadereNodeManager::traciInit() {
 
   m_boundary = Boundary{m_api->v_simulation.getNetBoundary()};
   m_subscriptions->subscribeSimulationVariables(sSimulationVariables);
-  m_subscriptions->subscribePersonVariables(sVehicleVariables);
+  if (!m_subscriptions->useBulkState()) {
+    m_subscriptions->subscribePersonVariables(sVehicleVariables);
+  }
+
+  // build idle host modules before the first persons arrive
+  const char* poolType = par("personPoolType").stringValue();
+  if (m_pool.getPoolSize() > 0 && poolType[0] != '\0') {
+    cModuleType* type = cModuleType::get(poolType);
+    m_pool.warmUp(type, m_pool.getPoolSize());
+  }
 
   // insert and subscribe to already running nodes
   for (const std::string& id : m_api->v_person.getIDList()) {
@@ -90,6 +131,7 @@ void VadereNodeManager::traciInit() {
 }
 
 void VadereNodeManager::traciStep() {
+  CROWNET_PROFILE_MODULE_SCOPE("traci.nodeStep", this);
   auto sim_cache = m_subscriptions->getSimulationCache();
   // todo
   //    ASSERT(checkTimeSync(*sim_cache, omnetpp::simTime()));
@@ -110,16 +152,23 @@ void VadereNodeManager::traciStep() {
     removeMovingObject(id);
   }
 
-  for (auto& obj : m_persons) {
-    const std::string& id = obj.first;
-    VaderePersonSink* sink = obj.second;
-    updateMovingObject(id, sink);
+  if (m_subscriptions->useBulkState()) {
+    updateMovingObjects(m_subscriptions->getBulkState());
+  } else {
+    for (auto& obj : m_persons) {
+      const std::string& id = obj.first;
+      VaderePersonSink* sink = obj.second;
+      updateMovingObject(id, sink);
+    }
   }
 
   emit(updateNodeSignal, getNumberOfNodes());
+  m_pool.refill(m_poolRefill);
 }
 
 void VadereNodeManager::traciClose() {
+  // idle pool modules were never initialized and must not be finished
+  m_pool.clear();
   for (unsigned i = m_nodes.size(); i > 0; --i) {
     removeNodeModule(m_nodes.begin()->first, false);
   }
@@ -130,9 +179,17 @@ void VadereNodeManager::addMovingObject(const std::string& id) {
       VaderePersonSink* objectSink = getObjectSink(module);
     auto& traci = m_api->v_person;
     objectSink->initializeSink(m_api, m_subscriptions->getPersonCache(id), m_boundary);
-    objectSink->initializePerson(traci.getPosition(id),
-                                 TraCIAngle{traci.getAngle(id)},
-                                 traci.getSpeed(id));
+    int i = m_subscriptions->useBulkState() ? m_subscriptions->getBulkState().indexOf(id) : -1;
+    if (i >= 0) {
+      const auto& state = m_subscriptions->getBulkState();
+      objectSink->initializePerson(state.getPosition(i),
+                                   TraCIAngle{state.getAngle(i)},
+                                   state.getSpeed(i));
+    } else {
+      objectSink->initializePerson(traci.getPosition(id),
+                                   TraCIAngle{traci.getAngle(id)},
+                                   traci.getSpeed(id));
+    }
     m_persons[id] = objectSink;
   };
 
@@ -155,8 +212,10 @@ void VadereNodeManager::removeMovingObject(const std::string& id) {
 void VadereNodeManager::updateMovingObject(const std::string& id,
         VaderePersonSink* sink) {
   auto person = m_subscriptions->getPersonCache(id);
-  VaderePersonObjectImpl update(person);
-  emit(updatePersonSignal, id.c_str(), &update);
+  if (mayHaveListeners(updatePersonSignal)) {
+    VaderePersonObjectImpl update(person);
+    emit(updatePersonSignal, id.c_str(), &update);
+  }
   if (sink) {
     sink->updatePerson(person->get<VAR_POSITION>(),
                        TraCIAngle{person->get<VAR_ANGLE>()},
@@ -164,28 +223,36 @@ void VadereNodeManager::updateMovingObject(const std::string& id,
   }
 }
 
-cModule* VadereNodeManager::createModule(const std::string&,
-                                         cModuleType* type) {
-
-    cModule* parentModule = getSystemModule();
-
-  if (!parentModule->hasSubmoduleVector(m_personModuleVectorName.c_str())) {
-      parentModule->addSubmoduleVector(m_personModuleVectorName.c_str(), m_nodeIndex + 1);
+void VadereNodeManager::updateMovingObjects(const VadereBulkState& state) {
+  const bool signal = mayHaveListeners(updatePersonSignal);
+  for (std::size_t i = 0; i < state.size(); ++i) {
+    auto found = m_persons.find(state.ids[i]);
+    if (found == m_persons.end()) {
+      continue;  // not (yet) managed by this node manager
+    }
+    if (signal) {
+      VadereBulkPersonObject update(m_subscriptions, state, i);
+      emit(updatePersonSignal, found->first.c_str(), &update);
+    }
+    if (found->second) {
+      found->second->updatePerson(state.getPosition(i),
+                                  TraCIAngle{state.getAngle(i)},
+                                  state.getSpeed(i));
+    }
   }
-  else
-      parentModule->setSubmoduleVectorSize(m_personModuleVectorName.c_str(), m_nodeIndex + 1);
-  cModule* module = type->create(m_personModuleVectorName.c_str(), parentModule, m_nodeIndex);
+}
 
-  ++m_nodeIndex;
-  return module;
+cModule* VadereNodeManager::createModule(const std::string&,
+                                         cModuleType* type) {
+  // finalized and built, either from the pool or created on demand
+  return m_pool.acquire(type);
 }
 
 cModule* VadereNodeManager::addNodeModule(const std::string& id,
                                           cModuleType* type,
                                           NodeInitializer& init) {
+  auto t0 = std::chrono::steady_clock::now();
   cModule* module = createModule(id, type);
-  module->finalizeParameters();
-  module->buildInside();
   m_nodes[id] = module;
   init(module);
   module->scheduleStart(simTime());
@@ -198,6 +265,8 @@ cModule* VadereNodeManager::addNodeModule(const std::string& id,
   post.module = module;
   emit(POST_MODEL_CHANGE, &post);
 
+  emit(createTimeSignal, std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - t0).count());
   emit(addNodeSignal, id.c_str(), module);
 
   return module;
@@ -209,7 +278,7 @@ void VadereNodeManager::removeNodeModule(const std::string& id, bool deleteModul
     emit(removeNodeSignal, id.c_str(), module);
     module->callFinish();
     if(deleteModule)
-        module->deleteModule();
+        m_pool.release(module);  // slot only reused with nodePoolReuseSlots
     m_nodes.erase(id);
   } else {
     EV_DEBUG << "Node with id " << id << " does not exist, no removal\n";
@@ -14,6 +14,7 @@
 #include <traci/VariableCache.h>
 #include <functional>
 #include "crownet/artery/traci.h"
+#include "crownet/artery/traci/NodeModulePool.h"
 #include "crownet/artery/traci/VadereSubscriptionManager.h"
 #include "crownet/artery/traci/VariableCache.h"
 #include "crownet/artery/traci/VaderePersonSink.h"
@@ -33,6 +34,7 @@ class VadereNodeManager : public traci::NodeManager,
   static const omnetpp::simsignal_t addPersonSignal;
   static const omnetpp::simsignal_t updatePersonSignal;
   static const omnetpp::simsignal_t removePersonSignal;
+  static const omnetpp::simsignal_t createTimeSignal;
 
   std::shared_ptr<API> getAPI() override { return m_api; }
   std::size_t getNumberOfNodes() const override;
@@ -57,6 +59,8 @@ class VadereNodeManager : public traci::NodeManager,
   virtual void addMovingObject(const std::string&);
   virtual void removeMovingObject(const std::string&);
   virtual void updateMovingObject(const std::string&, VaderePersonSink*);
+  // update all persons from one bulk state buffer
+  virtual void updateMovingObjects(const VadereBulkState&);
   virtual omnetpp::cModule* createModule(const std::string&,
                                          omnetpp::cModuleType*);
   virtual omnetpp::cModule* addNodeModule(const std::string&,
@@ -78,7 +82,8 @@ class VadereNodeManager : public traci::NodeManager,
   ModuleMapper* m_mapper;
   Boundary m_boundary;
   VadereSubscriptionManager* m_subscriptions;
-  unsigned m_nodeIndex;
+  NodeModulePool m_pool;
+  int m_poolRefill;
   std::map<std::string, VaderePersonSink*> m_persons;
   std::string m_personSinkModule;
   std::string m_personModuleVectorName;
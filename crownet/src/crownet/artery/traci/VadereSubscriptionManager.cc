@@ -39,9 +39,20 @@ void VadereSubscriptionManager::step() {
   }
 
   const auto& persons = m_api->v_person;
-  for (const std::string& person : m_subscribed_persons) {
-    const auto& vars = persons.getSubscriptionResults(person);
-    getPersonCache(person)->reset(vars);
+  if (m_bulk) {
+    static const std::vector<std::string> all;
+    persons.getBulkState(all, m_bulk_state);
+    // values not part of the bulk state are fetched on demand.
+    static const libsumo::TraCIResults empty;
+    for (auto& cache : m_person_caches) {
+      cache.second->reset(empty);
+    }
+  }
+  if (!m_person_vars.empty()) {
+    for (const std::string& person : m_subscribed_persons) {
+      const auto& vars = persons.getSubscriptionResults(person);
+      getPersonCache(person)->reset(vars);
+    }
   }
 }
 
@@ -107,6 +118,7 @@ void VadereSubscriptionManager::initialize() {
       inet::getModuleFromPar<VadereCore>(par("coreModule"), this);
   subscribeTraCI(core);
   m_api =core->getVadereApi();
+  m_bulk = par("bulkPersonState").boolValue();
   m_sim_cache = std::make_shared<VadereSimulationCache>(m_api);
 }
 
@@ -134,7 +146,9 @@ void VadereSubscriptionManager::traciStep() {}
 void VadereSubscriptionManager::traciClose() {}
 
 void VadereSubscriptionManager::subscribePerson(const std::string& id) {
-  updatePersonSubscription(id, m_person_vars);
+  if (!m_person_vars.empty()) {
+    updatePersonSubscription(id, m_person_vars);
+  }
   m_subscribed_persons.insert(id);
 }
 
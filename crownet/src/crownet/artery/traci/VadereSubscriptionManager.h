@@ -39,6 +39,9 @@ class VadereSubscriptionManager : public traci::Listener,
   getAllPersonCaches() const;
   std::shared_ptr<VaderePersonCache> getPersonCache(const std::string& id);
   std::shared_ptr<VadereSimulationCache> getSimulationCache();
+  // bulk mode: state of all persons is fetched with one request per step.
+  bool useBulkState() const { return m_bulk; }
+  const VadereBulkState& getBulkState() const { return m_bulk_state; }
 
  protected:
   void initialize() override;
@@ -65,6 +68,8 @@ class VadereSubscriptionManager : public traci::Listener,
   std::unordered_map<std::string, std::shared_ptr<VaderePersonCache>>
       m_person_caches;
   std::shared_ptr<VadereSimulationCache> m_sim_cache;
+  bool m_bulk = false;
+  VadereBulkState m_bulk_state;
 };
 
 } /* namespace crownet */
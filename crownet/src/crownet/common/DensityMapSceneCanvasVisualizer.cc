@@ -15,6 +15,7 @@
 
 #include "DensityMapSceneCanvasVisualizer.h"
 #include "crownet/common/ModuleAccess.h"
+#include <algorithm>
 
 namespace crownet {
 
@@ -38,9 +39,21 @@ void DensityMapSceneCanvasVisualizer::initialize(int stage) {
         converter = coordinateSystem->getConverter();
         auto canvas = visualizationTargetModule->getCanvas();
         canvasProjection = CanvasProjection::getCanvasProjection(canvas);
+        // same cell range as RegularGridInfo::aoiIter()
+        auto grid = converter->getGridDescription();
+        auto lowerLeft = grid.getCellKey(grid.getAreaOfIntrest().lowerLeftPosition());
+        auto upperRight = grid.getCellKey(grid.getAreaOfIntrest().upperRightPosition());
+        xMin = lowerLeft.x();
+        yMin = lowerLeft.y();
+        xMax = upperRight.x() - 1;
+        yMax = upperRight.y() - 1;
         auto mapGroupFigure = createMapFigure();
         mapGroupFigure->setZIndex(par("zIndex"));
         visualizationTargetModule->getCanvas()->addFigure(mapGroupFigure);
+        densityMode = par("densityMode").stdstringValue();
+        if (densityMode != "none"){
+            createDensityFigure();
+        }
         cDisplayString& displayString = visualizationTargetModule->getDisplayString();
         if (par("adjustBackgroundBox").boolValue()) {
             traci::TraCIPosition br = traci::TraCIPosition(
@@ -57,11 +70,9 @@ void DensityMapSceneCanvasVisualizer::initialize(int stage) {
 cGroupFigure *DensityMapSceneCanvasVisualizer::createMapFigure(){
     const cFigure::Color COLOR_BOUND = { 255, 0, 0 };
     const cFigure::Color COLOR_AREA_OF_INTREST = { 0, 0, 255 };
-    const cFigure::Color COLOR_GRID = { 200, 200, 200};
 
     auto bound = new cGroupFigure("MapBound");
     auto aoi = new cGroupFigure("AreaOfIntrest");
-    auto grid = new cGroupFigure("Grid");
 
     cRectangleFigure *rect = converter->toCanvas(converter->getSimBound(), "Bound");
     rect->setFilled(false);
@@ -74,18 +85,157 @@ cGroupFigure *DensityMapSceneCanvasVisualizer::createMapFigure(){
     rect->setLineStyle(cFigure::LINE_DOTTED);
     aoi->addFigure(rect);
 
-    for (const auto& cellId : converter->getGridDescription().aoiIter()){
-        auto c = converter->toCanvas(cellId);
-        c->setLineColor(COLOR_GRID);
-        grid->addFigure(c);
-    }
-
     auto mapFigure = new cGroupFigure("Density Map");
     mapFigure->setTags("street_map");
     mapFigure->addFigure(bound);
     mapFigure->addFigure(aoi);
-    mapFigure->addFigure(grid);
+    mapFigure->addFigure(createGridFigure(par("gridMode").stdstringValue()));
 
     return mapFigure;
 }
+
+cGroupFigure *DensityMapSceneCanvasVisualizer::createGridFigure(const std::string& gridMode){
+    const cFigure::Color COLOR_GRID = { 200, 200, 200};
+    auto grid = new cGroupFigure("Grid");
+    if (gridMode == "cells"){
+        // one figure per cell. Slow for large AOIs.
+        for (const auto& cellId : converter->getGridDescription().aoiIter()){
+            auto c = converter->toCanvas(cellId);
+            c->setLineColor(COLOR_GRID);
+            grid->addFigure(c);
+        }
+    } else if (gridMode == "lines"){
+        // same picture with (xMax - xMin) + (yMax - yMin) + 4 figures.
+        const auto& cellSize = converter->getCellSize();
+        double left = xMin * cellSize.x;
+        double right = (xMax + 1) * cellSize.x;
+        double bottom = yMin * cellSize.y;
+        double top = (yMax + 1) * cellSize.y;
+        for (int x = xMin; x <= xMax + 1; x++){
+            auto l = new cLineFigure();
+            l->setStart(converter->toCanvas(x * cellSize.x, bottom));
+            l->setEnd(converter->toCanvas(x * cellSize.x, top));
+            l->setLineColor(COLOR_GRID);
+            grid->addFigure(l);
+        }
+        for (int y = yMin; y <= yMax + 1; y++){
+            auto l = new cLineFigure();
+            l->setStart(converter->toCanvas(left, y * cellSize.y));
+            l->setEnd(converter->toCanvas(right, y * cellSize.y));
+            l->setLineColor(COLOR_GRID);
+            grid->addFigure(l);
+        }
+    } else if (gridMode != "none"){
+        throw cRuntimeError("expected cells, lines or none as gridMode got '%s'", gridMode.c_str());
+    }
+    return grid;
+}
+
+void DensityMapSceneCanvasVisualizer::createDensityFigure(){
+    if (densityMode != "sparse" && densityMode != "pixmap"){
+        throw cRuntimeError("expected none, sparse or pixmap as densityMode got '%s'", densityMode.c_str());
+    }
+    globalMapHandler = inet::getModuleFromPar<IGlobalDensityMapHandler<RegularDcdMap>>(
+            par("globalMapModule"), this);
+    updateInterval = par("updateInterval");
+    maxCount = par("maxCount").doubleValue();
+    if (maxCount <= 0.0){
+        throw cRuntimeError("maxCount must be > 0 got %f", maxCount);
+    }
+
+    densityFigure = new cGroupFigure("Density");
+    densityFigure->setTags("density_map");
+    densityFigure->setZIndex(par("zIndex").doubleValue() + 0.1);
+    if (densityMode == "pixmap"){
+        // one pixel per AOI cell, scaled to the AOI on the canvas.
+        const auto& cellSize = converter->getCellSize();
+        int width = xMax - xMin + 1;
+        int height = yMax - yMin + 1;
+        pixmap = cFigure::Pixmap(width, height, cFigure::RGBA(0, 0, 0, 0));
+        pixmapFigure = new cPixmapFigure("DensityPixmap");
+        pixmapFigure->setPosition(converter->toCanvas(xMin * cellSize.x, (yMax + 1) * cellSize.y));
+        pixmapFigure->setAnchor(cFigure::ANCHOR_NW);
+        pixmapFigure->setWidth(width * cellSize.x);
+        pixmapFigure->setHeight(height * cellSize.y);
+        pixmapFigure->setInterpolation(cFigure::INTERPOLATION_NONE);
+        pixmapFigure->setPixmap(pixmap);
+        densityFigure->addFigure(pixmapFigure);
+    }
+    visualizationTargetModule->getCanvas()->addFigure(densityFigure);
+}
+
+void DensityMapSceneCanvasVisualizer::refreshDisplay() const {
+    inet::visualizer::SceneVisualizerBase::refreshDisplay();
+    if (densityFigure == nullptr || (lastUpdate >= 0.0 && simTime() - lastUpdate < updateInterval)){
+        return;
+    }
+    auto map = globalMapHandler->getMap();
+    if (!map){
+        return; // not initialized yet
+    }
+    lastUpdate = simTime();
+    if (pixmapFigure){
+        updatePixmap(*map);
+    } else {
+        updateSparse(*map);
+    }
+}
+
+void DensityMapSceneCanvasVisualizer::updateSparse(const RegularDcdMap& map) const {
+    size_t usedFigures = 0;
+    for (const auto& val : map.validLocal()){
+        const auto& cellId = val.first;
+        if (cellId.x() < xMin || cellId.x() > xMax || cellId.y() < yMin || cellId.y() > yMax){
+            continue;
+        }
+        double count = val.second.getLocal()->getCount();
+        if (count <= 0.0){
+            continue;
+        }
+        if (usedFigures == cellFigures.size()){
+            // grow pool. Figures are never deleted, only hidden.
+            auto c = converter->toCanvas(cellId);
+            c->setFilled(true);
+            c->setLineColor(cFigure::GREY);
+            c->setFillOpacity(0.6);
+            densityFigure->addFigure(c);
+            cellFigures.push_back(c);
+        }
+        auto c = cellFigures[usedFigures++];
+        auto bounds = c->getBounds();
+        auto pos = converter->toCanvas(cellId.x() * converter->getCellSize().x,
+                (cellId.y() + 1) * converter->getCellSize().y);
+        if (bounds.x != pos.x || bounds.y != pos.y){
+            c->setBounds(cFigure::Rectangle(pos.x, pos.y, bounds.width, bounds.height));
+        }
+        c->setFillColor(countColor(count));
+        c->setVisible(true);
+    }
+    for (size_t i = usedFigures; i < cellFigures.size() && cellFigures[i]->isVisible(); i++){
+        cellFigures[i]->setVisible(false);
+    }
+}
+
+void DensityMapSceneCanvasVisualizer::updatePixmap(const RegularDcdMap& map) const {
+    pixmap.fill(cFigure::RGBA(0, 0, 0, 0));
+    for (const auto& val : map.validLocal()){
+        const auto& cellId = val.first;
+        if (cellId.x() < xMin || cellId.x() > xMax || cellId.y() < yMin || cellId.y() > yMax){
+            continue;
+        }
+        double count = val.second.getLocal()->getCount();
+        if (count > 0.0){
+            // pixmap row 0 is the top (yMax) row of the AOI
+            pixmap.setPixel(cellId.x() - xMin, yMax - cellId.y(), countColor(count), 0.6);
+        }
+    }
+    pixmapFigure->setPixmap(pixmap);
+}
+
+cFigure::Color DensityMapSceneCanvasVisualizer::countColor(double count) const {
+    // white (0) to red (>= maxCount)
+    double f = std::min(count / maxCount, 1.0);
+    uint8_t v = (uint8_t)(255 * (1.0 - f));
+    return cFigure::Color(255, v, v);
+}
 }
@@ -20,6 +20,8 @@
 #include "inet/common/geometry/common/GeographicCoordinateSystem.h"
 #include "inet/visualizer/base/SceneVisualizerBase.h"
 #include "crownet/common/converter/OsgCoordConverter.h"
+#include "crownet/common/IDensityMapHandler.h"
+#include "crownet/dcd/regularGrid/RegularDcdMap.h"
 
 using namespace inet;
 
@@ -34,9 +36,30 @@ protected:
   OsgCoordConverterProvider* coordinateSystem;
   std::shared_ptr<OsgCoordinateConverter> converter;
 
+  // density layer (densityMode sparse | pixmap). Only created with GUI.
+  std::string densityMode;
+  IGlobalDensityMapHandler<RegularDcdMap>* globalMapHandler = nullptr;
+  simtime_t updateInterval;
+  double maxCount;
+  cGroupFigure *densityFigure = nullptr;
+  cPixmapFigure *pixmapFigure = nullptr;
+  // AOI in cell coordinates (inclusive)
+  int xMin, yMin, xMax, yMax;
+
+  mutable simtime_t lastUpdate = -1.0;
+  // sparse: figure pool, only the first usedFigures are visible.
+  mutable std::vector<cRectangleFigure*> cellFigures;
+  mutable cFigure::Pixmap pixmap;
+
 protected:
   virtual void initialize(int stage) override;
+  virtual void refreshDisplay() const override;
   cGroupFigure *createMapFigure();
+  cGroupFigure *createGridFigure(const std::string& gridMode);
+  void createDensityFigure();
+  void updateSparse(const RegularDcdMap& map) const;
+  void updatePixmap(const RegularDcdMap& map) const;
+  cFigure::Color countColor(double count) const;
 
 };
 }
@@ -16,6 +16,7 @@
 
 #include "crownet/common/util/FilePrinter.h"
 #include "crownet/common/RsdProviderMixin.h"
+#include "crownet/common/EntryAllocator.h"
 
 struct EntryDist{
     double sourceHost;     /* distance between the node which conducted the measurement and the current node */
@@ -23,6 +24,18 @@ struct EntryDist{
     double hostEntry;      /* distance the current node and the point/cell of interest */
 };
 
+/**
+ * Receives validity transitions (valid <-> invalid) of an IEntry. The
+ * container holding the entry (i.e. a Cell) uses this to keep track of
+ * its valid entries without scanning them.
+ */
+template <typename K>
+class IEntryObserver {
+ public:
+  virtual ~IEntryObserver() = default;
+  virtual void validityChanged(const K& source, const bool valid) = 0;
+};
+
 template <typename K, typename T>
 class IEntry : public crownet::FilePrinter {
  public:
@@ -36,21 +49,21 @@ class IEntry : public crownet::FilePrinter {
   virtual ~IEntry() = default;
   virtual void reset(const time_type& t) {
     count = 0;
-    _valid = false;
+    setValid(false);
     measurement_time = t;
     received_time = t;
-    selected_in = "";
+    selectionId = 0;
   }
   virtual void reset() {
     count = 0;
-    _valid = false;
-    selected_in = "";
+    setValid(false);
+    selectionId = 0;
   }
   virtual void clear(const time_type& t) {
     count = 0;
     measurement_time = t;
     received_time = t;
-    selected_in = "";
+    selectionId = 0;
   }
   const bool empty() const;
   virtual const bool valid() const { return _valid; }
@@ -88,6 +101,9 @@ class IEntry : public crownet::FilePrinter {
 
   virtual void setSelectedIn(std::string viewName);
   virtual std::string getSelectedIn() const;
+  // interned selection name (see StringRegistry). 0 := not selected
+  void setSelectionId(const int id) { selectionId = id; }
+  const int getSelectionId() const { return selectionId; }
 
   virtual void setResourceSharingDomainId(const int rsd);
   virtual void setResourceSharingDomainId(const crownet::RsdIdPair& rsdIdPair);
@@ -108,16 +124,34 @@ class IEntry : public crownet::FilePrinter {
   bool operator==(const IEntry<K, T>& rhs) const;
   std::string logShort()const;
 
+  // at most one observer (the cell the entry was put into last).
+  void setObserver(IEntryObserver<K>* observer) { this->observer.ptr = observer; }
+  IEntryObserver<K>* getObserver() const { return observer.ptr; }
+
+ protected:
+  void setValid(const bool valid);
+
+ private:
+  // Copies of an entry (e.g. selected cell values) are not part of any
+  // cell and thus do not inherit the observer.
+  struct ObserverRef {
+    ObserverRef() = default;
+    ObserverRef(const ObserverRef&) {}
+    ObserverRef& operator=(const ObserverRef&) { return *this; }
+    IEntryObserver<K>* ptr = nullptr;
+  };
+  ObserverRef observer;
+
  protected:
   double count = 0.0;
   double selectionRank = std::numeric_limits<double>::max();
   time_type measurement_time;
   time_type received_time;
-  bool _valid;
   key_type source = 0;
   EntryDist entryDist;
-  std::string selected_in;
   int resourceSharingDomainId = -1;
+  int selectionId = 0;  // interned name of selecting algorithm (StringRegistry)
+  bool _valid;
 };
 
 
@@ -157,32 +191,40 @@ class EntryCtor {
 template <typename K, typename T>
 class EntryDefaultCtorImpl : public EntryCtor<K, T> {
  public:
+  EntryDefaultCtorImpl(std::shared_ptr<crownet::EntrySlabAllocator> allocator = nullptr) : allocator(allocator) {}
+
   std::shared_ptr<IEntry<K, T>> entry() const override{
-    return std::make_shared<IEntry<K, T>>();
+    return crownet::makeSlabShared<IEntry<K, T>>(allocator);
   }
 
   std::shared_ptr<IGlobalEntry<K, T>> globalEntry() const override {
-    return std::make_shared<IGlobalEntry<K, T>>();
+    return crownet::makeSlabShared<IGlobalEntry<K, T>>(allocator);
   }
 
   std::shared_ptr<IEntry<K, T>> empty() const override {
-    return std::make_shared<IEntry<K, T>>(-1);
+    return crownet::makeSlabShared<IEntry<K, T>>(allocator, -1);
   }
+
+  // entries are allocated from allocator if set (see DcDMap)
+  const std::shared_ptr<crownet::EntrySlabAllocator>& getAllocator() const { return allocator; }
+
+ private:
+  std::shared_ptr<crownet::EntrySlabAllocator> allocator;
 };
 
 /// implementation IEntry<K, T>
 
 template <typename K, typename T>
 inline IEntry<K, T>::IEntry()
-    : count(0), measurement_time(), received_time(), _valid(true), source(0) {}
+    : count(0), measurement_time(), received_time(), source(0), _valid(true) {}
 
 template <typename K, typename T>
 inline IEntry<K, T>::IEntry(double count)
     : count(count),
       measurement_time(),
       received_time(),
-      _valid(count >= 0),
-      source(0) {}
+      source(0),
+      _valid(count >= 0) {}
 
 template <typename K, typename T>
 inline IEntry<K, T>::IEntry(const double count, const time_type& m_t,
@@ -190,9 +232,9 @@ inline IEntry<K, T>::IEntry(const double count, const time_type& m_t,
     : count(count),
       measurement_time(m_t),
       received_time(r_t),
-      _valid(true),
       source(0),
-      entryDist(){}
+      entryDist(),
+      _valid(true){}
 
 template <typename K, typename T>
 inline IEntry<K, T>::IEntry(const double count, const time_type& m_t,
@@ -200,9 +242,9 @@ inline IEntry<K, T>::IEntry(const double count, const time_type& m_t,
     : count(count),
       measurement_time(m_t),
       received_time(r_t),
-      _valid(true),
       source(source),
-      entryDist(dist){}
+      entryDist(dist),
+      _valid(true){}
 
 template <typename K, typename T>
 inline IEntry<K, T>::IEntry(const double count, const time_type& m_t, const time_type& r_t,
@@ -210,9 +252,9 @@ inline IEntry<K, T>::IEntry(const double count, const time_type& m_t, const time
     : count(count),
       measurement_time(m_t),
       received_time(r_t),
-      _valid(true),
       source(std::move(source)),
-      entryDist(std::move(dist)){}
+      entryDist(std::move(dist)),
+      _valid(true){}
 
 
 template <typename K, typename T>
@@ -268,7 +310,15 @@ inline void IEntry<K, T>::touch(const time_type& sent_time, const time_type& rec
         this->measurement_time = sent_time;
         this->received_time = received_time;
     }
-    this->_valid = true;
+    this->setValid(true);
+}
+
+template <typename K, typename T>
+inline void IEntry<K, T>::setValid(const bool valid) {
+    if (this->_valid != valid){
+        this->_valid = valid;
+        if (this->observer.ptr) this->observer.ptr->validityChanged(this->source, valid);
+    }
 }
 
 template <typename K, typename T>
@@ -373,12 +423,12 @@ inline const K& IEntry<K, T>::getSource() const {
 
 template <typename K, typename T>
 void IEntry<K, T>::setSelectedIn(std::string viewName) {
-  this->selected_in = viewName;
+  this->selectionId = crownet::StringRegistry::id(viewName);
 }
 
 template <typename K, typename T>
 std::string IEntry<K, T>::getSelectedIn() const {
-  return this->selected_in;
+  return crownet::StringRegistry::str(this->selectionId);
 }
 
 template <typename K, typename T>
@@ -412,7 +462,7 @@ inline std::string IEntry<K, T>::csv(std::string delimiter) const {
   std::stringstream out;
   out << this->count << delimiter << this->measurement_time << delimiter
       << this->received_time << delimiter << this->source << delimiter
-      << this->selected_in;
+      << crownet::StringRegistry::str(this->selectionId);
   return out.str();
 }
 
@@ -436,7 +486,7 @@ void IEntry<K, T>::writeTo(std::ostream& out, const std::string& sep) const {
           this->measurement_time << sep << \
           this->received_time << sep << \
           this->source << sep << \
-          this->selected_in  << sep << \
+          crownet::StringRegistry::str(this->selectionId)  << sep << \
           this->selectionRank << sep << \
           this->entryDist.sourceHost << sep << \
           this->entryDist.sourceEntry << sep << \
@@ -480,8 +530,8 @@ std::string IEntry<K, T>::logShort() const{
 template <typename K, typename T>
 void IGlobalEntry<K, T>::writeTo(std::ostream& out, const std::string& sep) const {
   out << this->count << sep << this->measurement_time << sep
-      << this->received_time << sep << this->source << sep << this->selected_in << sep
-      << this->selectionRank;
+      << this->received_time << sep << this->source << sep
+      << crownet::StringRegistry::str(this->selectionId) << sep << this->selectionRank;
 }
 
 template <typename K, typename T>
@@ -0,0 +1,115 @@
+/*
+ * EntryAllocator.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/common/EntryAllocator.h"
+
+#include <algorithm>
+#include <new>
+#include <omnetpp/cexception.h>
+
+namespace crownet {
+
+constexpr std::size_t EntrySlabAllocator::ALIGN;
+constexpr std::size_t EntrySlabAllocator::MAX_BLOCK_SIZE;
+constexpr std::size_t EntrySlabAllocator::FIRST_CHUNK_BLOCKS;
+constexpr std::size_t EntrySlabAllocator::MAX_CHUNK_BLOCKS;
+
+EntrySlabAllocator::EntrySlabAllocator() : sizeClasses(MAX_BLOCK_SIZE / ALIGN + 1) {}
+
+EntrySlabAllocator::~EntrySlabAllocator() {
+  for (auto chunk : chunks) {
+    ::operator delete(chunk);
+  }
+}
+
+void* EntrySlabAllocator::allocate(std::size_t bytes) {
+  std::size_t idx = (std::max(bytes, sizeof(FreeBlock)) + ALIGN - 1) / ALIGN;
+  if (idx >= sizeClasses.size()) {
+    ++stats.fallbackAllocations;
+    return ::operator new(bytes);
+  }
+  auto& sizeClass = sizeClasses[idx];
+  if (sizeClass.free == nullptr) {
+    refill(sizeClass, idx * ALIGN);
+  }
+  FreeBlock* block = sizeClass.free;
+  sizeClass.free = block->next;
+  ++stats.allocations;
+  stats.peakLive = std::max(stats.peakLive, stats.live());
+  return block;
+}
+
+void EntrySlabAllocator::deallocate(void* p, std::size_t bytes) {
+  if (p == nullptr) return;
+  std::size_t idx = (std::max(bytes, sizeof(FreeBlock)) + ALIGN - 1) / ALIGN;
+  if (idx >= sizeClasses.size()) {
+    ::operator delete(p);
+    return;
+  }
+  auto block = static_cast<FreeBlock*>(p);
+  block->next = sizeClasses[idx].free;
+  sizeClasses[idx].free = block;
+  ++stats.deallocations;
+}
+
+void EntrySlabAllocator::refill(SizeClass& sizeClass, std::size_t blockSize) {
+  std::size_t blocks = sizeClass.nextChunkBlocks;
+  sizeClass.nextChunkBlocks = std::min(blocks * 2, MAX_CHUNK_BLOCKS);
+
+  char* chunk = static_cast<char*>(::operator new(blocks * blockSize));
+  chunks.push_back(chunk);
+  ++stats.chunkAllocations;
+  stats.reservedBytes += blocks * blockSize;
+
+  // thread blocks of new chunk into free list (keep address order)
+  for (std::size_t i = blocks; i > 0; --i) {
+    auto block = reinterpret_cast<FreeBlock*>(chunk + (i - 1) * blockSize);
+    block->next = sizeClass.free;
+    sizeClass.free = block;
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+StringRegistry::StringRegistry() {
+  strings.push_back("");
+  ids[""] = 0;
+}
+
+StringRegistry& StringRegistry::instance() {
+  static StringRegistry registry;
+  return registry;
+}
+
+int StringRegistry::id(const std::string& str) {
+  if (str.empty()) return 0;
+  auto& r = instance();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  auto iter = r.ids.find(str);
+  if (iter != r.ids.end()) return iter->second;
+  int id = (int)r.strings.size();
+  r.strings.push_back(str);
+  r.ids[str] = id;
+  return id;
+}
+
+const std::string& StringRegistry::str(const int id) {
+  auto& r = instance();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  if (id < 0 || id >= (int)r.strings.size()) {
+    throw omnetpp::cRuntimeError("No interned string with id %d", id);
+  }
+  return r.strings[id];
+}
+
+int StringRegistry::size() {
+  auto& r = instance();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  return (int)r.strings.size();
+}
+
+}  // namespace crownet
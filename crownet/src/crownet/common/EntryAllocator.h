@@ -0,0 +1,150 @@
+/*
+ * EntryAllocator.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crownet {
+
+struct EntrySlabStats {
+  std::size_t allocations = 0;          // blocks handed out
+  std::size_t deallocations = 0;        // blocks returned
+  std::size_t peakLive = 0;             // max. number of blocks in use
+  std::size_t chunkAllocations = 0;     // calls to ::operator new for slabs
+  std::size_t fallbackAllocations = 0;  // requests too big for any size class
+  std::size_t reservedBytes = 0;        // bytes held by slabs
+
+  std::size_t live() const { return allocations - deallocations; }
+};
+
+/**
+ * Slab allocator for map entries (IEntry, IGlobalEntry and the shared_ptr
+ * control block allocated together with them by std::allocate_shared).
+ *
+ * This only replaces the heap allocation of entries. Entries are still
+ * polymorphic objects owned by std::shared_ptr (reference counted, virtual
+ * calls) and are constructed and destroyed as before. There is no object
+ * reuse and no handle/index based access.
+ *
+ * Out of scope: a compact, map owned entry representation without vtable
+ * and without per entry reference count (entries addressed by index into
+ * the map storage). Apps, visitors, printers and the packet code hold and
+ * share entries as std::shared_ptr<IEntry> (see EntryDefaultCtorImpl), thus
+ * this needs a change of the entry API and is a separate work item.
+ *
+ * Blocks are grouped into size classes of ALIGN bytes. Each size class
+ * allocates slabs (chunks) of blocks which grow geometrically from
+ * FIRST_CHUNK_BLOCKS up to MAX_CHUNK_BLOCKS and keeps freed blocks in an
+ * intrusive free list. Slabs are only released when the allocator is
+ * destroyed.
+ *
+ * An allocator is owned by a DcDMap. Each entry keeps a shared_ptr to it
+ * (EntryAllocator in the control block) such that entries can outlive the
+ * map. Not thread safe.
+ */
+class EntrySlabAllocator {
+ public:
+  static constexpr std::size_t ALIGN = alignof(std::max_align_t);
+  static constexpr std::size_t MAX_BLOCK_SIZE = 512;
+  static constexpr std::size_t FIRST_CHUNK_BLOCKS = 16;
+  static constexpr std::size_t MAX_CHUNK_BLOCKS = 1024;
+
+  EntrySlabAllocator();
+  ~EntrySlabAllocator();
+  EntrySlabAllocator(const EntrySlabAllocator&) = delete;
+  EntrySlabAllocator& operator=(const EntrySlabAllocator&) = delete;
+
+  void* allocate(std::size_t bytes);
+  void deallocate(void* p, std::size_t bytes);
+
+  const EntrySlabStats& getStats() const { return stats; }
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+  struct SizeClass {
+    FreeBlock* free = nullptr;
+    std::size_t nextChunkBlocks = FIRST_CHUNK_BLOCKS;
+  };
+  void refill(SizeClass& sizeClass, std::size_t blockSize);
+
+  std::vector<SizeClass> sizeClasses;
+  std::vector<void*> chunks;
+  EntrySlabStats stats;
+};
+
+/**
+ * std compatible allocator backed by an EntrySlabAllocator.
+ */
+template <typename T>
+class EntryAllocator {
+ public:
+  using value_type = T;
+
+  explicit EntryAllocator(std::shared_ptr<EntrySlabAllocator> slab) : slab(std::move(slab)) {}
+  template <typename U>
+  EntryAllocator(const EntryAllocator<U>& other) : slab(other.getSlab()) {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(slab->allocate(n * sizeof(T)));
+  }
+  void deallocate(T* p, std::size_t n) { slab->deallocate(p, n * sizeof(T)); }
+
+  const std::shared_ptr<EntrySlabAllocator>& getSlab() const { return slab; }
+
+  template <typename U>
+  bool operator==(const EntryAllocator<U>& rhs) const { return slab == rhs.getSlab(); }
+  template <typename U>
+  bool operator!=(const EntryAllocator<U>& rhs) const { return slab != rhs.getSlab(); }
+
+ private:
+  std::shared_ptr<EntrySlabAllocator> slab;
+};
+
+/**
+ * Create shared entry (object and control block in one slab block). Falls
+ * back to std::make_shared if no allocator is given.
+ */
+template <typename E, typename... Args>
+std::shared_ptr<E> makeSlabShared(const std::shared_ptr<EntrySlabAllocator>& slab, Args&&... args) {
+  if (slab) {
+    return std::allocate_shared<E>(EntryAllocator<E>(slab), std::forward<Args>(args)...);
+  }
+  return std::make_shared<E>(std::forward<Args>(args)...);
+}
+
+/**
+ * Process wide registry of interned strings. Used for values which are set
+ * on many objects but only have a handful of distinct values (e.g. the
+ * name of the aggregation algorithm which selected an entry).
+ * Id 0 is reserved for the empty string. Access is synchronized because maps
+ * may be updated concurrently (see GlobalDensityMap::updateThreads).
+ */
+class StringRegistry {
+ public:
+  static int id(const std::string& str);
+  static const std::string& str(const int id);
+  static int size();
+
+ private:
+  static StringRegistry& instance();
+  StringRegistry();
+  std::mutex mutex;
+  std::deque<std::string> strings;  // stable references
+  std::unordered_map<std::string, int> ids;
+};
+
+}  // namespace crownet
@@ -24,6 +24,7 @@
 #include "crownet/dcd/regularGrid/RegularCellVisitors.h"
 #include "crownet/dcd/regularGrid/MapCellAggregationAlgorithms.h"
 #include "crownet/dcd/regularGrid/RegularDcdMapPrinter.h"
+#include "crownet/common/util/Profiler.h"
 
 namespace {
 const simsignal_t traciConnected = cComponent::registerSignal("traci.connected");
@@ -67,6 +68,12 @@ void GlobalDensityMap::finish() {
   getSystemModule()->unsubscribe(removeMap, this);
   getSystemModule()->unsubscribe(traciConnected, this);
   fileWriter->finish();
+  if (cellKeyProvider){
+      // distance table is shared by all maps and neighborhood tables of this grid.
+      auto distTable = cellKeyProvider->getDistanceTable();
+      recordScalar("cellDistanceTableHits", (double)distTable->getHits());
+      recordScalar("cellDistanceTableMisses", (double)distTable->getMisses());
+  }
 }
 
 void GlobalDensityMap::receiveSignal(omnetpp::cComponent *source,
@@ -77,12 +84,6 @@ void GlobalDensityMap::receiveSignal(omnetpp::cComponent *source,
       auto mapHandler = check_and_cast<GridHandler *>(obj);
       mapHandler->setMapFactory(dcdMapFactory);
       mapHandler->setCoordinateConverter(converter);
-
-      if (par("writerType").stdstringValue() == "sql"){
-          // only share the sql writer between maps
-          // todo mw
-          // mapHandler->setSqlApi(api);
-      }
   }
   else if (signalId == registerMap) {
     auto mapHandler = check_and_cast<GridHandler *>(obj);
@@ -121,44 +122,44 @@ void GlobalDensityMap::initializeMap(){
 
     dcdMapFactory = std::make_shared<RegularDcdMapFactory>(converter);
 
-    dcdMapGlobal = dcdMapFactory->create_shared_ptr(IntIdentifer(-1));  // global
+    dcdMapGlobal = dcdMapFactory->create_shared_ptr(IntIdentifer(-1), "default", mapCfg->getCellStoreType());  // global
     cellKeyProvider = dcdMapFactory->getCellKeyProvider();
 
     // 2) setup writer.
-    if (par("writerType").stdstringValue() == "csv"){
-        ActiveFileWriterBuilder fBuilder{};
-        fBuilder.addMetadata("IDXCOL", 3);
-        fBuilder.addMetadata("XSIZE", converter->getGridSize().x);
-        fBuilder.addMetadata("YSIZE", converter->getGridSize().y);
-        fBuilder.addMetadata("XOFFSET", converter->getOffset().x);
-        fBuilder.addMetadata("YOFFSET", converter->getOffset().y);
-        // todo cellsize in x and y
-        fBuilder.addMetadata("CELLSIZE", converter->getCellSize().x);
-        fBuilder.addMetadata("VERSION", std::string("0.4")); // todo!!!
-        fBuilder.addMetadata("DATATYPE", mapDataType);
-        fBuilder.addMetadata<std::string>(
-            "MAP_TYPE",
-            mapCfg->getMapType());  // The global density map is the ground
-                                    // truth. No algorihm needed.
-        fBuilder.addMetadata<const traci::Boundary&>("SIM_BBOX", converter->getSimBound());
-        fBuilder.addMetadata<int>("NODE_ID", -1);
+    std::string writerType = par("writerType").stdstringValue();
+    if (writerType != "csv" && writerType != "bin" && writerType != "sql"){
+        throw cRuntimeError("expected sql, csv or bin as writer type got '%s'", writerType.c_str());
+    }
+    ActiveFileWriterBuilder fBuilder{};
+    fBuilder.addMetadata("IDXCOL", 3);
+    fBuilder.addMetadata("XSIZE", converter->getGridSize().x);
+    fBuilder.addMetadata("YSIZE", converter->getGridSize().y);
+    fBuilder.addMetadata("XOFFSET", converter->getOffset().x);
+    fBuilder.addMetadata("YOFFSET", converter->getOffset().y);
+    // todo cellsize in x and y
+    fBuilder.addMetadata("CELLSIZE", converter->getCellSize().x);
+    fBuilder.addMetadata("VERSION", std::string("0.4")); // todo!!!
+    fBuilder.addMetadata("DATATYPE", mapDataType);
+    fBuilder.addMetadata<std::string>(
+        "MAP_TYPE",
+        mapCfg->getMapType());  // The global density map is the ground
+                                // truth. No algorihm needed.
+    fBuilder.addMetadata<const traci::Boundary&>("SIM_BBOX", converter->getSimBound());
+    fBuilder.addMetadata<int>("NODE_ID", -1);
+    if (writerType == "bin"){
         fBuilder.addPath("global");
-
-        fileWriter.reset(fBuilder.build(
+        fileWriter.reset(fBuilder.buildBinary(
             std::make_shared<RegularDcdMapGlobalPrinter>(dcdMapGlobal)));
-    } else if (par("writerType").stdstringValue() == "sql"){
-//      todo mw
-//
-//      create sqlApi <--- will be shared
-//      create sqlWriter/Printer for global map
-//          todo mw setup SqlLiteWriter
-//          auto sqlWriter = std::make_shared<SqlLiteWriter>();
-//          auto sqlPrinter = std::make_shared<RegularDcdMapSqlValuePrinter>(dcdMapGlobal);
-//          sqlWriter->setSqlApi(sqlApi);
-//          sqlWriter->setPrinter(sqlPrinter);
-//          filewriter = sqlWriter;
+    } else if (writerType == "sql"){
+        fBuilder.addPath(par("sqlFile").stdstringValue());
+        fileWriter.reset(fBuilder.buildSql(
+            std::make_shared<RegularDcdMapSqlGlobalPrinter>(dcdMapGlobal),
+            par("sqlCommitInterval").intValue()));
     } else {
-        throw cRuntimeError("expected sql or csv as writer type got '%s'", par("writerType").stringValue());
+        fBuilder.addPath("global");
+        fBuilder.setAsyncWrite(par("asyncWrite").boolValue());
+        fileWriter.reset(fBuilder.build(
+            std::make_shared<RegularDcdMapGlobalPrinter>(dcdMapGlobal)));
     }
     fileWriter->initWriter();
 }
@@ -190,6 +191,10 @@ void GlobalDensityMap::initialize(int stage) {
           appDeleteNode = new cMessage("deleteNode");
           scheduleAt(par("deleteTime").doubleValue(), appDeleteNode);
       }
+      int updateThreads = par("updateThreads").intValue();
+      if (updateThreads > 1){
+          workerPool.reset(new WorkerPool(updateThreads));
+      }
 
   } else if (stage == INITSTAGE_APPLICATION_LAYER) {
     m_mobilityModule = par("mobilityModule").stdstringValue();
@@ -310,17 +315,65 @@ void GlobalDensityMap::updateMaps() {
   dcdMapGlobal->clearNeighborhood();
   acceptNodeVisitor(this);
   valueVisitor->setTime(simTime());
-  dcdMapGlobal->computeValues(valueVisitor);
+  {
+    CROWNET_PROFILE_MODULE_SCOPE("map.computeValues", this);
+    dcdMapGlobal->computeValues(valueVisitor);
+  }
 
-  // update decentralized map
+  updateDezentralMaps();
+}
+
+void GlobalDensityMap::updateDezentralMaps() {
+  if (!workerPool) {
+    for (auto &handler : dezentralMaps) {
+      handler.second->updateLocalMap();
+      handler.second->computeValues();
+    }
+    return;
+  }
+
+  // 1) simulation thread: everything accessing the simulation (neighborhood
+  //    tables, signals, other modules). Same order as in serial mode.
+  concurrentHandlers.clear();
   for (auto &handler : dezentralMaps) {
     handler.second->updateLocalMap();
-    handler.second->computeValues();
+    if (handler.second->supportsConcurrentCompute()) {
+      handler.second->prepareComputeValues();
+      concurrentHandlers.push_back(handler.second);
+    } else {
+      handler.second->computeValues();
+    }
+  }
+  // 2) worker threads: maps are independent of each other, thus the result
+  //    is the same as in serial mode.
+  //    Exceptions are caught on the worker and rethrown in 3).
+  std::vector<std::exception_ptr> errors(concurrentHandlers.size());
+  workerPool->parallelFor((int)concurrentHandlers.size(), [this, &errors](int i) {
+    try {
+      concurrentHandlers[i]->computeMapValues();
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  });
+  // 3) simulation thread: report errors and finish in the serial order.
+  for (size_t i = 0; i < concurrentHandlers.size(); i++) {
+    if (errors[i]) {
+      try {
+        std::rethrow_exception(errors[i]);
+      } catch (const std::exception &e) {
+        throw cRuntimeError("computeMapValues of %s failed: %s",
+                concurrentHandlers[i]->getModule()->getFullPath().c_str(), e.what());
+      }
+    }
+    concurrentHandlers[i]->finishComputeValues();
   }
 }
 
 void GlobalDensityMap::writeMaps() {
-  fileWriter->writeData();
+  {
+    CROWNET_PROFILE_MODULE_SCOPE("map.write", this);
+    fileWriter->writeData();
+  }
 
   // write decentralized maps
   for (auto &handler : dezentralMaps) {
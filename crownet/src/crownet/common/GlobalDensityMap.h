@@ -25,6 +25,7 @@
 #include "crownet/common/converter/OsgCoordConverter.h"
 #include "crownet/common/util/Writer.h"
 #include "crownet/common/util/FileWriter.h"
+#include "crownet/common/util/WorkerPool.h"
 #include "crownet/dcd/regularGrid/RegularDcdMap.h"
 #include "traci/NodeManager.h"
 #include "crownet/dcd/regularGrid/RegularCellVisitors.h"
@@ -98,6 +99,8 @@ class GlobalDensityMap : public omnetpp::cSimpleModule,
   virtual void handleMessage(cMessage *msg) override;
 
   virtual void updateMaps();
+  // update and compute values of all decentralized maps (concurrently if updateThreads > 1)
+  virtual void updateDezentralMaps();
   void writeMaps();
 
  protected:
@@ -123,6 +126,8 @@ class GlobalDensityMap : public omnetpp::cSimpleModule,
   std::string mapDataType; //todo switch for PedestrianVsEntropy data
   std::string m_mobilityModule;
   std::shared_ptr<ActiveWriter> fileWriter;
+  std::unique_ptr<WorkerPool> workerPool; // nullptr: serial update
+  std::vector<GridHandler*> concurrentHandlers;
 
 
 };
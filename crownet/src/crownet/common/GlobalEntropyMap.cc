@@ -115,10 +115,7 @@ void GlobalEntropyMap::updateMaps() {
     dcdMapGlobal->computeValues(valueVisitor);
 
     // update decentralized map
-    for (auto &handler : dezentralMaps) {
-      handler.second->updateLocalMap();
-      handler.second->computeValues();
-    }
+    updateDezentralMaps();
 }
 
 NeighborhoodTableValue_t GlobalEntropyMap::getValue(const int sourceId){
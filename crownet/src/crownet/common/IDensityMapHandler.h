@@ -31,6 +31,18 @@ class IDensityMapHandler : public IDensityMapHandlerBase<GRID> {
   virtual ~IDensityMapHandler() = default;
   virtual void updateLocalMap() = 0;
   virtual void computeValues() = 0;
+  /**
+   * Split of computeValues() used to update the maps of several nodes
+   * concurrently (see GlobalDensityMap). prepareComputeValues() and
+   * finishComputeValues() are called on the simulation thread and do all
+   * interaction with the simulation (simTime(), signals, cRuntimeError).
+   * computeMapValues() may run on a worker thread and must only access
+   * the map of this handler.
+   */
+  virtual bool supportsConcurrentCompute() const { return false; }
+  virtual void prepareComputeValues() {}
+  virtual void computeMapValues() {}
+  virtual void finishComputeValues() {}
   // FIXME: allow global fileWriter object to pass in.
   virtual void writeMap() = 0;
   //  FIXME: make mergeMap independent from Packet (see ArteryDensityMapApp.cc)
@@ -0,0 +1,87 @@
+/*
+ * PositionQuantizer.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/common/converter/PositionQuantizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace crownet {
+
+PositionQuantizer::PositionQuantizer(std::shared_ptr<OsgCoordinateConverter> converter, double resolution, int bits)
+    : converter(converter), resolution(resolution), bits(bits) {
+  if (!converter) {
+    throw cRuntimeError("PositionQuantizer needs a coordinate converter");
+  }
+  if (resolution <= 0.0) {
+    throw cRuntimeError("position resolution must be > 0 got %f", resolution);
+  }
+  if (bits < 1 || bits > 32) {
+    throw cRuntimeError("position bits must be in [1, 32] got %d", bits);
+  }
+  maxValue = bits == 32 ? 0xFFFFFFFF : (uint32_t)((1ull << bits) - 1);
+  auto bound = converter->getAreaOfInterestBound();
+  origin = bound.lowerLeftPosition();
+  double width = bound.upperRightPosition().x - origin.x;
+  double height = bound.upperRightPosition().y - origin.y;
+  if (width > getCoverage() || height > getCoverage()) {
+    throw cRuntimeError("position encoding covers %.1fm per axis (resolution %f, %d bits) but the "
+                        "area of interest is %.1fm x %.1fm. Increase resolution or bits",
+                        getCoverage(), resolution, bits, width, height);
+  }
+}
+
+uint32_t PositionQuantizer::toFixed(const double value) const {
+  double v = std::round(value / resolution);
+  return (uint32_t)std::min(std::max(v, 0.0), (double)maxValue);
+}
+
+void PositionQuantizer::encode(const inet::Coord& pos, uint32_t& x, uint32_t& y) const {
+  auto p = converter->position_cast_traci(pos);
+  x = toFixed(p.x - origin.x);
+  y = toFixed(p.y - origin.y);
+}
+
+inet::Coord PositionQuantizer::decode(const uint32_t x, const uint32_t y) const {
+  traci::TraCIPosition p(origin.x + x * resolution, origin.y + y * resolution, 0.0);
+  return converter->position_cast_inet(p);
+}
+
+inet::Coord PositionQuantizer::quantize(const inet::Coord& pos) const {
+  uint32_t x, y;
+  encode(pos, x, y);
+  return decode(x, y);
+}
+
+bool PositionQuantizer::covers(const inet::Coord& pos) const {
+  auto p = converter->position_cast_traci(pos);
+  double dx = p.x - origin.x;
+  double dy = p.y - origin.y;
+  return dx >= 0.0 && dy >= 0.0 && dx <= getCoverage() && dy <= getCoverage();
+}
+
+uint16_t quantizeSpeed(const double speed, const double resolution, const int bits) {
+  double v = std::round(std::abs(speed) / resolution);
+  return (uint16_t)std::min(v, (double)((1 << bits) - 1));
+}
+
+double dequantizeSpeed(const uint16_t value, const double resolution) { return value * resolution; }
+
+uint16_t quantizeHeading(const double heading, const int bits) {
+  const double steps = (double)(1 << bits);
+  double h = std::fmod(heading, 2 * M_PI);
+  if (h < 0.0) {
+    h += 2 * M_PI;
+  }
+  return (uint16_t)((uint32_t)std::round(h / (2 * M_PI) * steps) % (1u << bits));
+}
+
+double dequantizeHeading(const uint16_t value, const int bits) {
+  return value * 2 * M_PI / (double)(1 << bits);
+}
+
+}  // namespace crownet
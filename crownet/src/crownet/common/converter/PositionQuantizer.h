@@ -0,0 +1,75 @@
+/*
+ * PositionQuantizer.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+#include "inet/common/geometry/common/Coord.h"
+#include "crownet/common/converter/OsgCoordinateConverter.h"
+
+namespace crownet {
+
+/**
+ * Fixed point position encoding relative to the lower left corner of the
+ * area of interest (AOI) of the converter (simulation bound if no AOI is
+ * set). Each axis uses `bits` bits with a step of `resolution` meter.
+ *
+ * Error bounds: positions within covered area (see getCoverage()) are
+ * reconstructed with at most resolution/2 error per axis. The covered area
+ * must contain the AOI (checked at construction). Positions outside of the
+ * AOI are clamped to the border of the covered area. The z coordinate is not
+ * encoded.
+ *
+ *   bits=16, resolution=0.1m  -> 6553.5m per axis, error <= 0.05m
+ */
+class PositionQuantizer {
+ public:
+  PositionQuantizer(std::shared_ptr<OsgCoordinateConverter> converter, double resolution, int bits = 16);
+
+  // fixed point value of pos (OCS)
+  void encode(const inet::Coord& pos, uint32_t& x, uint32_t& y) const;
+  // OCS position of fixed point value
+  inet::Coord decode(const uint32_t x, const uint32_t y) const;
+  // position as seen by the receiver (encode + decode)
+  inet::Coord quantize(const inet::Coord& pos) const;
+
+  bool covers(const inet::Coord& pos) const;
+  // covered size in meter per axis starting at the AOI origin.
+  double getCoverage() const { return resolution * maxValue; }
+  double getMaxError() const { return resolution / 2.0; }
+  double getResolution() const { return resolution; }
+  int getBits() const { return bits; }
+
+ private:
+  uint32_t toFixed(const double value) const;
+
+  std::shared_ptr<OsgCoordinateConverter> converter;
+  double resolution;
+  int bits;
+  uint32_t maxValue;
+  traci::TraCIPosition origin;  // TCS
+};
+
+/**
+ * Speed and heading of the compact beacon encoding (8 bit each).
+ *   speed:   0.25 m/s per step, saturates at 63.75 m/s
+ *   heading: 360/256 deg per step, error <= 0.71 deg
+ */
+static constexpr double COMPACT_SPEED_RESOLUTION = 0.25;
+static constexpr int COMPACT_SPEED_BITS = 8;
+static constexpr int COMPACT_HEADING_BITS = 8;
+
+uint16_t quantizeSpeed(const double speed, const double resolution = COMPACT_SPEED_RESOLUTION,
+                       const int bits = COMPACT_SPEED_BITS);
+double dequantizeSpeed(const uint16_t value, const double resolution = COMPACT_SPEED_RESOLUTION);
+// heading in rad (any value, wrapped to [0, 2pi))
+uint16_t quantizeHeading(const double heading, const int bits = COMPACT_HEADING_BITS);
+double dequantizeHeading(const uint16_t value, const int bits = COMPACT_HEADING_BITS);
+
+}  // namespace crownet
@@ -15,6 +15,9 @@
 
 #include "CountQuadTree.h"
 
+#include <functional>
+#include <queue>
+
 using namespace inet;
 
 namespace crownet {
@@ -32,25 +35,42 @@ CountQuadTree::CountQuadTree(Coord boundMin, double width, double height, int qu
 
 
 int CountQuadTree::insert(const cObject* elementData, const Coord& pos){
+    if (!treeNodes[0].contains(pos)){
+        throw cRuntimeError("Insertion failed for object: %s with position: (%f, %f, %f)", elementData ? elementData->getFullName() : "nullptr", pos.x, pos.y, pos.z);
+    }
+    if (elementData && objectIndex.find(elementData) != objectIndex.end()){
+        throw cRuntimeError("Object %s already part of the QuadTree", elementData->getFullName());
+    }
+    ElementNode eNode;
+    eNode.elementData = elementData;
+    eNode.pos = pos;
+    eNode.next = -1;
+    int dataId = data.insert(eNode);
+    insertElement(dataId);
+    if (elementData){
+        objectIndex[elementData] = dataId;
+    }
+    return dataId;
+}
 
+void CountQuadTree::insertElement(int dataId){
+    const Coord pos = data[dataId].pos;
     std::vector<int> treeNodesToProcess;
     treeNodesToProcess.push_back(0);
     while(treeNodesToProcess.size() > 0){
         int nodeIdx = treeNodesToProcess.back();
         treeNodesToProcess.pop_back();
-        QuadTreeNode& node = treeNodes[nodeIdx];
+        // copy: splitNode() may reallocate treeNodes
+        QuadTreeNode node = treeNodes[nodeIdx];
         if (node.contains(pos)){
             if (node.isLeaf()){
-                if (node.count < quadrantCapacity){
+                if (node.count < quadrantCapacity || node.level >= max_depth){
                     // add point to quadrant
-                    ElementNode eNode;
-                    eNode.elementData = elementData;
-                    eNode.pos = pos;
-                    eNode.next = node.firstChild;
-                    node.firstChild = data.insert(eNode);
+                    data[dataId].next = node.firstChild;
+                    node.firstChild = dataId;
                     ++node.count;
                     treeNodes[nodeIdx] = node;
-                    return node.firstChild;
+                    return;
                 } else {
                     // split and move points
                     splitNode(node);
@@ -71,7 +91,233 @@ int CountQuadTree::insert(const cObject* elementData, const Coord& pos){
             }
         }
     }
-    throw cRuntimeError("Insertion failed for object: %s with position: (%f, %f, %f)", elementData->getFullName(), pos.x, pos.y, pos.z);
+    throw cRuntimeError("Insertion failed for element %d with position: (%f, %f, %f)", dataId, pos.x, pos.y, pos.z);
+}
+
+int CountQuadTree::getDataId(const cObject* elementData) const {
+    auto iter = objectIndex.find(elementData);
+    return iter == objectIndex.end() ? -1 : iter->second;
+}
+
+void CountQuadTree::remove(const cObject* elementData){
+    int dataId = getDataId(elementData);
+    if (dataId == -1){
+        throw cRuntimeError("Object %s not part of the QuadTree", elementData ? elementData->getFullName() : "nullptr");
+    }
+    remove(dataId);
+}
+
+void CountQuadTree::remove(const int& dataId){
+    if (!data.valid(dataId)){
+        throw cRuntimeError("Element %d not part of the QuadTree", dataId);
+    }
+    unlinkElement(dataId);
+    auto elementData = data[dataId].elementData;
+    if (elementData){
+        objectIndex.erase(elementData);
+    }
+    data.erase(dataId);
+}
+
+void CountQuadTree::move(const cObject* elementData, const Coord& newPos){
+    int dataId = getDataId(elementData);
+    if (dataId == -1){
+        throw cRuntimeError("Object %s not part of the QuadTree", elementData ? elementData->getFullName() : "nullptr");
+    }
+    move(dataId, newPos);
+}
+
+void CountQuadTree::move(const int& dataId, const Coord& newPos){
+    if (!data.valid(dataId)){
+        throw cRuntimeError("Element %d not part of the QuadTree", dataId);
+    }
+    if (!treeNodes[0].contains(newPos)){
+        throw cRuntimeError("Move failed for element %d with position: (%f, %f, %f)", dataId, newPos.x, newPos.y, newPos.z);
+    }
+    std::vector<int> path;
+    if (!findPath(0, dataId, path)){
+        throw cRuntimeError("Element %d not found in QuadTree", dataId);
+    }
+    if (treeNodes[path.back()].contains(newPos)){
+        // same quadrant
+        data[dataId].pos = newPos;
+        return;
+    }
+    unlinkElement(dataId);
+    data[dataId].pos = newPos;
+    insertElement(dataId);
+}
+
+bool CountQuadTree::findPath(int nodeIdx, int dataId, std::vector<int>& path) const {
+    const QuadTreeNode& node = treeNodes[nodeIdx];
+    if (!node.contains(data[dataId].pos)){
+        return false;
+    }
+    path.push_back(nodeIdx);
+    if (node.isLeaf()){
+        for (int next = node.firstChild; next != -1; next = data[next].next){
+            if (next == dataId){
+                return true;
+            }
+        }
+    } else {
+        // points on a quadrant border are contained in more than one quadrant.
+        for (int i = 0; i < 4; i++){
+            if (findPath(node.firstChild + i, dataId, path)){
+                return true;
+            }
+        }
+    }
+    path.pop_back();
+    return false;
+}
+
+void CountQuadTree::unlinkElement(int dataId){
+    std::vector<int> path;
+    if (!findPath(0, dataId, path)){
+        throw cRuntimeError("Element %d not found in QuadTree", dataId);
+    }
+    QuadTreeNode& leaf = treeNodes[path.back()];
+    if (leaf.firstChild == dataId){
+        leaf.firstChild = data[dataId].next;
+    } else {
+        int prev = leaf.firstChild;
+        while (data[prev].next != dataId){
+            prev = data[prev].next;
+        }
+        data[prev].next = data[dataId].next;
+    }
+    data[dataId].next = -1;
+    --leaf.count;
+
+    // merge quadrants bottom up as long as the children fit into the parent.
+    for (int i = (int)path.size() - 2; i >= 0; i--){
+        const QuadTreeNode& parent = treeNodes[path[i]];
+        int count = 0;
+        for (int c = 0; c < 4; c++){
+            const QuadTreeNode& child = treeNodes[parent.firstChild + c];
+            if (child.isBranch()){
+                return;
+            }
+            count += child.count;
+        }
+        if (count > quadrantCapacity){
+            return;
+        }
+        mergeChildren(path[i]);
+    }
+}
+
+void CountQuadTree::mergeChildren(int nodeIdx){
+    QuadTreeNode node = treeNodes[nodeIdx];
+    int firstQuadrant = node.firstChild;
+    node.firstChild = -1;
+    node.count = 0;
+    for (int c = 0; c < 4; c++){
+        int elementIndex = treeNodes[firstQuadrant + c].firstChild;
+        while (elementIndex != -1){
+            int next = data[elementIndex].next;
+            data[elementIndex].next = node.firstChild;
+            node.firstChild = elementIndex;
+            ++node.count;
+            elementIndex = next;
+        }
+    }
+    treeNodes[nodeIdx] = node;
+    // reuse quadrants on next split
+    treeNodes[firstQuadrant].firstChild = free_node;
+    treeNodes[firstQuadrant].count = 0;
+    free_node = firstQuadrant;
+}
+
+std::vector<int> CountQuadTree::queryRect(const Coord& min, const Coord& max) const {
+    std::vector<int> ret;
+    std::vector<int> treeNodesToProcess{0};
+    while (!treeNodesToProcess.empty()){
+        const QuadTreeNode& node = treeNodes[treeNodesToProcess.back()];
+        treeNodesToProcess.pop_back();
+        if (!node.intersects(min, max)){
+            continue;
+        }
+        if (node.isLeaf()){
+            for (int next = node.firstChild; next != -1; next = data[next].next){
+                const Coord& p = data[next].pos;
+                if (p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y){
+                    ret.push_back(next);
+                }
+            }
+        } else {
+            for (int c = 0; c < 4; c++){
+                treeNodesToProcess.push_back(node.firstChild + c);
+            }
+        }
+    }
+    return ret;
+}
+
+std::vector<int> CountQuadTree::queryRadius(const Coord& center, double radius) const {
+    std::vector<int> ret;
+    const double r2 = radius * radius;
+    std::vector<int> treeNodesToProcess{0};
+    while (!treeNodesToProcess.empty()){
+        const QuadTreeNode& node = treeNodes[treeNodesToProcess.back()];
+        treeNodesToProcess.pop_back();
+        if (node.minSqrDist(center) > r2){
+            continue;
+        }
+        if (node.isLeaf()){
+            for (int next = node.firstChild; next != -1; next = data[next].next){
+                const Coord& p = data[next].pos;
+                double dx = p.x - center.x, dy = p.y - center.y;
+                if (dx * dx + dy * dy <= r2){
+                    ret.push_back(next);
+                }
+            }
+        } else {
+            for (int c = 0; c < 4; c++){
+                treeNodesToProcess.push_back(node.firstChild + c);
+            }
+        }
+    }
+    return ret;
+}
+
+std::vector<int> CountQuadTree::kNearest(const Coord& pos, int k) const {
+    // best first search over quadrants and elements ordered by (squared) distance.
+    struct Candidate {
+        double sqrDist;
+        bool isElement;
+        int index;
+        bool operator>(const Candidate& other) const { return sqrDist > other.sqrDist; }
+    };
+    std::vector<int> ret;
+    if (k <= 0){
+        return ret;
+    }
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> queue;
+    queue.push(Candidate{treeNodes[0].minSqrDist(pos), false, 0});
+    while (!queue.empty() && (int)ret.size() < k){
+        Candidate c = queue.top();
+        queue.pop();
+        if (c.isElement){
+            ret.push_back(c.index);
+            continue;
+        }
+        const QuadTreeNode& node = treeNodes[c.index];
+        if (node.isLeaf()){
+            for (int next = node.firstChild; next != -1; next = data[next].next){
+                const Coord& p = data[next].pos;
+                double dx = p.x - pos.x, dy = p.y - pos.y;
+                queue.push(Candidate{dx * dx + dy * dy, true, next});
+            }
+        } else {
+            for (int i = 0; i < 4; i++){
+                int childIdx = node.firstChild + i;
+                queue.push(Candidate{treeNodes[childIdx].minSqrDist(pos), false, childIdx});
+            }
+        }
+    }
+    return ret;
 }
 
 std::vector<ElementNode> CountQuadTree::getList(int qNodeIdx){
@@ -91,6 +337,15 @@ void CountQuadTree::splitNode(QuadTreeNode& node){
     // create 4 new bounding boxes
     Coord minBoundaries[4], maxBoundaries[4];
     node.setBoundary(minBoundaries, maxBoundaries);
+    // use freed quadrants (see mergeChildren) or append new ones.
+    int first;
+    if (free_node != -1){
+        first = free_node;
+        free_node = treeNodes[free_node].firstChild;
+    } else {
+        first = treeNodes.size();
+        treeNodes.resize(first + 4);
+    }
     // create children as leafs
     for(int i=0; i < 4; i++){
         QuadTreeNode childNode;
@@ -99,20 +354,11 @@ void CountQuadTree::splitNode(QuadTreeNode& node){
         childNode.firstChild = -1; // new leaf node with zero data elements
         childNode.count  = 0; // new leaf node with zero data elements
         childNode.level = node.level + 1;
-        if (free_node != -1){
-            treeNodes[free_node + i] = childNode;
-        } else {
-            treeNodes.push_back(childNode);
-        }
+        treeNodes[first + i] = childNode;
     }
     // set first_child of node (now branch node) to the first child.
     int elementIndex = node.firstChild; // save ElementNode index before overriding with QuadNode index.
-    if (free_node != -1){
-        node.firstChild = free_node;
-        free_node = -1;
-    } else {
-        node.firstChild = treeNodes.size()-4;
-    }
+    node.firstChild = first;
     // move data points to new children
 
     while(elementIndex != -1){
@@ -126,7 +372,6 @@ void CountQuadTree::splitNode(QuadTreeNode& node){
         elementIndex = eNode.next; // update next child to be moved
         eNode.next = tmp; // connect new first element to the rest of the items in the new Quadrant
         ++newQuad.count; // increment node count managed by this leafe
-        treeNodes[quadrant] = newQuad;
     }
 }
 
@@ -148,6 +393,17 @@ bool QuadTreeNode::contains(const Coord& pos) const {
            pos.y <= boundaryMax.y && pos.y >= boundaryMin.y;
 }
 
+bool QuadTreeNode::intersects(const Coord& min, const Coord& max) const {
+    return min.x <= boundaryMax.x && max.x >= boundaryMin.x &&
+           min.y <= boundaryMax.y && max.y >= boundaryMin.y;
+}
+
+double QuadTreeNode::minSqrDist(const Coord& pos) const {
+    double dx = std::max(std::max(boundaryMin.x - pos.x, 0.0), pos.x - boundaryMax.x);
+    double dy = std::max(std::max(boundaryMin.y - pos.y, 0.0), pos.y - boundaryMax.y);
+    return dx * dx + dy * dy;
+}
+
 void QuadTreeNode::setBoundary(Coord *minBoundaries, Coord *maxBoundaries) const{
     // We just divide a rectangle into four smaller congruent rectangle
     // see inet::QuadTree
@@ -16,6 +16,8 @@
 #pragma once
 
 #include <algorithm>
+#include <unordered_map>
+#include <vector>
 #include "inet/common/geometry/common/Coord.h"
 #include "crownet/common/geometry/container/FreeList.h"
 
@@ -41,6 +43,9 @@ struct QuadTreeNode {
     int level = 0;
 
     bool contains(const Coord& pos) const;
+    bool intersects(const Coord& min, const Coord& max) const;
+    // squared (x, y) distance between pos and the quadrant (0 if inside)
+    double minSqrDist(const Coord& pos) const;
     bool isLeaf() const {return count != -1;}
     bool isBranch() const {return count == -1;}
     bool isEmptyLeaf() const {return firstChild == -1;}
@@ -49,6 +54,14 @@ struct QuadTreeNode {
 
 
 
+/**
+ * Point QuadTree (x, y) with element and quadrant storage in contiguous
+ * memory. Elements are identified by the data index returned by insert().
+ * The index stays valid until the element is removed (also after move()).
+ *
+ * Query boundaries are inclusive. Leafs at max_depth are not split any
+ * further and may hold more than quadrantCapacity elements.
+ */
 class CountQuadTree  {
 public:
 
@@ -56,23 +69,39 @@ public:
 
     int quadrantCapacity;
     int max_depth;
-    int free_node;
+    int free_node; // first of 4 unused quadrants (chained over firstChild)
 
 
     int insert(const cObject* data, const Coord& pos);
     std::vector<ElementNode> getList(int qNodeIdx);
     int dataSize() const { return data.size(); }
 
-//    void move(const cObject* data, const Coord& newPos);
-//    void move(const int& dataId, const Coord& newPos);
-//    void remove(const cObject* data);
-//    void remove(const int& dataId);
+    void move(const cObject* data, const Coord& newPos);
+    void move(const int& dataId, const Coord& newPos);
+    void remove(const cObject* data);
+    void remove(const int& dataId);
+
+    const ElementNode& getElement(const int& dataId) const { return data[dataId]; }
+    // data index of object or -1
+    int getDataId(const cObject* data) const;
+
+    // data indices of all elements within the rectangle [min, max]
+    std::vector<int> queryRect(const Coord& min, const Coord& max) const;
+    // data indices of all elements with (x, y) distance <= radius to center
+    std::vector<int> queryRadius(const Coord& center, double radius) const;
+    // data indices of the k nearest elements to pos ordered by distance
+    std::vector<int> kNearest(const Coord& pos, int k) const;
 
 private:
     FreeList<ElementNode>  data;
+    std::unordered_map<const cObject*, int> objectIndex;
 
 
 private:
+    void insertElement(int dataId);
+    void unlinkElement(int dataId);
+    bool findPath(int nodeIdx, int dataId, std::vector<int>& path) const;
+    void mergeChildren(int nodeIdx);
     void splitNode(QuadTreeNode& node);
     int getQuadrant(QuadTreeNode& node, const Coord& pos);
 
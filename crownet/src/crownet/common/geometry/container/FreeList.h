@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <iterator>
 #include <vector>
 #include <omnetpp/cexception.h>
 
@@ -28,37 +29,45 @@ public:
         using pointer = value_type*;
         using reference = value_type&;
 
-       Iterator(FreeList* list, int index = 0): freeList(list) {
-           if (index > freeList->data.size()){
-               index = freeList->data.size(); // invalid
-           } else {
-               while(index < freeList->data.size() && freeList->data[index].next != VALID){
-                   ++index;
-               }
-               this->index = index;
+       Iterator(FreeList* list, int index = 0): freeList(list), index(index) {
+           if (this->index > end()){
+               this->index = end(); // invalid
            }
+           skipInvalid();
        }
 
        reference operator*() const  { return freeList->data[index].element;}
        pointer operator->() {return &freeList->data[index].element;}
 
        Iterator& operator++() {
-           while(index < freeList->data.size() && freeList->data[index].next != VALID){
+           // advance at least one element and skip holes.
+           if (index < end()){
                ++index;
            }
+           skipInvalid();
            return *this;
        }
        Iterator operator++(int) {Iterator tmp = *this; ++(*this); return tmp;}
 
+       // index in FreeList (use with operator[] and erase)
+       int getIndex() const { return index; }
+
        friend bool operator==(const Iterator& a, const Iterator& b){
            return a.freeList == b.freeList && a.index == b.index;
        }
 
        friend bool operator!=(const Iterator& a, const Iterator& b){
-           return a.freeList != b.freeList && a.index != b.index;
+           return !(a == b);
        }
 
     private:
+       int end() const { return static_cast<int>(freeList->data.size()); }
+       void skipInvalid() {
+           while(index < end() && freeList->data[index].next != VALID){
+               ++index;
+           }
+       }
+
        FreeList* freeList;
        int index;
     };
@@ -72,6 +81,9 @@ public:
     // Remove the nth element
     void erase(int n);
 
+    // True if index n holds an element
+    bool valid(int n) const;
+
     // Remove all elements
     void clear();
 
@@ -132,11 +144,19 @@ int FreeList<T>::insert(const T& element){
 
 template <class T>
 void FreeList<T>::erase(int n){
+    if (!valid(n)){
+        throw omnetpp::cRuntimeError("Erase invalid index %d in FreeList", n);
+    }
     data[n].next = first_free;
     first_free = n;
     ++free_count;
 }
 
+template <class T>
+bool FreeList<T>::valid(int n) const{
+    return n >= 0 && n < static_cast<int>(data.size()) && data[n].next == VALID;
+}
+
 template <class T>
 void FreeList<T>::clear(){
     data.clear();
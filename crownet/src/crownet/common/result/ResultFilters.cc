@@ -107,8 +107,8 @@ Register_ResultFilter("rcvdPerSrcJitter", RcvdPerSrcJitter);
 void RcvdPerSrcJitter::receiveSignal(cResultFilter *prev, simtime_t_cref t,
                                      cObject *object, cObject *details) {
     if (auto packet = dynamic_cast<Packet *>(object)) {
-        if (auto tag = packet->findTag<RxPerSrcJitterTag>()){
-            fire(this, t, tag->getJitter().dbl(), details);
+        if (auto tag = packet->findTag<RxInfoTag>()){
+            fire(this, t, tag->getPerSrcJitter().dbl(), details);
         }
     }
 }
@@ -117,8 +117,8 @@ Register_ResultFilter("rcvdPerSrcAvgSize", RcvdPerSrcAvgSize);
 void RcvdPerSrcAvgSize::receiveSignal(cResultFilter *prev, simtime_t_cref t,
                                      cObject *object, cObject *details) {
     if (auto packet = dynamic_cast<Packet *>(object)) {
-        if (auto tag = packet->findTag<RxPerSrcAvgSizeTag>()){
-            fire(this, t, tag->getSize().get(), details);
+        if (auto tag = packet->findTag<RxInfoTag>()){
+            fire(this, t, tag->getPerSrcAvgSize().get(), details);
         }
     }
 }
@@ -127,8 +127,8 @@ Register_ResultFilter("rcvdPerSrcCount", RcvdPerSrcCount);
 void RcvdPerSrcCount::receiveSignal(cResultFilter *prev, simtime_t_cref t,
                                      cObject *object, cObject *details) {
     if (auto packet = dynamic_cast<Packet *>(object)) {
-        if (auto tag = packet->findTag<RxPerSrcPktCountTag>()){
-            fire(this, t, (long)tag->getCount(), details);
+        if (auto tag = packet->findTag<RxInfoTag>()){
+            fire(this, t, (long)tag->getPerSrcPktCount(), details);
         }
     }
 }
@@ -137,8 +137,8 @@ Register_ResultFilter("rcvdPerSrcTotalCount", RcvdPerSrcTotalCount);
 void RcvdPerSrcTotalCount::receiveSignal(cResultFilter *prev, simtime_t_cref t,
                                      cObject *object, cObject *details) {
     if (auto packet = dynamic_cast<Packet *>(object)) {
-        if (auto tag = packet->findTag<RxPerSrcTotalSentCountTag>()){
-            fire(this, t, (long)tag->getCount(), details);
+        if (auto tag = packet->findTag<RxInfoTag>()){
+            fire(this, t, (long)tag->getPerSrcTotalSentCount(), details);
         }
     }
 }
@@ -147,8 +147,8 @@ Register_ResultFilter("rcvdPerSrcLossCount", RcvdPerSrcLossCount);
 void RcvdPerSrcLossCount::receiveSignal(cResultFilter *prev, simtime_t_cref t,
                                      cObject *object, cObject *details) {
     if (auto packet = dynamic_cast<Packet *>(object)) {
-        if (auto tag = packet->findTag<RxPerSrcPktLossCountTag>()){
-            fire(this, t, (long)tag->getCount(), details);
+        if (auto tag = packet->findTag<RxInfoTag>()){
+            fire(this, t, (long)tag->getPerSrcPktLossCount(), details);
 
         }
     }
@@ -158,8 +158,8 @@ Register_ResultFilter("rcvdAvgSize", RcvdAvgSize);
 void RcvdAvgSize::receiveSignal(cResultFilter *prev, simtime_t_cref t,
                                      cObject *object, cObject *details) {
     if (auto packet = dynamic_cast<Packet *>(object)) {
-        if (auto tag = packet->findTag<RxPerAppAvgSizeTag>()){
-            fire(this, t, tag->getSize().get(), details);
+        if (auto tag = packet->findTag<RxInfoTag>()){
+            fire(this, t, tag->getPerAppAvgSize().get(), details);
         }
     }
 }
@@ -168,8 +168,8 @@ Register_ResultFilter("rcvdCount", RcvdCount);
 void RcvdCount::receiveSignal(cResultFilter *prev, simtime_t_cref t,
                                      cObject *object, cObject *details) {
     if (auto packet = dynamic_cast<Packet *>(object)) {
-        if (auto tag = packet->findTag<RxPerAppPktCountTag>()){
-            fire(this, t, (long)tag->getCount(), details);
+        if (auto tag = packet->findTag<RxInfoTag>()){
+            fire(this, t, (long)tag->getPerAppPktCount(), details);
         }
     }
 }
@@ -179,7 +179,7 @@ Register_ResultFilter("rcvdSrcCount", RcvdSrcCount);
 void RcvdSrcCount::receiveSignal(cResultFilter *prev, simtime_t_cref t,
                                      cObject *object, cObject *details) {
     if (auto packet = dynamic_cast<Packet *>(object)) {
-        if (auto tag = packet->findTag<RxSourceCountTag>()){
+        if (auto tag = packet->findTag<RxInfoTag>()){
             fire(this, t, (long)tag->getRxSourceCount(), details);
         }
     }
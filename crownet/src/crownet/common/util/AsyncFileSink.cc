@@ -0,0 +1,155 @@
+/*
+ * AsyncFileSink.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/common/util/AsyncFileSink.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <omnetpp/cexception.h>
+
+namespace crownet {
+
+AsyncFileSink::AsyncFileSink(const std::string& filePath, std::size_t maxPendingBytes)
+    : file(filePath), maxPendingBytes(maxPendingBytes) {
+  if (!file.is_open()) {
+    throw omnetpp::cRuntimeError("cannot open file %s", filePath.c_str());
+  }
+  if (maxPendingBytes == 0) {
+    throw omnetpp::cRuntimeError("maxPendingBytes must be > 0");
+  }
+  thread = std::thread(&AsyncFileSink::run, this);
+}
+
+AsyncFileSink::~AsyncFileSink() {
+  try {
+    close();
+  } catch (...) {
+    // do not throw from destructor. Errors are reported by close().
+  }
+}
+
+void AsyncFileSink::checkError() {
+  // mutex must be held
+  if (error) {
+    auto e = error;
+    error = nullptr;
+    try {
+      std::rethrow_exception(e);
+    } catch (const std::exception& ex) {
+      throw omnetpp::cRuntimeError("async file write failed: %s", ex.what());
+    }
+  }
+}
+
+void AsyncFileSink::submit(std::string&& data) {
+  if (data.empty()) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex);
+  if (closed) {
+    throw omnetpp::cRuntimeError("AsyncFileSink already closed");
+  }
+  checkError();
+  auto hasSpace = [this, &data] {
+    return error || pendingBytes == 0 || pendingBytes + data.size() <= maxPendingBytes;
+  };
+  if (!hasSpace()) {
+    blockedCount++;
+    spaceAvailable.wait(lock, hasSpace);
+    checkError();
+  }
+  pendingBytes += data.size();
+  peakPendingBytes = std::max(peakPendingBytes, pendingBytes);
+  queue.push_back(std::move(data));
+  dataAvailable.notify_one();
+}
+
+void AsyncFileSink::flush() {
+  std::unique_lock<std::mutex> lock(mutex);
+  if (closed) {
+    return;
+  }
+  flushRequested = true;
+  dataAvailable.notify_one();
+  spaceAvailable.wait(lock, [this] { return error || (!flushRequested && pendingBytes == 0); });
+  checkError();
+}
+
+void AsyncFileSink::close() {
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (closed) {
+      return;
+    }
+    closed = true;
+    stop = true;
+  }
+  dataAvailable.notify_one();
+  thread.join();  // writes all pending data
+  file.close();
+  std::lock_guard<std::mutex> lock(mutex);
+  checkError();
+}
+
+std::size_t AsyncFileSink::getPeakPendingBytes() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return peakPendingBytes;
+}
+
+long AsyncFileSink::getBlockedCount() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return blockedCount;
+}
+
+void AsyncFileSink::setPaused(bool paused) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->paused = paused;
+  }
+  dataAvailable.notify_one();
+}
+
+void AsyncFileSink::run() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    dataAvailable.wait(lock, [this] {
+      return stop || (!paused && (flushRequested || !queue.empty()));
+    });
+    while (!queue.empty() && (!paused || stop)) {
+      std::string data = std::move(queue.front());
+      queue.pop_front();
+      lock.unlock();
+      std::exception_ptr e;
+      try {
+        if (!file.write(data.data(), (std::streamsize)data.size())) {
+          throw std::runtime_error("write error");
+        }
+      } catch (...) {
+        e = std::current_exception();
+      }
+      lock.lock();
+      pendingBytes -= data.size();
+      if (e && !error) {
+        error = e;
+      }
+      spaceAvailable.notify_all();
+    }
+    if (flushRequested || stop) {
+      file.flush();
+      if (!file && !error) {
+        error = std::make_exception_ptr(std::runtime_error("flush error"));
+      }
+      flushRequested = false;
+      spaceAvailable.notify_all();
+    }
+    if (stop) {
+      return;
+    }
+  }
+}
+
+}  // namespace crownet
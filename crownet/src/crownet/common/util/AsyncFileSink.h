@@ -0,0 +1,80 @@
+/*
+ * AsyncFileSink.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace crownet {
+
+/**
+ * Write buffers to a file on a background thread. The simulation thread hands
+ * over complete buffers (submit) and continues with a new one while the I/O
+ * thread writes the old one (double buffering).
+ *
+ * Memory is bounded: submit blocks while more than maxPendingBytes are
+ * waiting to be written (back-pressure). A single buffer larger than
+ * maxPendingBytes is accepted once the queue is empty.
+ *
+ * I/O errors of the background thread are rethrown as cRuntimeError by the
+ * next submit, flush or close call.
+ */
+class AsyncFileSink {
+ public:
+  AsyncFileSink(const std::string& filePath, std::size_t maxPendingBytes = 8 * 1024 * 1024);
+  ~AsyncFileSink();
+  AsyncFileSink(const AsyncFileSink&) = delete;
+  AsyncFileSink& operator=(const AsyncFileSink&) = delete;
+
+  void submit(std::string&& data);
+  // block until all submitted data is written and flushed to the file.
+  void flush();
+  // flush, stop the I/O thread and close the file. Idempotent.
+  void close();
+
+  std::size_t getMaxPendingBytes() const { return maxPendingBytes; }
+  // largest amount of pending bytes seen so far (<= maxPendingBytes unless a
+  // single buffer was larger)
+  std::size_t getPeakPendingBytes() const;
+  // number of submit calls which had to wait for the I/O thread
+  long getBlockedCount() const;
+
+  // test hook: a paused I/O thread does not write queued data, thus submit
+  // blocks deterministically once maxPendingBytes are queued. close() writes
+  // all data regardless. Do not flush() while paused.
+  void setPaused(bool paused);
+
+ private:
+  void run();
+  void checkError();
+
+  std::ofstream file;
+  std::size_t maxPendingBytes;
+  std::thread thread;
+
+  mutable std::mutex mutex;
+  std::condition_variable dataAvailable;
+  std::condition_variable spaceAvailable;
+  std::deque<std::string> queue;
+  std::size_t pendingBytes = 0;  // queued and in progress
+  std::size_t peakPendingBytes = 0;
+  long blockedCount = 0;
+  bool flushRequested = false;
+  bool paused = false;
+  bool stop = false;
+  bool closed = false;
+  std::exception_ptr error;
+};
+
+}  // namespace crownet
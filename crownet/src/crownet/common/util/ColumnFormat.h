@@ -0,0 +1,212 @@
+/*
+ * ColumnFormat.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ *
+ * Binary columnar file format used by BinaryColumnFileWriter. Header only and
+ * without OMNeT++ dependencies so standalone tools (tools/colbin2csv) can
+ * read the files.
+ *
+ * All integers are little endian.
+ *
+ *   magic        8B  "CRNTCOL1"
+ *   metadata     u32 length + bytes (key=value pairs separated by ',' as in
+ *                the first line of the csv files)
+ *   columns      u16 count, per column: u8 type, u16 length + name
+ *   chunk*       u32 rows, per column: u64 length + data
+ *
+ * Column data is stored as INT32 (4B), INT64 (8B), FLOAT64 (8B) values or
+ * STRING values (u16 length + bytes) for each row of the chunk.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace crownet {
+namespace colfmt {
+
+static const char MAGIC[] = "CRNTCOL1";
+static const std::size_t MAGIC_LEN = 8;
+
+enum class ColumnType : uint8_t { INT32 = 1, INT64 = 2, FLOAT64 = 3, STRING = 4 };
+
+struct ColumnSpec {
+  std::string name;
+  ColumnType type;
+};
+
+template <typename T>
+inline void putLE(std::string& buf, T value) {
+  static_assert(std::is_integral<T>::value, "integral type expected");
+  for (std::size_t i = 0; i < sizeof(T); i++) {
+    buf.push_back((char)((uint64_t)value >> (8 * i) & 0xFF));
+  }
+}
+
+inline void putDouble(std::string& buf, double value) {
+  uint64_t raw;
+  std::memcpy(&raw, &value, sizeof(raw));
+  putLE<uint64_t>(buf, raw);
+}
+
+inline void putString(std::string& buf, const std::string& value) {
+  if (value.size() > 0xFFFF) {
+    throw std::length_error("string value too long for column");
+  }
+  putLE<uint16_t>(buf, (uint16_t)value.size());
+  buf.append(value);
+}
+
+template <typename T>
+inline T getLE(const char* p) {
+  uint64_t ret = 0;
+  for (std::size_t i = 0; i < sizeof(T); i++) {
+    ret |= (uint64_t)(uint8_t)p[i] << (8 * i);
+  }
+  return (T)ret;
+}
+
+inline double getDouble(const char* p) {
+  uint64_t raw = getLE<uint64_t>(p);
+  double ret;
+  std::memcpy(&ret, &raw, sizeof(ret));
+  return ret;
+}
+
+inline std::size_t fixedSize(ColumnType type) {
+  switch (type) {
+    case ColumnType::INT32:
+      return 4;
+    case ColumnType::INT64:
+    case ColumnType::FLOAT64:
+      return 8;
+    default:
+      return 0;  // variable length
+  }
+}
+
+inline std::string fileHeader(const std::string& metadata, const std::vector<ColumnSpec>& columns) {
+  std::string buf(MAGIC, MAGIC_LEN);
+  putLE<uint32_t>(buf, (uint32_t)metadata.size());
+  buf.append(metadata);
+  putLE<uint16_t>(buf, (uint16_t)columns.size());
+  for (const auto& c : columns) {
+    putLE<uint8_t>(buf, (uint8_t)c.type);
+    putString(buf, c.name);
+  }
+  return buf;
+}
+
+/**
+ * Sequential reader. Use readHeader() once and readChunk() until it returns
+ * false. Values of the current chunk are accessed with row/column index.
+ */
+class ColumnFileReader {
+ public:
+  explicit ColumnFileReader(std::istream& in) : in(in) {}
+
+  void readHeader() {
+    std::string magic = readBytes(MAGIC_LEN);
+    if (magic != std::string(MAGIC, MAGIC_LEN)) {
+      throw std::runtime_error("not a crownet column file");
+    }
+    metadata = readBytes(getLE<uint32_t>(readBytes(4).data()));
+    int n = getLE<uint16_t>(readBytes(2).data());
+    for (int i = 0; i < n; i++) {
+      auto type = (ColumnType)getLE<uint8_t>(readBytes(1).data());
+      auto name = readBytes(getLE<uint16_t>(readBytes(2).data()));
+      columns.push_back(ColumnSpec{name, type});
+    }
+  }
+
+  bool readChunk() {
+    char raw[4];
+    if (!in.read(raw, 4)) {
+      return false;  // end of file
+    }
+    rows = getLE<uint32_t>(raw);
+    data.clear();
+    offsets.clear();
+    for (const auto& c : columns) {
+      data.push_back(readBytes(getLE<uint64_t>(readBytes(8).data())));
+      std::vector<std::size_t> o;
+      const std::string& d = data.back();
+      std::size_t pos = 0;
+      for (uint32_t r = 0; r < rows; r++) {
+        o.push_back(pos);
+        if (c.type == ColumnType::STRING) {
+          pos += (pos + 2 <= d.size()) ? 2 + getLE<uint16_t>(d.data() + pos) : 2;
+        } else {
+          pos += fixedSize(c.type);
+        }
+        if (pos > d.size()) {
+          throw std::runtime_error("corrupt column chunk '" + c.name + "'");
+        }
+      }
+      offsets.push_back(std::move(o));
+    }
+    return true;
+  }
+
+  const std::string& getMetadata() const { return metadata; }
+  const std::vector<ColumnSpec>& getColumns() const { return columns; }
+  uint32_t getRows() const { return rows; }
+
+  int64_t getInt(uint32_t row, int col) const {
+    const char* p = data[col].data() + offsets[col][row];
+    return columns[col].type == ColumnType::INT32 ? (int64_t)getLE<int32_t>(p) : getLE<int64_t>(p);
+  }
+  double getDouble(uint32_t row, int col) const {
+    return colfmt::getDouble(data[col].data() + offsets[col][row]);
+  }
+  std::string getString(uint32_t row, int col) const {
+    const char* p = data[col].data() + offsets[col][row];
+    return std::string(p + 2, getLE<uint16_t>(p));
+  }
+  std::string str(uint32_t row, int col) const {
+    std::ostringstream s;
+    s.precision(15);
+    switch (columns[col].type) {
+      case ColumnType::INT32:
+      case ColumnType::INT64:
+        s << getInt(row, col);
+        break;
+      case ColumnType::FLOAT64:
+        s << getDouble(row, col);
+        break;
+      case ColumnType::STRING:
+        s << getString(row, col);
+        break;
+    }
+    return s.str();
+  }
+
+ private:
+  std::string readBytes(std::size_t n) {
+    std::string ret(n, '\0');
+    if (n > 0 && !in.read(&ret[0], n)) {
+      throw std::runtime_error("unexpected end of column file");
+    }
+    return ret;
+  }
+
+  std::istream& in;
+  std::string metadata;
+  std::vector<ColumnSpec> columns;
+  uint32_t rows = 0;
+  std::vector<std::string> data;
+  std::vector<std::vector<std::size_t>> offsets;
+};
+
+}  // namespace colfmt
+}  // namespace crownet
@@ -0,0 +1,154 @@
+/*
+ * ColumnWriter.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/common/util/ColumnWriter.h"
+
+#include <omnetpp.h>
+#include "crownet/common/util/FileWriter.h"
+
+namespace crownet {
+
+ColumnChunk::ColumnChunk(std::vector<ColumnSpec> columns)
+    : columns(std::move(columns)), data(this->columns.size()) {}
+
+const ColumnSpec& ColumnChunk::next(ColumnType type) {
+  if (currentColumn >= columns.size()) {
+    throw omnetpp::cRuntimeError("row has more than %d columns", (int)columns.size());
+  }
+  const auto& c = columns[currentColumn];
+  bool isInt = type == ColumnType::INT64 && (c.type == ColumnType::INT32 || c.type == ColumnType::INT64);
+  if (!isInt && c.type != type) {
+    throw omnetpp::cRuntimeError("wrong type for column '%s'", c.name.c_str());
+  }
+  return c;
+}
+
+ColumnChunk& ColumnChunk::putInt(int64_t value) {
+  const auto& c = next(ColumnType::INT64);
+  if (c.type == ColumnType::INT32) {
+    colfmt::putLE<int32_t>(data[currentColumn], (int32_t)value);
+  } else {
+    colfmt::putLE<int64_t>(data[currentColumn], value);
+  }
+  ++currentColumn;
+  return *this;
+}
+
+ColumnChunk& ColumnChunk::putDouble(double value) {
+  next(ColumnType::FLOAT64);
+  colfmt::putDouble(data[currentColumn], value);
+  ++currentColumn;
+  return *this;
+}
+
+ColumnChunk& ColumnChunk::putString(const std::string& value) {
+  next(ColumnType::STRING);
+  colfmt::putString(data[currentColumn], value);
+  ++currentColumn;
+  return *this;
+}
+
+void ColumnChunk::endRow() {
+  if (currentColumn != columns.size()) {
+    throw omnetpp::cRuntimeError("row incomplete: expected %d columns got %d",
+                                 (int)columns.size(), (int)currentColumn);
+  }
+  currentColumn = 0;
+  ++rows;
+}
+
+std::size_t ColumnChunk::getByteSize() const {
+  std::size_t ret = 0;
+  for (const auto& d : data) {
+    ret += d.size();
+  }
+  return ret;
+}
+
+void ColumnChunk::writeTo(std::ostream& out) const {
+  std::string buf;
+  colfmt::putLE<uint32_t>(buf, rows);
+  out.write(buf.data(), buf.size());
+  for (const auto& d : data) {
+    buf.clear();
+    colfmt::putLE<uint64_t>(buf, d.size());
+    out.write(buf.data(), buf.size());
+    out.write(d.data(), d.size());
+  }
+}
+
+void ColumnChunk::clear() {
+  for (auto& d : data) {
+    d.clear();
+  }
+  currentColumn = 0;
+  rows = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+BinaryColumnFileWriter::BinaryColumnFileWriter(std::string filePath,
+                                               std::shared_ptr<ColumnPrinter> printer,
+                                               uint32_t chunkRows)
+    : filePath(filePath), printer(std::move(printer)),
+      chunk(this->printer->columnSpec()), chunkRows(chunkRows) {}
+
+BinaryColumnFileWriter::~BinaryColumnFileWriter() { finish(); }
+
+void BinaryColumnFileWriter::initialize() {
+  if (file.is_open()) {
+    return;  // only once
+  }
+  if (filePath == "") {
+    throw omnetpp::cRuntimeError("Path is not set");
+  }
+  filePath = BaseFileWriter::getAbsOutputPath(filePath, ".bin");
+  EV_INFO << "create file: " << filePath << omnetpp::endl;
+  file = std::ofstream(filePath, std::ios::binary);
+}
+
+void BinaryColumnFileWriter::writeMetaData(std::map<std::string, std::string>& mData) {
+  std::stringstream s;
+  int n = mData.size();
+  for (const auto& e : mData) {
+    s << e.first << "=" << e.second;
+    if (n > 1) {
+      s << ",";
+    }
+    n--;
+  }
+  metadata = s.str();
+}
+
+void BinaryColumnFileWriter::initWriter() {
+  auto header = colfmt::fileHeader(metadata, chunk.getColumns());
+  file.write(header.data(), header.size());
+}
+
+void BinaryColumnFileWriter::writeData() {
+  printer->writeTo(chunk);
+  if (chunk.getRows() >= chunkRows) {
+    writeChunk();
+  }
+}
+
+void BinaryColumnFileWriter::writeChunk() {
+  if (chunk.getRows() > 0) {
+    chunk.writeTo(file);
+    chunk.clear();
+  }
+}
+
+void BinaryColumnFileWriter::finish() {
+  if (!closed && file.is_open()) {
+    writeChunk();
+    file.close();
+    closed = true;
+  }
+}
+
+}  // namespace crownet
@@ -0,0 +1,97 @@
+/*
+ * ColumnWriter.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "crownet/common/util/ColumnFormat.h"
+#include "crownet/common/util/Writer.h"
+
+namespace crownet {
+
+using colfmt::ColumnSpec;
+using colfmt::ColumnType;
+
+/**
+ * Rows of typed columns collected before they are written as one chunk.
+ * Values must be added in column order and each row closed with endRow().
+ */
+class ColumnChunk {
+ public:
+  ColumnChunk(std::vector<ColumnSpec> columns);
+
+  ColumnChunk& putInt(int64_t value);
+  ColumnChunk& putDouble(double value);
+  ColumnChunk& putString(const std::string& value);
+  void endRow();
+
+  const std::vector<ColumnSpec>& getColumns() const { return columns; }
+  uint32_t getRows() const { return rows; }
+  std::size_t getByteSize() const;
+
+  void writeTo(std::ostream& out) const;
+  void clear();
+
+ private:
+  const ColumnSpec& next(ColumnType type);
+
+  std::vector<ColumnSpec> columns;
+  std::vector<std::string> data;
+  std::size_t currentColumn = 0;
+  uint32_t rows = 0;
+};
+
+/**
+ * Binary counterpart of FilePrinter.
+ */
+class ColumnPrinter {
+ public:
+  virtual ~ColumnPrinter() = default;
+  virtual std::vector<ColumnSpec> columnSpec() const = 0;
+  virtual void writeTo(ColumnChunk& out) const = 0;
+};
+
+/**
+ * ActiveWriter for binary columnar files (see ColumnFormat.h). Rows are
+ * collected in a ColumnChunk and written once chunkRows is reached and
+ * on finish().
+ */
+class BinaryColumnFileWriter : public ActiveWriter {
+ public:
+  BinaryColumnFileWriter(std::string filePath, std::shared_ptr<ColumnPrinter> printer,
+                         uint32_t chunkRows = 65536);
+  virtual ~BinaryColumnFileWriter();
+
+  // open file (path relative to output-scalar-file directory)
+  void initialize();
+  void writeMetaData(std::map<std::string, std::string>& mData);
+
+  virtual void initWriter() override;
+  virtual void writeData() override;
+  virtual void finish() override;
+
+  const std::string& getFilePath() const { return filePath; }
+
+ protected:
+  void writeChunk();
+
+ private:
+  std::string filePath;
+  std::ofstream file;
+  std::shared_ptr<ColumnPrinter> printer;
+  std::string metadata;
+  ColumnChunk chunk;
+  uint32_t chunkRows;
+  bool closed = false;
+};
+
+}  // namespace crownet
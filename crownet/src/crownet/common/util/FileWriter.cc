@@ -7,6 +7,7 @@
 
 #include "crownet/crownet.h"
 #include "crownet/common/util/FileWriter.h"
+#include "crownet/common/util/Profiler.h"
 #include "crownet/dcd/regularGrid/RegularDcdMap.h"
 #include "crownet/dcd/regularGrid/RegularDcdMapPrinter.h"
 
@@ -18,7 +19,7 @@
 
 namespace crownet {
 
-std::string BaseFileWriter::getAbsOutputPath(std::string fileName){
+std::string BaseFileWriter::getAbsOutputPath(std::string fileName, const std::string& ext){
 
     boost::filesystem::path pp{fileName};
     if (pp.is_absolute()){
@@ -37,10 +38,11 @@ std::string BaseFileWriter::getAbsOutputPath(std::string fileName){
            boost::filesystem::create_directories(p.parent_path());
       }
       std::string _path;
-      if (0 == fileName.compare(fileName.size() - 4, fileName.size(), ".csv")){
+      if (fileName.size() >= ext.size() &&
+              0 == fileName.compare(fileName.size() - ext.size(), ext.size(), ext)){
           _path = p.parent_path().string() + "/" + fileName;
       } else {
-          _path = p.parent_path().string() + "/" + fileName + ".csv";
+          _path = p.parent_path().string() + "/" + fileName + ext;
       }
 
       return _path;
@@ -62,7 +64,11 @@ void BaseFileWriter::initialize(){
     }
     filePath = getAbsOutputPath(filePath);
     EV_INFO << "create file: " << filePath << endl;
-    file = std::ofstream(filePath);
+    if (asyncWrite){
+        asyncSink.reset(new AsyncFileSink(filePath, (std::size_t)maxPendingBytes));
+    } else {
+        file = std::ofstream(filePath);
+    }
     init = true;
     onInit();
 }
@@ -72,18 +78,32 @@ BaseFileWriter::~BaseFileWriter(){
 }
 
 void BaseFileWriter::writeBuffer(){
-    file << buffer.str();
+    CROWNET_PROFILE_SCOPE("file.write");
+    if (asyncSink){
+        // hand over the buffer, the I/O thread writes it.
+        asyncSink->submit(buffer.str());
+    } else {
+        file << buffer.str();
+    }
     buffer.str(std::string());
     buffer.clear();
 }
 void BaseFileWriter::flush(){
     writeBuffer();
-    file.flush();
+    if (asyncSink){
+        asyncSink->flush();
+    } else {
+        file.flush();
+    }
 }
 void BaseFileWriter::close(){
     if (!closed){
         flush();
-        file.close();
+        if (asyncSink){
+            asyncSink->close();
+        } else {
+            file.close();
+        }
         closed = true;
     }
 }
@@ -118,35 +138,64 @@ FileWriterBuilder &FileWriterBuilder::addPath(const std::string &path) {
   return *this;
 }
 
+FileWriterBuilder &FileWriterBuilder::setAsyncWrite(bool asyncWrite) {
+  this->asyncWrite = asyncWrite;
+  return *this;
+}
+
 
 template <>
-ActiveFileWriter *ActiveFileWriterBuilder::build(std::shared_ptr<RegularDcdMap> map, MapCfg *mapCfg){
-    ActiveFileWriter *obj = nullptr;
+ActiveWriter *ActiveFileWriterBuilder::build(std::shared_ptr<RegularDcdMap> map, MapCfg *mapCfg){
+    std::shared_ptr<RegularDcdMapValuePrinter> printer;
     if (strcmp(mapCfg->getMapTypeLog(), "all") == 0){
-        obj = new ActiveFileWriter(
-                path,
-                std::make_shared<RegularDcdMapAllPrinter>(map));
+        printer = std::make_shared<RegularDcdMapAllPrinter>(map);
     } else {
-        obj = new ActiveFileWriter(
-                path,
-                std::make_shared<RegularDcdMapValuePrinter>(map));
+        printer = std::make_shared<RegularDcdMapValuePrinter>(map);
+    }
+    if (strcmp(mapCfg->getWriterType(), "bin") == 0){
+        return buildBinary(printer);
+    } else if (strcmp(mapCfg->getWriterType(), "csv") == 0){
+        setAsyncWrite(mapCfg->getAsyncWrite());
+        return build(std::static_pointer_cast<FilePrinter>(printer));
+    } else if (strcmp(mapCfg->getWriterType(), "sql") == 0){
+        // own database (and transaction scope) per node. mapTypeLog is not supported.
+        return buildSql(std::make_shared<RegularDcdMapSqlValuePrinter>(map), mapCfg->getSqlCommitInterval());
+    } else {
+        throw cRuntimeError("expected csv, bin or sql as writer type got '%s'", mapCfg->getWriterType());
     }
-    obj->initialize();
-    obj->writeMetaData(metadata);
-    obj->flush();
-    return obj;
 }
 
 ActiveFileWriter *ActiveFileWriterBuilder::build(std::shared_ptr<FilePrinter> printer) {
   ActiveFileWriter *obj = new ActiveFileWriter(
           path,
           std::move(printer));
+  obj->setAsyncWrite(asyncWrite);
   obj->initialize();
   obj->writeMetaData(metadata);
   obj->flush();
   return obj;
 }
 
+BinaryColumnFileWriter *ActiveFileWriterBuilder::buildBinary(std::shared_ptr<ColumnPrinter> printer) {
+  BinaryColumnFileWriter *obj = new BinaryColumnFileWriter(
+          path,
+          std::move(printer));
+  obj->initialize();
+  obj->writeMetaData(metadata);
+  return obj;
+}
+
+SqlLiteWriter *ActiveFileWriterBuilder::buildSql(std::shared_ptr<SqlPrinter> printer, int commitInterval) {
+  auto sqlApi = SqlApi::open(BaseFileWriter::getAbsOutputPath(path, ".db"));
+  SqlLiteWriter *obj = new SqlLiteWriter(
+          sqlApi,
+          std::move(printer),
+          commitInterval);
+  obj->initialize();
+  obj->writeMetaData(metadata);
+  return obj;
+}
+
 ActiveFileWriter::ActiveFileWriter(std::string filePath, std::shared_ptr<FilePrinter> printer, std::string sep, long bufferSize)
     : BaseFileWriter(filePath, sep, bufferSize), printer(std::move(printer)) {}
 
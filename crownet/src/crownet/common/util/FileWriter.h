@@ -15,7 +15,10 @@
 #include <omnetpp.h>
 #include "traci/Boundary.h"
 #include "Writer.h"
+#include "AsyncFileSink.h"
 #include "FilePrinter.h"
+#include "ColumnWriter.h"
+#include "SqlLiteWriter.h"
 #include "crownet/applications/dmap/dmap_m.h"
 
 namespace crownet {
@@ -23,7 +26,8 @@ namespace crownet {
 
 class BaseFileWriter : public BufferWriter {
 public:
-    static std::string getAbsOutputPath(std::string fileName);
+    // path relative to the directory of output-scalar-file. Appends ext if missing.
+    static std::string getAbsOutputPath(std::string fileName, const std::string& ext=".csv");
 
 public:
     BaseFileWriter(std::string filePath="", std::string sep=";", long bufferSize=8192);
@@ -43,12 +47,22 @@ public:
     bool isInitialized() const {return  init;}
     virtual void onInit() {/* do nothing */}
 
+    // write full buffers on a background thread (set before initialize())
+    bool getAsyncWrite() const { return asyncWrite; }
+    void setAsyncWrite(bool asyncWrite) { this->asyncWrite = asyncWrite; }
+    long getMaxPendingBytes() const { return maxPendingBytes; }
+    void setMaxPendingBytes(long maxPendingBytes) { this->maxPendingBytes = maxPendingBytes; }
+    AsyncFileSink* getAsyncSink() const { return asyncSink.get(); }
+
     template <typename T>
     friend std::ostream &operator<<(BaseFileWriter &output, const T &_t);
 
 private:
     std::string filePath;
     std::ofstream file;
+    bool asyncWrite = false;
+    long maxPendingBytes = 8 * 1024 * 1024;
+    std::unique_ptr<AsyncFileSink> asyncSink;
 
 protected:
     void writeBuffer() override;
@@ -101,12 +115,15 @@ class FileWriterBuilder {
     return *this;
   }
   FileWriterBuilder &addPath(const std::string &path);
+  // csv writer only (see BaseFileWriter::setAsyncWrite)
+  FileWriterBuilder &setAsyncWrite(bool asyncWrite);
 
 
  protected:
   using metadata_t = std::map<std::string, std::string>;
   metadata_t metadata;
   std::string path;
+  bool asyncWrite = false;
 };
 
 template <>
@@ -129,8 +146,12 @@ class ActiveFileWriterBuilder : public FileWriterBuilder {
 public:
 
     ActiveFileWriter *build(std::shared_ptr<FilePrinter> printer);
+    BinaryColumnFileWriter *buildBinary(std::shared_ptr<ColumnPrinter> printer);
+    // sqlite database at path (one writer per file, see SqlApi::open)
+    SqlLiteWriter *buildSql(std::shared_ptr<SqlPrinter> printer, int commitInterval=1);
+    // csv, binary or sql writer based on mapCfg->getWriterType()
     template <typename M>
-    ActiveFileWriter *build(std::shared_ptr<M> map, MapCfg *mapCfg);
+    ActiveWriter *build(std::shared_ptr<M> map, MapCfg *mapCfg);
 
 };
 
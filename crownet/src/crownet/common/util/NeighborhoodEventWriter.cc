@@ -10,6 +10,17 @@
 
 namespace crownet {
 
+const char* neighborhoodEventName(NeighborhoodEventCode code){
+    switch (code) {
+        case NeighborhoodEventCode::DROPPED: return "dropped";
+        case NeighborhoodEventCode::TTL_REACHED: return "ttl_reached";
+        case NeighborhoodEventCode::LEAVE_CELL: return "leave_cell";
+        case NeighborhoodEventCode::ENTER_CELL: return "enter_cell";
+        case NeighborhoodEventCode::STAY_IN_CELL: return "stay_in_cell";
+    }
+    throw cRuntimeError("wrong event code: %d", (int)code);
+}
+
 NeighborhoodEventWriter::NeighborhoodEventWriter(std::string filePath, std::string sep, long bufferSize)
         : BaseFileWriter(filePath, sep, bufferSize){}
 
@@ -21,7 +32,15 @@ void NeighborhoodEventWriter::onInit(){
             "beacon_value", "pkt_count", "pkt_loss", "pkt_seq", "cell_x", "cell_y",
             };
 
-    write() << "#version=4 " << endl;
+    write() << "#version=4 ";
+    if (eventCodes){
+        // mapping of the integer event column
+        write() << "event_codes=";
+        for (int i = 0; i < NEIGHBORHOOD_EVENT_CODE_COUNT; i++){
+            write() << (i > 0 ? "," : "") << i << ":" << neighborhoodEventName((NeighborhoodEventCode)i);
+        }
+    }
+    write() << endl;
     for (int i = 0; i < header.size(); i++){
         if (i < header.size() -1){
             write() << header[i] << sep;
@@ -37,72 +56,158 @@ void NeighborhoodEventWriter::onInit(){
 }
 
 void NeighborhoodEventWriter::neighborhoodEntryRemoved(INeighborhoodTable* table, BeaconReceptionInfo* info){
-    writeData(table, info, "ttl_reached");
+    writeData(table, info, NeighborhoodEventCode::TTL_REACHED);
 }
 
 void NeighborhoodEventWriter::neighborhoodEntryDropped(INeighborhoodTable* table, BeaconReceptionInfo* info){
-    writeData(table, info, "dropped");
+    writeData(table, info, NeighborhoodEventCode::DROPPED);
 }
 
 
 void NeighborhoodEventWriter::neighborhoodEntryLeaveCell(INeighborhoodTable* table, BeaconReceptionInfo* info){
-    writeData(table, info, "leave_cell");
+    writeData(table, info, NeighborhoodEventCode::LEAVE_CELL);
 }
 
 void NeighborhoodEventWriter::neighborhoodEntryEnterCell(INeighborhoodTable* table, BeaconReceptionInfo* info){
-    writeData(table, info, "enter_cell");
+    writeData(table, info, NeighborhoodEventCode::ENTER_CELL);
 }
 
 void NeighborhoodEventWriter::neighborhoodEntryStayInCell(INeighborhoodTable* table, BeaconReceptionInfo* info){
-    writeData(table, info, "stay_in_cell");
+    writeData(table, info, NeighborhoodEventCode::STAY_IN_CELL);
 }
 
 
 
-void NeighborhoodEventWriter::writeData(INeighborhoodTable* table, BeaconReceptionInfo* info, std::string event){
+void NeighborhoodEventWriter::writeData(INeighborhoodTable* table, BeaconReceptionInfo* info, NeighborhoodEventCode event){
     int beaconValue = 0;
     simtime_t rcvdTime;
     simtime_t sentTime;
     Coord position;
     auto currentData = info->getCurrentData();
     auto prioData = info->getPrioData();
-    if (event == "dropped") {
+    switch (event) {
+    case NeighborhoodEventCode::DROPPED:
         beaconValue = 0;
-    } else if (event == "leave_cell"){
+        break;
+    case NeighborhoodEventCode::LEAVE_CELL:
         // current time but old position
         beaconValue = -1;
         rcvdTime = currentData->getReceivedTime();
         sentTime = currentData->getCreationTime();
         position = prioData->getPosition();
-    } else if (event == "enter_cell") {
+        break;
+    case NeighborhoodEventCode::ENTER_CELL:
         // current time and current position
         beaconValue = 1;
         rcvdTime = currentData->getReceivedTime();
         sentTime = currentData->getCreationTime();
         position = currentData->getPosition();
-    } else if (event == "stay_in_cell") {
+        break;
+    case NeighborhoodEventCode::STAY_IN_CELL:
         // current time and current position no change of beacon value
         beaconValue = 0;
         rcvdTime = currentData->getReceivedTime();
         sentTime = currentData->getCreationTime();
         position = currentData->getPosition();
-    } else if (event == "ttl_reached"){
+        break;
+    case NeighborhoodEventCode::TTL_REACHED:
         // current time and current position (last known values but older than TTL)
         beaconValue = -1;
         rcvdTime = currentData->getReceivedTime();
         sentTime = currentData->getCreationTime();
         position = currentData->getPosition();
-    } else { //pre_changed, ttl_reached
-        throw cRuntimeError("wrong event: %s", event.c_str());
+        break;
+    default:
+        throw cRuntimeError("wrong event: %d", (int)event);
     }
     eventnumber_t event_number = getSimulation()->getEventNumber();
     auto traciPosition = globalMapHandler->getConverter()->position_cast_traci(position);
     auto cellPos = globalMapHandler->getCellKeyProvider()->getCellPosition(traciPosition);
 
-    write() << table->getOwnerId() << sep << event_number << sep << event << sep << simTime().dbl() << sep \
-            << rcvdTime << sep << sentTime << sep << info->getNodeId() << sep << position.x << sep << position.y << sep \
-            << beaconValue << sep << info->getPacketsReceivedCount() << sep << info->getPacketsLossCount() << sep \
-            << info->getMaxSequenceNumber() << sep << cellPos.x << sep << cellPos.y << endl;
+    writeEvent(NeighborhoodEvent{table->getOwnerId(), event_number, event, simTime(),
+            rcvdTime, sentTime, info->getNodeId(), position, beaconValue,
+            (int)info->getPacketsReceivedCount(), (int)info->getPacketsLossCount(),
+            (int)info->getMaxSequenceNumber(), cellPos.x, cellPos.y});
+}
+
+void NeighborhoodEventWriter::writeEvent(const NeighborhoodEvent& e){
+    write() << e.tableOwner << sep << e.eventNumber << sep;
+    if (eventCodes){
+        write() << (int)e.event << sep;
+    } else {
+        write() << neighborhoodEventName(e.event) << sep;
+    }
+    write() << e.eventTime.dbl() << sep \
+            << e.receivedTime << sep << e.sentTime << sep << e.sourceNode << sep << e.position.x << sep << e.position.y << sep \
+            << e.beaconValue << sep << e.pktCount << sep << e.pktLoss << sep \
+            << e.pktSeq << sep << e.cellX << sep << e.cellY << endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+NeighborhoodEventSqlWriter::NeighborhoodEventSqlWriter(std::string filePath, long commitInterval)
+        : NeighborhoodEventWriter(filePath), commitInterval(commitInterval){}
+
+NeighborhoodEventSqlWriter::~NeighborhoodEventSqlWriter(){
+    close();
+}
+
+void NeighborhoodEventSqlWriter::initialize(){
+    if (isInitialized()){
+        return; // only once
+    }
+    if (std::string(getFilePath()) == ""){
+        throw cRuntimeError("Path is not set");
+    }
+    if (commitInterval < 1){
+        throw cRuntimeError("commitInterval must be >= 1 got %ld", commitInterval);
+    }
+    setFilePath(getAbsOutputPath(getFilePath(), ".db").c_str());
+    EV_INFO << "open database: " << getFilePath() << endl;
+    sqlApi = SqlApi::open(getFilePath());
+    sqlApi->exec(std::string("CREATE TABLE IF NOT EXISTS neighborhood_event("
+            "table_owner INTEGER, event_number INTEGER, event " +
+            std::string(getEventCodes() ? "INTEGER" : "TEXT") + ", event_time REAL, "
+            "received_at_time REAL, sent_time REAL, source_node INTEGER, posX REAL, posY REAL, "
+            "beacon_value INTEGER, pkt_count INTEGER, pkt_loss INTEGER, pkt_seq INTEGER, "
+            "cell_x REAL, cell_y REAL)");
+    insert = sqlApi->prepare("INSERT INTO neighborhood_event VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?,?)");
+    init = true;
+}
+
+void NeighborhoodEventSqlWriter::writeEvent(const NeighborhoodEvent& e){
+    sqlApi->begin();
+    insert->bind(1, e.tableOwner).bind(2, (int64_t)e.eventNumber);
+    if (getEventCodes()){
+        insert->bind(3, (int)e.event);
+    } else {
+        insert->bind(3, std::string(neighborhoodEventName(e.event)));
+    }
+    insert
+          .bind(4, e.eventTime.dbl()).bind(5, e.receivedTime.dbl()).bind(6, e.sentTime.dbl())
+          .bind(7, e.sourceNode).bind(8, e.position.x).bind(9, e.position.y)
+          .bind(10, e.beaconValue).bind(11, e.pktCount).bind(12, e.pktLoss).bind(13, e.pktSeq)
+          .bind(14, e.cellX).bind(15, e.cellY);
+    insert->exec();
+    if (++pendingEvents >= commitInterval){
+        flush();
+    }
+}
+
+void NeighborhoodEventSqlWriter::flush(){
+    if (sqlApi){
+        sqlApi->commit();
+    }
+    pendingEvents = 0;
+}
+
+void NeighborhoodEventSqlWriter::close(){
+    if (!closed){
+        flush();
+        insert.reset();
+        sqlApi.reset();
+        closed = true;
+    }
 }
 
 }
@@ -7,6 +7,7 @@
 
 #pragma once
 #include "crownet/common/util/FileWriter.h"
+#include "crownet/common/util/SqlApi.h"
 #include "crownet/common/IDensityMapHandler.h"
 #include "crownet/neighbourhood/contract/INeighborhoodTable.h"
 #include <fstream>
@@ -14,6 +15,35 @@
 
 namespace crownet {
 
+// compact event codes (eventCodes=true). Do not reorder, codes are written to the log.
+enum class NeighborhoodEventCode : int {
+    DROPPED = 0,
+    TTL_REACHED = 1,
+    LEAVE_CELL = 2,
+    ENTER_CELL = 3,
+    STAY_IN_CELL = 4,
+};
+static constexpr int NEIGHBORHOOD_EVENT_CODE_COUNT = 5;
+const char* neighborhoodEventName(NeighborhoodEventCode code);
+
+// one row of the neighborhood event log
+struct NeighborhoodEvent {
+    int tableOwner;
+    omnetpp::eventnumber_t eventNumber;
+    NeighborhoodEventCode event;
+    omnetpp::simtime_t eventTime;
+    omnetpp::simtime_t receivedTime;
+    omnetpp::simtime_t sentTime;
+    int sourceNode;
+    inet::Coord position;
+    int beaconValue;
+    int pktCount;
+    int pktLoss;
+    int pktSeq;
+    double cellX;
+    double cellY;
+};
+
 class NeighborhoodEventWriter : public NeighborhoodEntryListner, public BaseFileWriter
 {
 public:
@@ -33,14 +63,49 @@ public:
     void setGlobalDensityMapHandler(IGlobalDensityMapHandler<RegularDcdMap>* globalMapHandler){
             this->globalMapHandler = globalMapHandler;
     }
-    void writeData(INeighborhoodTable* table, BeaconReceptionInfo* info, std::string event);
+    void writeData(INeighborhoodTable* table, BeaconReceptionInfo* info, NeighborhoodEventCode event);
+
+    bool getEventCodes() const { return eventCodes; }
+    void setEventCodes(bool eventCodes) { this->eventCodes = eventCodes; }
+
+protected:
+    virtual void writeEvent(const NeighborhoodEvent& e);
 
 private :
     IGlobalDensityMapHandler<RegularDcdMap>* globalMapHandler;
+    bool eventCodes = false;
 
     void init();
 };
 
+/**
+ * Write neighborhood events into table neighborhood_event of a SQLite
+ * database (filePath) instead of csv. Events are batched into one
+ * transaction which is committed every commitInterval events.
+ */
+class NeighborhoodEventSqlWriter : public NeighborhoodEventWriter
+{
+public:
+    NeighborhoodEventSqlWriter(std::string filePath="", long commitInterval=10000);
+    virtual ~NeighborhoodEventSqlWriter();
+
+    virtual void initialize() override;
+    virtual void flush() override;
+    virtual void close() override;
+
+    long getCommitInterval() const { return commitInterval; }
+    void setCommitInterval(long commitInterval) { this->commitInterval = commitInterval; }
+
+protected:
+    virtual void writeEvent(const NeighborhoodEvent& e) override;
+
+private:
+    std::shared_ptr<SqlApi> sqlApi;
+    std::unique_ptr<SqlStatement> insert;
+    long commitInterval;
+    long pendingEvents = 0;
+};
+
 }
 
 
@@ -0,0 +1,90 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#include "crownet/common/util/ProfileRecorder.h"
+
+#include <chrono>
+
+namespace crownet {
+
+Define_Module(ProfileRecorder);
+
+namespace {
+std::string typeName(const profile::ScopeStat& stat){
+    auto type = stat.type.load(std::memory_order_relaxed);
+    return type ? type->getFullName() : "other";
+}
+}
+
+ProfileRecorder::~ProfileRecorder(){
+    cancelAndDelete(traceTimer);
+}
+
+void ProfileRecorder::initialize(){
+#ifndef CROWNET_PROFILE
+    EV_WARN << "crownet build without PROFILE=1. No profile data will be recorded." << endl;
+#endif
+    if (par("resetOnInit").boolValue()){
+        profile::Registry::instance().reset();
+    }
+    traceInterval = par("traceInterval");
+    if (traceInterval > 0){
+        trace.reset(new BaseFileWriter(par("traceFile").stdstringValue()));
+        trace->initialize();
+        trace->write() << "simtime;walltime;scope;type;calls;time" << std::endl;
+        traceTimer = new cMessage("profileTrace");
+        scheduleAt(simTime() + traceInterval, traceTimer);
+    }
+}
+
+void ProfileRecorder::handleMessage(cMessage *msg){
+    if (msg != traceTimer){
+        throw cRuntimeError("unknown message");
+    }
+    writeTrace();
+    scheduleAt(simTime() + traceInterval, traceTimer);
+}
+
+void ProfileRecorder::writeTrace(){
+    double wall = std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    for (auto scope : profile::Registry::instance().getScopes()){
+        for (int i = 0; i < scope->getStatCount(); i++){
+            const auto& stat = scope->getStatAt(i);
+            trace->write() << simTime().dbl() << ";" << std::fixed << wall << ";"
+                    << scope->getName() << ";" << typeName(stat) << ";"
+                    << stat.calls.load(std::memory_order_relaxed) << ";"
+                    << std::defaultfloat << stat.nanos.load(std::memory_order_relaxed) * 1e-9
+                    << std::endl;
+        }
+    }
+}
+
+void ProfileRecorder::finish(){
+    for (auto scope : profile::Registry::instance().getScopes()){
+        for (int i = 0; i < scope->getStatCount(); i++){
+            const auto& stat = scope->getStatAt(i);
+            std::string name = std::string(scope->getName()) + ":" + typeName(stat);
+            recordScalar((name + ":calls").c_str(), (double)stat.calls.load(std::memory_order_relaxed));
+            recordScalar((name + ":time").c_str(), stat.nanos.load(std::memory_order_relaxed) * 1e-9, "s");
+        }
+    }
+    if (trace){
+        writeTrace();
+        trace->close();
+    }
+}
+
+} // namespace crownet
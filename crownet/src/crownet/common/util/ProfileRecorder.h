@@ -0,0 +1,44 @@
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU Lesser General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU Lesser General Public License for more details.
+// 
+// You should have received a copy of the GNU Lesser General Public License
+// along with this program.  If not, see http://www.gnu.org/licenses/.
+// 
+
+#pragma once
+
+#include <omnetpp.h>
+#include <memory>
+#include "crownet/common/util/FileWriter.h"
+#include "crownet/common/util/Profiler.h"
+
+namespace crownet {
+
+class ProfileRecorder : public omnetpp::cSimpleModule {
+public:
+    virtual ~ProfileRecorder();
+
+    // cSimpleModule
+    virtual void initialize() override;
+    virtual void handleMessage(omnetpp::cMessage *msg) override;
+    virtual void finish() override;
+
+protected:
+    // one line per scope and module type with the cumulative values.
+    virtual void writeTrace();
+
+private:
+    omnetpp::cMessage *traceTimer = nullptr;
+    omnetpp::simtime_t traceInterval;
+    std::unique_ptr<BaseFileWriter> trace;
+};
+
+} // namespace crownet
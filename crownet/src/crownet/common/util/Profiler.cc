@@ -0,0 +1,82 @@
+/*
+ * Profiler.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/common/util/Profiler.h"
+
+namespace crownet {
+namespace profile {
+
+Scope::Scope(const char* name) : name(name) { Registry::instance().add(this); }
+
+ScopeStat& Scope::getStat(const omnetpp::cComponentType* type) {
+  int n = used.load(std::memory_order_acquire);
+  for (int i = 0; i < n; i++) {
+    if (stats[i].type.load(std::memory_order_relaxed) == type) {
+      return stats[i];
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  n = used.load(std::memory_order_relaxed);
+  for (int i = 0; i < n; i++) {
+    if (stats[i].type.load(std::memory_order_relaxed) == type) {
+      return stats[i];
+    }
+  }
+  if (n < MAX_TYPES - 1) {
+    stats[n].type.store(type, std::memory_order_relaxed);
+    used.store(n + 1, std::memory_order_release);
+    return stats[n];
+  }
+  // all slots used. Last slot collects the remaining types.
+  used.store(MAX_TYPES, std::memory_order_release);
+  return stats[MAX_TYPES - 1];
+}
+
+void Scope::reset() {
+  for (auto& s : stats) {
+    s.calls.store(0, std::memory_order_relaxed);
+    s.nanos.store(0, std::memory_order_relaxed);
+  }
+}
+
+Registry& Registry::instance() {
+  static Registry registry;
+  return registry;
+}
+
+void Registry::add(Scope* scope) {
+  std::lock_guard<std::mutex> lock(mutex);
+  scopes.push_back(scope);
+}
+
+std::vector<Scope*> Registry::getScopes() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return scopes;
+}
+
+void Registry::reset() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto scope : scopes) {
+    scope->reset();
+  }
+}
+
+namespace {
+const omnetpp::cComponentType* typeOf(const omnetpp::cComponent* component) {
+  if (component == nullptr) {
+    auto sim = omnetpp::cSimulation::getActiveSimulation();
+    component = sim ? sim->getContextModule() : nullptr;
+  }
+  return component ? component->getComponentType() : nullptr;
+}
+}  // namespace
+
+ScopedTimer::ScopedTimer(Scope& scope, const omnetpp::cComponent* component)
+    : stat(scope.getStat(typeOf(component))), start(std::chrono::steady_clock::now()) {}
+
+}  // namespace profile
+}  // namespace crownet
@@ -0,0 +1,119 @@
+/*
+ * Profiler.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ *
+ * Hot path instrumentation. Call counts and cumulative wall-clock time of
+ * named scopes, kept per module type. Only compiled with CROWNET_PROFILE
+ * (make PROFILE=1). Otherwise the macros expand to nothing.
+ *
+ *   void BaseDensityMapApp::computeMapValues() {
+ *       CROWNET_PROFILE_MODULE_SCOPE("map.computeValues", this);
+ *       ...
+ *   }
+ *
+ * Results are recorded as scalars by the ProfileRecorder module (see ProfileRecorder.ned).
+ */
+
+#pragma once
+
+#include <omnetpp.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace crownet {
+namespace profile {
+
+struct ScopeStat {
+  std::atomic<const omnetpp::cComponentType*> type{nullptr};  // nullptr: unknown or other
+  std::atomic<uint64_t> calls{0};
+  std::atomic<uint64_t> nanos{0};
+};
+
+/**
+ * One instrumented scope. Statistics are kept per module type. Types beyond
+ * MAX_TYPES share the last slot (type nullptr). Safe to use from worker
+ * threads (see GlobalDensityMap).
+ */
+class Scope {
+ public:
+  static const int MAX_TYPES = 16;
+
+  explicit Scope(const char* name);
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+  ScopeStat& getStat(const omnetpp::cComponentType* type);
+
+  const char* getName() const { return name; }
+  int getStatCount() const { return used.load(std::memory_order_acquire); }
+  const ScopeStat& getStatAt(int i) const { return stats[i]; }
+  void reset();
+
+ private:
+  const char* name;
+  ScopeStat stats[MAX_TYPES];
+  std::atomic<int> used{0};
+  std::mutex mutex;  // insert only
+};
+
+/**
+ * Process wide list of all scopes executed at least once.
+ */
+class Registry {
+ public:
+  static Registry& instance();
+
+  void add(Scope* scope);
+  std::vector<Scope*> getScopes();
+  // set all counters to zero (e.g. at the start of a new run)
+  void reset();
+
+ private:
+  std::mutex mutex;
+  std::vector<Scope*> scopes;
+};
+
+class ScopedTimer {
+ public:
+  // component nullptr: use the module type of the current context module
+  ScopedTimer(Scope& scope, const omnetpp::cComponent* component);
+  ~ScopedTimer() {
+    auto d = std::chrono::steady_clock::now() - start;
+    stat.nanos.fetch_add(
+        (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(d).count(),
+        std::memory_order_relaxed);
+    stat.calls.fetch_add(1, std::memory_order_relaxed);
+  }
+  ScopedTimer(const ScopedTimer&) = delete;
+  ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+ private:
+  ScopeStat& stat;
+  std::chrono::steady_clock::time_point start;
+};
+
+}  // namespace profile
+}  // namespace crownet
+
+#ifdef CROWNET_PROFILE
+#define CROWNET_PROFILE_CONCAT_(a, b) a##b
+#define CROWNET_PROFILE_CONCAT(a, b) CROWNET_PROFILE_CONCAT_(a, b)
+#define CROWNET_PROFILE_MODULE_SCOPE(name, component)                                  \
+  static ::crownet::profile::Scope CROWNET_PROFILE_CONCAT(crownetProfileScope_, __LINE__){name}; \
+  ::crownet::profile::ScopedTimer CROWNET_PROFILE_CONCAT(crownetProfileTimer_, __LINE__){      \
+      CROWNET_PROFILE_CONCAT(crownetProfileScope_, __LINE__), component}
+#define CROWNET_PROFILE_SCOPE(name) CROWNET_PROFILE_MODULE_SCOPE(name, nullptr)
+#else
+#define CROWNET_PROFILE_MODULE_SCOPE(name, component) \
+  do {                                                \
+  } while (0)
+#define CROWNET_PROFILE_SCOPE(name) \
+  do {                              \
+  } while (0)
+#endif
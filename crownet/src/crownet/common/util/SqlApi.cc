@@ -0,0 +1,141 @@
+/*
+ * SqlApi.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/common/util/SqlApi.h"
+
+#include <omnetpp.h>
+#include <sqlite3.h>
+
+namespace crownet {
+
+namespace {
+void check(sqlite3* db, int rc, const char* what) {
+  if (rc != SQLITE_OK && rc != SQLITE_DONE && rc != SQLITE_ROW) {
+    throw omnetpp::cRuntimeError("sqlite %s failed: %s", what, sqlite3_errmsg(db));
+  }
+}
+}  // namespace
+
+SqlStatement::~SqlStatement() { sqlite3_finalize(stmt); }
+
+SqlStatement& SqlStatement::bind(int idx, int value) {
+  check(db, sqlite3_bind_int(stmt, idx, value), "bind");
+  return *this;
+}
+
+SqlStatement& SqlStatement::bind(int idx, int64_t value) {
+  check(db, sqlite3_bind_int64(stmt, idx, value), "bind");
+  return *this;
+}
+
+SqlStatement& SqlStatement::bind(int idx, double value) {
+  check(db, sqlite3_bind_double(stmt, idx, value), "bind");
+  return *this;
+}
+
+SqlStatement& SqlStatement::bind(int idx, const std::string& value) {
+  check(db, sqlite3_bind_text(stmt, idx, value.c_str(), (int)value.size(), SQLITE_TRANSIENT), "bind");
+  return *this;
+}
+
+SqlStatement& SqlStatement::bindNull(int idx) {
+  check(db, sqlite3_bind_null(stmt, idx), "bind");
+  return *this;
+}
+
+bool SqlStatement::step() {
+  int rc = sqlite3_step(stmt);
+  check(db, rc, "step");
+  return rc == SQLITE_ROW;
+}
+
+void SqlStatement::exec() {
+  int rc = sqlite3_step(stmt);
+  sqlite3_reset(stmt);
+  check(db, rc, "step");
+}
+
+void SqlStatement::reset() {
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+}
+
+int64_t SqlStatement::getInt(int col) const { return sqlite3_column_int64(stmt, col); }
+
+double SqlStatement::getDouble(int col) const { return sqlite3_column_double(stmt, col); }
+
+std::string SqlStatement::getString(int col) const {
+  auto text = sqlite3_column_text(stmt, col);
+  return text ? std::string((const char*)text, sqlite3_column_bytes(stmt, col)) : std::string();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+std::map<std::string, std::weak_ptr<SqlApi>> SqlApi::connections;
+
+std::shared_ptr<SqlApi> SqlApi::open(const std::string& path) {
+  if (connections[path].lock()) {
+    throw omnetpp::cRuntimeError("sqlite database %s is already used by another writer. Use a separate file",
+                                 path.c_str());
+  }
+  auto ret = std::make_shared<SqlApi>(path);
+  connections[path] = ret;
+  return ret;
+}
+
+SqlApi::SqlApi(const std::string& path) : path(path) {
+  int rc = sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr);
+  if (rc != SQLITE_OK) {
+    std::string err = db ? sqlite3_errmsg(db) : "out of memory";
+    sqlite3_close(db);
+    throw omnetpp::cRuntimeError("cannot open sqlite database %s: %s", path.c_str(), err.c_str());
+  }
+  // results can be recreated by rerunning the simulation. Trade durability for speed.
+  exec("PRAGMA journal_mode=WAL");
+  exec("PRAGMA synchronous=OFF");
+}
+
+SqlApi::~SqlApi() {
+  if (transaction) {
+    sqlite3_exec(db, "COMMIT", nullptr, nullptr, nullptr);
+  }
+  sqlite3_close(db);
+}
+
+void SqlApi::exec(const std::string& sql) {
+  char* err = nullptr;
+  if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &err) != SQLITE_OK) {
+    std::string msg = err ? err : "unknown error";
+    sqlite3_free(err);
+    throw omnetpp::cRuntimeError("sqlite exec failed: %s (%s)", msg.c_str(), sql.c_str());
+  }
+}
+
+std::unique_ptr<SqlStatement> SqlApi::prepare(const std::string& sql) {
+  sqlite3_stmt* stmt = nullptr;
+  int rc = sqlite3_prepare_v2(db, sql.c_str(), (int)sql.size() + 1, &stmt, nullptr);
+  if (rc != SQLITE_OK) {
+    throw omnetpp::cRuntimeError("sqlite prepare failed: %s (%s)", sqlite3_errmsg(db), sql.c_str());
+  }
+  return std::unique_ptr<SqlStatement>(new SqlStatement(db, stmt));
+}
+
+void SqlApi::begin() {
+  if (!transaction) {
+    exec("BEGIN");
+    transaction = true;
+  }
+}
+
+void SqlApi::commit() {
+  if (transaction) {
+    exec("COMMIT");
+    transaction = false;
+  }
+}
+
+}  // namespace crownet
@@ -0,0 +1,91 @@
+/*
+ * SqlApi.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace crownet {
+
+/**
+ * Prepared statement bound to the SqlApi that created it. Parameter indices
+ * start at 1 (sqlite convention), column indices at 0.
+ */
+class SqlStatement {
+ public:
+  SqlStatement(sqlite3* db, sqlite3_stmt* stmt) : db(db), stmt(stmt) {}
+  ~SqlStatement();
+  SqlStatement(const SqlStatement&) = delete;
+  SqlStatement& operator=(const SqlStatement&) = delete;
+
+  SqlStatement& bind(int idx, int value);
+  SqlStatement& bind(int idx, int64_t value);
+  SqlStatement& bind(int idx, double value);
+  SqlStatement& bind(int idx, const std::string& value);
+  SqlStatement& bindNull(int idx);
+
+  // true if a result row is available
+  bool step();
+  // step() for INSERT/UPDATE statements followed by reset()
+  void exec();
+  void reset();
+
+  int64_t getInt(int col) const;
+  double getDouble(int col) const;
+  std::string getString(int col) const;
+
+ private:
+  sqlite3* db;
+  sqlite3_stmt* stmt;
+};
+
+/**
+ * Connection to a SQLite database. Transactions are explicit
+ * (begin()/commit()) to batch many inserts into one commit. A transaction
+ * belongs to the connection, thus each writer must use its own connection
+ * (and file), see open().
+ */
+class SqlApi {
+ public:
+  /**
+   * Connection for a writer. Throws if another writer still holds a
+   * connection to path, otherwise commits of one writer would include the
+   * pending rows of the other. Readers can use the constructor.
+   */
+  static std::shared_ptr<SqlApi> open(const std::string& path);
+
+  SqlApi(const std::string& path);
+  ~SqlApi();
+  SqlApi(const SqlApi&) = delete;
+  SqlApi& operator=(const SqlApi&) = delete;
+
+  void exec(const std::string& sql);
+  std::unique_ptr<SqlStatement> prepare(const std::string& sql);
+
+  // begin transaction if none is active.
+  void begin();
+  // commit active transaction (if any).
+  void commit();
+  bool inTransaction() const { return transaction; }
+
+  const std::string& getPath() const { return path; }
+
+ private:
+  std::string path;
+  sqlite3* db = nullptr;
+  bool transaction = false;
+
+  static std::map<std::string, std::weak_ptr<SqlApi>> connections;
+};
+
+}  // namespace crownet
@@ -10,52 +10,44 @@
 namespace crownet {
 
 
-SqlLiteWriter::SqlLiteWriter(long bufferSize)
-        : BufferWriter(bufferSize) {
-
+SqlLiteWriter::SqlLiteWriter(std::shared_ptr<SqlApi> sqlApi, std::shared_ptr<SqlPrinter> printer, int commitInterval)
+        : sqlApi(std::move(sqlApi)), printer(std::move(printer)), commitInterval(commitInterval) {
+    if (this->commitInterval < 1){
+        throw omnetpp::cRuntimeError("commitInterval must be >= 1 got %d", commitInterval);
+    }
 }
 
 SqlLiteWriter::~SqlLiteWriter() {
-    close();
+    finish();
 }
 
 void SqlLiteWriter::initialize() {
-    //only create Schema once!
-
-    //todo check if sql file exist
-    // if yes
-        // do nothing (schema already created)
-    // else create scheam using printer
-        // printer->writeSqlStatement(write());
-        // flush Buffer to disc immediately
-        //flush();
+    // schema uses IF NOT EXISTS, an existing file is appended to. Only one
+    // writer per database file (SqlApi::open throws on a second writer).
+    sqlApi->begin();
+    printer->createSchema(*sqlApi);
+    sqlApi->commit();
 }
 
 void SqlLiteWriter::initWriter(){
-    // insert data on writer init (e.g. metadata)
-    printer->writeInitSqlStatement(write());
-    // flush Buffer to disc immediately
-    flush();
-}
-
-void SqlLiteWriter::writeBuffer(){
-    //todo send buffer to sql API. buffer contains a string of multiple sql statements.
+    sqlApi->begin();
+    printer->writeInitSqlStatement(*sqlApi, metadata);
+    sqlApi->commit();
 }
 
 void SqlLiteWriter::writeData() {
-    printer->writeSqlStatement(write());
+    sqlApi->begin();
+    printer->writeSqlStatement(*sqlApi);
+    if (++pendingIntervals >= commitInterval){
+        sqlApi->commit();
+        pendingIntervals = 0;
+    }
 }
+
 void SqlLiteWriter::finish() {
-    close();
-}
-void SqlLiteWriter::flush() {
-    writeBuffer();
-}
-void SqlLiteWriter::close() {
     if (!closed){
-        flush();
+        sqlApi->commit();
         closed = true;
     }
 }
 }
-
@@ -7,42 +7,51 @@
 
 #pragma once
 
-#include <fstream>
-#include <sstream>
-#include "Writer.h"
+#include <map>
 #include <memory>
+#include <string>
+#include "Writer.h"
+#include "SqlApi.h"
 
 namespace crownet {
 
 class SqlPrinter {
 public:
     virtual ~SqlPrinter()=default;
-    virtual void writeSqlStatement(std::ostream& out) = 0;
-    virtual void createSchema(std::ostream& out) = 0;
-    virtual void writeInitSqlStatement(std::ostream& out) = 0;
+    // create tables (IF NOT EXISTS) and prepare statements.
+    virtual void createSchema(SqlApi& api) = 0;
+    // insert data on writer init (e.g. metadata)
+    virtual void writeInitSqlStatement(SqlApi& api, const std::map<std::string, std::string>& metadata) = 0;
+    // insert current state (one simulation interval)
+    virtual void writeSqlStatement(SqlApi& api) = 0;
 };
 
-class SqlLiteWriter : public BufferWriter,
-                      public ActiveWriter  {
+/**
+ * ActiveWriter for SQLite databases. Each writeData() call writes one
+ * simulation interval. Intervals are batched into one transaction and
+ * committed every commitInterval calls and on finish().
+ */
+class SqlLiteWriter : public ActiveWriter  {
 public:
-    SqlLiteWriter(long bufferSize=8192);
+    SqlLiteWriter(std::shared_ptr<SqlApi> sqlApi, std::shared_ptr<SqlPrinter> printer, int commitInterval=1);
     virtual ~SqlLiteWriter();
 
-    virtual void writeBuffer() override;
+    void initialize();
+    void writeMetaData(std::map<std::string, std::string>& mData) { metadata = mData; }
+
     virtual void initWriter() override;
     virtual void writeData() override;
     virtual void finish() override;
-    virtual void flush() override;
-    virtual void close() override;
-    virtual void initialize() override;
-    void setPrinter(std::shared_ptr<SqlPrinter> p){ printer = p;}
+
     std::shared_ptr<SqlPrinter> getPrinter() { return printer;}
-    // todo mw
-//    void setSqlApi(std::shared_ptr<SqlAPI>);
+    std::shared_ptr<SqlApi> getSqlApi() { return sqlApi;}
 
 private:
+    std::shared_ptr<SqlApi> sqlApi;
     std::shared_ptr<SqlPrinter> printer;
-    // todo mw add sql handle here
-    // std::shared_ptr<SqlAPI> sqlApi;
+    std::map<std::string, std::string> metadata;
+    int commitInterval;
+    int pendingIntervals = 0;
+    bool closed = false;
 };
 }
@@ -0,0 +1,91 @@
+/*
+ * WorkerPool.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/common/util/WorkerPool.h"
+
+namespace crownet {
+
+WorkerPool::WorkerPool(int numThreads) {
+  for (int i = 1; i < numThreads; i++) {
+    threads.emplace_back(&WorkerPool::run, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stop = true;
+  }
+  workAvailable.notify_all();
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+void WorkerPool::parallelFor(int n, const std::function<void(int)>& fn) {
+  if (threads.empty() || n <= 1) {
+    for (int i = 0; i < n; i++) {
+      fn(i);
+    }
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    job = &fn;
+    jobSize = n;
+    next = 0;
+    error = nullptr;
+    activeThreads = (int)threads.size();
+    ++generation;
+  }
+  workAvailable.notify_all();
+  work();
+
+  std::unique_lock<std::mutex> lock(mutex);
+  workDone.wait(lock, [this] { return activeThreads == 0; });
+  job = nullptr;
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void WorkerPool::run() {
+  uint64_t seen = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      workAvailable.wait(lock, [&] { return stop || generation != seen; });
+      if (stop) {
+        return;
+      }
+      seen = generation;
+    }
+    work();
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--activeThreads == 0) {
+        workDone.notify_all();
+      }
+    }
+  }
+}
+
+void WorkerPool::work() {
+  for (int i = next.fetch_add(1); i < jobSize; i = next.fetch_add(1)) {
+    try {
+      (*job)(i);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+      next = jobSize;  // skip remaining work items
+    }
+  }
+}
+
+}  // namespace crownet
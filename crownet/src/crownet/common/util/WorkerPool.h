@@ -0,0 +1,64 @@
+/*
+ * WorkerPool.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace crownet {
+
+/**
+ * Fixed set of worker threads used to run independent work items (e.g. the
+ * density maps of different nodes) concurrently. The threads are created once
+ * and reused for each call of parallelFor. The calling thread takes part in
+ * the work, thus numThreads <= 1 executes everything on the calling thread.
+ *
+ * Work items must not interact with the simulation kernel (simTime(), EV,
+ * signals, other modules) because OMNeT++ is not thread safe.
+ */
+class WorkerPool {
+ public:
+  explicit WorkerPool(int numThreads);
+  ~WorkerPool();
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  int getNumThreads() const { return (int)threads.size() + 1; }
+
+  /**
+   * Call fn(i) for all i in [0, n) and block until all calls returned.
+   * The first exception thrown by fn is rethrown on the calling thread.
+   */
+  void parallelFor(int n, const std::function<void(int)>& fn);
+
+ private:
+  void run();
+  void work();
+
+  std::vector<std::thread> threads;
+  std::mutex mutex;
+  std::condition_variable workAvailable;
+  std::condition_variable workDone;
+
+  // current job (guarded by mutex, next is lock free)
+  const std::function<void(int)>* job = nullptr;
+  int jobSize = 0;
+  std::atomic<int> next{0};
+  int activeThreads = 0;
+  uint64_t generation = 0;
+  bool stop = false;
+  std::exception_ptr error;
+};
+
+}  // namespace crownet
@@ -8,6 +8,7 @@
 #ifndef CROWNET_CONTROL_CONTROLHANDLER_H_
 #define CROWNET_CONTROL_CONTROLHANDLER_H_
 
+#include "crownet/control/DensityMapSnapshot.h"
 
 namespace crownet {
 
@@ -36,7 +37,13 @@ class ControlHandler {
 public:
     virtual ~ControlHandler() = default;
     virtual void handleActionCommand(const ControlCmd& cmd) = 0;
-    virtual std::vector<double> handleDensityMapCommand(const DensityMapCmd& cmd) = 0;
+    // fill snapshot with the valid cells of the map of cmd.nodeId (buffer is reused)
+    virtual void getDensityMap(const DensityMapCmd& cmd, DensityMapSnapshot& snapshot) = 0;
+    virtual std::vector<double> handleDensityMapCommand(const DensityMapCmd& cmd) {
+        DensityMapSnapshot snapshot;
+        getDensityMap(cmd, snapshot);
+        return snapshot.toDoubleList();
+    }
 
     //todo: (CM) add handle method for sensor command here
 
@@ -22,6 +22,7 @@
 #include "inet/common/packet/Message.h"
 #include "crownet/artery/traci/TraCiForwarder.h"
 #include "crownet/artery/traci/VadereCore.h"
+#include "crownet/common/util/Profiler.h"
 #include "crownet/crownet.h"
 #include "crownet/applications/control/control_m.h"
 #include "crownet/dcd/identifier/CellKeyProvider.h"
@@ -90,38 +91,37 @@ void ControlManager::handleActionCommand(const ControlCmd& cmd){
 
 }
 
-std::vector<double> ControlManager::handleDensityMapCommand(const DensityMapCmd& cmd){
+void ControlManager::getDensityMap(const DensityMapCmd& cmd, DensityMapSnapshot& snapshot){
     Enter_Method_Silent();
 
 
     auto node_module = this->findModuleByPath(cmd.nodeId.c_str());
+    if (!node_module){
+        throw cRuntimeError("Cannot find module with path %s", cmd.nodeId.c_str());
+    }
     IDensityMapHandlerBase<RegularDcdMap>* map_handler =
             check_and_cast<IDensityMapHandlerBase<RegularDcdMap>*>(node_module);
 
-    std::vector<double> density_vals;
     auto map = map_handler->getMap();
     auto cellProvider = std::dynamic_pointer_cast<GridCellIDKeyProvider>(map->getCellKeyProvider());
 
-    density_vals.push_back(cellProvider->getGridSize().x);
-    density_vals.push_back(cellProvider->getGridSize().y);
-    density_vals.push_back(cellProvider->getCellSize().x);
-    density_vals.push_back(cellProvider->getCellSize().y);
+    snapshot.clear();
+    snapshot.gridSizeX = cellProvider->getGridSize().x;
+    snapshot.gridSizeY = cellProvider->getGridSize().y;
+    snapshot.cellSizeX = cellProvider->getCellSize().x;
+    snapshot.cellSizeY = cellProvider->getCellSize().y;
     auto iter = map->valid();
      for( auto item: iter){
          const auto measure = item.second.val();
          if(measure){
              auto x = item.first.val().first;
              auto y = item.first.val().second;
-             auto count = item.second.val()->getCount();
-             density_vals.push_back(x);
-             density_vals.push_back(y);
-             density_vals.push_back(count);
+             auto count = measure->getCount();
+             snapshot.add(x, y, count);
              EV_INFO << "x-y-count: " <<
                      x << "-" << y <<"-"<< count << std::endl;
          }
     }
-
-     return density_vals;
 }
 
 void ControlManager::finish() {
@@ -158,11 +158,17 @@ void ControlManager::traciInit()
                 host.c_str(), std::to_string(port).c_str());
     }
     nextTime = api->handleInit(simTime().dbl());
+
+    if (par("asyncControl").boolValue()){
+        std::vector<std::string> pushNodes = cStringTokenizer(par("pushDensityMaps").stringValue()).asVector();
+        api->enableAsync(par("controlLookahead").intValue(), pushNodes);
+    }
 }
 
 void ControlManager::traciStep()
 {
     Enter_Method_Silent();
+    CROWNET_PROFILE_MODULE_SCOPE("traci.controlStep", this);
     // only call controller if nextTime is reached. (negative or zero: each event)
     if (nextTime <= simtime_t::ZERO || simTime() >= nextTime ){
         nextTime = api->handleSimStep(simTime().dbl());
@@ -43,7 +43,7 @@ public:
 
     // implement ControlHander interface
     virtual void handleActionCommand(const ControlCmd& cmd) override;
-    virtual std::vector<double> handleDensityMapCommand(const DensityMapCmd& cmd) override;
+    virtual void getDensityMap(const DensityMapCmd& cmd, DensityMapSnapshot& snapshot) override;
 
 
     using omnetpp::cIListener::finish;  // [-Woverloaded-virtual]
@@ -6,6 +6,8 @@
  */
 
 #include <omnetpp/cexpression.h>
+#include <chrono>
+#include <thread>
 #include "ControlTraCiApi.h"
 
 using namespace libsumo;
@@ -41,7 +43,19 @@ ForwardCmd ControlTraCiApi::parseCtrlCmd(tcpip::Storage& inMsg){
     return cmd;
 }
 
+void ControlTraCiApi::enableAsync(int lookahead, const std::vector<std::string>& pushNodes){
+    if (lookahead < 1){
+        throw omnetpp::cRuntimeError("lookahead must be at least one step. Got %d", lookahead);
+    }
+    this->async = true;
+    this->lookahead = lookahead;
+    this->pushNodes = pushNodes;
+}
+
 double ControlTraCiApi::handleSimStep(double simtime){
+    if (async){
+        return handleSimStepAsync(simtime);
+    }
 
     std::string objId = "";
     tcpip::Storage content;
@@ -69,65 +83,144 @@ double ControlTraCiApi::handleInit(double simtime){
 }
 
 
+double ControlTraCiApi::handleSimStepAsync(double simtime){
+    // apply commands the controller sent since the last step
+    receiveAvailable(false);
+    while (!rxQueue.empty() || pendingSteps >= lookahead){
+        if (rxQueue.empty()){
+            // lookahead exhausted. Wait for the controller.
+            receiveAvailable(true);
+        }
+        myInput.reset();
+        myInput.writePacket(rxQueue.front());
+        rxQueue.pop_front();
+        if (handleControllerCmd(nextControlUpdateAt)){
+            --pendingSteps;
+        }
+    }
+
+    std::string objId = "";
+    tcpip::Storage content;
+    content.writeByte(TYPE_COMPOUND);
+    content.writeInt(2 + 2 * (int)pushNodes.size());
+    content.writeByte(TYPE_DOUBLE);
+    content.writeDouble(simtime);
+    content.writeByte(TYPE_INTEGER);
+    content.writeInt((int)pushNodes.size());
+    for (const auto& node : pushNodes){
+        DensityMapCmd densityCmd;
+        densityCmd.nodeId = node;
+        controlHandler->getDensityMap(densityCmd, snapshot);
+        content.writeByte(TYPE_STRING);
+        content.writeString(node);
+        snapshot.write(content);
+    }
+    createCommand(traci::constants::CMD_CONTROL, traci::constants::VAR_STEP_ASYNC, objId, &content);
+    mySocket->sendExact(myOutput);
+    ++pendingSteps;
+
+    return nextControlUpdateAt;
+}
+
+void ControlTraCiApi::receiveAvailable(bool block){
+    while (true) {
+        // non blocking. Empty if no data is waiting.
+        std::vector<unsigned char> data = mySocket->receive(4096);
+        rxBuffer.insert(rxBuffer.end(), data.begin(), data.end());
+
+        // split into commands (4 byte length including the length field)
+        std::size_t pos = 0;
+        while (rxBuffer.size() - pos >= 4){
+            std::size_t len = (std::size_t)rxBuffer[pos] << 24 | (std::size_t)rxBuffer[pos+1] << 16 |
+                    (std::size_t)rxBuffer[pos+2] << 8 | (std::size_t)rxBuffer[pos+3];
+            if (len < 4){
+                throw omnetpp::cRuntimeError("#Error: invalid message length %zu from controller", len);
+            }
+            if (rxBuffer.size() - pos < len){
+                break;
+            }
+            rxQueue.emplace_back(rxBuffer.begin() + pos + 4, rxBuffer.begin() + pos + len);
+            pos += len;
+        }
+        rxBuffer.erase(rxBuffer.begin(), rxBuffer.begin() + pos);
+
+        if (!block || !rxQueue.empty()){
+            return;
+        }
+        if (rxBuffer.empty()){
+            // nothing partially received: read the next command blocking
+            myInput.reset();
+            mySocket->receiveExact(myInput);
+            rxQueue.emplace_back(myInput.begin(), myInput.end());
+            return;
+        }
+        if (data.empty()){
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+}
+
 double ControlTraCiApi::handleControlLoop(){
     // send  command to controller
     mySocket->sendExact(myOutput);
     myInput.reset();
-    bool running = true;
-    double nextControlUpdateAt = -1.0; // -1.0 means next simStep
+    double nextUpdateAt = -1.0; // -1.0 means next simStep
 
-    while(running){
-        // receive myInput and decided what to do
-        // replies must be CMD_CONTROL commands. no result State provided.
+    // receive myInput and decided what to do
+    // replies must be CMD_CONTROL commands. no result State provided.
+    do {
         mySocket->receiveExact(myInput);
-        ForwardCmd result = parseCtrlCmd(myInput);
+    } while (!handleControllerCmd(nextUpdateAt));
+    // stop receiving mode. (Other side is waiting for next 'sendExact' call)
 
-        if (result.cmdId != traci::constants::CMD_CONTROL){
-            throw omnetpp::cRuntimeError("#Error: expected CMD_CONTROL");
-        }
+    return nextUpdateAt;
+}
 
-        if (result.varId == traci::constants::VAR_Step || result.varId == traci::constants::VAR_INIT){
-            // Acknowledgment of simStep from controller [simAck]
-            // read next call time
-            if (myInput.readUnsignedByte() != TYPE_DOUBLE){
-                throw omnetpp::cRuntimeError("#Error: expected TYPE_DOUBLE");
-            }
-            nextControlUpdateAt = myInput.readDouble();
+bool ControlTraCiApi::handleControllerCmd(double& nextUpdateAt){
+    ForwardCmd result = parseCtrlCmd(myInput);
 
-            // stop receiving mode. (Other side is waiting for next 'sendExact' call)
-            running = false;
-        } else if (result.varId == traci::constants::VAR_FORWARD){
+    if (result.cmdId != traci::constants::CMD_CONTROL){
+        throw omnetpp::cRuntimeError("#Error: expected CMD_CONTROL");
+    }
 
-            if (result.objectIdentifer == traci::constants::SIMULATOR_VADERE){
+    if (result.varId == traci::constants::VAR_Step || result.varId == traci::constants::VAR_INIT
+            || result.varId == traci::constants::VAR_STEP_ASYNC){
+        // Acknowledgment of simStep from controller [simAck]
+        // read next call time
+        if (myInput.readUnsignedByte() != TYPE_DOUBLE){
+            throw omnetpp::cRuntimeError("#Error: expected TYPE_DOUBLE");
+        }
+        nextUpdateAt = myInput.readDouble();
+        return true;
+    } else if (result.varId == traci::constants::VAR_FORWARD){
 
-                  // extract payload and forward
-                  tcpip::Storage forwardCmd;
-                  tcpip::Storage forwardResponse;
+        if (result.objectIdentifer == traci::constants::SIMULATOR_VADERE){
 
-                  forwardCmd.writeStorage(myInput, result.payloadLength);
-                  traciForwarder->forward(forwardCmd, forwardResponse);
+              // extract payload and forward
+              tcpip::Storage forwardCmd;
+              tcpip::Storage forwardResponse;
 
-                  // send response from mobilityProvider to controller
-                  mySocket->sendExact(forwardResponse);
+              forwardCmd.writeStorage(myInput, result.payloadLength);
+              traciForwarder->forward(forwardCmd, forwardResponse);
 
-              } else if (result.objectIdentifer == traci::constants::SIMULATOR_OPP){
-                  // extract command and execute
-                  tcpip::Storage res = handleControllerOppRequest(result);
-                  // send response to controller
-                  mySocket->sendExact(res);
-              } else {
-                  throw omnetpp::cRuntimeError("#Error: expected 'V' or 'O' as objectID to select simulator");
-              }
+              // send response from mobilityProvider to controller
+              mySocket->sendExact(forwardResponse);
 
-            // keep receiving commands
-            running = true;
-        }
-        else {
-            throw omnetpp::cRuntimeError("#Error: expected VAR_Step or VAR_FORWARD");
-        }
-    }
+          } else if (result.objectIdentifer == traci::constants::SIMULATOR_OPP){
+              // extract command and execute
+              tcpip::Storage res = handleControllerOppRequest(result);
+              // send response to controller
+              mySocket->sendExact(res);
+          } else {
+              throw omnetpp::cRuntimeError("#Error: expected 'V' or 'O' as objectID to select simulator");
+          }
 
-    return nextControlUpdateAt;
+        // keep receiving commands
+        return false;
+    }
+    else {
+        throw omnetpp::cRuntimeError("#Error: expected VAR_Step or VAR_FORWARD");
+    }
 }
 
 void ControlTraCiApi::checkCompound(tcpip::Storage& cmd, int numElements){
@@ -177,6 +270,23 @@ tcpip::Storage ControlTraCiApi::handleControllerOppRequest(ForwardCmd& ctrlCmd){
          response.writeStorage(myOutput);
          myOutput.reset();
 
+     } else if(varId == traci::constants::VAR_DENSITY_MAP_PACKED){
+         // same as VAR_DENSITY_MAP with packed payload (see DensityMapSnapshot)
+         checkCompound(cmd, 1);
+
+         DensityMapCmd densityCmd;
+         cmd.readUnsignedByte(); // string
+         densityCmd.nodeId = cmd.readString();
+
+         this->controlHandler->getDensityMap(densityCmd, snapshot);
+         this->createResponse(response, cmdId, RTYPE_OK, ""); // assume all is ok
+
+         tcpip::Storage cmdData;
+         snapshot.write(cmdData);
+         this->createCommand(cmdId+0x10, varId, objectIdentifer, &cmdData);
+         response.writeStorage(myOutput);
+         myOutput.reset();
+
      } else if (varId == traci::constants::VAR_EXTERNAL_INPUT){ // varId == 32
          checkCompound(cmd, 3);
 
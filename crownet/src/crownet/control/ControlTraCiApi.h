@@ -8,6 +8,8 @@
 #pragma once
 
 #include <memory.h>
+#include <deque>
+#include <vector>
 
 #include <traci/sumo/utils/traci/TraCIAPI.h>
 #include "crownet/artery/traci/TraCiForwarder.h"
@@ -25,12 +27,18 @@ constexpr int VAR_FORWARD = 0xff;
 constexpr int VAR_INIT = 0x00;
 constexpr int VAR_Step = 0x02;
 constexpr int VAR_DENSITY_MAP = 0x22;
+constexpr int VAR_DENSITY_MAP_PACKED = 0x23;
+// asynchronous step: send without waiting, acknowledged later by controller
+constexpr int VAR_STEP_ASYNC = 0x03;
 constexpr int VAR_EXTERNAL_INPUT_INIT = 0x21;
 constexpr int VAR_EXTERNAL_INPUT = 0x20;
 
 constexpr char SIMULATOR_VADERE[] = "V";
 constexpr char SIMULATOR_OPP[] = "O";
 
+// value type of DensityMapSnapshot (see DensityMapSnapshot.h)
+constexpr int TYPE_DENSITY_MAP_PACKED = 0x20;
+
 
 }
 }
@@ -48,8 +56,32 @@ public:
     void setTraCiForwarder(std::shared_ptr<TraCiForwarder> traciForwarder);
     void setControlHandler(ControlHandler* controlHandler);
 
+    /**
+     * Switch to asynchronous steps (call after handleInit). handleSimStep()
+     * sends the step together with the packed density maps of pushNodes and
+     * returns without waiting for the controller. Controller commands
+     * received in the meantime are handled at the beginning of the next
+     * step. At most lookahead steps may be unacknowledged, otherwise
+     * handleSimStep() blocks until the controller catches up.
+     *
+     * Controller side: answer each VAR_STEP_ASYNC step (in order) with a
+     * CMD_CONTROL/VAR_STEP_ASYNC acknowledgment containing the next control
+     * time (TYPE_DOUBLE) as for VAR_Step. VAR_FORWARD commands may be sent at
+     * any time and are answered when handled.
+     */
+    void enableAsync(int lookahead, const std::vector<std::string>& pushNodes);
+    bool isAsync() const { return async; }
+    int getPendingSteps() const { return pendingSteps; }
+
 protected:
     virtual double handleControlLoop();
+    virtual double handleSimStepAsync(double simtime);
+    // handle one received controller command in myInput. Returns true for a
+    // step acknowledgment (next control time in nextUpdateAt).
+    virtual bool handleControllerCmd(double& nextUpdateAt);
+    // read all received commands from the socket. If block is set wait for at
+    // least one command.
+    void receiveAvailable(bool block);
     virtual tcpip::Storage handleControllerOppRequest(ForwardCmd& ctrlCmd);
 
     ForwardCmd parseCtrlCmd(tcpip::Storage& inMsg);
@@ -61,6 +93,16 @@ private:
 
     std::shared_ptr<TraCiForwarder> traciForwarder;
     ControlHandler* controlHandler;
+
+    // async mode
+    bool async = false;
+    int lookahead = 1;
+    int pendingSteps = 0;
+    double nextControlUpdateAt = -1.0;
+    std::vector<std::string> pushNodes;
+    DensityMapSnapshot snapshot;
+    std::vector<unsigned char> rxBuffer;  // partially received command
+    std::deque<std::vector<unsigned char>> rxQueue;  // complete commands
 };
 
 } /* namespace crownet */
@@ -0,0 +1,72 @@
+/*
+ * DensityMapSnapshot.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/control/DensityMapSnapshot.h"
+
+#include <limits>
+#include <omnetpp/cexception.h>
+
+#include "crownet/control/ControlTraCiApi.h"
+
+namespace crownet {
+
+void DensityMapSnapshot::write(tcpip::Storage& out) const {
+  out.writeUnsignedByte(traci::constants::TYPE_DENSITY_MAP_PACKED);
+  out.writeDouble(gridSizeX);
+  out.writeDouble(gridSizeY);
+  out.writeDouble(cellSizeX);
+  out.writeDouble(cellSizeY);
+  out.writeInt((int)cells.size());
+  for (const auto& cell : cells) {
+    if (cell.x < 0 || cell.y < 0 || cell.x > std::numeric_limits<short>::max() ||
+        cell.y > std::numeric_limits<short>::max()) {
+      throw omnetpp::cRuntimeError(
+          "cell [%d, %d] does not fit into packed density map", cell.x, cell.y);
+    }
+    out.writeShort(cell.x);
+    out.writeShort(cell.y);
+  }
+  for (const auto& cell : cells) {
+    out.writeFloat((float)cell.count);
+  }
+}
+
+void DensityMapSnapshot::read(tcpip::Storage& in) {
+  gridSizeX = in.readDouble();
+  gridSizeY = in.readDouble();
+  cellSizeX = in.readDouble();
+  cellSizeY = in.readDouble();
+  int n = in.readInt();
+  if (n < 0) {
+    throw omnetpp::cRuntimeError("negative cell count %d in packed density map", n);
+  }
+  cells.resize(n);
+  for (auto& cell : cells) {
+    cell.x = in.readShort();
+    cell.y = in.readShort();
+  }
+  for (auto& cell : cells) {
+    cell.count = in.readFloat();
+  }
+}
+
+std::vector<double> DensityMapSnapshot::toDoubleList() const {
+  std::vector<double> ret;
+  ret.reserve(4 + 3 * cells.size());
+  ret.push_back(gridSizeX);
+  ret.push_back(gridSizeY);
+  ret.push_back(cellSizeX);
+  ret.push_back(cellSizeY);
+  for (const auto& cell : cells) {
+    ret.push_back(cell.x);
+    ret.push_back(cell.y);
+    ret.push_back(cell.count);
+  }
+  return ret;
+}
+
+}  // namespace crownet
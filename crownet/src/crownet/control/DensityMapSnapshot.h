@@ -0,0 +1,61 @@
+/*
+ * DensityMapSnapshot.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace tcpip {
+class Storage;
+}
+
+namespace crownet {
+
+/**
+ * Valid cells of a density map as sent to the controller.
+ *
+ * Packed TraCI encoding (TYPE_DENSITY_MAP_PACKED, big endian as all TraCI
+ * values):
+ *
+ *   type                       ubyte
+ *   gridSize x, y              double
+ *   cellSize x, y              double
+ *   cell count n               int
+ *   n * (cell x, cell y)       short (cell index, not position)
+ *   n * count                  float
+ *
+ * 8 byte per cell instead of 24 byte for the flat double list
+ * [gridX, gridY, cellX, cellY, (x, y, count)*] of VAR_DENSITY_MAP.
+ */
+struct DensityMapSnapshot {
+  struct Cell {
+    int x;
+    int y;
+    double count;
+  };
+
+  double gridSizeX = 0.0;
+  double gridSizeY = 0.0;
+  double cellSizeX = 0.0;
+  double cellSizeY = 0.0;
+  std::vector<Cell> cells;
+
+  // keeps the capacity of cells to reuse the buffer
+  void clear() { cells.clear(); }
+  void add(int x, int y, double count) { cells.push_back(Cell{x, y, count}); }
+
+  // type byte and packed map
+  void write(tcpip::Storage& out) const;
+  // packed map. The type byte must already be consumed.
+  void read(tcpip::Storage& in);
+
+  // flat double list of VAR_DENSITY_MAP
+  std::vector<double> toDoubleList() const;
+};
+
+}  // namespace crownet
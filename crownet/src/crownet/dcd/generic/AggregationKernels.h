@@ -0,0 +1,178 @@
+/*
+ * AggregationKernels.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ *
+ * Kernels used by the cell aggregation algorithms. They work on contiguous
+ * arrays gathered from the valid entries of one cell (structure of arrays) so
+ * the compiler can vectorize the element wise parts. On x86-64 with GCC or
+ * clang ageDistRank() has an AVX2 variant that is selected at runtime if the
+ * CPU supports it, thus the default build (no -mavx2) uses it as well. If the
+ * translation unit is compiled for AVX2 (-mavx2, -march=native) the check is
+ * skipped. Other compilers and architectures use the scalar loop.
+ *
+ * All kernels use the same operation order as the scalar per entry code, thus
+ * results are bitwise identical to a plain loop over the entries.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CROWNET_AGGREGATION_AVX2 1
+#include <immintrin.h>
+#else
+#define CROWNET_AGGREGATION_AVX2 0
+#endif
+
+namespace crownet {
+namespace aggregation {
+
+/**
+ * Column buffers of one cell. Buffers are cleared but never shrunk, thus a
+ * visitor reusing one instance does not allocate after the largest cell was
+ * processed once.
+ */
+template <typename E>
+struct EntryColumns {
+  std::vector<E> entries;
+  std::vector<double> age;
+  std::vector<double> dist;
+  std::vector<double> rank;
+
+  void clear() {
+    entries.clear();
+    age.clear();
+    dist.clear();
+    rank.clear();
+  }
+  std::size_t size() const { return entries.size(); }
+};
+
+namespace detail {
+
+// ageDistRank() for i in [begin, n)
+inline void ageDistRankScalar(const double* age, const double* dist, double* rank,
+                              std::size_t begin, std::size_t n, double ageMin,
+                              double ageSum, double distSum, double alpha) {
+  const double beta = 1 - alpha;
+  const bool ageConst = ageSum == 0.0;
+  const bool distConst = distSum == 0.0;
+  for (std::size_t i = begin; i < n; ++i) {
+    double ageRank = ageConst ? 1.0 : (age[i] - ageMin) / ageSum;
+    double distRank = distConst ? 1.0 : dist[i] / distSum;
+    rank[i] = alpha * ageRank + beta * distRank;
+  }
+}
+
+#if CROWNET_AGGREGATION_AVX2
+// ageDistRank() for all complete blocks of 4. Returns the number of entries
+// done. Only call if hasAvx2().
+__attribute__((target("avx2"))) inline std::size_t ageDistRankAvx2(
+    const double* age, const double* dist, double* rank, std::size_t n,
+    double ageMin, double ageSum, double distSum, double alpha) {
+  const bool ageConst = ageSum == 0.0;
+  const bool distConst = distSum == 0.0;
+  const __m256d vOne = _mm256_set1_pd(1.0);
+  const __m256d vAlpha = _mm256_set1_pd(alpha);
+  const __m256d vBeta = _mm256_set1_pd(1 - alpha);
+  const __m256d vAgeMin = _mm256_set1_pd(ageMin);
+  const __m256d vAgeSum = _mm256_set1_pd(ageSum);
+  const __m256d vDistSum = _mm256_set1_pd(distSum);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d a = ageConst ? vOne
+                         : _mm256_div_pd(_mm256_sub_pd(_mm256_loadu_pd(age + i), vAgeMin),
+                                         vAgeSum);
+    __m256d d = distConst ? vOne : _mm256_div_pd(_mm256_loadu_pd(dist + i), vDistSum);
+    // no fused multiply-add to keep the rounding of the scalar code.
+    _mm256_storeu_pd(rank + i,
+                     _mm256_add_pd(_mm256_mul_pd(vAlpha, a), _mm256_mul_pd(vBeta, d)));
+  }
+  return i;
+}
+
+inline bool hasAvx2() {
+#if defined(__AVX2__)
+  return true;
+#else
+  static const bool ret = __builtin_cpu_supports("avx2");
+  return ret;
+#endif
+}
+#else
+inline bool hasAvx2() { return false; }
+#endif
+
+}  // namespace detail
+
+/**
+ * rank[i] = alpha * ageRank + (1 - alpha) * distRank with
+ *   ageRank  = (age[i] - ageMin) / ageSum  (1.0 if ageSum == 0)
+ *   distRank = dist[i] / distSum           (1.0 if distSum == 0)
+ */
+inline void ageDistRank(const double* age, const double* dist, double* rank,
+                        std::size_t n, double ageMin, double ageSum,
+                        double distSum, double alpha) {
+  std::size_t i = 0;
+#if CROWNET_AGGREGATION_AVX2
+  if (detail::hasAvx2()) {
+    i = detail::ageDistRankAvx2(age, dist, rank, n, ageMin, ageSum, distSum, alpha);
+  }
+#endif
+  detail::ageDistRankScalar(age, dist, rank, i, n, ageMin, ageSum, distSum, alpha);
+}
+
+/**
+ * Index of the first minimum (n if n == 0).
+ */
+inline std::size_t argMin(const double* v, std::size_t n) {
+  std::size_t ret = n;
+  double min = std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < n; ++i) {
+    if (ret == n || v[i] < min) {
+      min = v[i];
+      ret = i;
+    }
+  }
+  return ret;
+}
+
+/**
+ * Index of the first maximum (n if n == 0).
+ */
+inline std::size_t argMax(const double* v, std::size_t n) {
+  std::size_t ret = n;
+  double max = -std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < n; ++i) {
+    if (ret == n || v[i] > max) {
+      max = v[i];
+      ret = i;
+    }
+  }
+  return ret;
+}
+
+/**
+ * Median of v[0..n) (mean of both middle elements for even n). Reorders v.
+ * n must be > 0.
+ */
+inline double median(double* v, std::size_t n) {
+  double* upper = v + n / 2;
+  std::nth_element(v, upper, v + n);
+  if (n % 2 == 1) {
+    return *upper;
+  }
+  // all elements left of upper are <= *upper: the lower middle element is
+  // the largest of them.
+  double lower = *std::max_element(v, upper);
+  return (lower + *upper) / 2;
+}
+
+}  // namespace aggregation
+}  // namespace crownet
@@ -15,6 +15,8 @@
 #include <iterator>
 
 #include "crownet/common/Entry.h"
+#include "crownet/dcd/generic/CellStore.h"
+#include "crownet/dcd/generic/ValidCellIndex.h"
 #include "crownet/dcd/generic/iterator/CellDataIterator.h"
 #include "crownet/dcd/identifier/Identifiers.h"
 #include "crownet/dcd/identifier/TimeProvider.h"
@@ -43,10 +45,19 @@ namespace crownet {
  * Cell<C, N, T> provides common iterators (all, valid) and accepts
  * a couple of visitors to mutate and retrieve information.
  *
+ * The entries are kept in a CellStore. The storage backend (ordered tree
+ * or flat slab) is selected by the owning DcDMap on cell creation. New
+ * entries are allocated from the EntrySlabAllocator of the owning DcDMap (if any).
+ *
+ * Each Cell observes the entries put into it (see IEntryObserver) and
+ * keeps track of its valid entries. Changes of the resulting CellState are
+ * reported to the ValidCellIndex of the owning DcDMap. Copies of a Cell
+ * (i.e. copied out of a map) are detached snapshots and
+ * do not observe any entry.
  *
  */
 template <typename C, typename N, typename T>
-class Cell {
+class Cell : public IEntryObserver<N> {
  public:
   using cell_key_t = C;
   using node_key_t = N;
@@ -59,18 +70,25 @@ class Cell {
 //  using localEntry_t = ILocalEntry<node_key_t, time_t>; // the measurement created by the owner itself
 //  using localEntry_t_ptr = std::shared_ptr<localEntry_t>;
 
-  using map_t = std::map<node_key_t, entry_t_ptr>;
+  using map_t = CellStore<node_key_t, entry_t_ptr>;
   using value_type_const = typename map_t::value_type;
   using value_type = std::pair<node_key_t, entry_t_ptr>;
   //  using cell_type = std::pair<cell_key_t, entry_t_ptr>;
 
  public:
-  virtual ~Cell() = default;
+  virtual ~Cell();
   Cell() {}
   Cell(std::shared_ptr<TimeProvider<T>> timeProvider,
        cell_key_t cell_id,
-       node_key_t owner_id)
-      : timeProvider(timeProvider),cell_id(cell_id), owner_id(owner_id) {}
+       node_key_t owner_id,
+       CellStoreType storeType = CellStoreType::ORDERED,
+       std::shared_ptr<EntrySlabAllocator> entryAllocator = nullptr)
+      : timeProvider(timeProvider), data(storeType), cell_id(cell_id), owner_id(owner_id),
+        entryCtor(entryAllocator) {}
+  Cell(const Cell& other);
+  Cell(Cell&& other);
+  Cell& operator=(const Cell& other);
+  Cell& operator=(Cell&& other);
 
   // getter
   map_t& getData() { return data; }
@@ -79,6 +97,10 @@ class Cell {
   bool hasLocal() const;
   bool hasValid() const;
   bool hasValidLocal() const;
+  // tracked state (O(1)). Only entries added with put()/getOrCreate() are
+  // observed. Entries inserted directly into getData() are not tracked.
+  int validEntryCount() const { return validEntries; }
+  CellState getState() const;
   entry_t_ptr getLocal();
   entry_t_ptr getLocal() const;
 
@@ -106,9 +128,15 @@ class Cell {
   // setter
   void put(entry_t_ptr&& m);
   void put(entry_t_ptr& m);
-  void setCellId(cell_key_t _cell_id) { cell_id = _cell_id; }
+  void setCellId(cell_key_t _cell_id);
   void setOwnerId(node_key_t _owner_id) { owner_id = _owner_id; }
   void sentAt(const time_t& time);
+  // report state changes to index (nullptr to detach). order: see
+  // ValidCellIndex::slot_t
+  void setValidCellIndex(ValidCellIndex<C>* index, std::size_t order = 0);
+
+  // IEntryObserver
+  virtual void validityChanged(const node_key_t& source, const bool valid) override;
 
 
   /**
@@ -183,6 +211,19 @@ class Cell {
   entry_ctor_t entryCtor;
   entry_t_ptr cell_value;  //  selected or calculated value.
   time_t last_sent; // time at which the cell_value was last broadcasted.
+
+  // tracked state of the observed entries.
+  int validEntries = 0;
+  bool local = false;
+  bool validLocal = false;
+  ValidCellIndex<C>* validIndex = nullptr;
+  std::size_t indexOrder = 0;
+
+  void release();  // stop observing entries and leave index
+  void attach(entry_t_ptr& e);
+  void detach(entry_t_ptr& e);
+  void count(const node_key_t& source, const bool valid);
+  void stateChanged(const CellState& before);
 };
 
 #include "Cell.tcc"
@@ -17,6 +17,77 @@ std::ostream& operator<<(std::ostream& os, const Cell<C, N, T>& cell) {
   return os << cell.str();
 }
 
+template <typename C, typename N, typename T>
+Cell<C, N, T>::~Cell() {
+  // the index is owned by the map and might already be gone.
+  for (auto& e : this->data) {
+    if (e.second && e.second->getObserver() == this) e.second->setObserver(nullptr);
+  }
+}
+
+template <typename C, typename N, typename T>
+Cell<C, N, T>::Cell(const Cell<C, N, T>& other) {
+  *this = other;
+}
+
+template <typename C, typename N, typename T>
+Cell<C, N, T>::Cell(Cell<C, N, T>&& other) {
+  *this = std::move(other);
+}
+
+template <typename C, typename N, typename T>
+Cell<C, N, T>& Cell<C, N, T>::operator=(const Cell<C, N, T>& other) {
+  if (this == &other) return *this;
+  release();
+  this->timeProvider = other.timeProvider;
+  this->data = other.data;
+  this->cell_id = other.cell_id;
+  this->owner_id = other.owner_id;
+  this->entryCtor = other.entryCtor;
+  this->cell_value = other.cell_value;
+  this->last_sent = other.last_sent;
+  // detached snapshot: keep state but do not observe entries.
+  this->validEntries = other.validEntries;
+  this->local = other.local;
+  this->validLocal = other.validLocal;
+  return *this;
+}
+
+template <typename C, typename N, typename T>
+Cell<C, N, T>& Cell<C, N, T>::operator=(Cell<C, N, T>&& other) {
+  if (this == &other) return *this;
+  release();
+  this->timeProvider = std::move(other.timeProvider);
+  this->data = std::move(other.data);
+  this->cell_id = std::move(other.cell_id);
+  this->owner_id = std::move(other.owner_id);
+  this->entryCtor = std::move(other.entryCtor);
+  this->cell_value = std::move(other.cell_value);
+  this->last_sent = std::move(other.last_sent);
+  this->validEntries = other.validEntries;
+  this->local = other.local;
+  this->validLocal = other.validLocal;
+  this->validIndex = other.validIndex;
+  this->indexOrder = other.indexOrder;
+  // take over entries observed by other
+  for (auto& e : this->data) {
+    if (e.second && e.second->getObserver() == &other) e.second->setObserver(this);
+  }
+  other.validIndex = nullptr;
+  other.validEntries = 0;
+  other.local = false;
+  other.validLocal = false;
+  return *this;
+}
+
+template <typename C, typename N, typename T>
+void Cell<C, N, T>::release() {
+  for (auto& e : this->data) {
+    if (e.second && e.second->getObserver() == this) e.second->setObserver(nullptr);
+  }
+  setValidCellIndex(nullptr);
+}
+
 template <typename C, typename N, typename T>
 bool Cell<C, N, T>::operator<(const Cell<C, N, T>& rhs) const {
   return this->cell_id < rhs.cell_id ||
@@ -59,16 +130,95 @@ bool Cell<C, N, T>::hasValidLocal() const {
   return this->hasLocal() && getLocal()->valid();
 }
 
+template <typename C, typename N, typename T>
+CellState Cell<C, N, T>::getState() const {
+  CellState s;
+  s.local = this->local;
+  s.valid = this->validEntries > 0;
+  s.validLocal = this->validLocal;
+  return s;
+}
+
 template <typename C, typename N, typename T>
 void Cell<C, N, T>::put(entry_t_ptr&& m) {
-  auto& key = m->getSource();
-  this->data[key] = std::move(m);
+  entry_t_ptr e = std::move(m);
+  put(e);
 }
 
 template <typename C, typename N, typename T>
 void Cell<C, N, T>::put(entry_t_ptr& m) {
+  auto before = this->getState();
   auto& key = m->getSource();
-  this->data[key] = m;
+  auto iter = this->data.find(key);
+  if (iter == this->data.end()) {
+    iter = this->data.emplace(key, m).first;
+  } else {
+    this->detach(iter->second);
+    iter->second = m;
+  }
+  this->attach(iter->second);
+  this->stateChanged(before);
+}
+
+template <typename C, typename N, typename T>
+void Cell<C, N, T>::attach(entry_t_ptr& e) {
+  auto observer = e->getObserver();
+  if (observer == this) return;
+  if (observer) {
+    // entry moves to this cell. The previous cell must not count it anymore.
+    if (e->valid()) observer->validityChanged(e->getSource(), false);
+  }
+  e->setObserver(this);
+  if (e->getSource() == this->owner_id) this->local = true;
+  if (e->valid()) this->count(e->getSource(), true);
+}
+
+template <typename C, typename N, typename T>
+void Cell<C, N, T>::detach(entry_t_ptr& e) {
+  if (!e || e->getObserver() != this) return;
+  e->setObserver(nullptr);
+  if (e->valid()) this->count(e->getSource(), false);
+}
+
+template <typename C, typename N, typename T>
+void Cell<C, N, T>::count(const node_key_t& source, const bool valid) {
+  this->validEntries += valid ? 1 : -1;
+  if (source == this->owner_id) this->validLocal = valid;
+}
+
+template <typename C, typename N, typename T>
+void Cell<C, N, T>::validityChanged(const node_key_t& source, const bool valid) {
+  auto before = this->getState();
+  this->count(source, valid);
+  this->stateChanged(before);
+}
+
+template <typename C, typename N, typename T>
+void Cell<C, N, T>::stateChanged(const CellState& before) {
+  if (this->validIndex) {
+    auto after = this->getState();
+    if (before != after) this->validIndex->update({this->indexOrder, this->cell_id}, before, after);
+  }
+}
+
+template <typename C, typename N, typename T>
+void Cell<C, N, T>::setCellId(cell_key_t _cell_id) {
+  // the cell id is part of the index slot
+  auto index = this->validIndex;
+  setValidCellIndex(nullptr, this->indexOrder);
+  this->cell_id = _cell_id;
+  setValidCellIndex(index, this->indexOrder);
+}
+
+template <typename C, typename N, typename T>
+void Cell<C, N, T>::setValidCellIndex(ValidCellIndex<C>* index, std::size_t order) {
+  if (this->validIndex == index && this->indexOrder == order) return;
+  CellState empty;
+  auto state = this->getState();
+  if (this->validIndex) this->validIndex->update({this->indexOrder, this->cell_id}, state, empty);
+  this->validIndex = index;
+  this->indexOrder = order;
+  if (this->validIndex) this->validIndex->update({this->indexOrder, this->cell_id}, empty, state);
 }
 
 template <typename C, typename N, typename T>
@@ -85,11 +235,12 @@ template <typename C, typename N, typename T>
 template <typename E>
 std::shared_ptr<E> Cell<C, N, T>::get(
     const node_key_t node_id) {
-  if (!hasData(node_id))
+  auto iter = this->data.find(node_id);
+  if (iter == this->data.end())
     throw omnetpp::cRuntimeError("node_id %s not found in cell %s",
                                  node_id.str().c_str(),
                                  this->cell_id.str().c_str());
-  return std::dynamic_pointer_cast<E>(this->data[node_id]);
+  return std::dynamic_pointer_cast<E>(iter->second);
 }
 
 template <typename C, typename N, typename T>
@@ -116,15 +267,21 @@ std::shared_ptr<E> const Cell<C, N, T>::get() const {
 template <typename C, typename N, typename T>
 template <typename E>
 std::shared_ptr<E> Cell<C, N, T>::getOrCreate(const node_key_t node_id){
-    if (!hasData(node_id)){
-        auto e = std::make_shared<E>(0.0,
+    auto iter = this->data.find(node_id);
+    if (iter == this->data.end()){
+        auto e = makeSlabShared<E>(this->entryCtor.getAllocator(),
+                0.0,
                 timeProvider->now(),
                 timeProvider->now(),
                 node_id
                 );
-        this->data[node_id] = e;
+        auto before = this->getState();
+        auto inserted = this->data.emplace(node_id, e).first;
+        this->attach(inserted->second);
+        this->stateChanged(before);
+        return e;
     }
-    return get<E>(node_id);
+    return std::dynamic_pointer_cast<E>(iter->second);
 }
 template <typename C, typename N, typename T>
 template <typename E>
@@ -200,7 +357,7 @@ template <typename Fn>
 void Cell<C, N, T>::computeValue(const Fn computeAlg) {
   // 1 clear selection flag on all entries
   for(auto & e : this->data){
-      e.second->setSelectedIn("");
+      e.second->setSelectionId(0);
       e.second->setSelectionRank(std::numeric_limits<double>::max());
   }
 
@@ -13,6 +13,11 @@ class DcDMap;
 template <typename C, typename N, typename T>
 class Cell;
 
+/**
+ * Cells newest first, then round robin. hasNext() and size() check the cells
+ * on each call (size: O(valid cells)). The "default" stream type uses
+ * SendStateCellIdStream (ROUND_ROBIN) which yields the same order.
+ */
 template <typename C, typename N, typename T>
 class InsertionOrderedCellIdStream : public ICellIdStream<C, N, T> {
 public:
@@ -30,6 +35,7 @@ public:
 
     virtual const cell_key_t nextCellId(const time_t& now) override;
     virtual Cell& nextCell(const time_t& now) override;
+    virtual std::vector<cell_key_t> peekCellIds(const time_t& now, const int maxCount) override;
     virtual const int size(const time_t& now) const override;
 
 
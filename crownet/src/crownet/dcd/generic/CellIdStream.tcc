@@ -14,8 +14,7 @@ const bool InsertionOrderedCellIdStream<C, N, T>::hasNext(const time_t& now) {
 
    for(int i=0; i < this->queue.size(); i++) {
 
-       auto id = this->queue.front();
-       auto cell = this->map->getCell(id);
+       const auto& cell = this->map->getCell(this->queue.front());
 
        if (cell.lastSent() >= now){
            // all cells were sent at this time point.
@@ -68,13 +67,33 @@ InsertionOrderedCellIdStream<C, N, T>::nextCell(const time_t& now){
     return map->getCell(id);
 }
 
+template <typename C, typename N, typename T>
+std::vector<typename InsertionOrderedCellIdStream<C, N, T>::cell_key_t>
+InsertionOrderedCellIdStream<C, N, T>::peekCellIds(const time_t& now, const int maxCount){
+    std::vector<cell_key_t> ret;
+    for (const auto& id : this->queue){
+        if ((int)ret.size() >= maxCount){
+            break;
+        }
+        const auto& cell = this->map->getCell(id);
+        if (cell.lastSent() >= now){
+            // same as hasNext(): all following cells were sent at this time point.
+            break;
+        }
+        if (cell.hasValid() && cell.val() && cell.val()->valid()){
+            ret.push_back(id);
+        }
+    }
+    return ret;
+}
+
 template <typename C, typename N, typename T>
 const int InsertionOrderedCellIdStream<C, N, T>::size(const time_t& now) const {
+    // only cells with at least one valid entry can be sent (see ValidCellIndex)
     int count = 0;
-    for(const auto &p : *map){
+    for(const auto &p : map->valid()){
         const auto &cell = p.second;
         if (cell.lastSent() < now && // cell was not already sent
-                cell.hasValid() && // cell has at least on valid entry
                 cell.val() &&  // cell has an selected/calculated
                 cell.val()->valid()){ // cell has an selected/calculated and its valid
             count++;
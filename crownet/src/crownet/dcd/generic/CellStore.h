@@ -0,0 +1,174 @@
+/*
+ * CellStore.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace crownet {
+
+/**
+ * Storage backend used by CellStore.
+ *
+ * ORDERED  std::map based tree. Iteration is sorted by key. (default)
+ * FLAT     contiguous slab with an open-addressed hash index. Iteration
+ *          follows insertion order and touches the elements linearly.
+ */
+enum class CellStoreType { ORDERED, FLAT };
+
+/**
+ * Associative container used by DcDMap (cells) and Cell (entries).
+ *
+ * The interface mirrors the subset of std::map used within the dcd package
+ * (value_type = std::pair<const K, V>, find, operator[], emplace, ...) such
+ * that iterators and visitors work unchanged for both backends.
+ *
+ * The FLAT backend stores all elements in a chunked slab. Chunks grow
+ * geometrically and are never moved, thus references and pointers to
+ * elements stay valid for the lifetime of the container (same guarantee
+ * as std::map). Lookups use linear probing over a power-of-two index which
+ * is only build once the container holds more than LINEAR_SCAN_LIMIT
+ * elements. Smaller containers (i.e. the entries of a single cell) are
+ * scanned linearly. Elements cannot be removed individually.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>>
+class CellStore {
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<const K, V>;
+  using size_type = std::size_t;
+  using tree_t = std::map<K, V>;
+
+  static constexpr size_type FIRST_CHUNK_SIZE = 4;
+  static constexpr size_type LINEAR_SCAN_LIMIT = 8;
+
+  template <bool Const>
+  class Iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename CellStore::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = typename std::conditional<Const, const value_type*, value_type*>::type;
+    using reference = typename std::conditional<Const, const value_type&, value_type&>::type;
+    using store_ptr = typename std::conditional<Const, const CellStore*, CellStore*>::type;
+    using tree_iter = typename std::conditional<Const, typename tree_t::const_iterator,
+                                                typename tree_t::iterator>::type;
+
+    Iterator() : store(nullptr), treeIter(), pos(0) {}
+    Iterator(store_ptr store, tree_iter treeIter, size_type pos)
+        : store(store), treeIter(treeIter), pos(pos) {}
+    // allow iterator -> const_iterator conversion
+    template <bool C = Const, typename = typename std::enable_if<C>::type>
+    Iterator(const Iterator<false>& other)
+        : store(other.store), treeIter(other.treeIter), pos(other.pos) {}
+
+    reference operator*() const {
+      return store->_type == CellStoreType::ORDERED ? *treeIter : store->at(pos);
+    }
+    pointer operator->() const { return &operator*(); }
+    Iterator& operator++() {
+      if (store->_type == CellStoreType::ORDERED) {
+        ++treeIter;
+      } else {
+        ++pos;
+      }
+      return *this;
+    }
+    Iterator operator++(int) {
+      Iterator tmp(*this);
+      operator++();
+      return tmp;
+    }
+    bool operator==(const Iterator& rhs) const {
+      if (store != rhs.store) return false;
+      if (store == nullptr) return true;
+      return store->_type == CellStoreType::ORDERED ? treeIter == rhs.treeIter : pos == rhs.pos;
+    }
+    bool operator!=(const Iterator& rhs) const { return !operator==(rhs); }
+
+   private:
+    friend class CellStore;
+    friend class Iterator<!Const>;
+    store_ptr store;
+    tree_iter treeIter;  // ORDERED
+    size_type pos;       // FLAT
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+ public:
+  explicit CellStore(CellStoreType type = CellStoreType::ORDERED) : _type(type) {}
+  CellStore(const CellStore& other);
+  CellStore(CellStore&& other) noexcept;
+  CellStore& operator=(const CellStore& other);
+  CellStore& operator=(CellStore&& other) noexcept;
+  ~CellStore() { clear(); }
+
+  CellStoreType type() const { return _type; }
+
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  size_type size() const;
+  bool empty() const { return size() == 0; }
+  size_type count(const K& key) const { return find(key) != end() ? 1 : 0; }
+
+  iterator find(const K& key);
+  const_iterator find(const K& key) const;
+
+  V& operator[](const K& key);
+
+  /**
+   * Same semantic as std::map::emplace. Arguments are used to construct a
+   * value_type. If the key already exists the existing element is returned.
+   */
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+
+  /**
+   * Prepare the FLAT backend for at least n elements. No-op for ORDERED.
+   */
+  void reserve(size_type n);
+  void clear();
+  void swap(CellStore& other) noexcept;
+
+ private:
+  value_type& at(size_type pos);
+  const value_type& at(size_type pos) const;
+  value_type* allocate();  // raw slot at position _size
+  size_type findPos(const K& key) const;  // FLAT; npos if missing
+  void indexInsert(size_type pos);
+  void rebuildIndex(size_type capacity);
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+  static constexpr std::uint32_t EMPTY_SLOT = 0;
+
+ private:
+  CellStoreType _type;
+  tree_t tree;
+
+  // FLAT backend: chunk k holds FIRST_CHUNK_SIZE << k elements.
+  std::vector<value_type*> chunks;
+  std::vector<std::uint32_t> index;  // slab position + 1, EMPTY_SLOT if unused
+  size_type _size = 0;
+  Hash hash;
+};
+
+#include "crownet/dcd/generic/CellStore.tcc"
+
+}  // namespace crownet
@@ -0,0 +1,231 @@
+/*
+ * CellStore.tcc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+#include "crownet/dcd/generic/CellStore.h"
+
+#include <new>
+#include <tuple>
+
+template <typename K, typename V, typename H>
+constexpr typename CellStore<K, V, H>::size_type CellStore<K, V, H>::FIRST_CHUNK_SIZE;
+template <typename K, typename V, typename H>
+constexpr typename CellStore<K, V, H>::size_type CellStore<K, V, H>::LINEAR_SCAN_LIMIT;
+template <typename K, typename V, typename H>
+constexpr typename CellStore<K, V, H>::size_type CellStore<K, V, H>::npos;
+template <typename K, typename V, typename H>
+constexpr std::uint32_t CellStore<K, V, H>::EMPTY_SLOT;
+
+template <typename K, typename V, typename H>
+CellStore<K, V, H>::CellStore(const CellStore& other) : _type(other._type), hash(other.hash) {
+  if (_type == CellStoreType::ORDERED) {
+    tree = other.tree;
+  } else {
+    reserve(other._size);
+    for (const auto& e : other) {
+      new (allocate()) value_type(e);
+      indexInsert(_size++);
+    }
+  }
+}
+
+template <typename K, typename V, typename H>
+CellStore<K, V, H>::CellStore(CellStore&& other) noexcept : _type(other._type) {
+  swap(other);
+}
+
+template <typename K, typename V, typename H>
+CellStore<K, V, H>& CellStore<K, V, H>::operator=(const CellStore& other) {
+  if (this != &other) {
+    CellStore tmp(other);
+    swap(tmp);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename H>
+CellStore<K, V, H>& CellStore<K, V, H>::operator=(CellStore&& other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename K, typename V, typename H>
+void CellStore<K, V, H>::swap(CellStore& other) noexcept {
+  std::swap(_type, other._type);
+  tree.swap(other.tree);
+  chunks.swap(other.chunks);
+  index.swap(other.index);
+  std::swap(_size, other._size);
+  std::swap(hash, other.hash);
+}
+
+template <typename K, typename V, typename H>
+typename CellStore<K, V, H>::iterator CellStore<K, V, H>::begin() {
+  return iterator(this, tree.begin(), 0);
+}
+
+template <typename K, typename V, typename H>
+typename CellStore<K, V, H>::iterator CellStore<K, V, H>::end() {
+  return iterator(this, tree.end(), _size);
+}
+
+template <typename K, typename V, typename H>
+typename CellStore<K, V, H>::const_iterator CellStore<K, V, H>::begin() const {
+  return const_iterator(this, tree.cbegin(), 0);
+}
+
+template <typename K, typename V, typename H>
+typename CellStore<K, V, H>::const_iterator CellStore<K, V, H>::end() const {
+  return const_iterator(this, tree.cend(), _size);
+}
+
+template <typename K, typename V, typename H>
+typename CellStore<K, V, H>::size_type CellStore<K, V, H>::size() const {
+  return _type == CellStoreType::ORDERED ? tree.size() : _size;
+}
+
+template <typename K, typename V, typename H>
+typename CellStore<K, V, H>::value_type& CellStore<K, V, H>::at(size_type pos) {
+  // chunk k starts at FIRST_CHUNK_SIZE * (2^k - 1)
+  const size_type q = pos / FIRST_CHUNK_SIZE + 1;
+  size_type k = 0;
+  while ((q >> (k + 1)) != 0) ++k;
+  const size_type offset = pos - FIRST_CHUNK_SIZE * ((size_type(1) << k) - 1);
+  return chunks[k][offset];
+}
+
+template <typename K, typename V, typename H>
+const typename CellStore<K, V, H>::value_type& CellStore<K, V, H>::at(size_type pos) const {
+  return const_cast<CellStore<K, V, H>*>(this)->at(pos);
+}
+
+template <typename K, typename V, typename H>
+typename CellStore<K, V, H>::value_type* CellStore<K, V, H>::allocate() {
+  const size_type capacity = FIRST_CHUNK_SIZE * ((size_type(1) << chunks.size()) - 1);
+  if (_size == capacity) {
+    const size_type n = FIRST_CHUNK_SIZE << chunks.size();
+    chunks.push_back(static_cast<value_type*>(::operator new(n * sizeof(value_type))));
+  }
+  return &at(_size);
+}
+
+template <typename K, typename V, typename H>
+typename CellStore<K, V, H>::size_type CellStore<K, V, H>::findPos(const K& key) const {
+  if (index.empty()) {
+    for (size_type pos = 0; pos < _size; ++pos) {
+      if (at(pos).first == key) return pos;
+    }
+    return npos;
+  }
+  const size_type mask = index.size() - 1;
+  for (size_type slot = hash(key) & mask;; slot = (slot + 1) & mask) {
+    const std::uint32_t e = index[slot];
+    if (e == EMPTY_SLOT) return npos;
+    if (at(e - 1).first == key) return e - 1;
+  }
+}
+
+template <typename K, typename V, typename H>
+void CellStore<K, V, H>::indexInsert(size_type pos) {
+  // pos < _size, i.e. the element is already part of the slab.
+  if (index.empty()) {
+    if (_size > LINEAR_SCAN_LIMIT) rebuildIndex(4 * LINEAR_SCAN_LIMIT);
+    return;
+  }
+  if (2 * _size > index.size()) {  // keep load factor <= 0.5
+    rebuildIndex(2 * index.size());
+    return;
+  }
+  const size_type mask = index.size() - 1;
+  size_type slot = hash(at(pos).first) & mask;
+  while (index[slot] != EMPTY_SLOT) slot = (slot + 1) & mask;
+  index[slot] = static_cast<std::uint32_t>(pos + 1);
+}
+
+template <typename K, typename V, typename H>
+void CellStore<K, V, H>::rebuildIndex(size_type capacity) {
+  size_type c = 1;
+  while (c < capacity) c <<= 1;
+  index.assign(c, EMPTY_SLOT);
+  const size_type mask = c - 1;
+  for (size_type pos = 0; pos < _size; ++pos) {
+    size_type slot = hash(at(pos).first) & mask;
+    while (index[slot] != EMPTY_SLOT) slot = (slot + 1) & mask;
+    index[slot] = static_cast<std::uint32_t>(pos + 1);
+  }
+}
+
+template <typename K, typename V, typename H>
+typename CellStore<K, V, H>::iterator CellStore<K, V, H>::find(const K& key) {
+  if (_type == CellStoreType::ORDERED) {
+    return iterator(this, tree.find(key), 0);
+  }
+  const size_type pos = findPos(key);
+  return iterator(this, tree.end(), pos == npos ? _size : pos);
+}
+
+template <typename K, typename V, typename H>
+typename CellStore<K, V, H>::const_iterator CellStore<K, V, H>::find(const K& key) const {
+  return const_iterator(const_cast<CellStore<K, V, H>*>(this)->find(key));
+}
+
+template <typename K, typename V, typename H>
+V& CellStore<K, V, H>::operator[](const K& key) {
+  if (_type == CellStoreType::ORDERED) {
+    return tree[key];
+  }
+  return emplace(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple())
+      .first->second;
+}
+
+template <typename K, typename V, typename H>
+template <typename... Args>
+std::pair<typename CellStore<K, V, H>::iterator, bool> CellStore<K, V, H>::emplace(Args&&... args) {
+  if (_type == CellStoreType::ORDERED) {
+    auto ret = tree.emplace(std::forward<Args>(args)...);
+    return std::make_pair(iterator(this, ret.first, 0), ret.second);
+  }
+  // construct in place at the end of the slab and drop it again if the key exists.
+  value_type* e = new (allocate()) value_type(std::forward<Args>(args)...);
+  const size_type existing = findPos(e->first);
+  if (existing != npos) {
+    e->~value_type();
+    return std::make_pair(iterator(this, tree.end(), existing), false);
+  }
+  const size_type pos = _size++;
+  indexInsert(pos);
+  return std::make_pair(iterator(this, tree.end(), pos), true);
+}
+
+template <typename K, typename V, typename H>
+void CellStore<K, V, H>::reserve(size_type n) {
+  if (_type == CellStoreType::ORDERED) return;
+  while (FIRST_CHUNK_SIZE * ((size_type(1) << chunks.size()) - 1) < n) {
+    const size_type c = FIRST_CHUNK_SIZE << chunks.size();
+    chunks.push_back(static_cast<value_type*>(::operator new(c * sizeof(value_type))));
+  }
+  if (n > LINEAR_SCAN_LIMIT && index.size() < 2 * n) {
+    rebuildIndex(2 * n);
+  }
+}
+
+template <typename K, typename V, typename H>
+void CellStore<K, V, H>::clear() {
+  tree.clear();
+  for (size_type pos = 0; pos < _size; ++pos) {
+    at(pos).~value_type();
+  }
+  for (auto chunk : chunks) {
+    ::operator delete(chunk);
+  }
+  chunks.clear();
+  index.clear();
+  _size = 0;
+}
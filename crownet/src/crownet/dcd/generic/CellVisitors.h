@@ -243,7 +243,7 @@ public:
     CellAggregationAlgorihm(typename C::time_t time, typename CellDataIterator<C>::pred_t&& pred): TimestampedGetCellVisitor<C>(time, pred) {} //allow move
 
     static const bool COPY_TRUE = true;
-    static const bool COPY_FALSE = true;
+    static const bool COPY_FALSE = false;
 public:
 
     virtual typename C::entry_t_ptr update_selection(typename C::entry_t_ptr val, bool copy = true) const{
@@ -9,6 +9,7 @@
 
 #include "crownet/dcd/generic/Cell.h"
 #include "crownet/dcd/generic/CellVisitors.h"  // *.tcc
+#include "crownet/dcd/generic/ValidCellIndex.h"
 #include "crownet/dcd/generic/iterator/DcDMapIterator.h"
 #include "crownet/dcd/identifier/CellKeyProvider.h"
 #include "crownet/dcd/identifier/TimeProvider.h"
@@ -24,7 +25,7 @@ class DcDMap {
   using time_t = T;
   using cell_t = Cell<cell_key_t, node_key_t, time_t>;
 
-  using map_t = std::map<cell_key_t, cell_t>;
+  using map_t = CellStore<cell_key_t, cell_t>;
   using cell_value_type_const = typename map_t::value_type;
   using cell_value_type = std::pair<node_key_t, cell_value_type_const>;
 
@@ -34,13 +35,21 @@ class DcDMap {
   DcDMap(node_key_t owner_id,
          std::shared_ptr<CellKeyProvider<C>> cellKeyProvider,
          std::shared_ptr<TimeProvider<T>> timeProvider,
-         std::shared_ptr<ICellIdStream<C, N, T>> cellKeyStream)
-      : owner_id(owner_id),
+         std::shared_ptr<ICellIdStream<C, N, T>> cellKeyStream,
+         CellStoreType storeType = CellStoreType::ORDERED)
+      : cells(storeType),
+        owner_id(owner_id),
         cellKeyProvider(cellKeyProvider),
         timeProvider(timeProvider),
-        cellKeyStream(cellKeyStream){
+        cellKeyStream(cellKeyStream),
+        entryAllocator(std::make_shared<EntrySlabAllocator>()){
       this->cellKeyStream->setMap(this);
   }
+  // Cells report to the ValidCellIndex of this map and entries are observed
+  // by their cells. A map can be moved but not copied.
+  DcDMap(DcDMap&& other);
+  DcDMap(const DcDMap& other) = delete;
+  DcDMap& operator=(const DcDMap& other) = delete;
 
   // getter
   const node_key_t& getOwnerId() const { return owner_id; }
@@ -54,6 +63,9 @@ class DcDMap {
   std::shared_ptr<CellKeyProvider<C>> getCellKeyProvider() const;
   std::map<node_key_t, cell_key_t>& getNeighborhood();
   time_t getLastComputedAt() const {return lastComputedAt;}
+  CellStoreType getCellStoreType() const { return cells.type(); }
+  // allocator for all entries created by this map (might be nullptr)
+  std::shared_ptr<EntrySlabAllocator> getEntryAllocator() const { return entryAllocator; }
 
   // getter/setter (create if missing)
   cell_t& getCell(const cell_key_t& cell_id);
@@ -94,9 +106,13 @@ class DcDMap {
   DcDMapIterator<DcDMap<C, N, T>> allLocal() const;
   DcDMapIterator<DcDMap<C, N, T>> valid();
   DcDMapIterator<DcDMap<C, N, T>> valid() const;
+  // O(1) based on the ValidCellIndex. The iterators above visit only the
+  // cells in the index (O(matching cells) lookups). Changing the state of a
+  // cell while iterating invalidates the iterator.
   const int validCellCount() const;
   const int validLocalCellCount() const;
   const int allLocalCellCount() const;
+  const ValidCellIndex<C>& getValidCellIndex() const { return validIndex; }
 
 
   // accept only pointer and reference to visitors (avoid copy)
@@ -106,6 +122,13 @@ class DcDMap {
   void visitCells(Fn& visitor);
   template <typename Fn>
   void visitCells(Fn&& visitor);
+  // same as visitCells/computeValues but with explicit time instead of
+  // timeProvider. Does not access the simulation kernel, thus usable from
+  // worker threads (see GlobalDensityMap::updateDezentralMaps).
+  template <typename Fn>
+  void visitCellsAt(Fn& visitor, const T& now);
+  template <typename Fn>
+  void computeValuesAt(Fn visitor, const T& now);
 
 
   template <typename Fn>
@@ -126,6 +149,9 @@ class DcDMap {
   std::shared_ptr<CellKeyProvider<C>> cellKeyProvider;
   std::shared_ptr<TimeProvider<T>> timeProvider;
   std::shared_ptr<ICellIdStream<C, N, T>> cellKeyStream;
+  std::shared_ptr<EntrySlabAllocator> entryAllocator;
+  ValidCellIndex<C> validIndex;
+  std::size_t indexOrder(std::size_t insertPos) const;  // see ValidCellIndex::slot_t
 
  public:
 
@@ -9,6 +9,26 @@
 #include "crownet/dcd/generic/DcdMap.h"
 #include "crownet/dcd/common/Visitor_check.h"
 
+template <typename C, typename N, typename T>
+DcDMap<C, N, T>::DcDMap(DcDMap<C, N, T>&& other)
+    : cells(std::move(other.cells)),
+      owner_id(std::move(other.owner_id)),
+      owner_cell(std::move(other.owner_cell)),
+      lastComputedAt(std::move(other.lastComputedAt)),
+      cellKeyProvider(std::move(other.cellKeyProvider)),
+      timeProvider(std::move(other.timeProvider)),
+      cellKeyStream(std::move(other.cellKeyStream)),
+      entryAllocator(std::move(other.entryAllocator)),
+      validIndex(),
+      neighborhood(std::move(other.neighborhood)) {
+  // cells keep their address (CellStore move) but must report to this index.
+  std::size_t order = 0;
+  for (auto& e : this->cells) {
+    e.second.setValidCellIndex(&this->validIndex, indexOrder(order++));
+  }
+  if (this->cellKeyStream) this->cellKeyStream->setMap(this);
+}
+
 template <typename C, typename N, typename T>
 const typename DcDMap<C, N, T>::map_t::iterator DcDMap<C, N, T>::begin() const {
   return const_cast<DcDMap<C, N, T>*>(this)->cells.begin();
@@ -19,6 +39,12 @@ const typename DcDMap<C, N, T>::map_t::iterator DcDMap<C, N, T>::end() const {
   return const_cast<DcDMap<C, N, T>*>(this)->cells.end();
 }
 
+template <typename C, typename N, typename T>
+std::size_t DcDMap<C, N, T>::indexOrder(std::size_t insertPos) const {
+  // FLAT iterates in insertion order, ORDERED by cell id.
+  return this->cells.type() == CellStoreType::FLAT ? insertPos : 0;
+}
+
 template <typename C, typename N, typename T>
 DcDMapIterator<DcDMap<C, N, T>> DcDMap<C, N, T>::validLocal() {
   return DcDMapIterator<DcDMap<C, N, T>>::ValidLocalCellIter(this);
@@ -51,32 +77,17 @@ DcDMapIterator<DcDMap<C, N, T>> DcDMap<C, N, T>::valid() const {
 
 template <typename C, typename N, typename T>
 const int DcDMap<C, N, T>::validCellCount() const{
-    auto iter = valid();
-    int i=0;
-    for(const auto& e: iter){++i;}
-    return i;
+    return this->validIndex.validCellCount();
 }
 
 template <typename C, typename N, typename T>
 const int DcDMap<C, N, T>::validLocalCellCount() const{
-    auto iter = validLocal();
-    int i=0;
-    while(iter != iter.end()){
-        ++i;
-        ++iter;
-    }
-    return i;
+    return this->validIndex.validLocalCellCount();
 }
 
 template <typename C, typename N, typename T>
 const int DcDMap<C, N, T>::allLocalCellCount() const{
-    auto iter = allLocal();
-    int i=0;
-    while(iter != iter.end()){
-        ++i;
-        ++iter;
-    }
-    return i;
+    return this->validIndex.localCellCount();
 }
 
 
@@ -114,11 +125,16 @@ void DcDMap<C, N, T>::visitCells(Fn* visitor) {
 template <typename C, typename N, typename T>
 template <typename Fn>
 void DcDMap<C, N, T>::visitCells(Fn& visitor) {
+  visitCellsAt(visitor, this->timeProvider->now());
+}
+template <typename C, typename N, typename T>
+template <typename Fn>
+void DcDMap<C, N, T>::visitCellsAt(Fn& visitor, const T& now) {
 
   for (auto& entry : this->cells) {
     entry.second.acceptSet(visitor);
   }
-  setTimeIfIdempotenceVisitor(visitor, this->timeProvider->now(), 0);
+  setTimeIfIdempotenceVisitor(visitor, now, 0);
 
 }
 template <typename C, typename N, typename T>
@@ -130,13 +146,19 @@ void DcDMap<C, N, T>::visitCells(Fn&& visitor) {
 template <typename C, typename N, typename T>
 template <typename Fn>
 void DcDMap<C, N, T>::computeValues(Fn visitor) {
+  computeValuesAt(visitor, this->timeProvider->now());
+}
+
+template <typename C, typename N, typename T>
+template <typename Fn>
+void DcDMap<C, N, T>::computeValuesAt(Fn visitor, const T& now) {
   // only compute values if needed. Ensure that first computation ( lastComputedAt == ZERO) takes place
-  if (lastComputedAt < this->timeProvider->now() || lastComputedAt == this->timeProvider->zero()) {
+  if (lastComputedAt < now || lastComputedAt == this->timeProvider->zero()) {
     for (auto& entry : this->cells) {
       entry.second.computeValue(visitor);
     }
-    setTimeIfIdempotenceVisitor(visitor, this->timeProvider->now(), 0);
-    lastComputedAt = this->timeProvider->now();
+    setTimeIfIdempotenceVisitor(visitor, now, 0);
+    lastComputedAt = now;
   }
 }
 
@@ -189,8 +211,9 @@ std::string DcDMap<C, N, T>::strFull() const {
 template <typename C, typename N, typename T>
 typename DcDMap<C, N, T>::cell_t& DcDMap<C, N, T>::getCell(
     const cell_key_t& cell_id) {
-  if (!hasCell(cell_id)) return this->createCell(cell_id);
-  return this->cells[cell_id];
+  auto iter = this->cells.find(cell_id);
+  if (iter == this->cells.end()) return this->createCell(cell_id);
+  return iter->second;
 }
 
 template <typename C, typename N, typename T>
@@ -199,14 +222,18 @@ typename DcDMap<C, N, T>::cell_t& DcDMap<C, N, T>::createCell(
   auto entry = this->cells.emplace(
       std::piecewise_construct,
       std::forward_as_tuple(cell_id),
-      std::forward_as_tuple(cell_t(
+      std::forward_as_tuple(
               timeProvider,
               cell_id,
-              this->getOwnerId()
-              )
+              this->getOwnerId(),
+              this->cells.type(),
+              this->entryAllocator
       )
   );
-  this->cellKeyStream->addNew(cell_id, this->timeProvider->now());
+  if (entry.second){
+      entry.first->second.setValidCellIndex(&this->validIndex, indexOrder(this->cells.size() - 1));
+      this->cellKeyStream->addNew(cell_id, this->timeProvider->now());
+  }
   return entry.first->second;
 }
 
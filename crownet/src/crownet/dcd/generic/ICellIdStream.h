@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <vector>
+
 namespace crownet {
 
 template <typename C, typename N, typename T>
@@ -38,11 +40,11 @@ public:
     virtual const cell_key_t nextCellId(const time_t& now) = 0;
     virtual Cell& nextCell(const time_t& now) = 0;
 
-//    /**
-//     * return first element of stream.  If hasNext() returns false this method throws an exception.
-//     */
-//    virtual const cell_key_t peekCellId() = 0;
-//    virtual CellPtr peekCell() = 0;
+    /**
+     * Return up to maxCount cellIds in the order nextCellId() would return them
+     * without consuming them (i.e. the stream order is not changed).
+     */
+    virtual std::vector<cell_key_t> peekCellIds(const time_t& now, const int maxCount) = 0;
 
     virtual void update(const time_t& time) = 0;
 
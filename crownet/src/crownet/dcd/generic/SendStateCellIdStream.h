@@ -0,0 +1,123 @@
+/*
+ * SendStateCellIdStream.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <omnetpp/cexception.h>
+#include "crownet/dcd/generic/ICellIdStream.h"
+
+namespace crownet {
+
+template <typename C, typename N, typename T>
+class DcDMap;
+
+template <typename C, typename N, typename T>
+class Cell;
+
+/**
+ * Order in which a size limited packet takes the sendable cells.
+ *
+ * ROUND_ROBIN:          new cells first (newest first), then continue after the
+ *                       last cell sent. Same order of valid cells as
+ *                       InsertionOrderedCellIdStream.
+ * OLDEST_SENT_FIRST:    cells not sent for the longest time first.
+ * HIGHEST_CHANGE_FIRST: largest count difference to the last sent value first.
+ *                       Cells never sent count as infinite change.
+ *
+ * Ties are resolved in ROUND_ROBIN order.
+ */
+enum class CellIdStreamPolicy {
+    ROUND_ROBIN,
+    OLDEST_SENT_FIRST,
+    HIGHEST_CHANGE_FIRST
+};
+
+/**
+ * Cell id stream without cell copies. The sendable cells (valid value, not
+ * sent at now) are collected once per value computation of the map
+ * (DcDMap::getLastComputedAt) and time step. After that
+ *
+ *   hasNext / nextCellId:  amortized O(1) (ROUND_ROBIN) or O(log n)
+ *   size:                  O(1)
+ *   peekCellIds(k):        O(k) (ROUND_ROBIN) or O(k log n)
+ *
+ * Cells which became unsendable after the snapshot (e.g. sent or invalid) are
+ * skipped by hasNext and peekCellIds. size() is based on the snapshot.
+ */
+template <typename C, typename N, typename T>
+class SendStateCellIdStream : public ICellIdStream<C, N, T> {
+public:
+    using cell_key_t = C;
+    using node_key_t = N;
+    using time_t = T;
+    using dMapPtr = DcDMap<C, N, T>*;
+    using Cell = Cell<C, N, T>;
+
+    SendStateCellIdStream(CellIdStreamPolicy policy = CellIdStreamPolicy::ROUND_ROBIN)
+        : policy(policy) {}
+
+    virtual void addNew(const cell_key_t& cellId, const time_t& time) override;
+
+    virtual void setMap(dMapPtr map) override {this->map = map;}
+
+    virtual const bool hasNext(const time_t& now) override;
+
+    virtual const cell_key_t nextCellId(const time_t& now) override;
+    virtual Cell& nextCell(const time_t& now) override;
+    virtual std::vector<cell_key_t> peekCellIds(const time_t& now, const int maxCount) override;
+    virtual const int size(const time_t& now) const override;
+
+    virtual void update(const time_t& time) override {/*nothing*/};
+
+    CellIdStreamPolicy getPolicy() const {return policy;}
+
+protected:
+    struct SendState {
+        cell_key_t id;
+        double lastSentCount;   // NaN: never sent
+    };
+    struct Candidate {
+        int index;      // into cells
+        int rank;       // position in ring
+        time_t lastSent;
+        double change;
+    };
+
+    bool sendable(const Cell& cell, const time_t& now) const;
+    void refresh(const time_t& now) const;
+    // sort ready up to position end (exclusive). ROUND_ROBIN is already sorted.
+    void sortTo(int end) const;
+    bool before(const Candidate& a, const Candidate& b) const;
+
+protected:
+    CellIdStreamPolicy policy;
+    dMapPtr map = nullptr;
+
+    // all cell ids in insertion order
+    std::vector<SendState> cells;
+    // ROUND_ROBIN order of all cells known at the last snapshot (index into
+    // cells). The next snapshot starts at ringPos.
+    mutable std::vector<int> ring;
+    mutable std::vector<int> ringNext;
+    mutable int ringPos = 0;
+    mutable int firstSentRank = -1; // first cell taken from this snapshot
+
+    // snapshot (refreshed on first access per time step/value computation)
+    mutable std::vector<Candidate> ready;
+    mutable int cursor = 0;
+    mutable int sortedEnd = 0;
+    mutable bool hasSnapshot = false;
+    mutable time_t snapshotTime;
+    mutable time_t snapshotComputedAt;
+};
+
+#include "SendStateCellIdStream.tcc"
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include "crownet/dcd/generic/SendStateCellIdStream.h"
+#include <omnetpp/cexception.h>
+
+
+template <typename C, typename N, typename T>
+void SendStateCellIdStream<C, N, T>::addNew(const cell_key_t& cellId, const time_t& time){
+    this->cells.push_back(SendState{cellId, std::numeric_limits<double>::quiet_NaN()});
+}
+
+template <typename C, typename N, typename T>
+bool SendStateCellIdStream<C, N, T>::sendable(const Cell& cell, const time_t& now) const {
+    return cell.lastSent() < now && // cell was not already sent
+            cell.hasValid() && // cell has at least on valid entry
+            cell.val() &&  // cell has an selected/calculated
+            cell.val()->valid(); // cell has an selected/calculated and its valid
+}
+
+template <typename C, typename N, typename T>
+void SendStateCellIdStream<C, N, T>::refresh(const time_t& now) const {
+    if (this->hasSnapshot && this->snapshotTime == now
+            && this->snapshotComputedAt == this->map->getLastComputedAt()){
+        return;
+    }
+    // new cells first (newest first), then the ring starting after the last
+    // cell sent.
+    this->ringNext.clear();
+    for (int i = (int)this->cells.size() - 1; i >= (int)this->ring.size(); i--){
+        this->ringNext.push_back(i);
+    }
+    for (int k = 0; k < (int)this->ring.size(); k++){
+        this->ringNext.push_back(this->ring[(this->ringPos + k) % this->ring.size()]);
+    }
+    std::swap(this->ring, this->ringNext);
+    this->ringPos = 0;
+    this->firstSentRank = -1;
+
+    this->ready.clear();
+    this->cursor = 0;
+    for (int rank = 0; rank < (int)this->ring.size(); rank++){
+        const auto& state = this->cells[this->ring[rank]];
+        const auto& cell = this->map->getCell(state.id);
+        if (sendable(cell, now)){
+            double change = std::isnan(state.lastSentCount)
+                    ? std::numeric_limits<double>::infinity()
+                    : std::abs(cell.val()->getCount() - state.lastSentCount);
+            this->ready.push_back(Candidate{this->ring[rank], rank, cell.lastSent(), change});
+        }
+    }
+
+    this->sortedEnd = (policy == CellIdStreamPolicy::ROUND_ROBIN) ? (int)this->ready.size() : 0;
+    this->snapshotTime = now;
+    this->snapshotComputedAt = this->map->getLastComputedAt();
+    this->hasSnapshot = true;
+}
+
+template <typename C, typename N, typename T>
+bool SendStateCellIdStream<C, N, T>::before(const Candidate& a, const Candidate& b) const {
+    switch (policy){
+        case CellIdStreamPolicy::OLDEST_SENT_FIRST:
+            if (a.lastSent != b.lastSent) return a.lastSent < b.lastSent;
+            break;
+        case CellIdStreamPolicy::HIGHEST_CHANGE_FIRST:
+            if (a.change != b.change) return a.change > b.change;
+            break;
+        default:
+            break;
+    }
+    return a.rank < b.rank;
+}
+
+template <typename C, typename N, typename T>
+void SendStateCellIdStream<C, N, T>::sortTo(int end) const {
+    if (end <= this->sortedEnd){
+        return;
+    }
+    // sort in growing chunks to keep the selection of the next k cells cheap.
+    const int n = (int)this->ready.size();
+    int newEnd = std::min(n, std::max({end, 2*this->sortedEnd, 32}));
+    std::partial_sort(this->ready.begin() + this->sortedEnd, this->ready.begin() + newEnd, this->ready.end(),
+            [this](const Candidate& a, const Candidate& b){ return before(a, b); });
+    this->sortedEnd = newEnd;
+}
+
+template <typename C, typename N, typename T>
+const bool SendStateCellIdStream<C, N, T>::hasNext(const time_t& now) {
+    refresh(now);
+    while (this->cursor < (int)this->ready.size()){
+        sortTo(this->cursor + 1);
+        const auto& cell = this->map->getCell(this->cells[this->ready[this->cursor].index].id);
+        if (sendable(cell, now)){
+            // skipped cells move behind this one (see InsertionOrderedCellIdStream::hasNext)
+            this->ringPos = this->ready[this->cursor].rank;
+            return true;
+        }
+        // sent or invalidated since the snapshot
+        this->cursor++;
+    }
+    if (this->firstSentRank >= 0){
+        // all sendable cells taken. Continue with the cells sent first.
+        this->ringPos = this->firstSentRank;
+    }
+    return false;
+}
+
+template <typename C, typename N, typename T>
+const typename SendStateCellIdStream<C, N, T>::cell_key_t
+SendStateCellIdStream<C, N, T>::nextCellId(const time_t& now){
+    if (!this->hasNext(now)){
+        throw omnetpp::cRuntimeError("No valid nextCellId");
+    }
+    const auto& candidate = this->ready[this->cursor++];
+    auto& state = this->cells[candidate.index];
+    state.lastSentCount = this->map->getCell(state.id).val()->getCount();
+    this->ringPos = candidate.rank + 1;
+    if (this->firstSentRank < 0){
+        this->firstSentRank = candidate.rank;
+    }
+    return state.id;
+}
+
+template <typename C, typename N, typename T>
+typename SendStateCellIdStream<C, N, T>::Cell&
+SendStateCellIdStream<C, N, T>::nextCell(const time_t& now){
+    auto id = nextCellId(now);
+    return map->getCell(id);
+}
+
+template <typename C, typename N, typename T>
+std::vector<typename SendStateCellIdStream<C, N, T>::cell_key_t>
+SendStateCellIdStream<C, N, T>::peekCellIds(const time_t& now, const int maxCount){
+    refresh(now);
+    std::vector<cell_key_t> ret;
+    for (int i = this->cursor; i < (int)this->ready.size() && (int)ret.size() < maxCount; i++){
+        sortTo(i + 1);
+        const auto& id = this->cells[this->ready[i].index].id;
+        if (sendable(this->map->getCell(id), now)){
+            ret.push_back(id);
+        }
+    }
+    return ret;
+}
+
+template <typename C, typename N, typename T>
+const int SendStateCellIdStream<C, N, T>::size(const time_t& now) const {
+    refresh(now);
+    return (int)this->ready.size() - this->cursor;
+}
+
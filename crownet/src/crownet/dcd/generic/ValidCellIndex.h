@@ -0,0 +1,85 @@
+/*
+ * ValidCellIndex.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <set>
+#include <utility>
+
+namespace crownet {
+
+/**
+ * State of a single cell as seen by the ValidCellIndex.
+ *
+ * local        cell contains an entry of the map owner (valid or not)
+ * valid        cell contains at least one valid entry
+ * validLocal   the entry of the map owner is valid
+ */
+struct CellState {
+  bool local = false;
+  bool valid = false;
+  bool validLocal = false;
+
+  bool operator==(const CellState& rhs) const {
+    return local == rhs.local && valid == rhs.valid && validLocal == rhs.validLocal;
+  }
+  bool operator!=(const CellState& rhs) const { return !operator==(rhs); }
+};
+
+/**
+ * Live index over the cells of a DcDMap. Each cell reports changes of its
+ * CellState (triggered by put, entry creation and validity changes of its
+ * entries, i.e. reset/touch) such that the (valid/local) cells are known
+ * without walking all cells and entries. Counts are O(1), the cell sets
+ * allow the DcDMapIterator to visit only matching cells.
+ *
+ * Cells are identified by their slot (order, cell id). order is the
+ * insertion number for the FLAT cell store and 0 for the ORDERED store, thus
+ * the sets follow the iteration order of the cell store in both cases.
+ */
+template <typename C>
+class ValidCellIndex {
+ public:
+  using slot_t = std::pair<std::size_t, C>;
+  using set_t = std::set<slot_t>;
+
+  void update(const slot_t& slot, const CellState& before, const CellState& after) {
+    update(local, slot, before.local, after.local);
+    update(valid, slot, before.valid, after.valid);
+    update(validLocal, slot, before.validLocal, after.validLocal);
+  }
+  void clear() {
+    local.clear();
+    valid.clear();
+    validLocal.clear();
+  }
+
+  int localCellCount() const { return (int)local.size(); }
+  int validCellCount() const { return (int)valid.size(); }
+  int validLocalCellCount() const { return (int)validLocal.size(); }
+
+  const set_t& localCells() const { return local; }
+  const set_t& validCells() const { return valid; }
+  const set_t& validLocalCells() const { return validLocal; }
+
+ private:
+  static void update(set_t& cells, const slot_t& slot, bool before, bool after) {
+    if (before == after) return;
+    if (after) {
+      cells.insert(slot);
+    } else {
+      cells.erase(slot);
+    }
+  }
+
+  set_t local;
+  set_t valid;
+  set_t validLocal;
+};
+
+}  // namespace crownet
@@ -7,46 +7,66 @@
 
 #pragma once
 
-#include "crownet/common/iterator/FilterIterator.h"
+#include <cstddef>
+#include <iterator>
+
+#include "crownet/dcd/generic/ValidCellIndex.h"
 
 namespace crownet {
 
+/**
+ * Iterate the cells of one set of the ValidCellIndex of a DcDMap (local,
+ * valid or validLocal cells) in the iteration order of the cell store. Only
+ * matching cells are visited, each with one lookup in the cell store.
+ *
+ * The iterator is invalidated if the state of a cell changes (e.g. an entry
+ * is reset) during the iteration.
+ */
 template <typename MAP>
-class DcDMapIterator
-    : public FilterIterator<
-          MAP, typename MAP::map_t::iterator, typename MAP::map_t::value_type,
-          std::function<bool(const typename MAP::map_t::value_type&)>> {
+class DcDMapIterator {
  public:
-  using iterable_t = typename DcDMapIterator<MAP>::iterable_t;
-  using iter_value_t = typename DcDMapIterator<MAP>::iter_value_t;
-  using iter_t = typename DcDMapIterator<MAP>::iter_t;
-  using pred_t = typename DcDMapIterator<MAP>::pred_t;
+  using index_t = ValidCellIndex<typename MAP::cell_key_t>;
+  using iterable_t = MAP;
+  using iter_t = typename index_t::set_t::const_iterator;
+  using iter_value_t = typename MAP::map_t::value_type;
+
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = iter_value_t;
+  using difference_type = std::ptrdiff_t;
+  using pointer = iter_value_t*;
+  using reference = iter_value_t&;
 
-  DcDMapIterator(iterable_t* data, pred_t predicate);
-  DcDMapIterator(DcDMapIterator& other, iter_t iter);
+  DcDMapIterator(iterable_t* data, const typename index_t::set_t* cells);
+  DcDMapIterator(const DcDMapIterator& other, iter_t iter);
 
-  //  typename DcDMapIterator<MAP>::iter_value_t operator*() const override;
+  iter_value_t& operator*() const;
+  iter_value_t* operator->() const { return &operator*(); }
+  DcDMapIterator<MAP>& operator++();
+  DcDMapIterator<MAP> operator++(int);
+  bool operator==(const DcDMapIterator<MAP>& rhs) const;
+  bool operator!=(const DcDMapIterator<MAP>& rhs) const;
+
+  DcDMapIterator<MAP> begin() const;
+  DcDMapIterator<MAP> end() const;
+
+  int distance() const { return (int)cells->size(); }
 
   static DcDMapIterator<MAP> LocalCellIter(MAP* map) {
-    pred_t f = [](const iter_value_t& val) -> bool {
-      return val.second.hasLocal();
-    };
-    return DcDMapIterator<MAP>(map, f);
+    return DcDMapIterator<MAP>(map, &map->getValidCellIndex().localCells());
   }
 
   static DcDMapIterator<MAP> ValidLocalCellIter(MAP* map) {
-    pred_t f = [](const iter_value_t& val) -> bool {
-      return val.second.hasValidLocal();
-    };
-    return DcDMapIterator<MAP>(map, f);
+    return DcDMapIterator<MAP>(map, &map->getValidCellIndex().validLocalCells());
   }
 
   static DcDMapIterator<MAP> ValidCellIter(MAP* map) {
-    pred_t f = [](const iter_value_t& val) -> bool {
-      return val.second.hasValid();
-    };
-    return DcDMapIterator<MAP>(map, f);
+    return DcDMapIterator<MAP>(map, &map->getValidCellIndex().validCells());
   }
+
+ protected:
+  iterable_t* data;
+  const typename index_t::set_t* cells;
+  iter_t iter;
 };
 #include "crownet/dcd/generic/iterator/DcDMapIterator.tcc"
 }  // namespace crownet
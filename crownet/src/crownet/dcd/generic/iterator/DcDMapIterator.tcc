@@ -12,22 +12,50 @@
 template <typename MAP>
 DcDMapIterator<MAP>::DcDMapIterator(
     typename DcDMapIterator<MAP>::iterable_t* data,
-    typename DcDMapIterator<MAP>::pred_t predicate)
-    : FilterIterator<
-          MAP, typename MAP::map_t::iterator, typename MAP::map_t::value_type,
-          std::function<bool(const typename MAP::map_t::value_type&)>>(
-          data, predicate) {}
+    const typename DcDMapIterator<MAP>::index_t::set_t* cells)
+    : data(data), cells(cells), iter(cells->begin()) {}
 
 template <typename MAP>
-DcDMapIterator<MAP>::DcDMapIterator(DcDMapIterator& other,
+DcDMapIterator<MAP>::DcDMapIterator(const DcDMapIterator& other,
                                     typename DcDMapIterator<MAP>::iter_t iter)
-    : FilterIterator<
-          MAP, typename MAP::map_t::iterator, typename MAP::map_t::value_type,
-          std::function<bool(const typename MAP::map_t::value_type&)>>(other,
-                                                                       iter) {}
-
-// template <typename MAP>
-// typename DcDMapIterator<MAP>::iter_value_t DcDMapIterator<MAP>::operator*()
-//    const {
-//  return *(this->iter);
-//}
+    : data(other.data), cells(other.cells), iter(iter) {}
+
+template <typename MAP>
+typename DcDMapIterator<MAP>::iter_value_t& DcDMapIterator<MAP>::operator*() const {
+  // slot: (order, cell id)
+  return *this->data->getCells().find(this->iter->second);
+}
+
+template <typename MAP>
+DcDMapIterator<MAP>& DcDMapIterator<MAP>::operator++() {
+  ++this->iter;
+  return *this;
+}
+
+template <typename MAP>
+DcDMapIterator<MAP> DcDMapIterator<MAP>::operator++(int) {
+  DcDMapIterator<MAP> tmp(*this);
+  this->operator++();
+  return tmp;
+}
+
+template <typename MAP>
+bool DcDMapIterator<MAP>::operator==(const DcDMapIterator<MAP>& rhs) const {
+  // compare pointer (iterator based on same data)
+  return (this->cells == rhs.cells) && (this->iter == rhs.iter);
+}
+
+template <typename MAP>
+bool DcDMapIterator<MAP>::operator!=(const DcDMapIterator<MAP>& rhs) const {
+  return !operator==(rhs);
+}
+
+template <typename MAP>
+DcDMapIterator<MAP> DcDMapIterator<MAP>::begin() const {
+  return DcDMapIterator<MAP>(*this, this->cells->begin());
+}
+
+template <typename MAP>
+DcDMapIterator<MAP> DcDMapIterator<MAP>::end() const {
+  return DcDMapIterator<MAP>(*this, this->cells->end());
+}
@@ -0,0 +1,66 @@
+/*
+ * CellDistanceTable.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/dcd/identifier/CellDistanceTable.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace crownet {
+
+std::mutex CellDistanceTable::registryMutex;
+std::map<CellDistanceTable::key_t, std::weak_ptr<CellDistanceTable>> CellDistanceTable::registry;
+
+std::shared_ptr<CellDistanceTable> CellDistanceTable::get(const inet::Coord& cellSize,
+                                                          const inet::Coord& cellCount) {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  key_t key{cellSize.x, cellSize.y, (int)cellCount.x, (int)cellCount.y};
+  auto ret = registry[key].lock();
+  if (!ret) {
+    ret = std::make_shared<CellDistanceTable>(cellSize, (int)cellCount.x, (int)cellCount.y);
+    registry[key] = ret;
+  }
+  return ret;
+}
+
+CellDistanceTable::CellDistanceTable(const inet::Coord& cellSize, int cellCountX,
+                                     int cellCountY, std::size_t maxEntries)
+    : cellSize(cellSize), sizeX(std::max(cellCountX, 1)), sizeY(std::max(cellCountY, 1)) {
+  if ((std::size_t)sizeX * sizeY > maxEntries) {
+    // keep offsets near the origin. These are the most frequent ones.
+    int side = (int)std::sqrt((double)maxEntries);
+    sizeX = std::min(sizeX, side);
+    sizeY = std::min(sizeY, (int)(maxEntries / sizeX));
+  }
+  table.resize((std::size_t)sizeX * sizeY);
+  for (int dy = 0; dy < sizeY; dy++) {
+    for (int dx = 0; dx < sizeX; dx++) {
+      table[(std::size_t)dy * sizeX + dx] = compute(dx, dy);
+    }
+  }
+}
+
+double CellDistanceTable::compute(int dx, int dy) const {
+  // same as RegularGridInfo::cellCenterDist for cells (0, 0) and (dx, dy)
+  inet::Coord c1{cellSize.x / 2, cellSize.y / 2};
+  inet::Coord c2{dx * cellSize.x + cellSize.x / 2, dy * cellSize.y + cellSize.y / 2};
+  return c1.distance(c2);
+}
+
+double CellDistanceTable::cellCenterDist(const GridCellID& cell1, const GridCellID& cell2) const {
+  int dx = std::abs(cell1.x() - cell2.x());
+  int dy = std::abs(cell1.y() - cell2.y());
+  if (dx < sizeX && dy < sizeY) {
+    hits.fetch_add(1, std::memory_order_relaxed);
+    return table[(std::size_t)dy * sizeX + dx];
+  }
+  misses.fetch_add(1, std::memory_order_relaxed);
+  return compute(dx, dy);
+}
+
+}  // namespace crownet
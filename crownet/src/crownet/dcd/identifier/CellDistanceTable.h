@@ -0,0 +1,66 @@
+/*
+ * CellDistanceTable.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+#include "inet/common/geometry/common/Coord.h"
+#include "crownet/dcd/identifier/Identifiers.h"
+
+namespace crownet {
+
+/**
+ * Center distances between cells of a regular grid. The distance only
+ * depends on the offset (|dx|, |dy|) of both cells. Thus the distances of all
+ * offsets within the grid are computed once and shared between all
+ * GridCellIDKeyProvider instances of the same grid (see get()). Offsets
+ * outside the table (cells outside the grid or a grid larger than
+ * maxEntries) are computed on each call and counted as miss.
+ *
+ * The table is read only after construction and can be used concurrently.
+ */
+class CellDistanceTable {
+ public:
+  static const std::size_t DEFAULT_MAX_ENTRIES = 1 << 20;  // 8 MB
+
+  // process wide table for the given grid (created on first use)
+  static std::shared_ptr<CellDistanceTable> get(const inet::Coord& cellSize,
+                                                const inet::Coord& cellCount);
+
+  CellDistanceTable(const inet::Coord& cellSize, int cellCountX, int cellCountY,
+                    std::size_t maxEntries = DEFAULT_MAX_ENTRIES);
+
+  double cellCenterDist(const GridCellID& cell1, const GridCellID& cell2) const;
+
+  uint64_t getHits() const { return hits.load(std::memory_order_relaxed); }
+  uint64_t getMisses() const { return misses.load(std::memory_order_relaxed); }
+  int getSizeX() const { return sizeX; }
+  int getSizeY() const { return sizeY; }
+
+ private:
+  double compute(int dx, int dy) const;
+
+  inet::Coord cellSize;
+  int sizeX;
+  int sizeY;
+  std::vector<double> table;  // row major [dy * sizeX + dx]
+  mutable std::atomic<uint64_t> hits{0};
+  mutable std::atomic<uint64_t> misses{0};
+
+  using key_t = std::tuple<double, double, int, int>;
+  static std::mutex registryMutex;
+  static std::map<key_t, std::weak_ptr<CellDistanceTable>> registry;
+};
+
+}  // namespace crownet
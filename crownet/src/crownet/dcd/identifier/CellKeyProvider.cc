@@ -69,17 +69,7 @@ const inet::Coord GridCellIDKeyProvider::cellCenter(const int cellKey1D) const{
 
 
 double GridCellIDKeyProvider::cellCenterDist(const GridCellID& cell1, const GridCellID&  cell2) {
-    if (cell1 == cell2){
-        return 0.0;
-    } else if (cell2 < cell1){
-        return this->cellCenterDist(cell2, cell1);
-    }
-    // cell1 < cell2 after here.
-    const auto p = std::make_pair(cell1, cell2);
-    if (distMap.find(p) == distMap.end()){
-        distMap[p] = gridInfo.cellCenterDist(cell1, cell2);
-    }
-    return distMap[p];
+    return distTable->cellCenterDist(cell1, cell2);
 }
 
 EntryDist GridCellIDKeyProvider::getEntryDist(const GridCellID& source, const GridCellID& owner, const GridCellID& entry) {
@@ -13,6 +13,7 @@
 #include "traci/Position.h"
 #include "crownet/common/RegularGridInfo.h"
 #include "crownet/common/converter/OsgCoordinateConverter.h"
+#include "crownet/dcd/identifier/CellDistanceTable.h"
 
 namespace crownet {
 
@@ -57,7 +58,8 @@ class GridCellIDKeyProvider : public CellKeyProvider<GridCellID> {
 //  GridCellIDKeyProvider(const RegularGridInfo& gridInfo)
 //      : gridInfo(gridInfo) {}
   GridCellIDKeyProvider(std::shared_ptr<OsgCoordinateConverter> converter)
-      : converter(converter), gridInfo(converter->getGridDescription()) {}
+      : converter(converter), gridInfo(converter->getGridDescription()),
+        distTable(CellDistanceTable::get(gridInfo.getCellSize(), gridInfo.getCellCount())) {}
 
   virtual const GridCellID getCellKey(const traci::TraCIPosition& pos) const override;
   virtual const GridCellID getCellKey(const inet::Coord& pos) const override;
@@ -90,10 +92,13 @@ class GridCellIDKeyProvider : public CellKeyProvider<GridCellID> {
   virtual EntryDist getExactDist(const inet::Coord source, const inet::Coord owner, const GridCellID& entry) override;
   virtual EntryDist getExactDist(const inet::Coord source, const inet::Coord owner, const GridCellID& entry, const double sourceEntry) override;
 
+  // shared between all providers of the same grid
+  std::shared_ptr<CellDistanceTable> getDistanceTable() const { return distTable; }
+
  private:
   std::shared_ptr<OsgCoordinateConverter> converter;
   RegularGridInfo gridInfo;
-  std::map<const CellPair, double> distMap;
+  std::shared_ptr<CellDistanceTable> distTable;
 
 };
 
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -92,3 +94,23 @@ class IntIdentifer : public NodeIdentifiere<int> {
 // class DblIdentifer : public NodeIdentifiere<double> {};
 
 }  // namespace crownet
+
+namespace std {
+// used by the FLAT CellStore backend (see crownet/dcd/generic/CellStore.h)
+template <>
+struct hash<crownet::GridCellID> {
+  size_t operator()(const crownet::GridCellID& id) const noexcept {
+    // grid cells are small non-negative integers: mix x and y into one word.
+    const uint64_t k = (static_cast<uint64_t>(static_cast<uint32_t>(id.x())) << 32) |
+                       static_cast<uint32_t>(id.y());
+    return static_cast<size_t>(k * 0x9E3779B97F4A7C15ULL >> 16);
+  }
+};
+
+template <>
+struct hash<crownet::IntIdentifer> {
+  size_t operator()(const crownet::IntIdentifer& id) const noexcept {
+    return static_cast<size_t>(static_cast<uint64_t>(id.value()) * 0x9E3779B97F4A7C15ULL >> 16);
+  }
+};
+}  // namespace std
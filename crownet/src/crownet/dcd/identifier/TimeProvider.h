@@ -20,5 +20,5 @@ class TimeProvider {
 class SimTimeProvider : public TimeProvider<omnetpp::simtime_t> {
  public:
   virtual omnetpp::simtime_t now() override { return omnetpp::simTime(); }
-  virtual omnetpp::simtime_t zero() override { return omnetpp::simTime().ZERO; }
+  virtual omnetpp::simtime_t zero() override { return omnetpp::SimTime::ZERO; }
 };
@@ -33,7 +33,7 @@ RegularCell::entry_t_ptr YmfVisitor::applyTo(const RegularCell& cell)  {
 }
 
 
-YmfPlusDistVisitor::sum_data YmfPlusDistVisitor::getSums(const RegularCell& cell) const  {
+YmfPlusDistVisitor::sum_data YmfPlusDistVisitor::gather(const RegularCell& cell) const  {
     double age_sum = 0.0;
     double age_min = std::numeric_limits<double>::max();
     double distance_sum = 0.0;
@@ -42,9 +42,9 @@ YmfPlusDistVisitor::sum_data YmfPlusDistVisitor::getSums(const RegularCell& cell
 
     double age = .0;
     double dist = .0;
-    int count = 0;
+    columns.clear();
     // cellIter -> valid entries only!
-    for (const auto& e : this->cellIter(cell)) {
+    for (auto&& e : this->cellIter(cell)) {
         /*
          * Collect the sum of age difference relative to the
          * youngest measure (i.e. smallest age). For this
@@ -60,16 +60,21 @@ YmfPlusDistVisitor::sum_data YmfPlusDistVisitor::getSums(const RegularCell& cell
         /*
          * In the case of a local entry the 'sourceEntry' and 'ownerEntry'
          * values must be the same. Thus the sum of all sourceEntry values
-         * is correct.
+         * is correct. For the step function sum up the step function result
+         * not only the distance.
          * TODO EntryDist for localEntry is ZERO {0, 0, 0}
          */
-        dist = e.second->getEntryDist().sourceEntry;
+        dist = getDistValue(e.second->getEntryDist().sourceEntry);
         if (dist < dist_min){
             dist_min = dist;
         }
         distance_sum += dist;
-        ++count;
+
+        columns.age.push_back(age);
+        columns.dist.push_back(dist);
+        columns.entries.push_back(std::move(e.second));
     }
+    int count = (int)columns.size();
     // normalize over the age (min)difference
     age_sum = age_sum - count*age_min;
     // dist sum must not be updated because the some of the distance step function is
@@ -77,121 +82,37 @@ YmfPlusDistVisitor::sum_data YmfPlusDistVisitor::getSums(const RegularCell& cell
     return sum_data{age_sum, age_min, distance_sum, dist_min, count};
 }
 
-RegularCell::entry_t_ptr YmfPlusDistVisitor::applyTo(const RegularCell& cell)  {
-
-    sum_data d = getSums(cell);
-    double now = this->time.dbl(); // current time the visitor is called.
-
-    RegularCell::entry_t_ptr ret = nullptr;
-    double ret_ymfPlusDist = 0.0;
-    double ymfPlusDist = 0.0;
-    // cellIter -> valid entries only!
-    for (const auto& e : this->cellIter(cell)) {
-      double age = (now - e.second->getMeasureTime().dbl()) - d.age_min;
-      double dist = e.second->getEntryDist().sourceEntry;
-
-      // set rank to maximum value (=1.0) if the sum equals to zero. (i.e. there is only one element in validIter)
-      double ageRank = (d.age_sum == 0) ? 1.0 : age/d.age_sum;
-      double distRank = (d.dist_sum == 0) ? 1.0 : dist/d.dist_sum;
-
-      ymfPlusDist = alpha * ageRank + (1-alpha) * distRank;
-      e.second->setSelectionRank(ymfPlusDist);
-
-      if (ret == nullptr) {
-        ret = e.second;
-        ret_ymfPlusDist = ymfPlusDist;
-        continue;
-      }
-
-      if (ymfPlusDist < ret_ymfPlusDist) {
-        ret = e.second;
-        ret_ymfPlusDist = ymfPlusDist;
-      }
-    }
-    return  update_selection(ret, YmfPlusDistVisitor::COPY_TRUE);
+YmfPlusDistVisitor::sum_data YmfPlusDistVisitor::getSums(const RegularCell& cell) const  {
+    sum_data d = gather(cell);
+    columns.entries.clear();
+    return d;
 }
 
+RegularCell::entry_t_ptr YmfPlusDistVisitor::applyTo(const RegularCell& cell)  {
 
-RegularCell::entry_t_ptr YmfPlusDistStepVisitor::applyTo(const RegularCell& cell)  {
-
-    sum_data d = getSums(cell);
-    double now = this->time.dbl(); // current time the visitor is called.
-
-    RegularCell::entry_t_ptr ret = nullptr;
-    double ret_ymfPlusDist = 0.0;
-    double ymfPlusDist = 0.0;
-    // cellIter -> valid entries only!
-    for (const auto& e : this->cellIter(cell)) {
-      double age = (now - e.second->getMeasureTime().dbl()) - d.age_min;
-      double dist = getDistValue(e.second->getEntryDist().sourceEntry);
-
-      // set rank to maximum value (=1.0) if the sum equals to zero. (i.e. there is only one element in validIter)
-      double ageRank = (d.age_sum == 0.0) ? 1.0 : (age)/d.age_sum; // 1.0 if one or all are the same (i.e all are the samllest)
-      double distRank = ( d.dist_sum == 0.0) ? 1.0 : dist/d.dist_sum; // 1.0 if one value
+    sum_data d = gather(cell);
+    const std::size_t n = columns.size();
+    columns.rank.resize(n);
 
-      ymfPlusDist = alpha * ageRank + (1-alpha) * distRank;
-      e.second->setSelectionRank(ymfPlusDist);
-      if (ret == nullptr) {
-        ret = e.second;
-        ret_ymfPlusDist = ymfPlusDist;
-        continue;
-      }
+    // set rank to maximum value (=1.0) if the sum equals to zero. (i.e. there is only one element in validIter
+    // or all are the same)
+    aggregation::ageDistRank(columns.age.data(), columns.dist.data(), columns.rank.data(), n,
+            d.age_min, d.age_sum, d.dist_sum, alpha);
 
-      if (ymfPlusDist < ret_ymfPlusDist) {
-        ret = e.second;
-        ret_ymfPlusDist = ymfPlusDist;
-      }
+    for (std::size_t i = 0; i < n; ++i){
+        columns.entries[i]->setSelectionRank(columns.rank[i]);
     }
-    return  update_selection(ret, YmfPlusDistStepVisitor::COPY_TRUE);
+    // first entry with the smallest rank
+    std::size_t i = aggregation::argMin(columns.rank.data(), n);
+    RegularCell::entry_t_ptr ret = (i < n) ? columns.entries[i] : nullptr;
+    columns.entries.clear(); // do not keep entries alive
+    return  update_selection(ret, YmfPlusDistVisitor::COPY_TRUE);
 }
 
 const double YmfPlusDistStepVisitor::getDistValue(const double dist) const {
         return (dist <= stepDist) ? stepDist : dist;
 }
 
-YmfPlusDistVisitor::sum_data YmfPlusDistStepVisitor::getSums(const RegularCell& cell)  const {
-    double age_sum = 0.0;
-    double age_min = std::numeric_limits<double>::max();
-    double distance_sum = 0.0;
-    double dist_min = std::numeric_limits<double>::max();
-    double now = this->time.dbl(); // current time the visitor is called.
-
-    double age = .0;
-    double dist = .0;
-    int count = 0;
-    // cellIter -> valid entries only!
-    for (const auto& e : this->cellIter(cell)) {
-        /*
-         * Collect the sum of age difference relative to the
-         * youngest measure (i.e. smallest age). For this
-         * sum up all ages and find the smallest age at the same
-         * time. Subtract count*age_min after the fact from age_sum.
-         */
-        age = now - e.second->getMeasureTime().dbl();
-        if(age < age_min){
-            age_min = age;
-        }
-        age_sum += age;
-
-
-        /*
-         * sum up step function result not only distance
-         */
-
-        dist = getDistValue(e.second->getEntryDist().sourceEntry);
-        if (dist < dist_min){
-            dist_min = dist;
-        }
-        distance_sum += dist;
-        ++count;
-    }
-    // normalize over the age (min)difference
-    age_sum = age_sum - count*age_min;
-    // dist sum must not be updated because the some of the distance step function is
-    // the correct normalization value.
-    return sum_data{age_sum, age_min, distance_sum, dist_min, count};
-}
-
 RegularCell::entry_t_ptr LocalSelector::applyTo(const RegularCell& cell)  {
     // to check local exists.... raise error.....
     auto val = cell.getLocal();
@@ -218,23 +139,21 @@ RegularCell::entry_t_ptr MeanVisitor::applyTo(const RegularCell& cell)  {
 }
 
 RegularCell::entry_t_ptr MedianVisitor::applyTo(const RegularCell& cell)  {
-  std::vector<double> count;
-  std::vector<double> time;
+  counts.clear();
+  times.clear();
   // cellIter -> valid entries only!
   for (const auto& e : this->cellIter(cell)) {
-      count.push_back(e.second->getCount());
-      time.push_back(e.second->getMeasureTime().dbl());
+      counts.push_back(e.second->getCount());
+      times.push_back(e.second->getMeasureTime().dbl());
   }
-  auto m  = count.begin() + count.size()/2;
-  int left = (int)(count.size()-1)/2; // lower-right
-  int right = (int)count.size()/2;    // upper-left
-  std::nth_element(count.begin(), m, count.end()); // only sort half of the data
-  std::nth_element(time.begin(), m, time.end()); // only sort half of the data
-
-
-  auto entry = cell.createEntry((double)(count[left] + count[right])/2);  // new entry created here!
-  entry->setMeasureTime((double)(count[left] + count[right])/2);
-  entry->setReceivedTime((double)(time[left] + time[right])/2);
+  if (counts.empty()){
+      return nullptr;
+  }
+  // median of count and of measure time (independent of each other)
+  auto entry = cell.createEntry(aggregation::median(counts.data(), counts.size()));  // new entry created here!
+  double t = aggregation::median(times.data(), times.size());
+  entry->setMeasureTime(t);
+  entry->setReceivedTime(t);
   entry->setSelectionRank(0.0);
   return update_selection(entry, MedianVisitor::COPY_FALSE);
 }
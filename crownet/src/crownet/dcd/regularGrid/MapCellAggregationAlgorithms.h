@@ -1,6 +1,7 @@
 
 #pragma once
 
+#include "crownet/dcd/generic/AggregationKernels.h"
 #include "crownet/dcd/generic/CellVisitors.h"
 #include "crownet/dcd/regularGrid/RegularDcdMap.h"
 
@@ -24,6 +25,13 @@ class YmfVisitor : public CellAggregationAlgorihm<RegularCell> {
 };
 
 
+/**
+ * Select the entry with the smallest rank (alpha * age rank + (1-alpha) * distance rank).
+ *
+ * The valid entries of a cell are gathered once into contiguous columns
+ * (sums and minima are computed during the gather) and ranked by the
+ * aggregation kernels. Column buffers are reused for all cells.
+ */
 class YmfPlusDistVisitor : public CellAggregationAlgorihm<RegularCell> {
 protected:
     struct sum_data {
@@ -40,10 +48,16 @@ public:
     virtual RegularCell::entry_t_ptr applyTo(
         const RegularCell& cell) override;
     virtual sum_data getSums(const RegularCell& cell) const;
+    // distance value used for the rank. Identity for this visitor.
+    virtual const double getDistValue(const double dist) const { return dist; }
     virtual std::string getVisitorName() const override { return "ymfPlusDist"; }
 
 protected:
+    // fill columns with the valid entries of the cell and return the sums.
+    sum_data gather(const RegularCell& cell) const;
+
     double alpha;
+    mutable aggregation::EntryColumns<RegularCell::entry_t_ptr> columns;
 };
 
 class YmfPlusDistStepVisitor : public YmfPlusDistVisitor {
@@ -51,10 +65,7 @@ public:
     YmfPlusDistStepVisitor(double alpha, RegularCell::time_t t, double stepDist)
         : YmfPlusDistVisitor(alpha, t), stepDist(stepDist) {}
 
-    virtual RegularCell::entry_t_ptr applyTo(
-        const RegularCell& cell)  override;
-    virtual sum_data getSums(const RegularCell& cell) const override;
-    virtual const double getDistValue(const double dist) const;
+    virtual const double getDistValue(const double dist) const override;
     virtual std::string getVisitorName() const override { return "ymfPlusDistStep"; }
 
 protected:
@@ -90,7 +101,12 @@ public:
 
     virtual RegularCell::entry_t_ptr applyTo(
         const RegularCell& cell) override;
-    virtual std::string getVisitorName() const override { return "mean"; }
+    virtual std::string getVisitorName() const override { return "median"; }
+
+private:
+    // reused for all cells
+    std::vector<double> counts;
+    std::vector<double> times;
 };
 
 
@@ -162,4 +162,28 @@ void RsdNeighborhoodCountVisitor::reset(RegularCell::time_t time, int rsdid){
     this->time = time;
 }
 
+void NeighborhoodCountByRsdVisitor::applyTo(RegularCell& cell){
+    cellCount++;
+    if (cell.val()){
+        count = count + cell.val()->getCount();
+        int& c = rsdCount[cell.val()->getResourceSharingDomainId()];
+        c = c + cell.val()->getCount();
+    }
+}
+
+void NeighborhoodCountByRsdVisitor::reset(){
+    cellCount = 0;
+    count = 0;
+    rsdCount.clear();
+}
+
+int NeighborhoodCountByRsdVisitor::getCount(int rsdid) const {
+    if (rsdid < 0){
+        // ego count only (if the map contains any cell).
+        return cellCount > 0 ? 1 : 0;
+    }
+    auto it = rsdCount.find(rsdid);
+    return it == rsdCount.end() ? 0 : it->second;
+}
+
 }  // namespace crownet
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "crownet/dcd/generic/CellVisitors.h"
 #include "crownet/dcd/regularGrid/RegularDcdMap.h"
 
@@ -196,6 +198,29 @@ public:
     virtual void applyTo(RegularCell& cell) override;
 };
 
+/**
+ * Neighborhood count of all resource sharing domains in one pass. Same sums
+ * (int, in cell order) as RsdNeighborhoodCountVisitor and
+ * FullNeighborhoodCountVisitor, thus the result of any rsdid can be looked up
+ * without visiting the map again.
+ */
+class NeighborhoodCountByRsdVisitor : public VoidCellVisitor<RegularCell> {
+public:
+    NeighborhoodCountByRsdVisitor() : VoidCellVisitor<RegularCell>(), cellCount(0), count(0) {}
+
+    virtual void applyTo(RegularCell& cell) override;
+    void reset();
+    // FullNeighborhoodCountVisitor
+    int getCount() const {return count;}
+    // RsdNeighborhoodCountVisitor
+    int getCount(int rsdid) const;
+
+private:
+    int cellCount;
+    int count;
+    std::unordered_map<int, int> rsdCount;
+};
+
 
 
 }  // namespace crownet
@@ -45,24 +45,43 @@ RegularDcdMapFactory::RegularDcdMapFactory(std::shared_ptr<OsgCoordinateConverte
         return std::make_shared<LocalSelector>(timeProvider->now());
     };
 
+    // same cell order as insertionOrder but size() and hasNext() without map scans
     cellIdStream_dispatcher["default"] = [](){
-        return std::make_shared<InsertionOrderedCellIdStream<GridCellID, IntIdentifer, omnetpp::simtime_t>>();
+        return std::make_shared<SendStateCellIdStream<GridCellID, IntIdentifer, omnetpp::simtime_t>>(
+                CellIdStreamPolicy::ROUND_ROBIN);
     };
     cellIdStream_dispatcher["insertionOrder"] = [](){
         return std::make_shared<InsertionOrderedCellIdStream<GridCellID, IntIdentifer, omnetpp::simtime_t>>();
     };
+    cellIdStream_dispatcher["roundRobin"] = [](){
+        return std::make_shared<SendStateCellIdStream<GridCellID, IntIdentifer, omnetpp::simtime_t>>(
+                CellIdStreamPolicy::ROUND_ROBIN);
+    };
+    cellIdStream_dispatcher["oldestSentFirst"] = [](){
+        return std::make_shared<SendStateCellIdStream<GridCellID, IntIdentifer, omnetpp::simtime_t>>(
+                CellIdStreamPolicy::OLDEST_SENT_FIRST);
+    };
+    cellIdStream_dispatcher["highestChangeFirst"] = [](){
+        return std::make_shared<SendStateCellIdStream<GridCellID, IntIdentifer, omnetpp::simtime_t>>(
+                CellIdStreamPolicy::HIGHEST_CHANGE_FIRST);
+    };
+
+    cellStore_dispatcher["default"] = CellStoreType::ORDERED;
+    cellStore_dispatcher["ordered"] = CellStoreType::ORDERED;
+    cellStore_dispatcher["flat"] = CellStoreType::FLAT;
 }
 
 
-RegularDcdMap RegularDcdMapFactory::create(const IntIdentifer& ownerID, const std::string& idStreamType) {
+RegularDcdMap RegularDcdMapFactory::create(const IntIdentifer& ownerID, const std::string& idStreamType,
+        const std::string& cellStoreType) {
   auto streamer = createCellIdStream(idStreamType); // create new one do not share
-  return RegularDcdMap(ownerID, cellKeyProvider, timeProvider, streamer);
+  return RegularDcdMap(ownerID, cellKeyProvider, timeProvider, streamer, getCellStoreType(cellStoreType));
 }
 
 std::shared_ptr<RegularDcdMap> RegularDcdMapFactory::create_shared_ptr(
-    const IntIdentifer& ownerID, const std::string& idStreamType) {
+    const IntIdentifer& ownerID, const std::string& idStreamType, const std::string& cellStoreType) {
   auto streamer = createCellIdStream(idStreamType); // create new one do not share
-  return std::make_shared<RegularDcdMap>(ownerID, cellKeyProvider, timeProvider, streamer);
+  return std::make_shared<RegularDcdMap>(ownerID, cellKeyProvider, timeProvider, streamer, getCellStoreType(cellStoreType));
 }
 
 std::shared_ptr<CellAggregationAlgorihm<RegularCell>> RegularDcdMapFactory::createValueVisitor(MapCfg* mapCfg){
@@ -81,4 +100,12 @@ std::shared_ptr<ICellIdStream<GridCellID, IntIdentifer, omnetpp::simtime_t>> Reg
     return cellIdStream_dispatcher[typeName]();
 }
 
+CellStoreType RegularDcdMapFactory::getCellStoreType(const std::string& typeName) const {
+    auto iter = cellStore_dispatcher.find(typeName);
+    if (iter == cellStore_dispatcher.end()){
+        throw cRuntimeError("No CellStore defined for type %s", typeName.c_str());
+    }
+    return iter->second;
+}
+
 }  // namespace crownet
@@ -12,6 +12,7 @@
 #include "crownet/dcd/generic/DcdMapWatcher.h"
 #include "crownet/dcd/regularGrid/RegularCell.h"
 #include "crownet/dcd/generic/CellIdStream.h"
+#include "crownet/dcd/generic/SendStateCellIdStream.h"
 #include "crownet/common/RegularGridInfo.h"
 #include "crownet/applications/dmap/dmap_m.h"
 
@@ -36,11 +37,15 @@ class RegularDcdMapFactory {
 
   std::map<std::string, VisitorCreator>visitor_dispatcher;
   std::map<std::string, CellIdStreamCreator>cellIdStream_dispatcher;
+  std::map<std::string, CellStoreType>cellStore_dispatcher;
 
-  RegularDcdMap create(const IntIdentifer& ownerID, const std::string& idStreamType = "default");
-  std::shared_ptr<RegularDcdMap> create_shared_ptr(const IntIdentifer& ownerID, const std::string& idStreamType = "default");
+  RegularDcdMap create(const IntIdentifer& ownerID, const std::string& idStreamType = "default",
+          const std::string& cellStoreType = "ordered");
+  std::shared_ptr<RegularDcdMap> create_shared_ptr(const IntIdentifer& ownerID, const std::string& idStreamType = "default",
+          const std::string& cellStoreType = "ordered");
   std::shared_ptr<CellAggregationAlgorihm<RegularCell>> createValueVisitor(MapCfg* mapCfg);
   std::shared_ptr<ICellIdStream<GridCellID, IntIdentifer, omnetpp::simtime_t>> createCellIdStream(const std::string& typeName);
+  CellStoreType getCellStoreType(const std::string& typeName) const;
   std::shared_ptr<GridCellIDKeyProvider> getCellKeyProvider() { return cellKeyProvider; }
   RegularGridInfo getGrid() const {return grid;}
   std::shared_ptr<SimTimeProvider> getTimeProvider() { return timeProvider; }
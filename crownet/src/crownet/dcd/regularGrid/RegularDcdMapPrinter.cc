@@ -9,19 +9,100 @@
 
 namespace crownet {
 
-void RegularDcdMapSqlValuePrinter::writeSqlStatement(std::ostream& out){
-    //todo mw write dcdMap State to sql buffer (out)
-    // out << "insert ..."
+namespace {
+
+void putCell(ColumnChunk& out, const GridCellID& cellId) {
+  out.putDouble(omnetpp::simTime().dbl());
+  out.putInt(cellId.x()).putInt(cellId.y());
+}
+
+void putEntry(ColumnChunk& out, const GridEntry& e) {
+  out.putDouble(e.getCount())
+     .putDouble(e.getMeasureTime().dbl())
+     .putDouble(e.getReceivedTime().dbl())
+     .putInt(e.getSource().value())
+     .putString(e.getSelectedIn())
+     .putDouble(e.getSelectionRank());
+}
+
+void putEntryDist(ColumnChunk& out, const GridEntry& e) {
+  auto dist = e.getEntryDist();
+  out.putDouble(dist.sourceHost)
+     .putDouble(dist.sourceEntry)
+     .putDouble(dist.hostEntry)
+     .putInt(e.getResourceSharingDomainId());
+}
+
+}  // namespace
+
+void RegularDcdMapSqlValuePrinter::createSchema(SqlApi& api){
+    api.exec("CREATE TABLE IF NOT EXISTS dcd_map_metadata("
+             "node_id INTEGER, key TEXT, value TEXT)");
+    api.exec("CREATE TABLE IF NOT EXISTS dcd_map("
+             "simtime REAL, node_id INTEGER, x INTEGER, y INTEGER, count REAL, "
+             "measured_t REAL, received_t REAL, source INTEGER, selection TEXT, "
+             "selectionRank REAL, sourceHost REAL, sourceEntry REAL, hostEntry REAL, "
+             "rsd_id INTEGER, own_cell INTEGER)");
+    insert = api.prepare("INSERT INTO dcd_map VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?,?)");
+}
+
+void RegularDcdMapSqlValuePrinter::writeInitSqlStatement(SqlApi& api, const std::map<std::string, std::string>& metadata) {
+    auto stmt = api.prepare("INSERT INTO dcd_map_metadata VALUES (?,?,?)");
+    for (const auto& e : metadata){
+        stmt->bind(1, map->getOwnerId().value()).bind(2, e.first).bind(3, e.second);
+        stmt->exec();
+    }
 }
 
-void RegularDcdMapSqlValuePrinter::createSchema(std::ostream& out){
-    //todo mw
-    // out << "insert ..."
+void RegularDcdMapSqlValuePrinter::writeSqlStatement(SqlApi& api){
+    double now = omnetpp::simTime().dbl();
+    int nodeId = map->getOwnerId().value();
+    for (const auto& val : map->valid()) {
+        const auto& e = *val.second.val();
+        auto dist = e.getEntryDist();
+        insert->bind(1, now).bind(2, nodeId)
+              .bind(3, val.first.x()).bind(4, val.first.y())
+              .bind(5, e.getCount())
+              .bind(6, e.getMeasureTime().dbl())
+              .bind(7, e.getReceivedTime().dbl())
+              .bind(8, e.getSource().value())
+              .bind(9, e.getSelectedIn())
+              .bind(10, e.getSelectionRank())
+              .bind(11, dist.sourceHost)
+              .bind(12, dist.sourceEntry)
+              .bind(13, dist.hostEntry)
+              .bind(14, e.getResourceSharingDomainId())
+              .bind(15, (val.first == map->getOwnerCell()) ? 1 : 0);
+        insert->exec();
+    }
 }
 
-void RegularDcdMapSqlValuePrinter::writeInitSqlStatement(std::ostream& out) {
-    //todo mw write metadata for given map
-    // out << "insert ..."
+void RegularDcdMapSqlGlobalPrinter::createSchema(SqlApi& api){
+    api.exec("CREATE TABLE IF NOT EXISTS dcd_map_metadata("
+             "node_id INTEGER, key TEXT, value TEXT)");
+    api.exec("CREATE TABLE IF NOT EXISTS dcd_map_global("
+             "simtime REAL, x INTEGER, y INTEGER, count REAL, measured_t REAL, "
+             "received_t REAL, source INTEGER, selection TEXT, selectionRank REAL, "
+             "own_cell INTEGER, node_id TEXT)");
+    insert = api.prepare("INSERT INTO dcd_map_global VALUES (?,?,?,?,?,?,?,?,?,?,?)");
+}
+
+void RegularDcdMapSqlGlobalPrinter::writeSqlStatement(SqlApi& api){
+    double now = omnetpp::simTime().dbl();
+    for (const auto& val : map->validLocal()) {
+        const auto lEntry = val.second.get<GridGlobalEntry>();
+        insert->bind(1, now)
+              .bind(2, val.first.x()).bind(3, val.first.y())
+              .bind(4, lEntry->getCount())
+              .bind(5, lEntry->getMeasureTime().dbl())
+              .bind(6, lEntry->getReceivedTime().dbl())
+              .bind(7, lEntry->getSource().value())
+              .bind(8, lEntry->getSelectedIn())
+              .bind(9, lEntry->getSelectionRank())
+              .bind(10, (val.first == map->getOwnerCell()) ? 1 : 0)
+              .bind(11, lEntry->nodeString(", "));
+        insert->exec();
+    }
 }
 
 int RegularDcdMapValuePrinter::columns() const { return 9; }
@@ -59,6 +140,33 @@ void RegularDcdMapValuePrinter::writeHeaderTo(std::ostream& out,
           "own_cell" << std::endl;
 }
 
+std::vector<ColumnSpec> RegularDcdMapValuePrinter::columnSpec() const {
+  return {{"simtime", ColumnType::FLOAT64},
+          {"x", ColumnType::INT32},
+          {"y", ColumnType::INT32},
+          {"count", ColumnType::FLOAT64},
+          {"measured_t", ColumnType::FLOAT64},
+          {"received_t", ColumnType::FLOAT64},
+          {"source", ColumnType::INT32},
+          {"selection", ColumnType::STRING},
+          {"selectionRank", ColumnType::FLOAT64},
+          {"sourceHost", ColumnType::FLOAT64},
+          {"sourceEntry", ColumnType::FLOAT64},
+          {"hostEntry", ColumnType::FLOAT64},
+          {"rsd_id", ColumnType::INT32},
+          {"own_cell", ColumnType::INT32}};
+}
+
+void RegularDcdMapValuePrinter::writeTo(ColumnChunk& out) const {
+  for (const auto& val : map->valid()) {
+    putCell(out, val.first);
+    putEntry(out, *val.second.val());
+    putEntryDist(out, *val.second.val());
+    out.putInt((val.first == map->getOwnerCell()) ? 1 : 0);
+    out.endRow();
+  }
+}
+
 void RegularDcdMapAllPrinter::writeTo(std::ostream& out,
                                       const std::string& sep) const {
   // for all cells in dcd map
@@ -92,6 +200,32 @@ void RegularDcdMapAllPrinter::writeTo(std::ostream& out,
   }
 }
 
+void RegularDcdMapAllPrinter::writeTo(ColumnChunk& out) const {
+  for (const auto& val : map->valid()) {
+    int ownCell = (val.first == map->getOwnerCell()) ? 1 : 0;
+    bool foundSelected = false;
+    for (const auto& cell : val.second.validIter()) {
+      auto entry = cell.second;
+      if (!foundSelected) {
+        foundSelected = entry->getSelectionId() != 0;
+      }
+      putCell(out, val.first);
+      putEntry(out, *entry);
+      putEntryDist(out, *entry);
+      out.putInt(ownCell);
+      out.endRow();
+    }
+    if (!foundSelected) {
+      // selected value was calculated. add selected value manually
+      putCell(out, val.first);
+      putEntry(out, *val.second.val());
+      putEntryDist(out, *val.second.val());
+      out.putInt(ownCell);
+      out.endRow();
+    }
+  }
+}
+
 void RegularDcdMapGlobalPrinter::writeTo(std::ostream& out,
                                          const std::string& sep) const {
     for(const auto& val : map->validLocal()){
@@ -123,4 +257,29 @@ void RegularDcdMapGlobalPrinter::writeHeaderTo(std::ostream& out,
           "node_id" << std::endl;
 }
 
+std::vector<ColumnSpec> RegularDcdMapGlobalPrinter::columnSpec() const {
+  return {{"simtime", ColumnType::FLOAT64},
+          {"x", ColumnType::INT32},
+          {"y", ColumnType::INT32},
+          {"count", ColumnType::FLOAT64},
+          {"measured_t", ColumnType::FLOAT64},
+          {"received_t", ColumnType::FLOAT64},
+          {"source", ColumnType::INT32},
+          {"selection", ColumnType::STRING},
+          {"selectionRank", ColumnType::FLOAT64},
+          {"own_cell", ColumnType::INT32},
+          {"node_id", ColumnType::STRING}};
+}
+
+void RegularDcdMapGlobalPrinter::writeTo(ColumnChunk& out) const {
+  for (const auto& val : map->validLocal()) {
+    const auto lEntry = val.second.get<GridGlobalEntry>();
+    putCell(out, val.first);
+    putEntry(out, *lEntry);
+    out.putInt((val.first == map->getOwnerCell()) ? 1 : 0);
+    out.putString(lEntry->nodeString(", "));
+    out.endRow();
+  }
+}
+
 }  // namespace crownet
@@ -9,27 +9,43 @@
 
 #include <omnetpp.h>
 
+#include "crownet/common/util/ColumnWriter.h"
 #include "crownet/common/util/FilePrinter.h"
 #include "crownet/common/util/SqlLiteWriter.h"
 #include "crownet/dcd/regularGrid/RegularDcdMap.h"
 
 namespace crownet {
 
+/**
+ * Write valid cells of a (decentralized) map into table dcd_map. Rows of
+ * all maps sharing one database are distinguished by node_id.
+ */
 class RegularDcdMapSqlValuePrinter : public SqlPrinter {
 public:
     RegularDcdMapSqlValuePrinter(std::shared_ptr<RegularDcdMap> map) : map(map){};
-    void writeSqlStatement(std::ostream& out) override;
-    void createSchema(std::ostream& out) override;
-    void writeInitSqlStatement(std::ostream& out) override;
+    void writeSqlStatement(SqlApi& api) override;
+    void createSchema(SqlApi& api) override;
+    void writeInitSqlStatement(SqlApi& api, const std::map<std::string, std::string>& metadata) override;
 
 protected:
  std::shared_ptr<RegularDcdMap> map;
-// todo postion provider?
+ std::unique_ptr<SqlStatement> insert;
+
+};
 
+/**
+ * Write local (ground truth) entries of the global map into table
+ * dcd_map_global including the ids of the nodes in each cell.
+ */
+class RegularDcdMapSqlGlobalPrinter : public RegularDcdMapSqlValuePrinter {
+public:
+    RegularDcdMapSqlGlobalPrinter(std::shared_ptr<RegularDcdMap> map) : RegularDcdMapSqlValuePrinter(map){};
+    void writeSqlStatement(SqlApi& api) override;
+    void createSchema(SqlApi& api) override;
 };
 
 // todo integrate with crownet/common/util/FileWriter.h
-class RegularDcdMapValuePrinter : public FilePrinter {
+class RegularDcdMapValuePrinter : public FilePrinter, public ColumnPrinter {
  public:
   RegularDcdMapValuePrinter(std::shared_ptr<RegularDcdMap> map) : map(map){};
 
@@ -39,6 +55,10 @@ class RegularDcdMapValuePrinter : public FilePrinter {
   virtual void writeHeaderTo(std::ostream& out,
                              const std::string& sep) const override;
 
+  // ColumnPrinter (same columns as csv)
+  virtual std::vector<ColumnSpec> columnSpec() const override;
+  virtual void writeTo(ColumnChunk& out) const override;
+
 
  protected:
   std::shared_ptr<RegularDcdMap> map;
@@ -51,6 +71,7 @@ class RegularDcdMapAllPrinter : public RegularDcdMapValuePrinter {
       : RegularDcdMapValuePrinter(map){};
   virtual void writeTo(std::ostream& out,
                        const std::string& sep) const override;
+  virtual void writeTo(ColumnChunk& out) const override;
 };
 
 // todo print global map
@@ -62,6 +83,8 @@ class RegularDcdMapGlobalPrinter : public RegularDcdMapValuePrinter {
                        const std::string& sep) const override;
   virtual void writeHeaderTo(std::ostream& out,
                              const std::string& sep) const override;
+  virtual std::vector<ColumnSpec> columnSpec() const override;
+  virtual void writeTo(ColumnChunk& out) const override;
 };
 
 }  // namespace crownet
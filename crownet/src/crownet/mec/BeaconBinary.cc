@@ -0,0 +1,146 @@
+#include "BeaconBinary.h"
+
+#include <cstring>
+#include <omnetpp.h>
+
+namespace {
+
+const char* BASE64 = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+const std::size_t HEADER_SIZE = 1 + 8 + 4;
+
+template <typename T>
+void putLE(std::string& buf, T value)
+{
+    uint64_t raw = 0;
+    std::memcpy(&raw, &value, sizeof(T));
+    for (std::size_t i = 0; i < sizeof(T); i++) {
+        buf.push_back((char)(raw >> (8 * i) & 0xFF));
+    }
+}
+
+template <typename T>
+T getLE(const char* p)
+{
+    uint64_t raw = 0;
+    for (std::size_t i = 0; i < sizeof(T); i++) {
+        raw |= (uint64_t)(uint8_t)p[i] << (8 * i);
+    }
+    T ret;
+    std::memcpy(&ret, &raw, sizeof(T));
+    return ret;
+}
+
+int base64Value(char c)
+{
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+} // namespace
+
+void beacon_binary::appendBeacon(std::string& raw, const SimpleMECBeacon& beacon)
+{
+    if (beacon.getNodeType() < 0 || beacon.getNodeType() > 255) {
+        throw omnetpp::cRuntimeError("beacon_binary: node type %d out of range", beacon.getNodeType());
+    }
+    putLE<int32_t>(raw, beacon.getNodeId());
+    putLE<uint8_t>(raw, (uint8_t)beacon.getNodeType());
+    putLE<double>(raw, beacon.getXPos());
+    putLE<double>(raw, beacon.getYPos());
+}
+
+std::string beacon_binary::finishBatch(const std::string& raw, uint64_t seq, uint32_t count)
+{
+    std::string batch;
+    batch.reserve(HEADER_SIZE + raw.size());
+    putLE<uint8_t>(batch, 1);
+    putLE<uint64_t>(batch, seq);
+    putLE<uint32_t>(batch, count);
+    batch.append(raw);
+    return encodeBase64(batch);
+}
+
+std::string beacon_binary::serializeBeacons(const std::vector<SimpleMECBeacon>& beaconsIn, uint64_t seq)
+{
+    std::string raw;
+    raw.reserve(beaconsIn.size() * BEACON_SIZE);
+    for (const auto& beacon : beaconsIn) {
+        appendBeacon(raw, beacon);
+    }
+    return finishBatch(raw, seq, (uint32_t)beaconsIn.size());
+}
+
+uint64_t beacon_binary::parseBeacons(const std::string& body, std::vector<SimpleMECBeacon>& beaconsOut)
+{
+    std::string batch = decodeBase64(body);
+    if (batch.size() < HEADER_SIZE || batch[0] != 1) {
+        throw omnetpp::cRuntimeError("beacon_binary: not a beacon batch");
+    }
+    const char* p = batch.data();
+    uint64_t seq = getLE<uint64_t>(p + 1);
+    uint32_t count = getLE<uint32_t>(p + 9);
+    if (batch.size() != HEADER_SIZE + (std::size_t)count * BEACON_SIZE) {
+        throw omnetpp::cRuntimeError("beacon_binary: expected %u beacons in batch of %zu byte", count, batch.size());
+    }
+    p += HEADER_SIZE;
+    beaconsOut.reserve(beaconsOut.size() + count);
+    for (uint32_t i = 0; i < count; i++, p += BEACON_SIZE) {
+        beaconsOut.emplace_back();
+        SimpleMECBeacon& beacon = beaconsOut.back();
+        beacon.setNodeId(getLE<int32_t>(p));
+        beacon.setNodeType(getLE<uint8_t>(p + 4));
+        beacon.setXPos(getLE<double>(p + 5));
+        beacon.setYPos(getLE<double>(p + 13));
+    }
+    return seq;
+}
+
+std::string beacon_binary::encodeBase64(const std::string& in)
+{
+    std::string out;
+    out.reserve((in.size() + 2) / 3 * 4);
+    std::size_t i = 0;
+    for (; i + 2 < in.size(); i += 3) {
+        uint32_t v = (uint8_t)in[i] << 16 | (uint8_t)in[i+1] << 8 | (uint8_t)in[i+2];
+        out.push_back(BASE64[v >> 18 & 0x3F]);
+        out.push_back(BASE64[v >> 12 & 0x3F]);
+        out.push_back(BASE64[v >> 6 & 0x3F]);
+        out.push_back(BASE64[v & 0x3F]);
+    }
+    if (i < in.size()) {
+        uint32_t v = (uint8_t)in[i] << 16;
+        if (i + 1 < in.size()) v |= (uint8_t)in[i+1] << 8;
+        out.push_back(BASE64[v >> 18 & 0x3F]);
+        out.push_back(BASE64[v >> 12 & 0x3F]);
+        out.push_back(i + 1 < in.size() ? BASE64[v >> 6 & 0x3F] : '=');
+        out.push_back('=');
+    }
+    return out;
+}
+
+std::string beacon_binary::decodeBase64(const std::string& in)
+{
+    std::string out;
+    out.reserve(in.size() / 4 * 3);
+    uint32_t v = 0;
+    int bits = 0;
+    for (char c : in) {
+        if (c == '=') break;
+        if (c == '\r' || c == '\n' || c == ' ') continue;
+        int d = base64Value(c);
+        if (d < 0) {
+            throw omnetpp::cRuntimeError("beacon_binary: invalid base64 character 0x%02x", (uint8_t)c);
+        }
+        v = v << 6 | d;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back((char)(v >> bits & 0xFF));
+        }
+    }
+    return out;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "packets/SimpleMECBeacon_m.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Compact batch encoding of beacons exchanged between MECBeaconApp and
+ * BeaconService (alternative to beacon_json).
+ *
+ * Batch layout (little endian):
+ *   version     u8   (1)
+ *   seq         u64  sequence number of the repository (0 for POST)
+ *   count       u32
+ *   count * (nodeId i32, nodeType u8, xPos f64, yPos f64)
+ *
+ * The Simu5G HTTP helpers handle bodies as C strings, thus the batch is
+ * base64 encoded to keep the body free of NUL bytes. A beacon takes 28 byte
+ * in the body instead of about 70 byte as JSON.
+ */
+namespace beacon_binary {
+    static const std::size_t BEACON_SIZE = 21;
+
+    // append one beacon to a raw batch
+    void appendBeacon(std::string& raw, const SimpleMECBeacon& beacon);
+    // raw batch to body. count must match the number of appended beacons.
+    std::string finishBatch(const std::string& raw, uint64_t seq, uint32_t count);
+
+    std::string serializeBeacons(const std::vector<SimpleMECBeacon>& beaconsIn, uint64_t seq = 0);
+    // append beacons of body to beaconsOut. Returns the sequence number.
+    uint64_t parseBeacons(const std::string& body, std::vector<SimpleMECBeacon>& beaconsOut);
+
+    std::string encodeBase64(const std::string& in);
+    std::string decodeBase64(const std::string& in);
+};
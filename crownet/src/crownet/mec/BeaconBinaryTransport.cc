@@ -0,0 +1,61 @@
+#include "BeaconBinaryTransport.h"
+
+#include <cstdlib>
+
+std::size_t BeaconBinaryService::receiveBatch(const std::string& body)
+{
+    receiveBuffer.clear();
+    beacon_binary::parseBeacons(body, receiveBuffer);
+    for (const auto& beacon : receiveBuffer)
+    {
+        repository.add(beacon);
+    }
+    return receiveBuffer.size();
+}
+
+std::string BeaconBinaryService::getSince(const std::string& params)
+{
+    uint64_t since = 0;
+    auto pos = params.find("seq=");
+    if (pos != std::string::npos)
+    {
+        since = std::strtoull(params.c_str() + pos + 4, nullptr, 10);
+    }
+    repository.getSince(since, beaconBuffer);
+    rawBuffer.clear();
+    for (const auto beacon : beaconBuffer)
+    {
+        beacon_binary::appendBeacon(rawBuffer, *beacon);
+    }
+    return beacon_binary::finishBatch(rawBuffer, repository.getSequenceNumber(), (uint32_t)beaconBuffer.size());
+}
+
+bool BeaconBinaryClient::addBeacon(const SimpleMECBeacon& beacon)
+{
+    pendingBeacons.push_back(beacon);
+    return pendingBeacons.size() >= batchSize;
+}
+
+std::string BeaconBinaryClient::takeBatch()
+{
+    std::string body = beacon_binary::serializeBeacons(pendingBeacons);
+    pendingBeacons.clear();
+    return body;
+}
+
+const std::vector<SimpleMECBeacon>& BeaconBinaryClient::merge(const std::string& body)
+{
+    beacons.clear();
+    lastSeq = beacon_binary::parseBeacons(body, beacons);
+    for (const auto& beacon : beacons)
+    {
+        beaconCache[beacon.getNodeId()] = beacon;
+    }
+    beacons.clear();
+    beacons.reserve(beaconCache.size());
+    for (const auto& entry : beaconCache)
+    {
+        beacons.push_back(entry.second);
+    }
+    return beacons;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "BeaconBinary.h"
+#include "BeaconRepository.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Service side of the binary transport (BeaconService): batched POST
+ * /beacons and delta GET /since. Buffers are reused between requests.
+ */
+class BeaconBinaryService
+{
+private:
+    BeaconRepository& repository;
+    std::vector<const SimpleMECBeacon*> beaconBuffer;
+    std::vector<SimpleMECBeacon> receiveBuffer;
+    std::string rawBuffer;
+
+public:
+    explicit BeaconBinaryService(BeaconRepository& repository) : repository(repository) {}
+
+    // add all beacons of a POST body. Returns the number of beacons.
+    std::size_t receiveBatch(const std::string& body);
+
+    // body of the GET response for parameters 'seq=<n>' (missing: all beacons)
+    std::string getSince(const std::string& params);
+};
+
+/**
+ * App side of the binary transport (MECBeaconApp): collects beacons for the
+ * next POST and merges the delta responses into the beacons known so far.
+ */
+class BeaconBinaryClient
+{
+private:
+    std::size_t batchSize = 1;
+    std::vector<SimpleMECBeacon> pendingBeacons;
+    // sequence number of the last response
+    uint64_t lastSeq = 0;
+    std::map<int, SimpleMECBeacon> beaconCache;
+    std::vector<SimpleMECBeacon> beacons;
+
+public:
+    void setBatchSize(std::size_t size) { batchSize = size; }
+
+    // Returns true if the batch is full and should be sent.
+    bool addBeacon(const SimpleMECBeacon& beacon);
+    bool hasPending() const { return !pendingBeacons.empty(); }
+    // POST body of the pending beacons. Clears the batch.
+    std::string takeBatch();
+
+    // parameters of the next GET /since request
+    std::string getSinceParams() const { return "seq=" + std::to_string(lastSeq); }
+    // merge a GET /since body. Returns all known beacons ordered by node id.
+    // The reference is valid until the next merge().
+    const std::vector<SimpleMECBeacon>& merge(const std::string& body);
+
+    uint64_t getLastSeq() const { return lastSeq; }
+};
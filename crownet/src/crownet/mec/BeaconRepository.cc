@@ -6,11 +6,13 @@ using namespace inet;
 
 void BeaconRepository::add(SimpleMECBeacon beacon)
 {
-    StoredBeacon sb = {
-      .beacon = beacon
-    };
-
-    storage[beacon.getNodeId()] = sb;
+    auto& sb = storage[beacon.getNodeId()];
+    if (sb.seq > 0) {
+        updates.erase(sb.seq);
+    }
+    sb.beacon = beacon;
+    sb.seq = ++seq;
+    updates.emplace_hint(updates.end(), sb.seq, beacon.getNodeId());
 
     EV << "Stored beacon. Repository now contains " << storage.size() << " beacons" << std::endl;
 }
@@ -19,6 +21,7 @@ void BeaconRepository::add(SimpleMECBeacon beacon)
 std::vector<SimpleMECBeacon> BeaconRepository::getAll()
 {
     std::vector<SimpleMECBeacon> beacons;
+    beacons.reserve(storage.size());
 
     for (auto it = storage.begin(); it != storage.end(); ++it)
     {
@@ -27,3 +30,12 @@ std::vector<SimpleMECBeacon> BeaconRepository::getAll()
 
     return beacons;
 }
+
+void BeaconRepository::getSince(uint64_t since, std::vector<const SimpleMECBeacon*>& out) const
+{
+    out.clear();
+    for (auto it = updates.upper_bound(since); it != updates.end(); ++it)
+    {
+        out.push_back(&storage.at(it->second).beacon);
+    }
+}
@@ -2,22 +2,35 @@
 
 #include "packets/SimpleMECBeacon_m.h"
 
+#include <cstdint>
 #include <map>
 #include <vector>
 
 struct StoredBeacon
 {
    SimpleMECBeacon beacon;
+   // sequence number of the last update
+   uint64_t seq = 0;
 };
 
 class BeaconRepository
 {
 private:
     std::map<int, StoredBeacon> storage;
+    // sequence number -> node id of all current beacons (for delta queries)
+    std::map<uint64_t, int> updates;
+    uint64_t seq = 0;
 
 public:
     void add(SimpleMECBeacon);
 
     std::vector<SimpleMECBeacon> getAll();
 
+    // Beacons added or updated after sequence number since (0: all) in update
+    // order. The pointers are valid until the next add().
+    void getSince(uint64_t since, std::vector<const SimpleMECBeacon*>& out) const;
+
+    // sequence number of the last update
+    uint64_t getSequenceNumber() const { return seq; }
+    std::size_t size() const { return storage.size(); }
 };
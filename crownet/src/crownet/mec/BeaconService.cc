@@ -38,6 +38,16 @@ void BeaconService::handleGETRequest(const HttpRequestMessage* msg, inet::TcpSoc
     {
         Http::send200Response(socket, beacon_json::serializeBeacons(beaconRepository.getAll()).dump().c_str());
     }
+    else if(uri.compare(baseUri + "/since") == 0)
+    {
+        // binary delta: beacons updated after the sequence number given as 'seq=<n>'
+        std::string body = binaryService.getSince(msg->getParameters());
+        Http::send200Response(socket, body.c_str());
+    }
+    else
+    {
+        EV << "Can't handle GET request for URI " << uri << std::endl;
+    }
 
 }
 
@@ -56,6 +66,12 @@ void BeaconService::handlePOSTRequest(const HttpRequestMessage* msg, inet::TcpSo
         EV << "Receive beacon: " << body << std::endl;
         beaconRepository.add(beacon_json::parseBeaconString(body));
     }
+    else if(uri.compare(baseUri + "/beacons") == 0)
+    {
+        // binary batch of beacons
+        std::size_t count = binaryService.receiveBatch(body);
+        EV << "Receive " << count << " beacons" << std::endl;
+    }
     else
     {
         EV << "Can't handle POST request for URI " << uri << std::endl;
@@ -4,6 +4,9 @@
 
 #include <nodes/mec/MECPlatform/MECServices/MECServiceBase/MecServiceBase.h>
 #include "BeaconRepository.h"
+#include "BeaconBinaryTransport.h"
+
+#include <string>
 
 class BeaconService: public MecServiceBase
 {
@@ -11,6 +14,7 @@ class BeaconService: public MecServiceBase
     std::string baseUri = "/example/Beacon/v1";
 
     BeaconRepository beaconRepository;
+    BeaconBinaryService binaryService{beaconRepository};
 
   public:
     BeaconService();
@@ -60,6 +60,13 @@ void MECBeaconApp::initialize(int stage)
     }
 
     period_ = par("period");
+    binaryEncoding = strcmp(par("beaconEncoding").stringValue(), "binary") == 0;
+    int batchSize = par("beaconBatchSize").intValue();
+    if (batchSize < 1)
+    {
+        throw cRuntimeError("MECBeaconApp::initialize: beaconBatchSize must be at least 1, got %d", batchSize);
+    }
+    binaryClient.setBatchSize(batchSize);
 
     stateRecorderVector.setName("stateRecorder");
     stateRecorderVector.record(0);
@@ -115,6 +122,15 @@ void MECBeaconApp::sendBeaconToService(const SimpleMECBeacon& beacon)
         return;
     }
 
+    if (binaryEncoding)
+    {
+        if (binaryClient.addBeacon(beacon))
+        {
+            sendPendingBeacons();
+        }
+        return;
+    }
+
     // Construct beacon JSON
     nlohmann::json beaconJson = beacon_json::serializeBeacon(beacon);
 
@@ -124,6 +140,17 @@ void MECBeaconApp::sendBeaconToService(const SimpleMECBeacon& beacon)
     Http::sendPostRequest(serviceSocket_, beaconJson.dump().c_str(), host.c_str(), uri.c_str());
 }
 
+void MECBeaconApp::sendPendingBeacons()
+{
+    if (!binaryClient.hasPending() || serviceSocket_->getState() != TcpSocket::CONNECTED)
+        return;
+
+    std::string uri = "/example/Beacon/v1/beacons";
+    std::string host = serviceSocket_->getRemoteAddress().str()+":"+std::to_string(serviceSocket_->getRemotePort());
+
+    Http::sendPostRequest(serviceSocket_, binaryClient.takeBatch().c_str(), host.c_str(), uri.c_str());
+}
+
 void MECBeaconApp::retrieveAllBeaconsFromService()
 {
     if (serviceSocket_->getState() != TcpSocket::CONNECTED)
@@ -134,9 +161,19 @@ void MECBeaconApp::retrieveAllBeaconsFromService()
 
     stateRecorderVector.record(5);
 
-    std::string uri = "/example/Beacon/v1/all";
     std::string host = serviceSocket_->getRemoteAddress().str()+":"+std::to_string(serviceSocket_->getRemotePort());
 
+    if (binaryEncoding)
+    {
+        // flush partial batch and ask only for beacons changed since the last response
+        sendPendingBeacons();
+        std::string params = binaryClient.getSinceParams();
+        Http::sendGetRequest(serviceSocket_, host.c_str(), "/example/Beacon/v1/since", params.c_str(), "");
+        return;
+    }
+
+    std::string uri = "/example/Beacon/v1/all";
+
     Http::sendGetRequest(serviceSocket_, host.c_str(), uri.c_str(), "", "");
 }
 
@@ -216,7 +253,16 @@ void MECBeaconApp::handleServiceMessage(int connId)
 
         stateRecorderVector.record(4);
 
-        std::vector<SimpleMECBeacon> beacons = beacon_json::parseBeaconsString(serviceHttpMessage->getBody());
+        std::vector<SimpleMECBeacon> beacons;
+        if (binaryEncoding)
+        {
+            // merge delta into the beacons known so far
+            beacons = binaryClient.merge(serviceHttpMessage->getBody());
+        }
+        else
+        {
+            beacons = beacon_json::parseBeaconsString(serviceHttpMessage->getBody());
+        }
 
         EV << "MECBeaconApp::handleServiceMessage -  Received " << beacons.size() << " beacons from service" << std::endl;
 
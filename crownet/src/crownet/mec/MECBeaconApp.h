@@ -14,7 +14,9 @@
 #include <nodes/mec/MECPlatform/ServiceRegistry/ServiceRegistry.h>
 
 #include <apps/mec/MecApps/MecAppBase.h>
+#include <vector>
 #include "aggregation/BeaconAggregationStrategy.h"
+#include "BeaconBinaryTransport.h"
 
 using namespace omnetpp;
 
@@ -43,6 +45,10 @@ class MECBeaconApp : public MecAppBase
     // State Recording
     cOutVector stateRecorderVector;
 
+    // binary transport: batched POST and delta GET
+    bool binaryEncoding;
+    BeaconBinaryClient binaryClient;
+
     protected:
         virtual int numInitStages() const override { return inet::NUM_INIT_STAGES; }
         virtual void initialize(int stage) override;
@@ -61,6 +67,7 @@ class MECBeaconApp : public MecAppBase
 
     private:
         void sendBeaconToService(const SimpleMECBeacon&);
+        void sendPendingBeacons();
         void retrieveAllBeaconsFromService();
 };
 
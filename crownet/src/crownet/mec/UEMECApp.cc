@@ -281,15 +281,17 @@ std::vector<UEMECApp::NodeMobility> UEMECApp::getMobilityBySubmoduleVector(const
 {
     std::vector<NodeMobility> mobilities;
 
-    cModule *nodes = getSystemModule()->getSubmodule(name, 0);
+    cModule *root = getSystemModule();
 
-    if (nodes != nullptr)
+    // slot 0 may be empty (departed node) thus use the vector size of the parent
+    if (root->hasSubmoduleVector(name))
     {
-        for (int i = 0; i < nodes->getVectorSize(); ++i)
+        for (int i = 0; i < root->getSubmoduleVectorSize(name); ++i)
         {
-            cModule *node = getSystemModule()->getSubmodule(name, i);
+            cModule *node = root->getSubmodule(name, i);
 
-            if (node != nullptr)
+            // skip empty slots and idle (not yet initialized) pooled nodes
+            if (node != nullptr && node->initialized())
             {
                 cModule *mobilitySubmodule = node->getSubmodule("mobility");
 
@@ -0,0 +1,309 @@
+/*
+ * BonnMotionBinaryFormat.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ *
+ * Binary BonnMotion trace format read by BonnMotionServerFile. Header only and
+ * without OMNeT++ dependencies so standalone tools (tools/bm2bin) can write the
+ * files.
+ *
+ * All integers and doubles are little endian.
+ *
+ *   magic        8B  "CRNTBM01"
+ *   is3D         u8  + 3B padding
+ *   traceCount   u32
+ *   indexOffset  u64 byte offset of the trace index
+ *   reserved     u64
+ *   data         waypoints of all traces (f64) in trace file order
+ *   index        traceCount entries sorted by start time (stable w.r.t.
+ *                trace file order). Per entry: u32 line, u32 value count,
+ *                f64 start time, f64 end time, u64 byte offset of the values
+ *
+ * The index is all that is needed to schedule node creation. Waypoints of a
+ * trace are only read when the node is created.
+ */
+
+#pragma once
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace crownet {
+namespace bmbin {
+
+static const char MAGIC[] = "CRNTBM01";
+static const std::size_t MAGIC_LEN = 8;
+static const std::size_t HEADER_SIZE = 32;
+static const std::size_t INDEX_ENTRY_SIZE = 32;
+
+struct TraceIndex {
+  uint32_t line;
+  uint32_t count;  // number of values (time, x, y[, z]) * waypoints
+  double start;
+  double end;
+  uint64_t offset;
+};
+
+template <typename T>
+inline void putLE(std::string& buf, T value) {
+  for (std::size_t i = 0; i < sizeof(T); i++) {
+    buf.push_back((char)((uint64_t)value >> (8 * i) & 0xFF));
+  }
+}
+
+inline void putDouble(std::string& buf, double value) {
+  uint64_t raw;
+  std::memcpy(&raw, &value, sizeof(raw));
+  putLE<uint64_t>(buf, raw);
+}
+
+template <typename T>
+inline T getLE(const char* p) {
+  uint64_t ret = 0;
+  for (std::size_t i = 0; i < sizeof(T); i++) {
+    ret |= (uint64_t)(uint8_t)p[i] << (8 * i);
+  }
+  return (T)ret;
+}
+
+inline double getDouble(const char* p) {
+  uint64_t raw = getLE<uint64_t>(p);
+  double ret;
+  std::memcpy(&ret, &raw, sizeof(ret));
+  return ret;
+}
+
+/**
+ * Parse one text line of a BonnMotion trace. Returns false for comments and
+ * empty lines. Throws if the number of values does not match the dimension.
+ */
+inline bool parseTextLine(const std::string& line, bool is3D, int lineCount,
+                          std::vector<double>& out) {
+  out.clear();
+  if (line.empty() || line.at(0) == '#') {
+    return false;
+  }
+  const char* p = line.c_str();
+  char* end = nullptr;
+  for (double d = std::strtod(p, &end); end != p; d = std::strtod(p, &end)) {
+    out.push_back(d);
+    p = end;
+  }
+  if (out.empty()) {
+    return false;
+  }
+  std::size_t minSize = is3D ? 4 : 3;
+  if (out.size() % minSize != 0) {
+    throw std::runtime_error("Expected multiple of " + std::to_string(minSize) +
+                             " elements in row got " + std::to_string(out.size()) +
+                             " for line " + std::to_string(lineCount));
+  }
+  if (out.size() == minSize) {
+    throw std::runtime_error("Expected at least " + std::to_string(2 * minSize) +
+                             " elements but got " + std::to_string(out.size()) +
+                             " for line " + std::to_string(lineCount) +
+                             ". (Need at least 2 points for speed interpolation.)");
+  }
+  return true;
+}
+
+/**
+ * Write traces to a seekable stream. The header is written again on finish()
+ * once the index offset is known.
+ */
+class BinaryTraceWriter {
+ public:
+  BinaryTraceWriter(std::ostream& out, bool is3D) : out(out), is3D(is3D) {
+    writeHeader(0);
+  }
+
+  void addTrace(const std::vector<double>& values) {
+    std::size_t step = is3D ? 4 : 3;
+    TraceIndex idx;
+    idx.line = (uint32_t)index.size();
+    idx.count = (uint32_t)values.size();
+    idx.start = values.front();
+    idx.end = values[values.size() - step];
+    idx.offset = offset;
+    index.push_back(idx);
+    buf.clear();
+    for (const auto v : values) {
+      putDouble(buf, v);
+    }
+    out.write(buf.data(), buf.size());
+    offset += buf.size();
+  }
+
+  void finish() {
+    std::stable_sort(index.begin(), index.end(),
+                     [](const TraceIndex& l, const TraceIndex& r) { return l.start < r.start; });
+    buf.clear();
+    for (const auto& e : index) {
+      putLE<uint32_t>(buf, e.line);
+      putLE<uint32_t>(buf, e.count);
+      putDouble(buf, e.start);
+      putDouble(buf, e.end);
+      putLE<uint64_t>(buf, e.offset);
+    }
+    out.write(buf.data(), buf.size());
+    out.seekp(0);
+    writeHeader(offset);
+    out.flush();
+    if (!out) {
+      throw std::runtime_error("cannot write binary trace");
+    }
+  }
+
+  std::size_t getTraceCount() const { return index.size(); }
+
+ private:
+  void writeHeader(uint64_t indexOffset) {
+    std::string h(MAGIC, MAGIC_LEN);
+    putLE<uint8_t>(h, is3D ? 1 : 0);
+    h.append(3, '\0');
+    putLE<uint32_t>(h, (uint32_t)index.size());
+    putLE<uint64_t>(h, indexOffset);
+    putLE<uint64_t>(h, 0);
+    out.write(h.data(), h.size());
+  }
+
+  std::ostream& out;
+  bool is3D;
+  uint64_t offset = HEADER_SIZE;
+  std::vector<TraceIndex> index;
+  std::string buf;
+};
+
+/**
+ * Convert a text trace (one trace per line) into the binary format. Returns
+ * the number of traces.
+ */
+inline std::size_t convertText(std::istream& in, std::ostream& out, bool is3D) {
+  BinaryTraceWriter writer(out, is3D);
+  std::string line;
+  std::vector<double> values;
+  int lineCount = 0;
+  while (std::getline(in, line)) {
+    if (parseTextLine(line, is3D, lineCount, values)) {
+      writer.addTrace(values);
+      ++lineCount;
+    }
+  }
+  writer.finish();
+  return writer.getTraceCount();
+}
+
+/**
+ * Read only memory map of a binary trace file. Pages are only loaded when a
+ * trace is accessed.
+ */
+class MappedTraceFile {
+ public:
+  MappedTraceFile() = default;
+  explicit MappedTraceFile(const std::string& path) { open(path); }
+  ~MappedTraceFile() { close(); }
+  MappedTraceFile(const MappedTraceFile&) = delete;
+  MappedTraceFile& operator=(const MappedTraceFile&) = delete;
+
+  void open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("cannot open '" + path + "': " + std::strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (std::size_t)st.st_size < HEADER_SIZE) {
+      ::close(fd);
+      throw std::runtime_error("not a binary BonnMotion trace '" + path + "'");
+    }
+    size = st.st_size;
+    void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+      size = 0;
+      throw std::runtime_error("cannot map '" + path + "': " + std::strerror(errno));
+    }
+    data = (const char*)p;
+    if (std::string(data, MAGIC_LEN) != std::string(MAGIC, MAGIC_LEN)) {
+      close();
+      throw std::runtime_error("not a binary BonnMotion trace '" + path + "'");
+    }
+    is3D = getLE<uint8_t>(data + 8) != 0;
+    traceCount = getLE<uint32_t>(data + 12);
+    indexOffset = getLE<uint64_t>(data + 16);
+    if (indexOffset + (uint64_t)traceCount * INDEX_ENTRY_SIZE > size) {
+      close();
+      throw std::runtime_error("corrupt binary BonnMotion trace '" + path + "'");
+    }
+  }
+
+  void close() {
+    if (data != nullptr) {
+      munmap((void*)data, size);
+    }
+    data = nullptr;
+    size = 0;
+    traceCount = 0;
+  }
+
+  bool isOpen() const { return data != nullptr; }
+  bool get3D() const { return is3D; }
+  uint32_t getTraceCount() const { return traceCount; }
+
+  // i-th trace in start time order
+  TraceIndex getIndex(uint32_t i) const {
+    const char* p = data + indexOffset + (uint64_t)i * INDEX_ENTRY_SIZE;
+    TraceIndex ret;
+    ret.line = getLE<uint32_t>(p);
+    ret.count = getLE<uint32_t>(p + 4);
+    ret.start = getDouble(p + 8);
+    ret.end = getDouble(p + 16);
+    ret.offset = getLE<uint64_t>(p + 24);
+    return ret;
+  }
+
+  void readTrace(const TraceIndex& idx, std::vector<double>& out) const {
+    if (idx.offset + (uint64_t)idx.count * 8 > indexOffset) {
+      throw std::runtime_error("corrupt trace " + std::to_string(idx.line));
+    }
+    out.resize(idx.count);
+    const char* p = data + idx.offset;
+    for (uint32_t i = 0; i < idx.count; i++) {
+      out[i] = getDouble(p + 8 * i);
+    }
+  }
+
+  // hint that the pages of a trace are not needed anymore.
+  void release(const TraceIndex& idx) const {
+    long page = sysconf(_SC_PAGESIZE);
+    uint64_t begin = (idx.offset + page - 1) / page * page;
+    uint64_t end = (idx.offset + (uint64_t)idx.count * 8) / page * page;
+    if (end > begin) {
+      madvise((void*)(data + begin), end - begin, MADV_DONTNEED);
+    }
+  }
+
+ private:
+  const char* data = nullptr;
+  std::size_t size = 0;
+  bool is3D = false;
+  uint32_t traceCount = 0;
+  uint64_t indexOffset = 0;
+};
+
+}  // namespace bmbin
+}  // namespace crownet
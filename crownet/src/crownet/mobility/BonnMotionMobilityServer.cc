@@ -13,8 +13,7 @@
 #include "crownet/mobility/BonnMotionMobilityClient.h"
 #include "crownet/common/GlobalDensityMap.h"
 
-#include <boost/iostreams/filtering_streambuf.hpp>
-#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <fstream>
 #include <iostream>
@@ -31,51 +30,49 @@
 
 namespace crownet {
 
+namespace {
+bool endsWith(const std::string& str, const std::string& suffix){
+    return str.size() >= suffix.size() && str.compare(str.size()-suffix.size(), suffix.size(), suffix) == 0;
+}
+}
+
 void BonnMotionServerFile::loadFile(const char *filename, bool is3D){
     std::string fname(filename);
-    std::stringstream inStr;
-    if (fname.compare(fname.size()-3, 3, ".gz") == 0){
-        //gz
-        std::ifstream file(fname.c_str(), std::ios_base::in | std::ios_base::binary);
-        boost::iostreams::filtering_streambuf<boost::iostreams::input> gzIn;
-        gzIn.push(boost::iostreams::gzip_decompressor());
-        gzIn.push(file);
-        boost::iostreams::copy(gzIn, inStr);
+    timeLine.clear();
+    traces.clear();
+    binaryIndex.clear();
+    nextTimeLineIndex = 0;
+    if (endsWith(fname, ".bmbin")){
+        loadBinaryFile(fname, is3D);
     } else {
-        std::ifstream file(fname.c_str(), std::ios::in);
-        if (file.fail())
-            throw cRuntimeError("Cannot open file '%s'", filename);
-        boost::iostreams::copy(file, inStr);
+        loadTextFile(fname, is3D);
     }
+}
+
+void BonnMotionServerFile::loadTextFile(const std::string& fname, bool is3D){
+    std::ifstream file(fname.c_str(), std::ios_base::in | std::ios_base::binary);
+    if (file.fail())
+        throw cRuntimeError("Cannot open file '%s'", fname.c_str());
+    // parse line by line. Do not copy the (decompressed) file into memory.
+    boost::iostreams::filtering_istream inStr;
+    if (endsWith(fname, ".gz")){
+        inStr.push(boost::iostreams::gzip_decompressor());
+    }
+    inStr.push(file);
 
     std::string line;
     int lineCount = 0;
-    int minSize = is3D ? 4 : 3;
+    BonnMotionFile::Line vec;
     while (std::getline(inStr, line)) {
-        if(line.at(0) == '#'){
-            continue; // ignore comets
-        }
-        lines.push_back(BonnMotionFile::Line());
-        BonnMotionFile::Line& vec = lines.back();
-
-        std::stringstream linestream(line);
-        double d;
-        while (linestream >> d)
-            vec.push_back(d);
-
-
-
-
-        if (((int)vec.size() % minSize) != 0 ){
-            throw cRuntimeError("Expected multiple of %i elements in row got %i for line %i",
-                        minSize, (int)vec.size(), lineCount);
-        }
-        if ((int)vec.size() == minSize){
-            throw cRuntimeError("Expected at least %i elements but got %i for line %i in %s mode. (Need at least 2 points for speed interpolation.)",
-                    2*minSize, (int)vec.size(), lineCount, is3D ? "3D" : "2D");
+        try {
+            if (!bmbin::parseTextLine(line, is3D, lineCount, vec)){
+                continue; // ignore comments
+            }
+        } catch (const std::runtime_error& e) {
+            throw cRuntimeError("%s in %s mode", e.what(), is3D ? "3D" : "2D");
         }
-
         timeLine.push_back(std::make_pair(lineCount, simtime_t(vec[0])));
+        traces[lineCount] = std::move(vec);
         ++lineCount;
     }
 
@@ -87,6 +84,50 @@ void BonnMotionServerFile::loadFile(const char *filename, bool is3D){
 
 }
 
+void BonnMotionServerFile::loadBinaryFile(const std::string& fname, bool is3D){
+    try {
+        mappedFile.open(fname);
+    } catch (const std::runtime_error& e) {
+        throw cRuntimeError("%s", e.what());
+    }
+    if (mappedFile.get3D() != is3D){
+        throw cRuntimeError("Binary trace '%s' is %s but %s was requested", fname.c_str(),
+                mappedFile.get3D() ? "3D" : "2D", is3D ? "3D" : "2D");
+    }
+    // index is already sorted by start time. Waypoints are read on demand.
+    auto n = mappedFile.getTraceCount();
+    timeLine.reserve(n);
+    binaryIndex.resize(n);
+    for (uint32_t i = 0; i < n; i++){
+        auto idx = mappedFile.getIndex(i);
+        if (idx.line >= n){
+            throw cRuntimeError("Corrupt index in binary trace '%s'", fname.c_str());
+        }
+        timeLine.push_back(std::make_pair((int)idx.line, simtime_t(idx.start)));
+        binaryIndex[idx.line] = idx;
+    }
+}
+
+const BonnMotionFile::Line* BonnMotionServerFile::getTrace(const int bmLine){
+    auto it = traces.find(bmLine);
+    if (it != traces.end()){
+        return &it->second;
+    }
+    if (!isBinary() || bmLine < 0 || bmLine >= (int)binaryIndex.size()){
+        throw cRuntimeError("No trace for line %d", bmLine);
+    }
+    auto& vec = traces[bmLine];
+    mappedFile.readTrace(binaryIndex[bmLine], vec);
+    return &vec;
+}
+
+void BonnMotionServerFile::releaseTrace(const int bmLine){
+    traces.erase(bmLine);
+    if (isBinary() && bmLine >= 0 && bmLine < (int)binaryIndex.size()){
+        mappedFile.release(binaryIndex[bmLine]);
+    }
+}
+
 bool BonnMotionServerFile::hasTraceForTime(const simtime_t time) const{
 
     return nextTimeLineIndex < timeLine.size() && timeLine[nextTimeLineIndex].second <= time.dbl();
@@ -184,7 +225,7 @@ void BonnMotionMobilityServer::handleMessage(cMessage *msg){
                             node->getFullPath().c_str());
 
                 }
-                mobily->initTrace(bmFile.getLine(timeLineIndex.first), is3D, timeLineIndex.first);
+                mobily->initTrace(bmFile.getTrace(timeLineIndex.first), is3D, timeLineIndex.first);
             };
 
 
@@ -251,6 +292,8 @@ void BonnMotionMobilityServer::removeNodeModule(const int bmLine){
       module->callFinish();
       module->deleteModule();
       nodeMap.erase(bmLine);
+      // waypoints not needed anymore
+      bmFile.releaseTrace(bmLine);
     } else {
       EV_DEBUG << "Node with BonnMotion trace " << bmLine << " does not exist, no removal\n";
     }
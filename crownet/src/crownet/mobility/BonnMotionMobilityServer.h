@@ -13,6 +13,7 @@
 #include <functional>
 #include "inet/mobility/single/BonnMotionFileCache.h"
 #include "crownet/artery/traci/TraCiNodeVisitorAcceptor.h"
+#include "crownet/mobility/BonnMotionBinaryFormat.h"
 
 
 using namespace inet;
@@ -23,6 +24,13 @@ namespace crownet {
 using BmTimedLineIndex = std::pair<int, simtime_t>;
 
 
+/*
+ * Trace file of the BonnMotionMobilityServer. Text traces (.bonnMotion, .gz)
+ * are parsed line by line. Binary traces (.bmbin, see BonnMotionBinaryFormat.h)
+ * are memory mapped and only the index is read at load time. Waypoints are
+ * accessed with getTrace() and must be released with releaseTrace() once the
+ * node is removed. (BonnMotionFile::getLine() is not used.)
+ */
 class BonnMotionServerFile : public BonnMotionFile{
 
 public:
@@ -36,9 +44,23 @@ public:
     bool hasNextTimeLineIndex() const;
     const BmTimedLineIndex peekAtNextTimeLineIndex();
 
+    const BonnMotionFile::Line* getTrace(const int bmLine);
+    void releaseTrace(const int bmLine);
+    std::size_t getLoadedTraceCount() const { return traces.size(); }
+    bool isBinary() const { return mappedFile.isOpen(); }
+
+protected:
+    void loadTextFile(const std::string& fname, bool is3D);
+    void loadBinaryFile(const std::string& fname, bool is3D);
+
 protected:
     std::vector<BmTimedLineIndex> timeLine;
     int nextTimeLineIndex = 0;
+    // waypoints of traces in use (key: line in trace file)
+    std::map<int, BonnMotionFile::Line> traces;
+    bmbin::MappedTraceFile mappedFile;
+    // binary index ordered by line in trace file
+    std::vector<bmbin::TraceIndex> binaryIndex;
 };
 
 
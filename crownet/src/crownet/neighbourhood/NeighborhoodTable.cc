@@ -7,12 +7,14 @@
 
 #include "crownet/neighbourhood/NeighborhoodTable.h"
 
+#include <algorithm>
 #include <omnetpp/simtime_t.h>
 #include <omnetpp/cstlwatch.h>
 #include <omnetpp/cwatch.h>
 #include "crownet/crownet.h"
 #include "crownet/common/GlobalDensityMap.h"
 #include "crownet/common/util/FileWriterRegister.h"
+#include "crownet/common/util/Profiler.h"
 #include "inet/common/ModuleAccess.h"
 #include "crownet/common/IDensityMapHandler.h"
 #include "crownet/dcd/regularGrid/RegularDcdMap.h"
@@ -36,7 +38,7 @@ NeighborhoodTable::~NeighborhoodTable(){
     if (ttl_msg != nullptr)
         cancelAndDelete(ttl_msg);
     for(auto e : _table){
-        delete(e.second);
+        deleteInfo(e.second);
     }
     _table.clear();
 }
@@ -84,6 +86,7 @@ void NeighborhoodTable::saveInfo(BeaconReceptionInfo* info) {
         // nothing present for this node id ==> set prio data to nullptr.
         info->updatePrioAppData(nullptr);
         _table[info->getNodeId()] = info;
+        scheduleTtl(info);
         tableSize = _table.size();
         setLastUpdatedAt(simTime());
         emit(neighborhoodTableChangedSignal, this);
@@ -93,8 +96,9 @@ void NeighborhoodTable::saveInfo(BeaconReceptionInfo* info) {
         info->updatePrioAppData(old_info);
         _table.erase(it);
         _table[info->getNodeId()] = info;
+        scheduleTtl(info);
         setLastUpdatedAt(simTime());
-        delete old_info;
+        deleteInfo(old_info);
         // no neighborhoodTableChangedSignal as size did not change
     }
 }
@@ -123,15 +127,16 @@ void NeighborhoodTable::removeInfo(BeaconReceptionInfo* info){
     if (it != _table.end()){
         auto old_info = it->second;
         it = _table.erase(it);
+        ttlGeneration.erase(info->getNodeId());
         tableSize = _table.size();
         setLastUpdatedAt(simTime());
         emit(neighborhoodTableChangedSignal, this);
         if (old_info == info){
             // same object delete only once
-            delete info;
+            deleteInfo(info);
         } else {
-            delete info;
-            delete old_info;
+            deleteInfo(info);
+            deleteInfo(old_info);
         }
     } else {
         // do nothing object not in map
@@ -163,8 +168,33 @@ bool NeighborhoodTable::processInfo(BeaconReceptionInfo *info){
     }
     // only save correctly ordered info objects into neighborhood table
     saveInfo(info);
+    processSaved(info);
+    return true;
+}
+
+bool NeighborhoodTable::processInfo(std::shared_ptr<BeaconReceptionInfo> info){
+    Enter_Method_Silent();
 
+    EV_INFO << "processInfo[id: " << ownerId << "] " << info->logShort() << endl;
+    if (!info->isUpdated()){
+        // out of order packet. The meter did not change the beacon data.
+        EV_INFO << "processInfo[id: " << ownerId << "] out of order. Ignore info object." << endl;
+        return true;
+    }
+    auto it = _table.find(info->getNodeId());
+    if (it != _table.end() && it->second == info.get()){
+        // state of the last beacon. The meter already moved the last beacon data to prioData.
+        scheduleTtl(info.get());
+        setLastUpdatedAt(simTime());
+    } else {
+        sharedInfos[info.get()] = info;
+        saveInfo(info.get());
+    }
+    processSaved(info.get());
+    return true;
+}
 
+void NeighborhoodTable::processSaved(BeaconReceptionInfo* info){
     if (ttlReached(info)){
         // information to old do not propagate to density map
         removeInfo(info);
@@ -189,30 +219,70 @@ bool NeighborhoodTable::processInfo(BeaconReceptionInfo *info){
             emitStayInCell(info);
         }
     }
-    return true;
+}
+
+void NeighborhoodTable::deleteInfo(BeaconReceptionInfo* info){
+    auto it = sharedInfos.find(info);
+    if (it == sharedInfos.end()){
+        delete info;
+    } else {
+        sharedInfos.erase(it);
+    }
 }
 
 bool NeighborhoodTable::ttlReached(BeaconReceptionInfo* info){
     return info->checkCurrentTtlReached(maxAge);
 }
 
+void NeighborhoodTable::scheduleTtl(const BeaconReceptionInfo* info){
+    auto generation = nextGeneration++;
+    ttlGeneration[info->getNodeId()] = generation;
+    ttlQueue.push(TtlEntry{info->getCurrentData()->getCreationTime() + maxAge, info->getNodeId(), generation});
+}
+
+void NeighborhoodTable::rebuildTtlQueue(){
+    ttlQueue = TtlQueue_t();
+    ttlGeneration.clear();
+    for(const auto& e : _table){
+        scheduleTtl(e.second);
+    }
+}
+
 void NeighborhoodTable::checkAllTimeToLive(){
     Enter_Method_Silent();
+    CROWNET_PROFILE_MODULE_SCOPE("nt.checkTtl", this);
 
     simtime_t now = simTime();
-    // remove old entries
-    for( auto it=_table.cbegin(); it !=_table.cend();){
-        // Received + maxAge := time at which entry must be removed.
-        if (ttlReached(it->second)){
-            emitRemoved(it->second);
-            auto obj = it->second;
-            it = _table.erase(it);
-            delete obj;
-            setLastUpdatedAt(now);
+    // Only look at heap entries whose expiry (creationTime + maxAge) has passed.
+    std::vector<int> expired;
+    while(!ttlQueue.empty() && ttlQueue.top().expiry < now){
+        auto entry = ttlQueue.top();
+        ttlQueue.pop();
+        auto gen = ttlGeneration.find(entry.nodeId);
+        if (gen == ttlGeneration.end() || gen->second != entry.generation){
+            continue; // node updated or removed after entry was scheduled.
+        }
+        auto it = _table.find(entry.nodeId);
+        if (it == _table.end()){
+            ttlGeneration.erase(gen);
+        } else if (ttlReached(it->second)){
+            expired.push_back(entry.nodeId);
         } else {
-            ++it;
+            // info object was updated in place (getForUpdate). Check again later.
+            scheduleTtl(it->second);
         }
     }
+    // remove old entries in node id order (same order as a full table scan)
+    std::sort(expired.begin(), expired.end());
+    for(const auto nodeId : expired){
+        auto it = _table.find(nodeId);
+        emitRemoved(it->second);
+        auto obj = it->second;
+        _table.erase(it);
+        ttlGeneration.erase(nodeId);
+        deleteInfo(obj);
+        setLastUpdatedAt(now);
+    }
     lastCheck = now;
     tableSize = _table.size();
     emit(neighborhoodTableChangedSignal, this);
@@ -8,6 +8,9 @@
 #pragma once
 
 #include <omnetpp/cobject.h>
+#include <queue>
+#include <unordered_map>
+#include <vector>
 #include "inet/common/InitStages.h"
 #include "crownet/neighbourhood/contract/INeighborhoodTable.h"
 #include "crownet/neighbourhood/contract/INeighborhoodSizeProvider.h"
@@ -43,6 +46,7 @@ public:
     virtual const int getSize() override;
 
     virtual bool processInfo(BeaconReceptionInfo *packet) override;
+    virtual bool processInfo(std::shared_ptr<BeaconReceptionInfo> info) override;
     virtual void saveInfo(BeaconReceptionInfo* info) override;
     virtual const BeaconReceptionInfo* find(int sourceId) const override;
 
@@ -55,8 +59,8 @@ public:
 
 
     //setter
-    void setMaxAge(const simtime_t& _maxAge) { maxAge = _maxAge; }
-    void setTable(const std::map<int, BeaconReceptionInfo*>& _nTable){ _table = _nTable;}
+    void setMaxAge(const simtime_t& _maxAge) { maxAge = _maxAge; rebuildTtlQueue(); }
+    void setTable(const std::map<int, BeaconReceptionInfo*>& _nTable){ _table = _nTable; rebuildTtlQueue(); }
     void setTitleMessage(cMessage *msg){ttl_msg = msg;}
     void setOwnerId(int ownerId) override {this->ownerId = ownerId;}
 
@@ -71,16 +75,41 @@ public:
     }
 
 protected:
+    // enter, leave or stay events (or remove if ttl reached) of saved info
+    void processSaved(BeaconReceptionInfo* info);
     virtual void removeInfo(BeaconReceptionInfo* info);
-
+    // delete owned info or release info shared with the meter
+    void deleteInfo(BeaconReceptionInfo* info);
+    // (re)schedule ttl check of info at creationTime + maxAge.
+    void scheduleTtl(const BeaconReceptionInfo* info);
+    void rebuildTtlQueue();
+
+    /*
+     * Min-heap entry ordered by expiry time. Entries are not removed from the
+     * heap when a node is updated or removed. Only the entry with the latest
+     * generation of a node is valid, all others are dropped when they reach
+     * the top of the heap.
+     */
+    struct TtlEntry {
+        simtime_t expiry;
+        int nodeId;
+        uint64_t generation;
+        bool operator>(const TtlEntry& other) const { return expiry > other.expiry; }
+    };
+    using TtlQueue_t = std::priority_queue<TtlEntry, std::vector<TtlEntry>, std::greater<TtlEntry>>;
 
 protected:
     int ownerId;
     int tableSize;
     NeighborhoodTable_t _table;
+    // entries of _table shared with the meter (not owned by the table)
+    std::unordered_map<const BeaconReceptionInfo*, std::shared_ptr<BeaconReceptionInfo>> sharedInfos;
     simtime_t maxAge;
     cMessage *ttl_msg = nullptr;
     simtime_t lastCheck;
+    TtlQueue_t ttlQueue;
+    std::unordered_map<int, uint64_t> ttlGeneration;
+    uint64_t nextGeneration = 0;
     std::shared_ptr<GridCellIDKeyProvider> cellKeyProvider;
 };
 
@@ -13,6 +13,7 @@
 #include "crownet/neighbourhood/NeighborhoodTableFilterIterator.h"
 
 #include <list>
+#include <memory>
 
 namespace crownet {
 
@@ -99,7 +100,10 @@ public:
     virtual const BeaconReceptionInfo* find(int sourceId) const = 0;
     virtual const BeaconReceptionInfo* get(int sourceId) const;
     virtual BeaconReceptionInfo* getForUpdate(int sourceId) const;
+    // take ownership of info
     virtual bool processInfo(BeaconReceptionInfo *info) = 0;
+    // keep state shared with the meter (see shareState()) without a copy
+    virtual bool processInfo(std::shared_ptr<BeaconReceptionInfo> info) = 0;
 };
 
 
@@ -24,6 +24,10 @@ namespace crownet {
 
 Define_Module(ApplicationPacketMeterIn);
 
+std::ostream& operator<<(std::ostream& os, const std::shared_ptr<AppRxInfoPerSource>& info){
+    return os << info->str();
+}
+
 
 ApplicationPacketMeterIn::ApplicationPacketMeterIn() {
     // TODO Auto-generated constructor stub
@@ -32,9 +36,7 @@ ApplicationPacketMeterIn::ApplicationPacketMeterIn() {
 
 ApplicationPacketMeterIn::~ApplicationPacketMeterIn() {
     delete appLevelInfo;
-    for(auto &e: appInfos){
-        delete e.second;
-    }
+    snapshots.clear();
     appInfos.clear();
 }
 
@@ -60,7 +62,7 @@ void ApplicationPacketMeterIn::initialize(int stage)
         appLevelInfo->setEma_smoothing_packet_size(emaSmoothingPacketSize);
 
         WATCH_PTR(appLevelInfo);
-        WATCH_PTRMAP(appInfos);
+        WATCH_MAP(appInfos);
     }
 }
 
@@ -68,12 +70,19 @@ void ApplicationPacketMeterIn::meterPacket(Packet *packet)
 {
     // todo how to handle self messages? aka hostId == sourceId
     GenericPacketMeter::meterPacket(packet);
+    meterSource(packet);
+}
+
+void ApplicationPacketMeterIn::meterSource(Packet *packet)
+{
     auto data = packet->peekData();
     int sourceId = data->getAllTags<HostIdTag>().front().getTag()->getHostId();
     auto now = simTime();
 
     // process source level statistics
-    AppRxInfoPerSource* info = getOrCreate(sourceId);
+    auto& info = getOrCreate(sourceId);
+    auto& snapshot = snapshots[sourceId];
+    detach(info, snapshot);
     info->processInbound(packet, hostId, now);
 
     // process application level statistics
@@ -81,22 +90,21 @@ void ApplicationPacketMeterIn::meterPacket(Packet *packet)
 
 
     if (appendAppInfo){
-        // append copy of current statistic object for application internal processing
-        auto tag = packet->addTagIfAbsent<AppRxInfoPerSourceTag>();
-        auto info_copy = info->dup();
-        tag->setPacketInfo(info_copy);
+        // share current statistic object (read only) for application internal processing
+        if (!snapshot){
+            snapshot = makeSnapshot(info);
+        }
+        packet->addTagIfAbsent<AppRxInfoPerSourceTag>()->setPacketInfo(snapshot);
     }
-    packet->addTagIfAbsent<RxPerSrcJitterTag>()->setJitter(info->getJitter());
-    packet->addTagIfAbsent<RxPerSrcAvgSizeTag>()->setSize(info->getAvg_packet_size());
-    packet->addTagIfAbsent<RxPerSrcPktCountTag>()->setCount(info->getPacketsReceivedCount());
-    packet->addTagIfAbsent<RxPerSrcPktLossCountTag>()->setCount(info->getPacketsLossCount());
-    packet->addTagIfAbsent<RxPerSrcTotalSentCountTag>()->setCount(info->getTotalSentPacketCount());
-
-    packet->addTagIfAbsent<RxPerAppAvgSizeTag>()->setSize(appLevelInfo->getAvg_packet_size());
-    packet->addTagIfAbsent<RxPerAppPktCountTag>()->setCount(appLevelInfo->getPacketsReceivedCount());
-
-
-    packet->addTagIfAbsent<RxSourceCountTag>()->setRxSourceCount(getNeighborhoodSize());
+    auto rxInfo = packet->addTagIfAbsent<RxInfoTag>();
+    rxInfo->setPerSrcJitter(info->getJitter());
+    rxInfo->setPerSrcAvgSize(info->getAvg_packet_size());
+    rxInfo->setPerSrcPktCount(info->getPacketsReceivedCount());
+    rxInfo->setPerSrcPktLossCount(info->getPacketsLossCount());
+    rxInfo->setPerSrcTotalSentCount(info->getTotalSentPacketCount());
+    rxInfo->setPerAppAvgSize(appLevelInfo->getAvg_packet_size());
+    rxInfo->setPerAppPktCount(appLevelInfo->getPacketsReceivedCount());
+    rxInfo->setRxSourceCount(getNeighborhoodSize());
 }
 
 const AppRxInfo* ApplicationPacketMeterIn::getAppRxInfo(const int id) const {
@@ -107,7 +115,7 @@ const AppRxInfo* ApplicationPacketMeterIn::getAppRxInfo(const int id) const {
       if (iter == appInfos.end()){
           throw cRuntimeError("No AppInfo object for nodeId %d", id);
       } else {
-          return iter->second;
+          return iter->second.get();
       }
     }
 }
@@ -116,9 +124,10 @@ const int ApplicationPacketMeterIn::getNeighborhoodSize() {
     return appInfos.size();
 }
 
-AppRxInfoPerSource* ApplicationPacketMeterIn::getOrCreate(int sourceId){
+std::shared_ptr<AppRxInfoPerSource>& ApplicationPacketMeterIn::getOrCreate(int sourceId){
 
-    if(appInfos.find(sourceId) == appInfos.end()){
+    auto& info = appInfos[sourceId];
+    if(!info){
         // no data from this host id. create new
         auto newInfo = dynamic_cast<AppRxInfoPerSource*>(appInfoFactor->createOne());
         if (newInfo == nullptr){
@@ -127,10 +136,28 @@ AppRxInfoPerSource* ApplicationPacketMeterIn::getOrCreate(int sourceId){
         newInfo->setNodeId(sourceId);
         newInfo->setEma_smoothing_jitter(emaSmoothingJitter);
         newInfo->setEma_smoothing_packet_size(emaSmoothingPacketSize);
-        take(newInfo);
-        appInfos[sourceId] = newInfo;
+        releaseOwnership(newInfo);
+        info.reset(newInfo);
     }
-    return appInfos[sourceId];
+    return info;
+}
+
+void ApplicationPacketMeterIn::detach(std::shared_ptr<AppRxInfoPerSource>& info, AppRxInfoPerSourceSnapshot& snapshot){
+    // references from shareState() (neighborhood table) do not count.
+    if (snapshot.use_count() > 1){
+        // a packet still references the current state. Keep it unchanged.
+        auto copy = info->dup();
+        releaseOwnership(copy);
+        info.reset(copy);
+        snapshot.reset();
+    }
+}
+
+void ApplicationPacketMeterIn::releaseOwnership(AppRxInfoPerSource* info){
+    // lifetime is managed by shared_ptr (shared with packets and the
+    // neighborhood table), which may outlive this module. No cObject owner.
+    take(info);
+    drop(info);
 }
 
 
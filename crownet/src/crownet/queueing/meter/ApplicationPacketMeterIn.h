@@ -16,13 +16,20 @@
 #ifndef CROWNET_QUEUEING_METER_APPLICATIONPACKETMETERIN_H_
 #define CROWNET_QUEUEING_METER_APPLICATIONPACKETMETERIN_H_
 
+#include <memory>
+
 #include "crownet/queueing/meter/GenericPacketMeter.h"
 #include "crownet/applications/common/info/AppRxInfoPerSource.h"
 #include "crownet/applications/common/info/AppRxInfoProvider.h"
 
 namespace crownet {
 
-using SourceAppInfoMap = std::map<int, AppRxInfoPerSource*>;
+// Per source statistics are shared with the AppRxInfoPerSourceTag of received
+// packets (see AppRxInfoPerSourceSnapshot). The meter only copies an object if
+// a packet still holds a snapshot when the next packet of the same source
+// arrives (copy on write).
+using SourceAppInfoMap = std::map<int, std::shared_ptr<AppRxInfoPerSource>>;
+using SourceSnapshotMap = std::map<int, AppRxInfoPerSourceSnapshot>;
 
 class ApplicationPacketMeterIn : public GenericPacketMeter, public AppRxInfoProvider {
 public:
@@ -33,7 +40,12 @@ public:
 protected:
     virtual void initialize(int stage) override;
     virtual void meterPacket(inet::Packet *packet) override;
-    virtual AppRxInfoPerSource* getOrCreate(int sourceId);
+    // per source and application level statistics and tags of meterPacket()
+    void meterSource(inet::Packet *packet);
+    virtual std::shared_ptr<AppRxInfoPerSource>& getOrCreate(int sourceId);
+    // ensure no packet holds a snapshot of info before it is updated.
+    void detach(std::shared_ptr<AppRxInfoPerSource>& info, AppRxInfoPerSourceSnapshot& snapshot);
+    void releaseOwnership(AppRxInfoPerSource* info);
 public:
     // AppRxInfoProvider
     virtual const AppRxInfo* getAppRxInfo( int id = -1) const override;
@@ -47,6 +59,7 @@ protected:
     double emaSmoothingJitter;
     double emaSmoothingPacketSize;
     SourceAppInfoMap appInfos;
+    SourceSnapshotMap snapshots; // last snapshot per source (reused if no packet holds it)
 };
 
 }// namespace
@@ -0,0 +1,150 @@
+/*
+ * bench_util.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <omnetpp.h>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "crownet/common/converter/OsgCoordConverter.h"
+#include "crownet/dcd/regularGrid/RegularDcdMap.h"
+
+namespace crownet {
+namespace bench {
+
+// incremented by the global operator new (see main_bench.cc)
+extern std::atomic<uint64_t> allocCount;
+extern std::atomic<uint64_t> allocBytes;
+
+/**
+ * Count heap allocations of the timed region. Call pause()/resume() together
+ * with state.PauseTiming()/ResumeTiming() to exclude setup code.
+ */
+class AllocCounter {
+ public:
+  AllocCounter() { resume(); }
+
+  void pause() {
+    count += allocCount.load(std::memory_order_relaxed) - count0;
+    bytes += allocBytes.load(std::memory_order_relaxed) - bytes0;
+  }
+  void resume() {
+    count0 = allocCount.load(std::memory_order_relaxed);
+    bytes0 = allocBytes.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Call once after the benchmark loop. Reports ops/s (items_per_second),
+   * allocations and allocated bytes per op.
+   */
+  void report(benchmark::State& state, int64_t opsPerIteration) {
+    reportTotal(state, state.iterations() * opsPerIteration);
+  }
+  // same as report() if the number of ops differs between iterations.
+  void reportTotal(benchmark::State& state, int64_t ops) {
+    pause();
+    state.SetItemsProcessed(ops);
+    state.counters["allocs_per_op"] = ops > 0 ? (double)count / ops : 0.0;
+    state.counters["bytes_per_op"] = ops > 0 ? (double)bytes / ops : 0.0;
+  }
+
+ private:
+  uint64_t count = 0;
+  uint64_t bytes = 0;
+  uint64_t count0 = 0;
+  uint64_t bytes0 = 0;
+};
+
+// current resident set size of the process in kB (/proc/self/statm)
+inline long residentKb() {
+  std::ifstream statm("/proc/self/statm");
+  long size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// peak resident set size of the process in kB (getrusage)
+inline long peakResidentKb() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+inline omnetpp::simtime_t setSimTime(omnetpp::simtime_t t) {
+  auto sim = omnetpp::cSimulation::getActiveSimulation();
+  auto old = sim->getSimTime();
+  sim->setSimTime(t);
+  return old;
+}
+
+inline omnetpp::simtime_t incrementSimTime(double incr = 1.0) {
+  auto sim = omnetpp::cSimulation::getActiveSimulation();
+  auto t = sim->getSimTime() + incr;
+  sim->setSimTime(t);
+  return t;
+}
+
+/**
+ * Synthetic density map on a 1000 x 1000 grid (1 m cells). entries are spread
+ * over entries/sourcesPerCell cells (row major) with sourcesPerCell foreign
+ * sources each.
+ */
+class SyntheticMap {
+ public:
+  static const int GRID = 1000;
+
+  explicit SyntheticMap(int sourcesPerCell = 10, const std::string& idStreamType = "default")
+      : sourcesPerCell(sourcesPerCell) {
+    converter = std::make_shared<OsgCoordinateConverter>(
+        inet::Coord(0.0, 0.0), inet::Coord(GRID, GRID), "EPSG:32632");
+    converter->setCellSize(inet::Coord(1.0, 1.0));
+    factory = std::make_shared<RegularDcdMapFactory>(converter);
+    map = factory->create_shared_ptr(IntIdentifer(42), idStreamType);
+  }
+
+  GridCellID cellOf(int64_t i) const {
+    int64_t c = i / sourcesPerCell;
+    return GridCellID((int)(c % GRID), (int)(c / GRID));
+  }
+  IntIdentifer sourceOf(int64_t i) const {
+    return IntIdentifer(100 + (int)(i % sourcesPerCell));
+  }
+  int64_t cellCount(int64_t entries) const {
+    return (entries + sourcesPerCell - 1) / sourcesPerCell;
+  }
+
+  // add (or overwrite) entries [0, n) measured at t.
+  void fill(int64_t n, omnetpp::simtime_t t) {
+    for (int64_t i = 0; i < n; i++) {
+      auto e = std::make_shared<GridEntry>(1 + (int)(i % 7), t, t, sourceOf(i),
+                                           EntryDist{(double)(i % 50), (double)(i % 50), 0.0});
+      map->setEntry(cellOf(i), std::move(e));
+    }
+  }
+
+  int sourcesPerCell;
+  std::shared_ptr<OsgCoordinateConverter> converter;
+  std::shared_ptr<RegularDcdMapFactory> factory;
+  std::shared_ptr<RegularDcdMap> map;
+};
+
+// 10^2 .. 10^6 entries
+inline void entryRange(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMicrosecond);
+}
+
+}  // namespace bench
+}  // namespace crownet
@@ -0,0 +1,86 @@
+/*
+ * EntryAllocatorBench.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "bench_util.h"
+
+#include <vector>
+
+#include "crownet/common/Entry.h"
+#include "crownet/common/EntryAllocator.h"
+#include "crownet/dcd/identifier/Identifiers.h"
+
+using namespace crownet;
+using namespace crownet::bench;
+
+namespace {
+
+using Entry = IEntry<IntIdentifer, omnetpp::simtime_t>;
+using GlobalEntry = IGlobalEntry<IntIdentifer, omnetpp::simtime_t>;
+
+void fill(std::vector<std::shared_ptr<Entry>>& entries,
+          const EntryDefaultCtorImpl<IntIdentifer, omnetpp::simtime_t>& ctor,
+          const std::shared_ptr<EntrySlabAllocator>& slab, int n) {
+  for (int i = 0; i < n; i++) {
+    if (i % 10 == 0) {
+      entries.push_back(ctor.globalEntry());
+    } else {
+      entries.push_back(makeSlabShared<Entry>(slab, 1.0, (double)i, (double)i, IntIdentifer(i)));
+    }
+  }
+}
+
+/**
+ * Create and drop N entries (90% IEntry / 10% IGlobalEntry) as done by the
+ * density map apps. One op is one entry. useSlab=false uses make_shared.
+ * The slab allocator is kept between iterations (like the one of a map).
+ *
+ * Resident memory (kB) is measured once after the timed loop for n live
+ * entries with a new allocator: before creating them (rss_before_kb), with
+ * all entries alive (rss_after_kb) and after dropping them (rss_free_kb).
+ * rss_peak_kb is the peak of the process (getrusage) and includes the other
+ * benchmarks run before.
+ */
+void createEntries(benchmark::State& state, bool useSlab) {
+  const int n = (int)state.range(0);
+  auto slab = useSlab ? std::make_shared<EntrySlabAllocator>() : nullptr;
+  EntryDefaultCtorImpl<IntIdentifer, omnetpp::simtime_t> ctor(slab);
+  std::vector<std::shared_ptr<Entry>> entries;
+  entries.reserve(n);
+
+  AllocCounter allocs;
+  for (auto _ : state) {
+    fill(entries, ctor, slab, n);
+    entries.clear();
+  }
+  allocs.report(state, n);
+  if (slab) {
+    state.counters["slab_chunks"] = slab->getStats().chunkAllocations;
+    state.counters["slab_reserved_kb"] = slab->getStats().reservedBytes / 1024.0;
+  }
+
+  std::vector<std::shared_ptr<Entry>> live;
+  live.reserve(n);
+  long rssBefore = residentKb();
+  {
+    auto rssSlab = useSlab ? std::make_shared<EntrySlabAllocator>() : nullptr;
+    EntryDefaultCtorImpl<IntIdentifer, omnetpp::simtime_t> rssCtor(rssSlab);
+    fill(live, rssCtor, rssSlab, n);
+    state.counters["rss_after_kb"] = residentKb();
+    live.clear();
+  }
+  state.counters["rss_before_kb"] = rssBefore;
+  state.counters["rss_free_kb"] = residentKb();
+  state.counters["rss_peak_kb"] = peakResidentKb();
+}
+
+}  // namespace
+
+static void BM_EntryAllocator_makeShared(benchmark::State& state) { createEntries(state, false); }
+BENCHMARK(BM_EntryAllocator_makeShared)->RangeMultiplier(10)->Range(1000, 100000);
+
+static void BM_EntryAllocator_slab(benchmark::State& state) { createEntries(state, true); }
+BENCHMARK(BM_EntryAllocator_slab)->RangeMultiplier(10)->Range(1000, 100000);
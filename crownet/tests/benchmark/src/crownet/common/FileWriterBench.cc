@@ -0,0 +1,50 @@
+/*
+ * FileWriterBench.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "bench_util.h"
+
+#include <boost/filesystem.hpp>
+
+#include "crownet/common/util/FileWriter.h"
+
+using namespace crownet;
+using namespace crownet::bench;
+
+namespace {
+
+/**
+ * Write csv like rows (similar to RegularDcdMapValuePrinter output) with the
+ * simulation thread (sync) or the AsyncFileSink I/O thread (async). One op is
+ * one row. close() is part of the timed region, thus async includes the time
+ * to drain the queue.
+ */
+void writeRows(benchmark::State& state, bool async) {
+  const int rows = (int)state.range(0);
+  auto path = (boost::filesystem::temp_directory_path() /
+               boost::filesystem::unique_path("%%%%-%%%%-bench.csv"))
+                  .string();
+  for (auto _ : state) {
+    BaseFileWriter w(path);
+    w.setAsyncWrite(async);
+    w.initialize();
+    for (int i = 0; i < rows; i++) {
+      w.write() << 0.4 * i << ";" << i % 100 << ";" << i / 100 << ";" << i % 7 << ";"
+                << 0.2 * i << ";" << 0.3 * i << ";" << 1000 + i << ";ymf;0;1;0;1;-1;0" << std::endl;
+    }
+    w.close();
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+  boost::filesystem::remove(path);
+}
+
+}  // namespace
+
+static void BM_FileWriter_sync(benchmark::State& state) { writeRows(state, false); }
+BENCHMARK(BM_FileWriter_sync)->Arg(200000)->Unit(benchmark::kMillisecond);
+
+static void BM_FileWriter_async(benchmark::State& state) { writeRows(state, true); }
+BENCHMARK(BM_FileWriter_async)->Arg(200000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,129 @@
+/*
+ * QuadTreeBench.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "bench_util.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "crownet/common/geometry/container/CountQuadTree.h"
+
+using namespace crownet;
+using namespace crownet::bench;
+using inet::Coord;
+
+namespace {
+
+const double radius = 50.0;
+const int k = 10;
+
+double sqrDist(const Coord& a, const Coord& b) {
+  return (a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y);
+}
+
+/**
+ * n uniform random points on 1000m x 1000m and 256 query centers. Points
+ * are stored in a QuadTree (capacity 8, depth 12) and in a vector for the
+ * linear scan (as done by the NeighborhoodTable predicates).
+ */
+struct Points {
+  explicit Points(int n) : tree(Coord{0.0, 0.0}, 1000.0, 1000.0, 8, 12) {
+    std::mt19937 rng(n);
+    std::uniform_real_distribution<double> u(0.0, 1000.0);
+    points.reserve(n);
+    for (int i = 0; i < n; i++) {
+      points.push_back(Coord(u(rng), u(rng)));
+      tree.insert(nullptr, points.back());
+    }
+    for (int q = 0; q < 256; q++) {
+      centers.push_back(Coord(u(rng), u(rng)));
+    }
+  }
+  const Coord& center(int64_t i) const { return centers[i % centers.size()]; }
+
+  CountQuadTree tree;
+  std::vector<Coord> points;
+  std::vector<Coord> centers;
+};
+
+void pointRange(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(10)->Range(100, 100000)->Unit(benchmark::kMicrosecond);
+}
+
+}  // namespace
+
+// one op is one radius query (50m)
+static void BM_QuadTree_radiusLinear(benchmark::State& state) {
+  Points p((int)state.range(0));
+  int64_t q = 0;
+  for (auto _ : state) {
+    const auto& c = p.center(q++);
+    std::vector<int> hits;
+    for (int i = 0; i < (int)p.points.size(); i++) {
+      if (sqrDist(p.points[i], c) <= radius * radius) hits.push_back(i);
+    }
+    benchmark::DoNotOptimize(hits.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QuadTree_radiusLinear)->Apply(pointRange);
+
+static void BM_QuadTree_radiusTree(benchmark::State& state) {
+  Points p((int)state.range(0));
+  int64_t q = 0;
+  for (auto _ : state) {
+    auto hits = p.tree.queryRadius(p.center(q++), radius);
+    benchmark::DoNotOptimize(hits.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QuadTree_radiusTree)->Apply(pointRange);
+
+// one op is one 10-nearest-neighbor query
+static void BM_QuadTree_kNearestLinear(benchmark::State& state) {
+  Points p((int)state.range(0));
+  std::vector<double> d;
+  d.reserve(p.points.size());
+  int64_t q = 0;
+  for (auto _ : state) {
+    const auto& c = p.center(q++);
+    d.clear();
+    for (const auto& point : p.points) d.push_back(sqrDist(point, c));
+    std::nth_element(d.begin(), d.begin() + std::min<std::size_t>(k, d.size() - 1), d.end());
+    benchmark::DoNotOptimize(d.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QuadTree_kNearestLinear)->Apply(pointRange);
+
+static void BM_QuadTree_kNearestTree(benchmark::State& state) {
+  Points p((int)state.range(0));
+  int64_t q = 0;
+  for (auto _ : state) {
+    auto hits = p.tree.kNearest(p.center(q++), k);
+    benchmark::DoNotOptimize(hits.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QuadTree_kNearestTree)->Apply(pointRange);
+
+// one op is one inserted point
+static void BM_QuadTree_insert(benchmark::State& state) {
+  const int n = (int)state.range(0);
+  std::mt19937 rng(n);
+  std::uniform_real_distribution<double> u(0.0, 1000.0);
+  std::vector<Coord> points;
+  for (int i = 0; i < n; i++) points.push_back(Coord(u(rng), u(rng)));
+  for (auto _ : state) {
+    CountQuadTree tree(Coord{0.0, 0.0}, 1000.0, 1000.0, 8, 12);
+    for (const auto& point : points) tree.insert(nullptr, point);
+    benchmark::DoNotOptimize(tree.dataSize());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_QuadTree_insert)->Apply(pointRange);
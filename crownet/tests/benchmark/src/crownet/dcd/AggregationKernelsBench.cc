@@ -0,0 +1,95 @@
+/*
+ * AggregationKernelsBench.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "bench_util.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "crownet/dcd/generic/AggregationKernels.h"
+
+using namespace crownet;
+using namespace crownet::bench;
+
+namespace {
+
+const double alpha = 0.3;
+
+// age and distance columns of range(0) entries of one cell
+struct Columns {
+  explicit Columns(std::size_t n) : age(n), dist(n), rank(n) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> u(0.0, 500.0);
+    ageMin = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < n; ++i) {
+      age[i] = u(gen);
+      dist[i] = u(gen);
+      ageMin = std::min(ageMin, age[i]);
+      ageSum += age[i];
+      distSum += dist[i];
+    }
+    ageSum -= n * ageMin;
+  }
+
+  std::vector<double> age;
+  std::vector<double> dist;
+  std::vector<double> rank;
+  double ageMin;
+  double ageSum = 0.0;
+  double distSum = 0.0;
+};
+
+void cellRange(benchmark::internal::Benchmark* b) {
+  b->Arg(7)->Arg(64)->Arg(1003);
+}
+
+}  // namespace
+
+// one op is the rank of one entry. Per entry code of the aggregation visitors.
+static void BM_AggregationKernels_ageDistRankLoop(benchmark::State& state) {
+  Columns c((std::size_t)state.range(0));
+  const std::size_t n = c.age.size();
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      double ageRank = (c.ageSum == 0) ? 1.0 : (c.age[i] - c.ageMin) / c.ageSum;
+      double distRank = (c.distSum == 0) ? 1.0 : c.dist[i] / c.distSum;
+      c.rank[i] = alpha * ageRank + (1 - alpha) * distRank;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_AggregationKernels_ageDistRankLoop)->Apply(cellRange);
+
+// fallback used if the CPU has no AVX2
+static void BM_AggregationKernels_ageDistRankScalar(benchmark::State& state) {
+  Columns c((std::size_t)state.range(0));
+  const std::size_t n = c.age.size();
+  for (auto _ : state) {
+    aggregation::detail::ageDistRankScalar(c.age.data(), c.dist.data(), c.rank.data(), 0, n,
+                                           c.ageMin, c.ageSum, c.distSum, alpha);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_AggregationKernels_ageDistRankScalar)->Apply(cellRange);
+
+// runtime dispatch (AVX2 if supported)
+static void BM_AggregationKernels_ageDistRank(benchmark::State& state) {
+  Columns c((std::size_t)state.range(0));
+  const std::size_t n = c.age.size();
+  for (auto _ : state) {
+    aggregation::ageDistRank(c.age.data(), c.dist.data(), c.rank.data(), n, c.ageMin,
+                             c.ageSum, c.distSum, alpha);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.counters["avx2"] = aggregation::detail::hasAvx2() ? 1 : 0;
+}
+BENCHMARK(BM_AggregationKernels_ageDistRank)->Apply(cellRange);
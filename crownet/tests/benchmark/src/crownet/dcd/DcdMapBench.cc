@@ -0,0 +1,173 @@
+/*
+ * DcdMapBench.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "bench_util.h"
+
+#include "crownet/applications/dmap/MapPacketBuild.h"
+#include "crownet/applications/dmap/MapPacketMerge.h"
+#include "crownet/applications/dmap/dmap_m.h"
+#include "crownet/dcd/regularGrid/MapCellAggregationAlgorithms.h"
+#include "crownet/dcd/regularGrid/RegularCellVisitors.h"
+
+using namespace crownet;
+using namespace crownet::bench;
+
+namespace {
+
+template <typename V>
+std::shared_ptr<V> makeVisitor(omnetpp::simtime_t t) {
+  return std::make_shared<V>(t);
+}
+template <>
+std::shared_ptr<YmfPlusDistVisitor> makeVisitor<YmfPlusDistVisitor>(omnetpp::simtime_t t) {
+  return std::make_shared<YmfPlusDistVisitor>(0.5, t);
+}
+template <>
+std::shared_ptr<YmfPlusDistStepVisitor> makeVisitor<YmfPlusDistStepVisitor>(omnetpp::simtime_t t) {
+  return std::make_shared<YmfPlusDistStepVisitor>(0.5, t, 20.0);
+}
+
+}  // namespace
+
+// insert received entries into an empty map
+static void BM_DcdMap_setEntry(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  setSimTime(10.0);
+  AllocCounter allocs;
+  for (auto _ : state) {
+    state.PauseTiming();
+    allocs.pause();
+    SyntheticMap m;
+    allocs.resume();
+    state.ResumeTiming();
+
+    m.fill(n, 10.0);
+    benchmark::DoNotOptimize(m.map.get());
+
+    state.PauseTiming();
+    allocs.pause();
+    m.map.reset();  // do not measure destruction
+    allocs.resume();
+    state.ResumeTiming();
+  }
+  allocs.report(state, n);
+}
+BENCHMARK(BM_DcdMap_setEntry)->Apply(entryRange);
+
+/**
+ * mergeReceivedCell (used by BaseDensityMapApp) for each cell of a received
+ * map: entry distance and get-or-create entry of the source.
+ */
+static void BM_DcdMap_mergeReceived(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  setSimTime(10.0);
+  SyntheticMap m;
+  m.fill(n, 10.0);
+  auto provider = m.factory->getCellKeyProvider();
+  inet::Coord sender(500.0, 500.0);
+  inet::Coord owner(250.0, 250.0);
+
+  AllocCounter allocs;
+  for (auto _ : state) {
+    auto now = incrementSimTime(0.1);
+    for (int64_t i = 0; i < n; i++) {
+      mergeReceivedCell(*m.map, *provider, sender, owner, m.sourceOf(i), m.cellOf(i), 2.0, now,
+                        now, (double)(i % 50));
+    }
+  }
+  allocs.report(state, n);
+}
+BENCHMARK(BM_DcdMap_mergeReceived)->Apply(entryRange);
+
+// Cell::computeValue of all cells with the given aggregation visitor
+template <typename V>
+static void BM_DcdMap_computeValues(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  setSimTime(10.0);
+  SyntheticMap m;
+  m.fill(n, 10.0);
+
+  AllocCounter allocs;
+  for (auto _ : state) {
+    // computeValues is idempotent per time step
+    auto now = incrementSimTime(0.1);
+    auto visitor = makeVisitor<V>(now);
+    m.map->computeValues(visitor.get());
+  }
+  allocs.report(state, n);
+}
+BENCHMARK_TEMPLATE(BM_DcdMap_computeValues, YmfVisitor)->Apply(entryRange);
+BENCHMARK_TEMPLATE(BM_DcdMap_computeValues, YmfPlusDistVisitor)->Apply(entryRange);
+BENCHMARK_TEMPLATE(BM_DcdMap_computeValues, YmfPlusDistStepVisitor)->Apply(entryRange);
+BENCHMARK_TEMPLATE(BM_DcdMap_computeValues, MeanVisitor)->Apply(entryRange);
+BENCHMARK_TEMPLATE(BM_DcdMap_computeValues, MedianVisitor)->Apply(entryRange);
+
+/**
+ * fillSparseMapPacket (BaseDensityMapApp::buildPayload, SPARSE): take all
+ * cells from the cell id stream and fill the packet. One op is one cell.
+ */
+static void BM_DcdMap_buildPayload(benchmark::State& state, const char* idStreamType) {
+  const int64_t n = state.range(0);
+  setSimTime(10.0);
+  SyntheticMap m(10, idStreamType);
+  m.fill(n, 10.0);
+  const int maxCellCount = (int)m.cellCount(n);
+
+  int64_t cells = 0;
+  AllocCounter allocs;
+  for (auto _ : state) {
+    state.PauseTiming();
+    allocs.pause();
+    auto now = incrementSimTime(0.1);
+    YmfVisitor visitor{now};
+    m.map->computeValues(&visitor);
+    auto payload = inet::makeShared<SparseMapPacket>();
+    inet::b maxData = payload->getChunkLength() + payload->getCellSize() * maxCellCount;
+    allocs.resume();
+    state.ResumeTiming();
+
+    cells += fillSparseMapPacket(*m.map, *payload, maxData, now);
+  }
+  allocs.reportTotal(state, cells);
+  state.counters["cells"] = (double)cells / state.iterations();
+}
+BENCHMARK_CAPTURE(BM_DcdMap_buildPayload, insertionOrder, "insertionOrder")->Apply(entryRange);
+BENCHMARK_CAPTURE(BM_DcdMap_buildPayload, roundRobin, "roundRobin")->Apply(entryRange);
+BENCHMARK_CAPTURE(BM_DcdMap_buildPayload, oldestSentFirst, "oldestSentFirst")->Apply(entryRange);
+BENCHMARK_CAPTURE(BM_DcdMap_buildPayload, highestChangeFirst, "highestChangeFirst")->Apply(entryRange);
+
+// position -> cell id lookups
+static void BM_GridCellIDKeyProvider_getCellKey(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  SyntheticMap m;
+  auto provider = m.factory->getCellKeyProvider();
+  AllocCounter allocs;
+  for (auto _ : state) {
+    for (int64_t i = 0; i < n; i++) {
+      inet::Coord pos((double)(i % 997) + 0.5, (double)((i / 997) % 997) + 0.5);
+      benchmark::DoNotOptimize(provider->getCellKey(pos));
+    }
+  }
+  allocs.report(state, n);
+}
+BENCHMARK(BM_GridCellIDKeyProvider_getCellKey)->Apply(entryRange);
+
+static void BM_GridCellIDKeyProvider_getExactDist(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  SyntheticMap m;
+  auto provider = m.factory->getCellKeyProvider();
+  inet::Coord sender(500.0, 500.0);
+  inet::Coord owner(250.0, 250.0);
+  AllocCounter allocs;
+  for (auto _ : state) {
+    for (int64_t i = 0; i < n; i++) {
+      benchmark::DoNotOptimize(provider->getExactDist(sender, owner, m.cellOf(i), 5.0));
+    }
+  }
+  allocs.report(state, n);
+}
+BENCHMARK(BM_GridCellIDKeyProvider_getExactDist)->Apply(entryRange);
@@ -0,0 +1,112 @@
+/*
+ * BeaconTransportBench.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "bench_util.h"
+
+#include <string>
+#include <vector>
+
+#include "crownet/mec/BeaconBinaryTransport.h"
+#include "crownet/mec/BeaconJSON.h"
+#include "crownet/mec/BeaconRepository.h"
+
+using namespace crownet::bench;
+
+namespace {
+
+const int periods = 20;
+const int apps = 4;
+
+SimpleMECBeacon makeBeacon(int id, double x, double y) {
+  SimpleMECBeacon beacon;
+  beacon.setNodeId(id);
+  beacon.setNodeType(1);
+  beacon.setXPos(x);
+  beacon.setYPos(y);
+  return beacon;
+}
+
+// half of the nodes move per period
+bool moves(int node, int period) { return period == 0 || node % 2 != period % 2; }
+
+void reportTransport(benchmark::State& state, double bytes, double requests) {
+  state.SetItemsProcessed(state.iterations() * periods);
+  state.counters["body_bytes"] = bytes;
+  state.counters["requests"] = requests;
+}
+
+}  // namespace
+
+/**
+ * Beacon exchange between MEC apps and the repository of the MEC host
+ * (BeaconService) without network: range(0) nodes send one beacon per period,
+ * each of the 4 apps polls the repository once per period. One op is one
+ * period. body_bytes and requests are per iteration.
+ */
+static void BM_BeaconTransport_json(benchmark::State& state) {
+  const int nodes = (int)state.range(0);
+  std::size_t bytes = 0;
+  std::size_t requests = 0;
+  for (auto _ : state) {
+    BeaconRepository repo;
+    bytes = 0;
+    requests = 0;
+    for (int p = 0; p < periods; p++) {
+      // MECBeaconApp::sendBeaconToService, BeaconService::handlePOSTRequest
+      for (int n = 0; n < nodes; n++) {
+        if (!moves(n, p)) continue;
+        std::string body = beacon_json::serializeBeacon(makeBeacon(n, n + p, p)).dump();
+        repo.add(beacon_json::parseBeaconString(body));
+        bytes += body.size();
+        requests++;
+      }
+      // BeaconService::handleGETRequest, MECBeaconApp::handleServiceMessage
+      for (int a = 0; a < apps; a++) {
+        std::string body = beacon_json::serializeBeacons(repo.getAll()).dump();
+        benchmark::DoNotOptimize(beacon_json::parseBeaconsString(body));
+        bytes += body.size();
+        requests++;
+      }
+    }
+  }
+  reportTransport(state, bytes, requests);
+}
+BENCHMARK(BM_BeaconTransport_json)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
+
+// same exchange with batched POST (one per app) and delta GET
+static void BM_BeaconTransport_binary(benchmark::State& state) {
+  const int nodes = (int)state.range(0);
+  std::size_t bytes = 0;
+  std::size_t requests = 0;
+  for (auto _ : state) {
+    BeaconRepository repo;
+    BeaconBinaryService service(repo);
+    std::vector<BeaconBinaryClient> clients(apps);
+    for (auto& client : clients) client.setBatchSize(nodes);
+    bytes = 0;
+    requests = 0;
+    for (int p = 0; p < periods; p++) {
+      for (int a = 0; a < apps; a++) {
+        for (int n = a; n < nodes; n += apps) {
+          if (moves(n, p)) clients[a].addBeacon(makeBeacon(n, n + p, p));
+        }
+        std::string body = clients[a].takeBatch();
+        service.receiveBatch(body);
+        bytes += body.size();
+        requests++;
+      }
+      for (int a = 0; a < apps; a++) {
+        std::string body = service.getSince(clients[a].getSinceParams());
+        benchmark::DoNotOptimize(clients[a].merge(body).data());
+        bytes += body.size();
+        requests++;
+      }
+    }
+  }
+  reportTransport(state, bytes, requests);
+}
+BENCHMARK(BM_BeaconTransport_binary)->Arg(100)->Arg(500)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,161 @@
+/*
+ * BonnMotionBench.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "bench_util.h"
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "crownet/mobility/BonnMotionMobilityServer.h"
+
+using namespace crownet;
+using namespace crownet::bench;
+namespace fs = boost::filesystem;
+
+namespace {
+
+// BonnMotionTest fixture traces (tests/gtest/src/crownet/mobility)
+fs::path fixtureDir() {
+  return fs::absolute(__FILE__).parent_path().parent_path().parent_path()
+             .parent_path().parent_path() / "gtest" / "src" / "crownet" / "mobility";
+}
+
+/**
+ * Temporary text and binary trace files with n traces. Removed on
+ * destruction.
+ *
+ * - random walk: traces of 100 waypoints each (0.4 s steps)
+ * - fixture: the traces of bmFile1.bonnMotion (BonnMotionTest) repeated
+ *   until n traces are written.
+ */
+struct TraceFiles {
+  TraceFiles(int n, bool fixture) {
+    text = fs::temp_directory_path() / fs::unique_path("%%%%-%%%%-bench.bonnMotion");
+    binary = fs::temp_directory_path() / fs::unique_path("%%%%-%%%%-bench.bmbin");
+    {
+      std::ofstream out(text.c_str());
+      if (fixture) {
+        writeFixture(out, n);
+      } else {
+        writeRandomWalk(out, n);
+      }
+    }
+    std::ifstream in(text.c_str());
+    std::ofstream out(binary.c_str(), std::ios::binary);
+    bmbin::convertText(in, out, false);
+  }
+  ~TraceFiles() {
+    fs::remove(text);
+    fs::remove(binary);
+  }
+
+  static void writeRandomWalk(std::ostream& out, int n) {
+    std::mt19937 rng(n);
+    std::uniform_real_distribution<double> start(0.0, 500.0);
+    std::uniform_real_distribution<double> step(-0.5, 0.5);
+    for (int i = 0; i < n; i++) {
+      double x = start(rng), y = start(rng);
+      double t = 0.4 * (i % 10);
+      for (int w = 0; w < 100; w++) {
+        out << (w > 0 ? " " : "") << t << " " << x << " " << y;
+        t += 0.4;
+        x += step(rng);
+        y += step(rng);
+      }
+      out << "\n";
+    }
+  }
+
+  static void writeFixture(std::ostream& out, int n) {
+    std::vector<std::string> lines;
+    std::ifstream in((fixtureDir() / "bmFile1.bonnMotion").c_str());
+    std::string line;
+    while (std::getline(in, line)) {
+      if (!line.empty()) lines.push_back(line);
+    }
+    if (lines.empty()) {
+      throw omnetpp::cRuntimeError("no fixture traces in %s", fixtureDir().c_str());
+    }
+    for (int i = 0; i < n; i++) {
+      out << lines[i % lines.size()] << "\n";
+    }
+  }
+
+  fs::path text;
+  fs::path binary;
+};
+
+/**
+ * Load a trace file as done at simulation start. One op is one trace of the
+ * file. Text files are parsed completely, binary files only read the
+ * time line index (traces are read on node creation).
+ *
+ * Resident memory (kB, relative to before loading) is measured once after
+ * the timed loop for one file: after loading (rss_load_kb), after all traces
+ * are read as done on node creation (rss_traces_kb) and after all traces are
+ * released again as done on node removal (rss_release_kb).
+ *
+ * range(0): number of traces, range(1): 1 fixture traces, 0 random walk.
+ */
+void loadTraces(benchmark::State& state, bool binary) {
+  const int n = (int)state.range(0);
+  TraceFiles files(n, state.range(1) != 0);
+  const auto& path = binary ? files.binary : files.text;
+  int loaded = 0;
+
+  AllocCounter allocs;
+  for (auto _ : state) {
+    BonnMotionServerFile file;
+    file.loadFile(path.c_str());
+    loaded = file.getLoadedTraceCount();
+    auto next = file.peekAtNextTimeLineIndex();
+    benchmark::DoNotOptimize(next);
+  }
+  allocs.report(state, n);
+  state.counters["traces_loaded"] = loaded;
+
+  long rss0 = residentKb();
+  {
+    BonnMotionServerFile file;
+    file.loadFile(path.c_str());
+    long rssLoad = residentKb();
+    std::vector<int> lines;
+    while (file.hasNextTimeLineIndex()) {
+      auto next = file.peekAtNextTimeLineIndex();
+      file.getNextTimeLineIndex(next.second);
+      benchmark::DoNotOptimize(file.getTrace(next.first));
+      lines.push_back(next.first);
+    }
+    long rssTraces = residentKb();
+    for (int line : lines) {
+      file.releaseTrace(line);
+    }
+    state.counters["rss_load_kb"] = rssLoad - rss0;
+    state.counters["rss_traces_kb"] = rssTraces - rss0;
+    state.counters["rss_release_kb"] = residentKb() - rss0;
+  }
+  state.counters["rss_peak_kb"] = peakResidentKb();
+}
+
+}  // namespace
+
+// random walk and BonnMotionTest fixture traces
+static void traceArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"traces", "fixture"})
+      ->Args({5000, 0})
+      ->Args({5000, 1})
+      ->Unit(benchmark::kMillisecond);
+}
+
+static void BM_BonnMotion_loadText(benchmark::State& state) { loadTraces(state, false); }
+BENCHMARK(BM_BonnMotion_loadText)->Apply(traceArgs);
+
+static void BM_BonnMotion_loadBinary(benchmark::State& state) { loadTraces(state, true); }
+BENCHMARK(BM_BonnMotion_loadBinary)->Apply(traceArgs);
@@ -0,0 +1,95 @@
+/*
+ * NeighborhoodTableBench.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "bench_util.h"
+
+#include "crownet/applications/beacon/BeaconReceptionInfo.h"
+#include "crownet/neighbourhood/NeighborhoodTable.h"
+
+using namespace crownet;
+using namespace crownet::bench;
+
+namespace {
+
+BeaconReceptionInfo* createInfo(int nodeId, omnetpp::simtime_t t) {
+  auto info = new BeaconReceptionInfo();
+  info->setNodeId(nodeId);
+  info->initAppData();
+  auto data = info->getCurrentDataForUpdate();
+  data->setCreationTimeStamp((uint32_t)t.inUnit(SimTimeUnit::SIMTIME_MS));
+  data->setCreationTime(t);
+  data->setReceivedTime(t);
+  data->setPosition(inet::Coord(nodeId % 1000, nodeId / 1000));
+  return info;
+}
+
+void fill(NeighborhoodTable& table, int64_t n, omnetpp::simtime_t t) {
+  for (int64_t i = 0; i < n; i++) {
+    table.saveInfo(createInfo((int)i, t));
+  }
+}
+
+}  // namespace
+
+// beacon of a known neighbor replaces the old info object
+static void BM_NeighborhoodTable_saveInfo(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  setSimTime(10.0);
+  NeighborhoodTable table;
+  table.setMaxAge(5.0);
+  fill(table, n, 10.0);
+
+  AllocCounter allocs;
+  for (auto _ : state) {
+    auto now = incrementSimTime(0.001);
+    for (int64_t i = 0; i < n; i++) {
+      table.saveInfo(createInfo((int)i, now));
+    }
+  }
+  allocs.report(state, n);
+}
+BENCHMARK(BM_NeighborhoodTable_saveInfo)->Apply(entryRange);
+
+// periodic TTL check without expired neighbors (common case)
+static void BM_NeighborhoodTable_checkTtlNoneExpired(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  setSimTime(10.0);
+  NeighborhoodTable table;
+  table.setMaxAge(1e6);
+  fill(table, n, 10.0);
+
+  AllocCounter allocs;
+  for (auto _ : state) {
+    incrementSimTime(0.001);
+    table.checkAllTimeToLive();
+  }
+  allocs.report(state, 1);
+  state.counters["size"] = table.getSize();
+}
+BENCHMARK(BM_NeighborhoodTable_checkTtlNoneExpired)->Apply(entryRange);
+
+// all n neighbors expire in one TTL check. One op is one removed neighbor.
+static void BM_NeighborhoodTable_checkTtlAllExpired(benchmark::State& state) {
+  const int64_t n = state.range(0);
+  setSimTime(10.0);
+  NeighborhoodTable table;
+  table.setMaxAge(1.0);
+
+  AllocCounter allocs;
+  for (auto _ : state) {
+    state.PauseTiming();
+    allocs.pause();
+    fill(table, n, incrementSimTime(0.1));
+    incrementSimTime(2.0);
+    allocs.resume();
+    state.ResumeTiming();
+
+    table.checkAllTimeToLive();
+  }
+  allocs.report(state, n);
+}
+BENCHMARK(BM_NeighborhoodTable_checkTtlAllExpired)->Apply(entryRange);
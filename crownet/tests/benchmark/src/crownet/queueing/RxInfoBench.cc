@@ -0,0 +1,122 @@
+/*
+ * RxInfoBench.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "bench_util.h"
+
+#include "crownet/applications/beacon/BeaconReceptionInfo.h"
+#include "crownet/applications/beacon/Beacon_m.h"
+#include "crownet/applications/common/AppCommon_m.h"
+#include "crownet/applications/common/info/InfoTags_m.h"
+#include "crownet/neighbourhood/NeighborhoodTable.h"
+#include "crownet/queueing/meter/ApplicationPacketMeterIn.h"
+
+using namespace crownet;
+using namespace crownet::bench;
+
+namespace {
+
+// count copies made of the per source info object
+class CountingInfo : public BeaconReceptionInfo {
+ public:
+  CountingInfo() : BeaconReceptionInfo() {}
+  CountingInfo(const CountingInfo& other) : BeaconReceptionInfo(other) { copies++; }
+  virtual CountingInfo* dup() const override { return new CountingInfo(*this); }
+  static int64_t copies;
+};
+int64_t CountingInfo::copies = 0;
+
+// meter without module setup (parameters, GenericPacketMeter)
+class BenchMeter : public ApplicationPacketMeterIn {
+ public:
+  BenchMeter() {
+    hostId = 1;
+    appendAppInfo = true;
+    emaSmoothingJitter = 1.0 / 16;
+    emaSmoothingPacketSize = 1.0 / 16;
+    appLevelInfo = new AppRxInfoPerSource();
+    take(appLevelInfo);
+  }
+  using ApplicationPacketMeterIn::meterSource;
+
+ protected:
+  virtual std::shared_ptr<AppRxInfoPerSource>& getOrCreate(int sourceId) override {
+    auto& info = appInfos[sourceId];
+    if (!info) {
+      auto newInfo = new CountingInfo();
+      newInfo->setNodeId(sourceId);
+      releaseOwnership(newInfo);
+      info.reset(newInfo);
+    }
+    return info;
+  }
+};
+
+class BenchTable : public NeighborhoodTable {
+ public:
+  BenchTable(std::shared_ptr<OsgCoordinateConverter> converter) {
+    cellKeyProvider = std::make_shared<GridCellIDKeyProvider>(converter);
+    setMaxAge(1e6);
+  }
+};
+
+Packet* createBeacon(int seq, int sourceId) {
+  const auto& chunk = makeShared<DynamicBeaconPacket>();
+  chunk->setSequenceNumber(seq);
+  chunk->setSourceId(sourceId);
+  chunk->setTimestamp((uint32_t)simTime().inUnit(SimTimeUnit::SIMTIME_MS));
+  chunk->setPos(inet::Coord(1.0 + seq % 10, 2.0));
+  chunk->setEpsilon(inet::Coord(0.0, 0.0));
+  chunk->addTagIfAbsent<HostIdTag>()->setHostId(sourceId);
+  auto packet = new Packet();
+  packet->insertAtFront(chunk);
+  return packet;
+}
+
+/**
+ * Receive path of one beacon: meter, BeaconDynamic::handleDataArrived and
+ * neighborhood table. One op is one beacon of one of 100 sources.
+ * copyPerPacket: the table gets a dup() of the meter state (previous
+ * BeaconDynamic). sharedState: the table keeps the meter state (shareState).
+ */
+void receiveBeacons(benchmark::State& state, bool copyPerPacket) {
+  const int sources = 100;
+  setSimTime(10.0);
+  SyntheticMap grid(1);
+  BenchMeter meter;
+  BenchTable table(grid.converter);
+  CountingInfo::copies = 0;
+  int seq = 0;
+  int tags = 0;
+
+  AllocCounter allocs;
+  for (auto _ : state) {
+    incrementSimTime(0.001);
+    seq++;
+    auto packet = createBeacon(seq / sources, 100 + seq % sources);
+    meter.meterSource(packet);
+    auto snapshot = packet->getTag<AppRxInfoPerSourceTag>()->getPacketInfo();
+    auto info = std::dynamic_pointer_cast<BeaconReceptionInfo>(shareState(snapshot));
+    if (copyPerPacket) {
+      table.processInfo(info->dup());
+    } else {
+      table.processInfo(info);
+    }
+    tags = packet->getNumTags();
+    delete packet;
+  }
+  allocs.report(state, 1);
+  state.counters["copies_per_op"] = state.iterations() > 0 ? (double)CountingInfo::copies / state.iterations() : 0.0;
+  state.counters["tags_per_packet"] = tags;
+}
+
+}  // namespace
+
+static void BM_RxInfo_copyPerPacket(benchmark::State& state) { receiveBeacons(state, true); }
+BENCHMARK(BM_RxInfo_copyPerPacket);
+
+static void BM_RxInfo_sharedState(benchmark::State& state) { receiveBeacons(state, false); }
+BENCHMARK(BM_RxInfo_sharedState);
@@ -0,0 +1,104 @@
+/*
+ * main_bench.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ *
+ * Headless micro benchmarks (google benchmark). Same simulation setup as the
+ * gtest suite (tests/gtest/src/main_test.cc) without any network.
+ *
+ *   make bench                       # all benchmarks, JSON in tests/benchmark/results
+ *   make bench BFILTER=DcdMap        # --benchmark_filter
+ */
+
+#include <cstdlib>
+#include <new>
+
+#include "bench_util.h"
+
+using namespace omnetpp;
+
+namespace crownet {
+namespace bench {
+std::atomic<uint64_t> allocCount{0};
+std::atomic<uint64_t> allocBytes{0};
+}  // namespace bench
+}  // namespace crownet
+
+// count all heap allocations of the process (see AllocCounter)
+void* operator new(std::size_t size) {
+  crownet::bench::allocCount.fetch_add(1, std::memory_order_relaxed);
+  crownet::bench::allocBytes.fetch_add(size, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+class EmptyConfig : public cConfiguration {
+ protected:
+  class NullKeyValue : public KeyValue {
+   public:
+    virtual const char *getKey() const { return nullptr; }
+    virtual const char *getValue() const { return nullptr; }
+    virtual const char *getBaseDirectory() const { return nullptr; }
+  };
+  NullKeyValue nullKeyValue;
+
+ public:
+  virtual const char *substituteVariables(const char *value) const { return value; }
+  virtual const char *getConfigValue(const char *key) const { return nullptr; }
+  virtual const KeyValue &getConfigEntry(const char *key) const { return nullKeyValue; }
+  virtual const char *getPerObjectConfigValue(const char *objectFullPath,
+                                              const char *keySuffix) const {
+    return nullptr;
+  }
+  virtual const KeyValue &getPerObjectConfigEntry(const char *objectFullPath,
+                                                  const char *keySuffix) const {
+    return nullKeyValue;
+  }
+};
+
+class BenchEnv : public cNullEnvir {
+ public:
+  BenchEnv(int ac, char **av, cConfiguration *c) : cNullEnvir(ac, av, c) {}
+  virtual void readParameter(cPar *par) {
+    if (par->containsValue())
+      par->acceptDefault();
+    else
+      throw cRuntimeError("no value for %s", par->getFullPath().c_str());
+  }
+  // module log is not part of the measurement
+  virtual void sputn(const char *s, int n) {}
+};
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+  if (::benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+  // the following line MUST be at the top of main()
+  cStaticFlag dummy;
+  CodeFragments::executeAll(CodeFragments::STARTUP);
+  SimTime::setScaleExp(-12);
+
+  cEnvir *env = new BenchEnv(argc, argv, new EmptyConfig());
+  cSimulation *sim = new cSimulation("simulation", env);
+  cSimulation::setActiveSimulation(sim);
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+
+  CodeFragments::executeAll(CodeFragments::SHUTDOWN);
+  cSimulation::setActiveSimulation(nullptr);
+  delete sim;  // deletes env as well
+  return 0;
+}
@@ -0,0 +1,209 @@
+/*
+ * DeltaMapEncodingTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <map>
+#include <vector>
+
+#include "crownet/applications/dmap/DeltaMapEncoding.h"
+#include "crownet/applications/dmap/MapPacketMerge.h"
+#include "crownet/applications/dmap/dmap_m.h"
+#include "crownet/crownet_testutil.h"
+#include "main_test.h"
+
+using namespace crownet;
+
+class DeltaMapEncodingTest : public BaseOppTest {
+ public:
+  DeltaMapEncodingTest() {}
+
+  // encode counts (count * 100) into one packet. Unchanged cells are not part of the packet.
+  Ptr<DeltaMapPacket> encode(DeltaMapEncoder& encoder, uint16_t seq, const std::map<GridCellID, int>& counts,
+                             Ptr<MapHeader> header) {
+    auto body = makeShared<DeltaMapPacket>();
+    body->setKeyframe(encoder.nextPacket(seq));
+    body->setKeyframeSeq(encoder.getKeyframeSeq());
+    DeltaMapPacketBuilder builder;
+    for (const auto& e : counts) {
+      DeltaDcDCell c;
+      if (encoder.encode(e.first, e.second, c)) {
+        builder.add(e.first, c);
+        encoder.commit(e.first, e.second);
+      }
+    }
+    auto offset = builder.fill(body.get());
+    header->setSequenceNumber(seq);
+    header->setVersion(MapType::DELTA);
+    header->setCellIdOffsetX(offset.x());
+    header->setCellIdOffsetY(offset.y());
+    return body;
+  }
+
+  std::map<GridCellID, int> decode(DeltaMapDecoder& decoder, Ptr<MapHeader> header,
+                                   Ptr<DeltaMapPacket> body, int& skipped) {
+    std::map<GridCellID, int> ret;
+    skipped = decoder.decode(42, *header, *body, [&](const GridCellID& id, int count, const DeltaDcDCell&) {
+      ret[id] = count;
+    });
+    return ret;
+  }
+};
+
+TEST_F(DeltaMapEncodingTest, varint) {
+  for (int32_t v : {0, 1, -1, 63, -64, 64, 1000, -1000, 0x7FFFFFFF, (int32_t)0x80000000}) {
+    EXPECT_EQ(v, zigzagDecode(zigzagEncode(v)));
+  }
+  EXPECT_EQ(0u, zigzagEncode(0));
+  EXPECT_EQ(1u, zigzagEncode(-1));
+  EXPECT_EQ(2u, zigzagEncode(1));
+
+  EXPECT_EQ(1, varintLength(0));
+  EXPECT_EQ(1, varintLength(127));
+  EXPECT_EQ(2, varintLength(128));
+  EXPECT_EQ(2, varintLength(16383));
+  EXPECT_EQ(3, varintLength(16384));
+  EXPECT_EQ(5, varintLength(0xFFFFFFFF));
+}
+
+TEST_F(DeltaMapEncodingTest, packetLength) {
+  DeltaMapPacketBuilder builder;
+  EXPECT_EQ(3 * 8, builder.getLength().get());
+
+  DeltaDcDCell c{250, true};  // count 2.5
+  c.setSourceEntryDist(10.0);
+  // insert in any order, length must match row-major encoding.
+  std::vector<GridCellID> ids{GridCellID(5, 2), GridCellID(1, 1), GridCellID(300, 2), GridCellID(0, 7), GridCellID(6, 2)};
+  for (const auto& id : ids) {
+    auto expected = builder.getLengthWith(id, c);
+    builder.add(id, c);
+    EXPECT_EQ(expected, builder.getLength());
+  }
+  EXPECT_THROW(builder.add(GridCellID(1, 1), c), cRuntimeError);
+
+  DeltaMapPacket p;
+  auto offset = builder.fill(&p);
+  EXPECT_EQ(GridCellID(1, 1), offset);
+  ASSERT_EQ(5, p.getCellsArraySize());
+  B length = B(3);
+  int x = offset.x(), y = offset.y();
+  std::vector<GridCellID> sorted{GridCellID(1, 1), GridCellID(5, 2), GridCellID(6, 2), GridCellID(300, 2), GridCellID(0, 7)};
+  for (int i = 0; i < 5; i++) {
+    x += p.getCells(i).getIdDeltaX();
+    y += p.getCells(i).getIdDeltaY();
+    EXPECT_EQ(sorted[i], GridCellID(x, y));
+    length += deltaMapCellLength(p.getCells(i));
+  }
+  EXPECT_EQ(b(length), p.getChunkLength());
+  // first cell: 2B id + 2B count (500 | absolute) + 1B deltaCreation + 1B dist
+  EXPECT_EQ(B(6), deltaMapCellLength(p.getCells(0)));
+}
+
+TEST_F(DeltaMapEncodingTest, roundtrip) {
+  DeltaMapEncoder encoder{4};
+  DeltaMapDecoder decoder;
+  int skipped;
+  std::map<GridCellID, int> counts{{GridCellID(1, 1), 100}, {GridCellID(2, 1), 200}, {GridCellID(4, 3), 50}};
+
+  // keyframe
+  auto header = makeShared<MapHeader>();
+  auto body = encode(encoder, 10, counts, header);
+  EXPECT_TRUE(body->getKeyframe());
+  EXPECT_EQ(3, body->getCellsArraySize());
+  EXPECT_EQ(counts, decode(decoder, header, body, skipped));
+  EXPECT_EQ(0, skipped);
+
+  // one changed, one new cell
+  counts[GridCellID(2, 1)] = 150;
+  counts[GridCellID(0, 5)] = 300;
+  body = encode(encoder, 11, counts, header);
+  EXPECT_FALSE(body->getKeyframe());
+  EXPECT_EQ(10, body->getKeyframeSeq());
+  ASSERT_EQ(2, body->getCellsArraySize());
+  EXPECT_FALSE(body->getCells(0).getAbsolute());
+  EXPECT_EQ(-50, body->getCells(0).getCountDelta());
+  EXPECT_TRUE(body->getCells(1).getAbsolute());
+  std::map<GridCellID, int> expected{{GridCellID(2, 1), 150}, {GridCellID(0, 5), 300}};
+  EXPECT_EQ(expected, decode(decoder, header, body, skipped));
+  EXPECT_EQ(0, skipped);
+
+  // (2, 1) changed since last sent (150) but equals the keyframe again. It
+  // must be sent, otherwise receivers keep 150. The delta is relative to the
+  // keyframe. (0, 5) did not change since last sent.
+  counts[GridCellID(2, 1)] = 200;
+  body = encode(encoder, 12, counts, header);
+  ASSERT_EQ(1, body->getCellsArraySize());
+  EXPECT_FALSE(body->getCells(0).getAbsolute());
+  EXPECT_EQ(0, body->getCells(0).getCountDelta());
+  expected = {{GridCellID(2, 1), 200}};
+  EXPECT_EQ(expected, decode(decoder, header, body, skipped));
+
+  // nothing changed since last sent
+  body = encode(encoder, 13, counts, header);
+  EXPECT_FALSE(body->getKeyframe());
+  EXPECT_EQ(0, body->getCellsArraySize());
+
+  // next keyframe after 4 packets
+  body = encode(encoder, 14, counts, header);
+  EXPECT_TRUE(body->getKeyframe());
+  EXPECT_EQ(4, body->getCellsArraySize());
+  EXPECT_EQ(counts, decode(decoder, header, body, skipped));
+}
+
+TEST_F(DeltaMapEncodingTest, missingKeyframe) {
+  DeltaMapEncoder encoder{10};
+  DeltaMapDecoder decoder;
+  int skipped;
+  std::map<GridCellID, int> counts{{GridCellID(1, 1), 100}, {GridCellID(2, 1), 200}};
+  auto header = makeShared<MapHeader>();
+  encode(encoder, 1, counts, header);  // lost
+
+  counts[GridCellID(1, 1)] = 120;
+  counts[GridCellID(3, 3)] = 10;
+  auto body = encode(encoder, 2, counts, header);
+  EXPECT_FALSE(decoder.hasKeyframe(42));
+  // only absolute cells can be used
+  std::map<GridCellID, int> expected{{GridCellID(3, 3), 10}};
+  EXPECT_EQ(expected, decode(decoder, header, body, skipped));
+  EXPECT_EQ(1, skipped);
+
+  EXPECT_THROW(DeltaMapEncoder(0), cRuntimeError);
+}
+
+TEST_F(DeltaMapEncodingTest, mergeIntoMap) {
+  DcdFactoryProvider f(inet::Coord(0.0, 0.0), inet::Coord(10.0, 10.0), 1.0);
+  auto map = f.dcdFactory->create_shared_ptr(IntIdentifer(1));
+  auto provider = f.dcdFactory->getCellKeyProvider();
+  DeltaMapEncoder encoder{10};
+  DeltaMapDecoder decoder;
+  auto header = makeShared<MapHeader>();
+  header->setSourceId(42);
+  header->setSourcePosition(inet::Coord(5.0, 5.0));
+  inet::Coord owner(2.0, 2.0);
+  auto count = [&](int x, int y) { return map->getCell(GridCellID(x, y)).get(IntIdentifer(42))->getCount(); };
+  auto merge = [&](uint16_t seq, const std::map<GridCellID, int>& counts) {
+    setSimTime((double)seq);
+    auto body = encode(encoder, seq, counts, header);
+    return mergeDeltaMapPacket(*map, *provider, decoder, *header, *body, owner, simTime(), simTime());
+  };
+
+  std::map<GridCellID, int> counts{{GridCellID(1, 1), 100}, {GridCellID(2, 1), 200}};
+  EXPECT_EQ(0, merge(1, counts));  // keyframe
+  EXPECT_DOUBLE_EQ(1.0, count(1, 1));
+  EXPECT_DOUBLE_EQ(2.0, count(2, 1));
+  EXPECT_EQ(simtime_t(1.0), map->getCell(GridCellID(2, 1)).get(IntIdentifer(42))->getMeasureTime());
+
+  counts[GridCellID(2, 1)] = 150;
+  EXPECT_EQ(0, merge(2, counts));
+  EXPECT_DOUBLE_EQ(1.5, count(2, 1));
+
+  // back to the keyframe value
+  counts[GridCellID(2, 1)] = 200;
+  EXPECT_EQ(0, merge(3, counts));
+  EXPECT_DOUBLE_EQ(2.0, count(2, 1));
+  EXPECT_DOUBLE_EQ(1.0, count(1, 1));
+  EXPECT_EQ(simtime_t(3.0), map->getCell(GridCellID(2, 1)).get(IntIdentifer(42))->getMeasureTime());
+  EXPECT_EQ(simtime_t(1.0), map->getCell(GridCellID(1, 1)).get(IntIdentifer(42))->getMeasureTime());
+}
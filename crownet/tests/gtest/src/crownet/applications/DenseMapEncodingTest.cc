@@ -0,0 +1,166 @@
+/*
+ * DenseMapEncodingTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <map>
+#include <vector>
+
+#include "crownet/applications/dmap/DenseMapEncoding.h"
+#include "crownet/applications/dmap/dmap_m.h"
+#include "main_test.h"
+
+using namespace crownet;
+
+class DenseMapEncodingTest : public BaseOppTest {
+ public:
+  DenseMapEncodingTest() {}
+
+  Packet* encode(const std::vector<GridCellID>& ids, b maxData, DenseMapBoundingBox& bbox) {
+    bbox = DenseMapBoundingBox::fromPrefix(ids, maxData);
+    auto header = makeShared<MapHeader>();
+    header->setSourceId(42);
+    header->setVersion(MapType::DENSE);
+    header->setCellIdOffsetX(bbox.getOffsetX());
+    header->setCellIdOffsetY(bbox.getOffsetY());
+
+    auto body = createDenseMapPacket(bbox);
+    for (int i = 0; i < bbox.getDataCellCount(); i++) {
+      DenseDcDCell c{(uint16_t)(100 * (i + 1))};
+      c.setDeltaCreation(SimTime(10 * i, SimTimeUnit::SIMTIME_MS));
+      c.setSourceEntryDist(1.5 * i);
+      setDenseMapCell(body.get(), bbox, ids[i], c);
+    }
+    auto packet = new Packet();
+    packet->insertAtFront(body);
+    packet->insertAtFront(header);
+    return packet;
+  }
+};
+
+TEST_F(DenseMapEncodingTest, boundingBox) {
+  DenseMapBoundingBox bbox(3, 4, 5, 2);
+  EXPECT_EQ(10, bbox.getArea());
+  EXPECT_TRUE(bbox.contains(GridCellID(3, 4)));
+  EXPECT_TRUE(bbox.contains(GridCellID(7, 5)));
+  EXPECT_FALSE(bbox.contains(GridCellID(8, 5)));
+  EXPECT_FALSE(bbox.contains(GridCellID(3, 6)));
+  // row-major
+  EXPECT_EQ(0, bbox.index(GridCellID(3, 4)));
+  EXPECT_EQ(4, bbox.index(GridCellID(7, 4)));
+  EXPECT_EQ(5, bbox.index(GridCellID(3, 5)));
+  EXPECT_EQ(GridCellID(4, 5), bbox.cellId(6));
+  EXPECT_THROW(bbox.index(GridCellID(0, 0)), cRuntimeError);
+  EXPECT_THROW(DenseMapBoundingBox(0, 0, 256, 1), cRuntimeError);
+  // 2B + 10 * 6B
+  EXPECT_EQ(62 * 8, bbox.getPacketLength().get());
+}
+
+TEST_F(DenseMapEncodingTest, boundingBoxFromPrefix) {
+  std::vector<GridCellID> ids{{2, 2}, {3, 2}, {2, 3}, {3, 3}, {9, 9}};
+  // 2B + 4 * 6B = 26B -> {9, 9} would need 2B + 8 * 8 * 6B
+  auto bbox = DenseMapBoundingBox::fromPrefix(ids, B(100));
+  EXPECT_EQ(4, bbox.getDataCellCount());
+  EXPECT_EQ(2, bbox.getOffsetX());
+  EXPECT_EQ(2, bbox.getOffsetY());
+  EXPECT_EQ(2, bbox.getCellCountX());
+  EXPECT_EQ(2, bbox.getCellCountY());
+
+  bbox = DenseMapBoundingBox::fromPrefix(ids, B(2 + 8 * 8 * 6));
+  EXPECT_EQ(5, bbox.getDataCellCount());
+  EXPECT_EQ(64, bbox.getArea());
+
+  // not even one cell fits
+  bbox = DenseMapBoundingBox::fromPrefix(ids, B(7));
+  EXPECT_EQ(0, bbox.getDataCellCount());
+
+  // bounding box must fit into uint8_t
+  bbox = DenseMapBoundingBox::fromPrefix({{0, 0}, {300, 0}}, B(1500));
+  EXPECT_EQ(1, bbox.getDataCellCount());
+}
+
+TEST_F(DenseMapEncodingTest, selectEncoding) {
+  b maxData = B(100);
+  EXPECT_EQ(10, maxSparseMapCells(maxData));
+  EXPECT_EQ(16, maxDenseMapCells(maxData));
+
+  // fully occupied 4x4 block: DENSE carries 16 cells, SPARSE only 10.
+  std::vector<GridCellID> block;
+  for (int y = 0; y < 4; y++)
+    for (int x = 0; x < 4; x++) block.emplace_back(x + 10, y + 10);
+  auto bbox = DenseMapBoundingBox::fromPrefix(block, maxData);
+  EXPECT_EQ(16, bbox.getDataCellCount());
+  EXPECT_TRUE(preferDenseMapPacket(bbox, (int)block.size(), maxData));
+
+  // scattered cells: SPARSE is better.
+  std::vector<GridCellID> scattered{{0, 0}, {5, 5}, {10, 0}};
+  bbox = DenseMapBoundingBox::fromPrefix(scattered, maxData);
+  EXPECT_EQ(1, bbox.getDataCellCount());
+  EXPECT_FALSE(preferDenseMapPacket(bbox, (int)scattered.size(), maxData));
+
+  // same number of cells -> smaller packet wins (2B + 2 * 6B < 2 * 10B)
+  std::vector<GridCellID> pair{{1, 1}, {2, 1}};
+  bbox = DenseMapBoundingBox::fromPrefix(pair, maxData);
+  EXPECT_TRUE(preferDenseMapPacket(bbox, (int)pair.size(), maxData));
+
+  // empty stream
+  bbox = DenseMapBoundingBox::fromPrefix({}, maxData);
+  EXPECT_FALSE(preferDenseMapPacket(bbox, 0, maxData));
+}
+
+TEST_F(DenseMapEncodingTest, roundTrip) {
+  // L-shaped occupation with holes in the bounding box
+  std::vector<GridCellID> ids{{5, 7}, {6, 7}, {7, 7}, {5, 8}, {5, 9}, {7, 9}};
+  DenseMapBoundingBox bbox;
+  auto packet = encode(ids, B(1000), bbox);
+  EXPECT_EQ(6, bbox.getDataCellCount());
+  EXPECT_EQ((30 + 2 + 9 * 6) * 8, packet->getTotalLength().get());
+
+  auto header = packet->popAtFront<MapHeader>();
+  ASSERT_EQ(MapType::DENSE, header->getVersion());
+  auto body = packet->popAtFront<DenseMapPacket>();
+  EXPECT_EQ(3, body->getCellCountX());
+  EXPECT_EQ(3, body->getCellCountY());
+
+  std::map<GridCellID, DenseDcDCell> decoded;
+  std::vector<GridCellID> order;
+  forEachDenseMapCell(*header, *body, [&](const GridCellID& id, const DenseDcDCell& c) {
+    decoded[id] = c;
+    order.push_back(id);
+  });
+  ASSERT_EQ(ids.size(), decoded.size());
+  for (int i = 0; i < (int)ids.size(); i++) {
+    const auto& c = decoded[ids[i]];
+    EXPECT_EQ(100 * (i + 1), c.getCount());
+    EXPECT_EQ(SimTime(10000 - 10 * i, SimTimeUnit::SIMTIME_MS), c.getCreationTime(SimTime(10.0)));
+    EXPECT_EQ(1.5 * i, c.getSourceEntryDist());
+  }
+  // decoded in row-major order
+  std::vector<GridCellID> rowMajor{{5, 7}, {6, 7}, {7, 7}, {5, 8}, {5, 9}, {7, 9}};
+  EXPECT_EQ(rowMajor, order);
+  delete packet;
+}
+
+TEST_F(DenseMapEncodingTest, emptyCellMarker) {
+  DenseMapBoundingBox bbox(0, 0, 2, 1);
+  auto body = createDenseMapPacket(bbox);
+  EXPECT_EQ(14 * 8, body->getChunkLength().get());
+  EXPECT_THROW(setDenseMapCell(body.get(), bbox, GridCellID(0, 0), DenseDcDCell{DENSE_CELL_EMPTY}),
+               cRuntimeError);
+  // zero is a valid count and must be decoded.
+  setDenseMapCell(body.get(), bbox, GridCellID(1, 0), DenseDcDCell{0});
+  MapHeader header;
+  int n = 0;
+  forEachDenseMapCell(header, *body, [&](const GridCellID& id, const DenseDcDCell& c) {
+    EXPECT_EQ(GridCellID(1, 0), id);
+    EXPECT_EQ(0, c.getCount());
+    n++;
+  });
+  EXPECT_EQ(1, n);
+
+  body->setCellsArraySize(3);
+  EXPECT_THROW(forEachDenseMapCell(header, *body, [](const GridCellID&, const DenseDcDCell&) {}),
+               cRuntimeError);
+}
@@ -0,0 +1,183 @@
+/*
+ * NodeModulePoolTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "crownet/artery/traci/NodeModulePool.h"
+#include "main_test.h"
+
+using namespace crownet;
+
+namespace {
+
+// host without submodules. Module creation only needs a NED type.
+const char* poolTestNed = R"(
+module PoolTestHost
+{
+}
+network PoolTestNetwork
+{
+}
+)";
+
+}  // namespace
+
+class NodeModulePoolTest : public BaseOppTest {
+ public:
+  static void SetUpTestSuite() {
+    static bool loaded = false;
+    if (!loaded) {
+      cSimulation::loadNedText("NodeModulePoolTest", poolTestNed);
+      cSimulation::doneLoadingNedFiles();
+      loaded = true;
+    }
+  }
+
+  void SetUp() override {
+    auto sim = cSimulation::getActiveSimulation();
+    sim->setupNetwork(cModuleType::get("PoolTestNetwork"));
+    root = sim->getSystemModule();
+    type = cModuleType::get("PoolTestHost");
+  }
+
+  void TearDown() override {
+    cSimulation::getActiveSimulation()->deleteNetwork();
+  }
+
+  int vectorSize() const {
+    return root->hasSubmoduleVector("pNode")
+               ? root->getSubmoduleVectorSize("pNode")
+               : 0;
+  }
+
+ protected:
+  cModule* root = nullptr;
+  cModuleType* type = nullptr;
+};
+
+TEST_F(NodeModulePoolTest, acquire) {
+  NodeModulePool pool;
+  pool.setup(root, "pNode", 2);
+  EXPECT_EQ(0, vectorSize());
+
+  // empty pool: build on demand
+  cModule* m = pool.acquire(type);
+  ASSERT_NE(nullptr, m);
+  EXPECT_EQ(root, m->getParentModule());
+  EXPECT_STREQ("pNode", m->getName());
+  EXPECT_EQ(0, m->getIndex());
+  EXPECT_FALSE(m->initialized());
+  EXPECT_EQ(1u, pool.getSize());
+  EXPECT_EQ(0u, pool.getIdleCount(type));
+
+  // built ahead of time: handed out in build order
+  EXPECT_EQ(2, pool.warmUp(type, 2));
+  EXPECT_EQ(2u, pool.getIdleCount(type));
+  EXPECT_EQ(3u, pool.getSize());
+  cModule* idle1 = root->getSubmodule("pNode", 1);
+  ASSERT_NE(nullptr, idle1);
+  EXPECT_EQ(idle1, pool.acquire(type));
+  EXPECT_EQ(1u, pool.getIdleCount(type));
+  EXPECT_EQ(3u, pool.getSize());
+
+  // refill up to pool size within budget
+  EXPECT_EQ(0, pool.refill(0));
+  EXPECT_EQ(1, pool.refill(5));
+  EXPECT_EQ(2u, pool.getIdleCount());
+  EXPECT_EQ(0, pool.refill(5));
+
+  pool.clear();
+  EXPECT_EQ(0u, pool.getIdleCount());
+  EXPECT_EQ(2u, pool.getSize());
+}
+
+TEST_F(NodeModulePoolTest, grow) {
+  NodeModulePool pool;
+  pool.setup(root, "pNode", 0);
+  const unsigned expected[] = {1, 2, 4, 4, 8};
+  for (int i = 0; i < 5; i++) {
+    cModule* m = pool.acquire(type);
+    EXPECT_EQ(i, m->getIndex());
+    EXPECT_EQ(expected[i], pool.getCapacity());
+    EXPECT_EQ((int)expected[i], vectorSize());
+  }
+  EXPECT_EQ(5u, pool.getSize());
+  // unused slots stay empty
+  for (int i = 5; i < 8; i++) {
+    EXPECT_EQ(nullptr, root->getSubmodule("pNode", i));
+  }
+  // pool size 0: nothing kept idle
+  EXPECT_EQ(0, pool.refill(10));
+  EXPECT_EQ(0u, pool.getIdleCount());
+
+  EXPECT_THROW(pool.setup(root, "pNode", -1), cRuntimeError);
+}
+
+TEST_F(NodeModulePoolTest, release) {
+  NodeModulePool pool;
+  pool.setup(root, "pNode", 1);
+  EXPECT_FALSE(pool.getReuseSlots());
+  cModule* m0 = pool.acquire(type);
+  cModule* m1 = pool.acquire(type);
+  cModule* m2 = pool.acquire(type);
+  EXPECT_EQ(4u, pool.getCapacity());
+
+  // departed host: module deleted, slot stays empty
+  pool.release(m1);
+  EXPECT_EQ(nullptr, root->getSubmodule("pNode", 1));
+  EXPECT_EQ(2u, pool.getSize());
+
+  // indices are monotonic: each node gets a unique module path
+  EXPECT_EQ(1, pool.refill(1));
+  EXPECT_EQ(nullptr, root->getSubmodule("pNode", 1));
+  cModule* idle = root->getSubmodule("pNode", 3);
+  ASSERT_NE(nullptr, idle);
+  EXPECT_FALSE(idle->initialized());
+  EXPECT_EQ(idle, pool.acquire(type));
+
+  pool.release(m2);
+  pool.release(m0);
+  EXPECT_EQ(4, pool.acquire(type)->getIndex());
+  EXPECT_EQ(5, pool.acquire(type)->getIndex());
+  EXPECT_EQ(8u, pool.getCapacity());
+  EXPECT_EQ(3u, pool.getSize());
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(nullptr, root->getSubmodule("pNode", i));
+  }
+
+  // module of another vector
+  cModule* other = type->create("other", root);
+  EXPECT_THROW(pool.release(other), cRuntimeError);
+}
+
+TEST_F(NodeModulePoolTest, releaseReuseSlots) {
+  NodeModulePool pool;
+  pool.setup(root, "pNode", 1, true);
+  EXPECT_TRUE(pool.getReuseSlots());
+  cModule* m0 = pool.acquire(type);
+  cModule* m1 = pool.acquire(type);
+  cModule* m2 = pool.acquire(type);
+  EXPECT_EQ(4u, pool.getCapacity());
+
+  pool.release(m1);
+  EXPECT_EQ(nullptr, root->getSubmodule("pNode", 1));
+  EXPECT_EQ(2u, pool.getSize());
+
+  // refill recycles the free slot before the vector grows
+  EXPECT_EQ(1, pool.refill(1));
+  cModule* idle = root->getSubmodule("pNode", 1);
+  ASSERT_NE(nullptr, idle);
+  EXPECT_FALSE(idle->initialized());
+  EXPECT_EQ(idle, pool.acquire(type));
+
+  // lowest free slot first
+  pool.release(m2);
+  pool.release(m0);
+  EXPECT_EQ(0, pool.acquire(type)->getIndex());
+  EXPECT_EQ(2, pool.acquire(type)->getIndex());
+  EXPECT_EQ(3, pool.acquire(type)->getIndex());
+  EXPECT_EQ(4u, pool.getCapacity());
+  EXPECT_EQ(4u, pool.getSize());
+}
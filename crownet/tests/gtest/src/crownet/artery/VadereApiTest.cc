@@ -0,0 +1,126 @@
+/*
+ * VadereApiTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <string>
+#include <vector>
+
+#include "crownet/artery/traci/VadereApi.h"
+#include "crownet/fake_traci.h"
+#include "main_test.h"
+
+using namespace crownet;
+using namespace libsumo;
+
+namespace {
+
+// recorded response of a person get command (status + result)
+tcpip::Storage getResponse(int var, const std::string& id, tcpip::Storage& value) {
+  tcpip::Storage r;
+  r.writeUnsignedByte(1 + 1 + 1 + 4);
+  r.writeUnsignedByte(CMD_GET_PERSON_VARIABLE);
+  r.writeUnsignedByte(RTYPE_OK);
+  r.writeString("");
+  r.writeUnsignedByte(0);  // extended length
+  r.writeInt(1 + 4 + 1 + 1 + 4 + (int)id.size() + (int)value.size());
+  r.writeUnsignedByte(RESPONSE_GET_PERSON_VARIABLE);
+  r.writeUnsignedByte(var);
+  r.writeString(id);
+  r.writeStorage(value);
+  return r;
+}
+
+VadereBulkState makeState(int n) {
+  VadereBulkState state;
+  for (int i = 0; i < n; i++) {
+    state.ids.push_back("p" + std::to_string(i));
+    state.values.insert(state.values.end(), {1.0 * i, 2.0 * i, 0.0, 1.3, 90.0});
+  }
+  return state;
+}
+
+}  // namespace
+
+TEST(VadereBulkStateTest, readWrite) {
+  auto state = makeState(3);
+  tcpip::Storage buf;
+  state.write(buf);
+
+  VadereBulkState read;
+  EXPECT_EQ(buf.readUnsignedByte(), TYPE_COMPOUND);
+  read.read(buf);
+  EXPECT_EQ(read.ids, state.ids);
+  EXPECT_EQ(read.values, state.values);
+  EXPECT_EQ(read.indexOf("p2"), 2);
+  EXPECT_EQ(read.indexOf("p9"), -1);
+  EXPECT_DOUBLE_EQ(read.getPosition(2).y, 4.0);
+  EXPECT_DOUBLE_EQ(read.getSpeed(1), 1.3);
+  EXPECT_DOUBLE_EQ(read.getAngle(0), 90.0);
+}
+
+TEST(VadereBulkStateTest, readLargerStride) {
+  // server sends one additional value per person
+  tcpip::Storage buf;
+  buf.writeInt(3);
+  buf.writeUnsignedByte(TYPE_STRINGLIST);
+  buf.writeStringList({"a", "b"});
+  buf.writeUnsignedByte(TYPE_INTEGER);
+  buf.writeInt(6);
+  buf.writeUnsignedByte(TYPE_DOUBLELIST);
+  buf.writeInt(12);
+  for (int i = 0; i < 12; i++) {
+    buf.writeDouble(i);
+  }
+  VadereBulkState state;
+  state.read(buf);
+  EXPECT_EQ(state.values.size(), 10);
+  EXPECT_DOUBLE_EQ(state.getPosition(1).x, 6.0);
+  EXPECT_DOUBLE_EQ(state.getAngle(1), 10.0);
+}
+
+TEST(VadereBulkStateTest, readWrongCount) {
+  tcpip::Storage buf;
+  buf.writeInt(3);
+  buf.writeUnsignedByte(TYPE_STRINGLIST);
+  buf.writeStringList({"a"});
+  buf.writeUnsignedByte(TYPE_INTEGER);
+  buf.writeInt(VadereBulkState::STRIDE);
+  buf.writeUnsignedByte(TYPE_DOUBLELIST);
+  buf.writeInt(3);
+  VadereBulkState state;
+  EXPECT_THROW(state.read(buf), libsumo::TraCIException);
+}
+
+TEST(VadereApiTest, getBulkStateFromServer) {
+  auto first = makeState(2);
+  auto second = makeState(4);
+  tcpip::Storage v1, v2;
+  first.write(v1);
+  second.write(v2);
+  FakeTraCiServer server({getResponse(constants::VAR_BULK_STATE, "", v1),
+                          getResponse(constants::VAR_BULK_STATE, "", v2)});
+
+  VadereApi api;
+  api.TraCIAPI::connect("localhost", server.getPort());
+
+  VadereBulkState state;
+  api.v_person.getBulkState({}, state);
+  EXPECT_EQ(state.ids, first.ids);
+  EXPECT_EQ(state.values, first.values);
+
+  // buffer is reused for the next step
+  api.v_person.getBulkState({}, state);
+  EXPECT_EQ(state.ids, second.ids);
+  EXPECT_EQ(state.values, second.values);
+  EXPECT_EQ(state.indexOf("p3"), 3);
+
+  server.join();
+  ASSERT_EQ(server.getRequests().size(), 2);
+  // one get command for all persons: length, command, variable, object id
+  const auto& req = server.getRequests()[0];
+  EXPECT_EQ((unsigned char)req[1], CMD_GET_PERSON_VARIABLE);
+  EXPECT_EQ((unsigned char)req[2], constants::VAR_BULK_STATE);
+}
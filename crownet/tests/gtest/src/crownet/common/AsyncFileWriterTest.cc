@@ -0,0 +1,193 @@
+/*
+ * AsyncFileWriterTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "main_test.h"
+#include "crownet/common/util/AsyncFileSink.h"
+#include "crownet/common/util/FileWriter.h"
+#include "crownet/common/util/NeighborhoodEventWriter.h"
+
+using namespace crownet;
+using omnetpp::cRuntimeError;
+
+namespace {
+
+std::string tmpPath(const std::string& name) {
+  auto p = boost::filesystem::temp_directory_path() /
+           boost::filesystem::unique_path("%%%%-%%%%-" + name);
+  return p.string();
+}
+
+std::string readFile(const std::string& path) {
+  std::ifstream in(path);
+  std::stringstream s;
+  s << in.rdbuf();
+  return s.str();
+}
+
+// csv like rows (similar to RegularDcdMapValuePrinter output)
+void writeRows(BaseFileWriter& w, int rows) {
+  for (int i = 0; i < rows; i++) {
+    w.write() << 0.4 * i << ";" << i % 100 << ";" << i / 100 << ";" << i % 7 << ";"
+              << 0.2 * i << ";" << 0.3 * i << ";" << 1000 + i << ";ymf;0;1;0;1;-1;0" << std::endl;
+  }
+}
+
+void writeFile(const std::string& path, bool async, int rows) {
+  BaseFileWriter w(path);
+  w.setAsyncWrite(async);
+  w.initialize();
+  writeRows(w, rows);
+  w.close();
+}
+
+// access writeEvent without neighborhood table and global map
+class TestEventWriter : public NeighborhoodEventWriter {
+ public:
+  using NeighborhoodEventWriter::NeighborhoodEventWriter;
+  using NeighborhoodEventWriter::writeEvent;
+};
+
+NeighborhoodEvent enterCell() {
+  return NeighborhoodEvent{1, 7, NeighborhoodEventCode::ENTER_CELL, 2.0, 1.5, 1.0, 42,
+                           inet::Coord(3.5, 4.5), 1, 10, 0, 10, 3.0, 4.0};
+}
+
+}  // namespace
+
+class AsyncFileWriterTest : public BaseOppTest {
+ public:
+  void TearDown() override {
+    for (const auto& p : files) {
+      boost::filesystem::remove(p);
+    }
+  }
+  std::string file(const std::string& name) {
+    files.push_back(tmpPath(name));
+    return files.back();
+  }
+
+ protected:
+  std::vector<std::string> files;
+};
+
+TEST_F(AsyncFileWriterTest, sameOutput) {
+  // throughput of both modes: tests/benchmark (BM_FileWriter_*)
+  const int rows = 20000;
+  auto syncFile = file("sync.csv");
+  auto asyncFile = file("async.csv");
+  writeFile(syncFile, false, rows);
+  writeFile(asyncFile, true, rows);
+
+  auto expected = readFile(syncFile);
+  EXPECT_GT(expected.size(), 0);
+  EXPECT_EQ(expected, readFile(asyncFile));
+}
+
+TEST_F(AsyncFileWriterTest, backPressure) {
+  auto path = file("bp.csv");
+  BaseFileWriter w(path, ";", 1024);
+  w.setAsyncWrite(true);
+  w.setMaxPendingBytes(4096);
+  w.initialize();
+  auto sink = w.getAsyncSink();
+  ASSERT_NE(nullptr, sink);
+
+  // paused I/O thread: the writer must block once 4096 bytes are queued
+  sink->setPaused(true);
+  std::thread simulation([&w] { writeRows(w, 5000); });
+  while (sink->getBlockedCount() == 0) {
+    std::this_thread::yield();
+  }
+  // one buffer is at most bufferSize + one row
+  EXPECT_LE(sink->getPeakPendingBytes(), sink->getMaxPendingBytes());
+  sink->setPaused(false);
+  simulation.join();
+  EXPECT_LE(sink->getPeakPendingBytes(), sink->getMaxPendingBytes());
+  w.close();
+
+  auto expected = file("bp_expected.csv");
+  writeFile(expected, false, 5000);
+  EXPECT_EQ(readFile(expected), readFile(path));
+}
+
+TEST_F(AsyncFileWriterTest, flushAndClose) {
+  auto path = file("flush.csv");
+  BaseFileWriter w(path);
+  w.setAsyncWrite(true);
+  w.initialize();
+  w.write() << "a;b" << std::endl;
+  // below bufferSize: nothing written yet
+  EXPECT_EQ("", readFile(path));
+  w.flush();
+  EXPECT_EQ("a;b\n", readFile(path));
+  w.write() << "c;d" << std::endl;
+  w.close();
+  EXPECT_EQ("a;b\nc;d\n", readFile(path));
+  w.close();  // idempotent
+}
+
+TEST_F(AsyncFileWriterTest, sink) {
+  auto path = file("sink.csv");
+  AsyncFileSink sink(path, 8);
+  sink.submit(std::string("0123456789"));  // larger than max but queue empty
+  sink.submit(std::string("ab"));
+  sink.close();
+  EXPECT_EQ("0123456789ab", readFile(path));
+  EXPECT_THROW(sink.submit(std::string("x")), cRuntimeError);
+
+  EXPECT_THROW(AsyncFileSink("/nonexistent/dir/file.csv"), cRuntimeError);
+  EXPECT_THROW(AsyncFileSink(file("zero.csv"), 0), cRuntimeError);
+}
+
+TEST_F(AsyncFileWriterTest, eventCodes) {
+  auto names = file("names.csv");
+  {
+    TestEventWriter w(names);
+    w.initialize();
+    w.writeEvent(enterCell());
+    w.close();
+  }
+  std::istringstream in(readFile(names));
+  std::string line;
+  std::getline(in, line);
+  EXPECT_EQ("#version=4 ", line);
+  std::getline(in, line);
+  EXPECT_EQ(0u, line.find("table_owner;event_number;event;"));
+  std::getline(in, line);
+  EXPECT_EQ(0u, line.find("1;7;enter_cell;"));
+
+  auto codes = file("codes.csv");
+  {
+    TestEventWriter w(codes);
+    w.setEventCodes(true);
+    w.initialize();
+    w.writeEvent(enterCell());
+    w.close();
+  }
+  in = std::istringstream(readFile(codes));
+  std::getline(in, line);
+  EXPECT_EQ("#version=4 event_codes=0:dropped,1:ttl_reached,2:leave_cell,3:enter_cell,4:stay_in_cell",
+            line);
+  std::getline(in, line);
+  EXPECT_EQ(0u, line.find("table_owner;event_number;event;"));
+  std::getline(in, line);
+  EXPECT_EQ(0u, line.find("1;7;3;"));
+
+  // header mapping matches the enum
+  for (int i = 0; i < NEIGHBORHOOD_EVENT_CODE_COUNT; i++) {
+    EXPECT_NE(nullptr, neighborhoodEventName((NeighborhoodEventCode)i));
+  }
+  EXPECT_STREQ("stay_in_cell", neighborhoodEventName(NeighborhoodEventCode::STAY_IN_CELL));
+  EXPECT_THROW(neighborhoodEventName((NeighborhoodEventCode)NEIGHBORHOOD_EVENT_CODE_COUNT),
+               cRuntimeError);
+}
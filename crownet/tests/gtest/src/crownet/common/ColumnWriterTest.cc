@@ -0,0 +1,124 @@
+/*
+ * ColumnWriterTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <gtest/gtest.h>
+#include <omnetpp.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "crownet/common/util/ColumnWriter.h"
+#include "main_test.h"
+
+using namespace crownet;
+using omnetpp::cRuntimeError;
+
+namespace {
+
+std::vector<ColumnSpec> testColumns() {
+  return {{"simtime", ColumnType::FLOAT64},
+          {"x", ColumnType::INT32},
+          {"id", ColumnType::INT64},
+          {"selection", ColumnType::STRING}};
+}
+
+void writeRows(ColumnChunk& chunk, int from, int to) {
+  for (int i = from; i < to; i++) {
+    chunk.putDouble(0.5 * i).putInt(-i).putInt((int64_t)1 << 40 | i);
+    chunk.putString(i % 2 == 0 ? "" : "ymf");
+    chunk.endRow();
+  }
+}
+
+}  // namespace
+
+TEST(ColumnWriterTest, roundTrip) {
+  ColumnChunk chunk(testColumns());
+  std::stringstream s;
+  auto header = colfmt::fileHeader("XSIZE=10,YSIZE=20", chunk.getColumns());
+  s.write(header.data(), header.size());
+  writeRows(chunk, 0, 3);
+  EXPECT_EQ(3, chunk.getRows());
+  // 3 * (8 + 4 + 8) + (2 + 5 + 2)
+  EXPECT_EQ(69, chunk.getByteSize());
+  chunk.writeTo(s);
+  chunk.clear();
+  EXPECT_EQ(0, chunk.getRows());
+  writeRows(chunk, 3, 5);
+  chunk.writeTo(s);
+
+  colfmt::ColumnFileReader reader(s);
+  reader.readHeader();
+  EXPECT_EQ("XSIZE=10,YSIZE=20", reader.getMetadata());
+  ASSERT_EQ(4, reader.getColumns().size());
+  EXPECT_EQ("selection", reader.getColumns()[3].name);
+  EXPECT_EQ(ColumnType::INT32, reader.getColumns()[1].type);
+
+  int row = 0;
+  while (reader.readChunk()) {
+    for (uint32_t r = 0; r < reader.getRows(); r++, row++) {
+      EXPECT_EQ(0.5 * row, reader.getDouble(r, 0));
+      EXPECT_EQ(-row, reader.getInt(r, 1));
+      EXPECT_EQ((int64_t)1 << 40 | row, reader.getInt(r, 2));
+      EXPECT_EQ(row % 2 == 0 ? "" : "ymf", reader.getString(r, 3));
+    }
+  }
+  EXPECT_EQ(5, row);
+}
+
+TEST(ColumnWriterTest, str) {
+  ColumnChunk chunk(testColumns());
+  writeRows(chunk, 1, 2);
+  std::stringstream s;
+  auto header = colfmt::fileHeader("", chunk.getColumns());
+  s.write(header.data(), header.size());
+  chunk.writeTo(s);
+
+  colfmt::ColumnFileReader reader(s);
+  reader.readHeader();
+  ASSERT_TRUE(reader.readChunk());
+  EXPECT_EQ("0.5", reader.str(0, 0));
+  EXPECT_EQ("-1", reader.str(0, 1));
+  EXPECT_EQ("1099511627777", reader.str(0, 2));
+  EXPECT_EQ("ymf", reader.str(0, 3));
+  EXPECT_FALSE(reader.readChunk());
+}
+
+TEST(ColumnWriterTest, rowErrors) {
+  ColumnChunk chunk(testColumns());
+  // wrong type
+  EXPECT_THROW(chunk.putInt(1), cRuntimeError);
+  chunk.clear();
+  // incomplete row
+  chunk.putDouble(1.0).putInt(2);
+  EXPECT_THROW(chunk.endRow(), cRuntimeError);
+  chunk.clear();
+  // too many columns
+  writeRows(chunk, 0, 1);
+  chunk.clear();
+  chunk.putDouble(1.0).putInt(2).putInt(3).putString("a");
+  EXPECT_THROW(chunk.putString("b"), cRuntimeError);
+}
+
+TEST(ColumnWriterTest, corruptFile) {
+  std::stringstream s("CRNTCOLX");
+  colfmt::ColumnFileReader reader(s);
+  EXPECT_THROW(reader.readHeader(), std::runtime_error);
+
+  ColumnChunk chunk(testColumns());
+  writeRows(chunk, 0, 2);
+  std::stringstream t;
+  auto header = colfmt::fileHeader("", chunk.getColumns());
+  t.write(header.data(), header.size());
+  chunk.writeTo(t);
+  std::string truncated = t.str();
+  truncated.resize(truncated.size() - 3);
+  std::stringstream u(truncated);
+  colfmt::ColumnFileReader r2(u);
+  r2.readHeader();
+  EXPECT_THROW(r2.readChunk(), std::runtime_error);
+}
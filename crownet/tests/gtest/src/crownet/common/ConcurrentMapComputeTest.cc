@@ -0,0 +1,170 @@
+/*
+ * ConcurrentMapComputeTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "main_test.h"
+#include "crownet/crownet_testutil.h"
+
+#include "crownet/common/Entry.h"
+#include "crownet/common/util/WorkerPool.h"
+#include "crownet/dcd/regularGrid/MapCellAggregationAlgorithms.h"
+#include "crownet/dcd/regularGrid/RegularCellVisitors.h"
+#include "crownet/dcd/regularGrid/RegularDcdMap.h"
+
+using namespace crownet;
+
+namespace {
+
+DcdFactoryProvider f = DcdFactoryProvider(
+        inet::Coord(.0, .0),
+        inet::Coord(50.0, 50.0),
+        1.0
+);
+std::shared_ptr<RegularDcdMapFactory> dcdFactory = f.dcdFactory;
+
+using Visitor = std::shared_ptr<CellAggregationAlgorihm<RegularCell>>;
+using VisitorCtor = std::function<Visitor()>;
+
+/**
+ * Map state of one node as kept by BaseDensityMapApp.
+ */
+struct NodeMap {
+    NodeMap(int id, const VisitorCtor& ctor) : rng(id) {
+        map = dcdFactory->create_shared_ptr(IntIdentifer(id));
+        cellAgeHandler = std::make_shared<TTLCellAgeHandler>(map, 3.0, 0.0);
+        valueVisitor = ctor();
+    }
+
+    // same as BaseDensityMapApp::computeMapValues (no simTime() access)
+    void computeMapValues(const simtime_t& now){
+        cellAgeHandler->setTime(now);
+        map->visitCellsAt(*cellAgeHandler, now);
+        valueVisitor->setTime(now);
+        map->computeValuesAt(valueVisitor, now);
+    }
+
+    // local counts and received entries (updateLocalMap/mergeReceivedMap)
+    void update(const simtime_t& now){
+        for (int i = 0; i < 40; i++){
+            GridCellID cellId(rng() % 25, rng() % 25);
+            int source = (rng() % 4 == 0) ? map->getOwnerId().value() : 100 + (int)(rng() % 10);
+            double d = (double)(rng() % 30);
+            auto e = std::make_shared<GridEntry>(1 + rng() % 5, now, now, IntIdentifer(source),
+                                                 EntryDist{d, d, d});
+            if (rng() % 5 == 0){
+                e->reset(now);
+            }
+            map->setEntry(cellId, std::move(e));
+        }
+    }
+
+    std::mt19937 rng;
+    RegularDcdMapPtr map;
+    std::shared_ptr<TTLCellAgeHandler> cellAgeHandler;
+    Visitor valueVisitor;
+};
+
+// the mean of a cell without valid entries is 0/0, thus NaN == NaN here.
+bool same(double a, double b){
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+void expectSameEntry(const std::shared_ptr<GridEntry>& a, const std::shared_ptr<GridEntry>& b,
+        const std::string& where){
+    ASSERT_EQ(a == nullptr, b == nullptr) << where;
+    if (!a){
+        return;
+    }
+    EXPECT_EQ(a->valid(), b->valid()) << where;
+    EXPECT_TRUE(same(a->getCount(), b->getCount())) << where;
+    EXPECT_EQ(a->getSource(), b->getSource()) << where;
+    EXPECT_TRUE(same(a->getMeasureTime().dbl(), b->getMeasureTime().dbl())) << where;
+    EXPECT_TRUE(same(a->getReceivedTime().dbl(), b->getReceivedTime().dbl())) << where;
+    EXPECT_TRUE(same(a->getSelectionRank(), b->getSelectionRank())) << where;
+    EXPECT_EQ(a->getSelectedIn(), b->getSelectedIn()) << where;
+}
+
+// cell by cell: state, selected value and all entries
+void expectSameMap(RegularDcdMap& serial, RegularDcdMap& parallel, int step){
+    ASSERT_EQ(serial.getCells().size(), parallel.getCells().size()) << "step " << step;
+    EXPECT_EQ(serial.validCellCount(), parallel.validCellCount()) << "step " << step;
+    EXPECT_EQ(serial.getLastComputedAt(), parallel.getLastComputedAt()) << "step " << step;
+    for (auto& c : serial){
+        std::stringstream where;
+        where << "step " << step << " cell " << c.first;
+        ASSERT_TRUE(parallel.hasCell(c.first)) << where.str();
+        auto& other = parallel.getCell(c.first);
+        EXPECT_EQ(c.second.hasValid(), other.hasValid()) << where.str();
+        EXPECT_EQ(c.second.lastSent(), other.lastSent()) << where.str();
+        expectSameEntry(c.second.val(), other.val(), where.str() + " val");
+        ASSERT_EQ(c.second.getData().size(), other.getData().size()) << where.str();
+        for (auto& e : c.second.getData()){
+            auto found = other.getData().find(e.first);
+            ASSERT_NE(found, other.getData().end()) << where.str();
+            expectSameEntry(e.second, found->second, where.str() + " entry");
+        }
+    }
+}
+
+}
+
+/**
+ * GlobalDensityMap::updateDezentralMaps with updateThreads > 1 computes the
+ * node maps on a WorkerPool. The result must be equal to the serial update.
+ */
+class ConcurrentMapComputeTest : public BaseOppTest,
+                                 public ::testing::WithParamInterface<std::string> {
+ public:
+  VisitorCtor visitorCtor() const {
+      const std::string type = GetParam();
+      if (type == "ymf") return [](){ return std::make_shared<YmfVisitor>(); };
+      if (type == "ymfPlusDistStep") return [](){ return std::make_shared<YmfPlusDistStepVisitor>(0.5, 0.0, 10.0); };
+      if (type == "mean") return [](){ return std::make_shared<MeanVisitor>(); };
+      return [](){ return std::make_shared<MedianVisitor>(); };
+  }
+};
+
+TEST_P(ConcurrentMapComputeTest, sameAsSerial) {
+    const int N = 32;
+    WorkerPool pool(4);
+    std::vector<std::unique_ptr<NodeMap>> serial;
+    std::vector<std::unique_ptr<NodeMap>> parallel;
+    for (int i = 0; i < N; i++){
+        serial.emplace_back(new NodeMap(i + 1, visitorCtor()));
+        parallel.emplace_back(new NodeMap(i + 1, visitorCtor()));
+    }
+
+    for (int step = 1; step <= 20; step++){
+        simtime_t now = 0.5 * step;
+        setSimTime(now);
+        for (int i = 0; i < N; i++){
+            serial[i]->update(now);
+            parallel[i]->update(now);
+        }
+        for (auto& node : serial){
+            node->computeMapValues(now);
+        }
+        pool.parallelFor(N, [&parallel, &now](int i) {
+            parallel[i]->computeMapValues(now);
+        });
+        for (int i = 0; i < N; i++){
+            expectSameMap(*serial[i]->map, *parallel[i]->map, step);
+        }
+    }
+    // the TTL handler removed old entries and some values are selected.
+    EXPECT_GT(serial[0]->map->validCellCount(), 0);
+}
+
+INSTANTIATE_TEST_CASE_P(Visitors, ConcurrentMapComputeTest,
+                        ::testing::Values("ymf", "ymfPlusDistStep", "mean", "median"));
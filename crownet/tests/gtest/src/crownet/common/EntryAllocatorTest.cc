@@ -0,0 +1,112 @@
+/*
+ * EntryAllocatorTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <gtest/gtest.h>
+#include <omnetpp.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "crownet/common/Entry.h"
+#include "crownet/common/EntryAllocator.h"
+#include "crownet/dcd/identifier/Identifiers.h"
+#include "main_test.h"
+
+using namespace crownet;
+
+namespace {
+
+using Entry = IEntry<IntIdentifer, omnetpp::simtime_t>;
+
+}  // namespace
+
+TEST(EntryAllocatorTest, reuseFreedBlocks) {
+    EntrySlabAllocator slab;
+    void* a = slab.allocate(100);
+    void* b = slab.allocate(100);
+    EXPECT_NE(a, b);
+    EXPECT_EQ(2, slab.getStats().live());
+    slab.deallocate(a, 100);
+    // same size class returns last freed block
+    EXPECT_EQ(a, slab.allocate(112));
+    EXPECT_EQ(1, slab.getStats().chunkAllocations);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(b) % EntrySlabAllocator::ALIGN);
+}
+
+TEST(EntryAllocatorTest, fallbackForLargeBlocks) {
+    EntrySlabAllocator slab;
+    void* p = slab.allocate(EntrySlabAllocator::MAX_BLOCK_SIZE + 1);
+    EXPECT_EQ(1, slab.getStats().fallbackAllocations);
+    EXPECT_EQ(0, slab.getStats().allocations);
+    slab.deallocate(p, EntrySlabAllocator::MAX_BLOCK_SIZE + 1);
+}
+
+TEST(EntryAllocatorTest, entryOutlivesAllocator) {
+    std::shared_ptr<Entry> e;
+    {
+        auto slab = std::make_shared<EntrySlabAllocator>();
+        EntryDefaultCtorImpl<IntIdentifer, omnetpp::simtime_t> ctor(slab);
+        e = ctor.entry();
+        auto g = ctor.globalEntry();
+        g->nodeIds.insert(IntIdentifer(4));
+        EXPECT_EQ(2, slab->getStats().live());
+        EXPECT_EQ(1, g->nodeIds.size());
+    }
+    // slab is kept alive by the EntryAllocator stored in the control block.
+    e->incrementCount(1.0);
+    EXPECT_EQ(1.0, e->getCount());
+}
+
+TEST(EntryAllocatorTest, internedSelection) {
+    Entry e(1.0, 1.0, 1.0, IntIdentifer(3));
+    EXPECT_EQ(0, e.getSelectionId());
+    EXPECT_EQ("", e.getSelectedIn());
+    e.setSelectedIn("ymf");
+    int id = e.getSelectionId();
+    EXPECT_NE(0, id);
+    EXPECT_EQ("ymf", e.getSelectedIn());
+    Entry e2(2.0, 1.0, 1.0, IntIdentifer(4));
+    e2.setSelectedIn("ymf");
+    EXPECT_EQ(id, e2.getSelectionId());
+    e.reset(2.0);
+    EXPECT_EQ("", e.getSelectedIn());
+    EXPECT_EQ("ymf", StringRegistry::str(id));
+    EXPECT_THROW(StringRegistry::str(StringRegistry::size()), omnetpp::cRuntimeError);
+}
+
+// allocation counts and timing compared to make_shared: tests/benchmark
+// (BM_EntryAllocator_*)
+TEST(EntryAllocatorTest, entriesShareSlabs) {
+    const int N = 2000;
+    auto slab = std::make_shared<EntrySlabAllocator>();
+    {
+        EntryDefaultCtorImpl<IntIdentifer, omnetpp::simtime_t> ctor(slab);
+        std::vector<std::shared_ptr<Entry>> entries;
+        for (int i = 0; i < N; i++){
+            if (i % 10 == 0){
+                entries.push_back(ctor.globalEntry());
+            } else {
+                entries.push_back(makeSlabShared<Entry>(slab, 1.0, (double)i, (double)i, IntIdentifer(i)));
+            }
+        }
+        EXPECT_EQ(N, slab->getStats().live());
+        EXPECT_EQ(N, slab->getStats().peakLive);
+    }
+    EXPECT_EQ(N, slab->getStats().allocations);
+    EXPECT_EQ(0, slab->getStats().live());
+    EXPECT_EQ(0, slab->getStats().fallbackAllocations);
+    // two size classes with geometric slab growth
+    EXPECT_LT(slab->getStats().chunkAllocations, 20);
+
+    // freed blocks are reused without new slabs
+    auto chunks = slab->getStats().chunkAllocations;
+    for (int i = 0; i < N; i++){
+        makeSlabShared<Entry>(slab, 1.0, (double)i, (double)i, IntIdentifer(i));
+    }
+    EXPECT_EQ(chunks, slab->getStats().chunkAllocations);
+}
@@ -77,6 +77,74 @@ TEST_F(NeighborhoodTableTest, checkAllTimeToLive) {
   EXPECT_EQ(nTable.getTable().count(4), 0); // invlaid not found
 }
 
+class RemovedListener : public NeighborhoodEntryListner {
+ public:
+    virtual void neighborhoodEntryRemoved(INeighborhoodTable* table, BeaconReceptionInfo* info) override {
+        removed.push_back(info->getNodeId());
+    }
+    virtual void neighborhoodEntryLeaveCell(INeighborhoodTable* table, BeaconReceptionInfo* info) override {}
+    virtual void neighborhoodEntryEnterCell(INeighborhoodTable* table, BeaconReceptionInfo* info) override {}
+    virtual void neighborhoodEntryStayInCell(INeighborhoodTable* table, BeaconReceptionInfo* info) override {}
+    std::vector<int> removed;
+};
+
+TEST_F(NeighborhoodTableTest, checkAllTimeToLiveRemoveOrder) {
+  setSimTime(20.0);
+  simtime_t now = simTime();
+  double maxAge = 3.0;
+  NeighborhoodTable nTable;
+  nTable.setMaxAge(maxAge);
+  RemovedListener l;
+  nTable.registerEntryListner(&l);
+
+  // expiry order differs from node id order
+  apply(nTable, 7, now - maxAge - 3, now - maxAge - 3, inet::Coord(0.0,0.0), inet::Coord(0.0,0.0));
+  apply(nTable, 2, now - maxAge - 1, now - maxAge - 1, inet::Coord(0.0,0.0), inet::Coord(0.0,0.0));
+  apply(nTable, 5, now - maxAge - 2, now - maxAge - 2, inet::Coord(0.0,0.0), inet::Coord(0.0,0.0));
+  apply(nTable, 1, now - maxAge + 1, now - maxAge + 1, inet::Coord(0.0,0.0), inet::Coord(0.0,0.0));
+
+  nTable.checkAllTimeToLive();
+  EXPECT_EQ(l.removed, std::vector<int>({2, 5, 7}));
+  EXPECT_EQ(nTable.getTable().size(), 1);
+
+  // nothing expired since last check
+  nTable.checkAllTimeToLive();
+  EXPECT_EQ(l.removed.size(), 3);
+
+  setSimTime(now + 1.5);
+  EXPECT_EQ(nTable.getSize(), 0);
+  EXPECT_EQ(l.removed, std::vector<int>({2, 5, 7, 1}));
+}
+
+TEST_F(NeighborhoodTableTest, checkAllTimeToLiveUpdatedEntry) {
+  setSimTime(20.0);
+  simtime_t now = simTime();
+  double maxAge = 3.0;
+  NeighborhoodTable nTable;
+  nTable.setMaxAge(maxAge);
+  RemovedListener l;
+  nTable.registerEntryListner(&l);
+
+  apply(nTable, 0, now - 1, now - 1, inet::Coord(0.0,0.0), inet::Coord(0.0,0.0));
+  apply(nTable, 1, now - 1, now - 1, inet::Coord(0.0,0.0), inet::Coord(0.0,0.0));
+  // new beacon of node 0 replaces the old info object
+  apply(nTable, 0, now, now, inet::Coord(1.0,0.0), inet::Coord(0.0,0.0));
+  // node 1 is updated in place
+  updateInfo(nTable.getForUpdate(1), now + 0.5, now + 0.5, inet::Coord(1.0,0.0), inet::Coord(0.0,0.0));
+
+  setSimTime(now + maxAge - 0.5);
+  EXPECT_EQ(nTable.getSize(), 2);
+  EXPECT_TRUE(l.removed.empty());
+
+  setSimTime(now + maxAge + 0.1);
+  EXPECT_EQ(nTable.getSize(), 1);
+  EXPECT_EQ(l.removed, std::vector<int>({0}));
+
+  setSimTime(now + maxAge + 0.6);
+  EXPECT_EQ(nTable.getSize(), 0);
+  EXPECT_EQ(l.removed, std::vector<int>({0, 1}));
+}
+
 TEST_F(NeighborhoodTableTest, handleBeacon) {
   NeighborhoodTable nTable;
 
@@ -0,0 +1,113 @@
+/*
+ * PositionQuantizerTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+#include "main_test.h"
+#include "crownet/common/converter/PositionQuantizer.h"
+
+using namespace crownet;
+
+class PositionQuantizerTest : public BaseOppTest {
+ public:
+  PositionQuantizerTest() {
+    // Munich (UTM zone 32N), 2km x 1km
+    converter = std::make_shared<OsgCoordinateConverter>(
+            inet::Coord(691000.0, 5334000.0), inet::Coord(2000.0, 1000.0), "EPSG:32632");
+  }
+
+  // random OCS position in [0, width] x [0, height] (TCS) passed through the
+  // geographic projection (TCS -> WGS84 -> OCS).
+  inet::Coord randomPosition(std::mt19937& rng, double width, double height) {
+    std::uniform_real_distribution<double> x(0.0, width);
+    std::uniform_real_distribution<double> y(0.0, height);
+    auto geo = converter->convertToGeoInet(traci::TraCIPosition(x(rng), y(rng), 0.0));
+    return converter->convertToCartInetPosition(geo);
+  }
+
+ protected:
+  std::shared_ptr<OsgCoordinateConverter> converter;
+};
+
+TEST_F(PositionQuantizerTest, errorBound) {
+  std::mt19937 rng(42);
+  // 2621.4m, 6553.5m and 32767.5m per axis
+  for (auto cfg : {std::make_pair(0.01, 18), std::make_pair(0.1, 16), std::make_pair(0.5, 16)}) {
+    double resolution = cfg.first;
+    PositionQuantizer q(converter, resolution, cfg.second);
+    EXPECT_DOUBLE_EQ(resolution / 2.0, q.getMaxError());
+    for (int i = 0; i < 1000; i++) {
+      auto pos = randomPosition(rng, 2000.0, 1000.0);
+      ASSERT_TRUE(q.covers(pos)) << pos;
+      auto decoded = q.quantize(pos);
+      EXPECT_LE(std::abs(decoded.x - pos.x), q.getMaxError() + 1e-6) << pos << " res " << resolution;
+      EXPECT_LE(std::abs(decoded.y - pos.y), q.getMaxError() + 1e-6) << pos << " res " << resolution;
+      // idempotent: receiver side positions are encoded without further error
+      uint32_t x1, y1, x2, y2;
+      q.encode(pos, x1, y1);
+      q.encode(decoded, x2, y2);
+      EXPECT_EQ(x1, x2);
+      EXPECT_EQ(y1, y2);
+    }
+  }
+}
+
+TEST_F(PositionQuantizerTest, aoiRelative) {
+  AreaOfInterest aoi;
+  aoi.setX(1000.);
+  aoi.setY(200.);
+  aoi.setWidth(500.);
+  aoi.setHeight(500.);
+  converter->setAreaOfInterest(&aoi);
+  PositionQuantizer q(converter, 0.1);
+
+  uint32_t x, y;
+  // AOI origin (TCS lower left) is the fixed point origin
+  q.encode(converter->position_cast_inet(traci::TraCIPosition(1000.0, 200.0, 0.0)), x, y);
+  EXPECT_EQ(0u, x);
+  EXPECT_EQ(0u, y);
+  q.encode(converter->position_cast_inet(traci::TraCIPosition(1012.34, 250.06, 0.0)), x, y);
+  EXPECT_EQ(123u, x);
+  EXPECT_EQ(501u, y);
+
+  // outside of AOI: clamped to the border of the covered area
+  auto outside = converter->position_cast_inet(traci::TraCIPosition(900.0, 200.0, 0.0));
+  EXPECT_FALSE(q.covers(outside));
+  q.encode(outside, x, y);
+  EXPECT_EQ(0u, x);
+  EXPECT_DOUBLE_EQ(6553.5, q.getCoverage());
+  q.encode(converter->position_cast_inet(traci::TraCIPosition(8000.0, 210.0, 0.0)), x, y);
+  EXPECT_EQ(65535u, x);
+  EXPECT_EQ(100u, y);
+
+  // covered area (25.5m) smaller than the AOI (500m)
+  EXPECT_THROW(PositionQuantizer(converter, 0.1, 8), cRuntimeError);
+
+  EXPECT_THROW(PositionQuantizer(converter, 0.0), cRuntimeError);
+  EXPECT_THROW(PositionQuantizer(converter, 0.1, 33), cRuntimeError);
+}
+
+TEST_F(PositionQuantizerTest, speedAndHeading) {
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<double> speed(0.0, 63.75);
+  std::uniform_real_distribution<double> heading(-4 * M_PI, 4 * M_PI);
+  for (int i = 0; i < 1000; i++) {
+    double s = speed(rng);
+    EXPECT_LE(std::abs(dequantizeSpeed(quantizeSpeed(s)) - s), COMPACT_SPEED_RESOLUTION / 2.0);
+
+    double h = heading(rng);
+    double d = std::abs(dequantizeHeading(quantizeHeading(h)) - std::fmod(h + 4 * M_PI, 2 * M_PI));
+    d = std::min(d, 2 * M_PI - d);  // wrap around at 0
+    EXPECT_LE(d, M_PI / (1 << COMPACT_HEADING_BITS) + 1e-9);
+  }
+  // saturate
+  EXPECT_EQ(255, quantizeSpeed(100.0));
+  EXPECT_EQ(0, quantizeHeading(2 * M_PI - 1e-6));
+  EXPECT_EQ(64, quantizeHeading(M_PI / 2));
+}
@@ -0,0 +1,66 @@
+/*
+ * ProfilerTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <thread>
+#include <vector>
+
+#include "crownet/common/util/Profiler.h"
+#include "main_test.h"
+
+using namespace crownet;
+
+namespace {
+
+// Scope only compares type pointers. No need for real component types.
+char typeTags[64];
+const cComponentType* fakeType(int i) {
+  return reinterpret_cast<const cComponentType*>(&typeTags[i]);
+}
+
+}  // namespace
+
+TEST(ProfilerTest, statPerType) {
+  static profile::Scope scope("test.statPerType");
+  auto& sa = scope.getStat(fakeType(0));
+  auto& sb = scope.getStat(fakeType(1));
+  EXPECT_NE(&sa, &sb);
+  EXPECT_EQ(&sa, &scope.getStat(fakeType(0)));
+  EXPECT_EQ(scope.getStatCount(), 2);
+  EXPECT_EQ(sb.type.load(), fakeType(1));
+}
+
+TEST(ProfilerTest, overflowSlot) {
+  static profile::Scope scope("test.overflowSlot");
+  const int maxTypes = profile::Scope::MAX_TYPES;
+  const int n = maxTypes + 4;
+  for (int i = 0; i < n; i++) {
+    scope.getStat(fakeType(i));
+  }
+  EXPECT_EQ(scope.getStatCount(), maxTypes);
+  auto& last = scope.getStatAt(maxTypes - 1);
+  EXPECT_EQ(last.type.load(), nullptr);
+  EXPECT_EQ(&scope.getStat(fakeType(n - 1)), &last);
+}
+
+TEST(ProfilerTest, timerConcurrent) {
+  static profile::Scope scope("test.timerConcurrent");
+  const int N = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([]() {
+      for (int i = 0; i < N; i++) {
+        profile::ScopedTimer timer(scope, nullptr);
+      }
+    });
+  }
+  for (auto& t : threads) t.join();
+  ASSERT_EQ(scope.getStatCount(), 1);
+  EXPECT_EQ(scope.getStatAt(0).calls.load(), 4 * N);
+
+  profile::Registry::instance().reset();
+  EXPECT_EQ(scope.getStatAt(0).calls.load(), 0);
+}
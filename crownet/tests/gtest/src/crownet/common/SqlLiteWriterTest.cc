@@ -0,0 +1,257 @@
+/*
+ * SqlLiteWriterTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <gtest/gtest.h>
+#include <omnetpp.h>
+#include <unistd.h>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "crownet/applications/dmap/dmap_m.h"
+#include "crownet/common/util/FileWriter.h"
+#include "crownet/common/util/NeighborhoodEventWriter.h"
+#include "crownet/common/util/SqlApi.h"
+#include "crownet/common/util/SqlLiteWriter.h"
+#include "crownet/crownet_testutil.h"
+#include "main_test.h"
+
+using namespace crownet;
+using omnetpp::cRuntimeError;
+
+namespace {
+
+class TestSqlPrinter : public SqlPrinter {
+ public:
+  void createSchema(SqlApi& api) override {
+    api.exec("CREATE TABLE IF NOT EXISTS meta(key TEXT, value TEXT)");
+    api.exec("CREATE TABLE IF NOT EXISTS data(step INTEGER, x REAL, name TEXT)");
+    insert = api.prepare("INSERT INTO data VALUES (?,?,?)");
+  }
+  void writeInitSqlStatement(SqlApi& api, const std::map<std::string, std::string>& metadata) override {
+    auto stmt = api.prepare("INSERT INTO meta VALUES (?,?)");
+    for (const auto& e : metadata) {
+      stmt->bind(1, e.first).bind(2, e.second);
+      stmt->exec();
+    }
+  }
+  void writeSqlStatement(SqlApi& api) override {
+    for (int i = 0; i < rowsPerInterval; i++) {
+      insert->bind(1, step).bind(2, 0.5 * i).bind(3, std::string("row"));
+      insert->exec();
+    }
+    step++;
+  }
+
+  int rowsPerInterval = 3;
+  int step = 0;
+  std::unique_ptr<SqlStatement> insert;
+};
+
+// access writeEvent without neighborhood table and global map
+class TestEventSqlWriter : public NeighborhoodEventSqlWriter {
+ public:
+  using NeighborhoodEventSqlWriter::NeighborhoodEventSqlWriter;
+  using NeighborhoodEventSqlWriter::writeEvent;
+};
+
+class SqlLiteWriterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    char tmpl[] = "/tmp/crownet_sql_XXXXXX";
+    int fd = mkstemp(tmpl);
+    ASSERT_NE(-1, fd);
+    close(fd);
+    path = tmpl;
+  }
+  void TearDown() override {
+    std::remove(path.c_str());
+    std::remove((path + "-wal").c_str());
+    std::remove((path + "-shm").c_str());
+  }
+
+  // count rows using a separate connection (only committed rows are visible)
+  int64_t committedRows(const std::string& table) {
+    SqlApi reader(path);
+    auto stmt = reader.prepare("SELECT count(*) FROM " + table);
+    EXPECT_TRUE(stmt->step());
+    return stmt->getInt(0);
+  }
+
+  std::string path;
+};
+
+}  // namespace
+
+TEST_F(SqlLiteWriterTest, statement) {
+  SqlApi api(path);
+  api.exec("CREATE TABLE t(a INTEGER, b REAL, c TEXT)");
+  auto insert = api.prepare("INSERT INTO t VALUES (?,?,?)");
+  insert->bind(1, (int64_t)1 << 40).bind(2, 1.25).bind(3, std::string("abc"));
+  insert->exec();
+  insert->bind(1, -1).bindNull(2).bind(3, std::string(""));
+  insert->exec();
+
+  auto select = api.prepare("SELECT a, b, c FROM t ORDER BY a");
+  ASSERT_TRUE(select->step());
+  EXPECT_EQ(-1, select->getInt(0));
+  EXPECT_EQ(0.0, select->getDouble(1));
+  EXPECT_EQ("", select->getString(2));
+  ASSERT_TRUE(select->step());
+  EXPECT_EQ((int64_t)1 << 40, select->getInt(0));
+  EXPECT_EQ(1.25, select->getDouble(1));
+  EXPECT_EQ("abc", select->getString(2));
+  EXPECT_FALSE(select->step());
+
+  EXPECT_THROW(api.prepare("SELECT * FROM missing"), cRuntimeError);
+  EXPECT_THROW(api.exec("not sql"), cRuntimeError);
+}
+
+TEST_F(SqlLiteWriterTest, exclusiveConnection) {
+  // transactions are per connection. Writers must not share one.
+  auto a = SqlApi::open(path);
+  EXPECT_THROW(SqlApi::open(path), cRuntimeError);
+  auto c = SqlApi::open(path + "-other");
+  EXPECT_NE(a.get(), c.get());
+  c.reset();
+  std::remove((path + "-other").c_str());
+  std::remove((path + "-other-wal").c_str());
+  std::remove((path + "-other-shm").c_str());
+  // readers use their own connection
+  EXPECT_EQ(0, committedRows("sqlite_master"));
+  a.reset();
+  EXPECT_NO_THROW(SqlApi::open(path));
+}
+
+TEST_F(SqlLiteWriterTest, commitInterval) {
+  auto printer = std::make_shared<TestSqlPrinter>();
+  {
+    SqlLiteWriter writer(SqlApi::open(path), printer, 2);
+    writer.initialize();
+    std::map<std::string, std::string> metadata{{"XSIZE", "10"}, {"YSIZE", "20"}};
+    writer.writeMetaData(metadata);
+    writer.initWriter();
+    EXPECT_EQ(2, committedRows("meta"));
+
+    writer.writeData();
+    EXPECT_EQ(0, committedRows("data"));  // transaction still open
+    writer.writeData();
+    EXPECT_EQ(6, committedRows("data"));  // two intervals committed
+    writer.writeData();
+    EXPECT_EQ(6, committedRows("data"));
+    writer.finish();
+    EXPECT_EQ(9, committedRows("data"));
+  }
+
+  SqlApi api(path);
+  auto select = api.prepare("SELECT step, count(*) FROM data GROUP BY step ORDER BY step");
+  for (int step = 0; step < 3; step++) {
+    ASSERT_TRUE(select->step());
+    EXPECT_EQ(step, select->getInt(0));
+    EXPECT_EQ(3, select->getInt(1));
+  }
+  EXPECT_FALSE(select->step());
+}
+
+TEST_F(SqlLiteWriterTest, reopen) {
+  auto printer = std::make_shared<TestSqlPrinter>();
+  {
+    SqlLiteWriter writer(SqlApi::open(path), printer);
+    writer.initialize();
+    writer.writeData();
+  }  // finish() on destruction
+  {
+    // schema exists already
+    SqlLiteWriter writer(SqlApi::open(path), printer);
+    writer.initialize();
+    writer.writeData();
+  }
+  EXPECT_EQ(6, committedRows("data"));
+  EXPECT_THROW(SqlLiteWriter(SqlApi::open(path), printer, 0), cRuntimeError);
+}
+
+TEST_F(SqlLiteWriterTest, mapWriter) {
+  DcdFactoryProvider f;
+  auto map = f.dcdFactory->create_shared_ptr(IntIdentifer(7));
+  MapCfg mapCfg;
+  mapCfg.setWriterType("sql");
+  mapCfg.setSqlCommitInterval(2);
+  {
+    ActiveFileWriterBuilder builder{};
+    builder.addMetadata("NODE_ID", 7);
+    builder.addPath(path);
+    std::unique_ptr<ActiveWriter> writer(builder.build<RegularDcdMap>(map, &mapCfg));
+    ASSERT_NE(nullptr, dynamic_cast<SqlLiteWriter*>(writer.get()));
+    writer->initWriter();
+    writer->writeData();
+
+    // second writer for the same database (e.g. same sqlFile as another map)
+    ActiveFileWriterBuilder other{};
+    other.addPath(path);
+    EXPECT_THROW(other.build<RegularDcdMap>(map, &mapCfg), cRuntimeError);
+    writer->finish();
+  }
+  // IDXCOL, DATACOL, SEP and NODE_ID
+  EXPECT_EQ(4, committedRows("dcd_map_metadata"));
+  EXPECT_EQ(0, committedRows("dcd_map"));  // no valid cells
+
+  SqlApi api(path);
+  auto select = api.prepare("SELECT DISTINCT node_id FROM dcd_map_metadata");
+  ASSERT_TRUE(select->step());
+  EXPECT_EQ(7, select->getInt(0));
+
+  mapCfg.setWriterType("xml");
+  ActiveFileWriterBuilder builder{};
+  builder.addPath(path);
+  EXPECT_THROW(builder.build<RegularDcdMap>(map, &mapCfg), cRuntimeError);
+}
+
+TEST_F(SqlLiteWriterTest, neighborhoodEventCodes) {
+  NeighborhoodEvent e{1, 7, NeighborhoodEventCode::ENTER_CELL, 2.0, 1.5, 1.0, 42,
+                      inet::Coord(3.5, 4.5), 1, 10, 0, 10, 3.0, 4.0};
+  {
+    TestEventSqlWriter writer(path, 2);
+    writer.setEventCodes(true);
+    writer.initialize();
+    writer.writeEvent(e);
+    e.event = NeighborhoodEventCode::TTL_REACHED;
+    writer.writeEvent(e);
+    e.event = NeighborhoodEventCode::DROPPED;
+    writer.writeEvent(e);
+  }  // close() commits the last event
+  EXPECT_EQ(3, committedRows("neighborhood_event"));
+
+  SqlApi api(path);
+  auto column = api.prepare(
+      "SELECT type FROM pragma_table_info('neighborhood_event') WHERE name = 'event'");
+  ASSERT_TRUE(column->step());
+  EXPECT_EQ("INTEGER", column->getString(0));
+
+  auto select = api.prepare("SELECT typeof(event), event FROM neighborhood_event ORDER BY rowid");
+  std::vector<int64_t> codes;
+  while (select->step()) {
+    EXPECT_EQ("integer", select->getString(0));
+    codes.push_back(select->getInt(1));
+  }
+  EXPECT_EQ((std::vector<int64_t>{3, 1, 0}), codes);
+}
+
+TEST_F(SqlLiteWriterTest, neighborhoodEventNames) {
+  {
+    TestEventSqlWriter writer(path);
+    writer.initialize();
+    writer.writeEvent(NeighborhoodEvent{1, 7, NeighborhoodEventCode::STAY_IN_CELL, 2.0, 1.5, 1.0,
+                                        42, inet::Coord(3.5, 4.5), 0, 10, 0, 10, 3.0, 4.0});
+  }
+  SqlApi api(path);
+  auto select = api.prepare("SELECT typeof(event), event FROM neighborhood_event");
+  ASSERT_TRUE(select->step());
+  EXPECT_EQ("text", select->getString(0));
+  EXPECT_EQ("stay_in_cell", select->getString(1));
+}
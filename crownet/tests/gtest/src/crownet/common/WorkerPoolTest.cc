@@ -0,0 +1,53 @@
+/*
+ * WorkerPoolTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "crownet/common/util/WorkerPool.h"
+
+using namespace crownet;
+
+TEST(WorkerPoolTest, serial) {
+  WorkerPool pool(1);
+  EXPECT_EQ(1, pool.getNumThreads());
+  std::vector<int> order;
+  pool.parallelFor(5, [&](int i) { order.push_back(i); });
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 3, 4}), order);
+}
+
+TEST(WorkerPoolTest, allItemsOnce) {
+  WorkerPool pool(4);
+  EXPECT_EQ(4, pool.getNumThreads());
+  for (int run = 0; run < 50; run++) {
+    std::vector<int> data(1000, 0);
+    pool.parallelFor((int)data.size(), [&](int i) { data[i] += i; });
+    for (int i = 0; i < (int)data.size(); i++) {
+      ASSERT_EQ(i, data[i]) << "run " << run;
+    }
+  }
+  // empty job
+  pool.parallelFor(0, [](int) { FAIL(); });
+}
+
+TEST(WorkerPoolTest, rethrowException) {
+  WorkerPool pool(3);
+  std::atomic<int> calls{0};
+  EXPECT_THROW(pool.parallelFor(100,
+                                [&](int i) {
+                                  ++calls;
+                                  if (i == 10) throw std::runtime_error("err");
+                                }),
+               std::runtime_error);
+  EXPECT_LE(calls.load(), 100);
+  // pool is still usable
+  std::atomic<int> sum{0};
+  pool.parallelFor(10, [&](int i) { sum += i; });
+  EXPECT_EQ(45, sum.load());
+}
@@ -103,7 +103,9 @@ TEST_F(FreeListTestF, iterator1){
     int j = 0;
     for(const auto& item : dList){
         EXPECT_DOUBLE_EQ(item, j*1.0);
+        j++;
     }
+    EXPECT_EQ(j, 30);
 }
 
 TEST_F(FreeListTestF, iterator2){
@@ -120,4 +122,39 @@ TEST_F(FreeListTestF, iterator2){
     for(const auto& item : dList){
         EXPECT_DOUBLE_EQ(item,val[i++]);
     }
+    EXPECT_EQ(i, 5);
+}
+
+TEST_F(FreeListTestF, iteratorEmpty){
+    EXPECT_TRUE(dList.begin() == dList.end());
+    dList.insert(1.0);
+    dList.erase(0);
+    EXPECT_TRUE(dList.begin() == dList.end());
+    EXPECT_FALSE(dList.begin() != dList.end());
+}
+
+TEST_F(FreeListTestF, iteratorAdvance){
+    for (int i=0; i < 5; i++){
+        dList.insert(i * 1.0);
+    }
+    dList.erase(4); // hole at the end
+    auto iter = dList.begin();
+    EXPECT_EQ(iter.getIndex(), 0);
+    EXPECT_EQ((iter++).getIndex(), 0);
+    EXPECT_EQ(iter.getIndex(), 1);
+    EXPECT_EQ((++iter).getIndex(), 2);
+    ++iter;
+    ++iter;
+    EXPECT_TRUE(iter == dList.end());
+    ++iter; // stays at end
+    EXPECT_TRUE(iter == dList.end());
+}
+
+TEST_F(FreeListTestF, eraseInvalid){
+    dList.insert(1.0);
+    dList.erase(0);
+    EXPECT_FALSE(dList.valid(0));
+    EXPECT_FALSE(dList.valid(1));
+    EXPECT_THROW(dList.erase(0), omnetpp::cRuntimeError);
+    EXPECT_EQ(dList.size(), 0);
 }
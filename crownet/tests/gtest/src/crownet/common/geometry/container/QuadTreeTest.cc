@@ -10,7 +10,9 @@
 
 #include <gtest/gtest.h>
 #include <omnetpp.h>
+#include <algorithm>
 #include <memory>
+#include <random>
 #include <string>
 
 #include "crownet/common/geometry/container/FreeList.h"
@@ -153,3 +155,158 @@ TEST_F(QuadTreeTestF, insertion1_cap4){
     testObjectsInQuadNode(qtree, 1, {0,1,2,3});
     testObjectsInQuadNode(qtree, 3, {4});
 }
+
+TEST_F(QuadTreeTestF, remove){
+    auto a = getData();
+    auto b = getData();
+    int idA = qtree->insert(a, {4.5, 4.5});
+    qtree->insert(b, {35.0, 35.0});
+    EXPECT_EQ(qtree->treeNodes.size(), 5);
+    testBranch(qtree, 0);
+
+    qtree->remove(idA);
+    EXPECT_EQ(qtree->dataSize(), 1);
+    EXPECT_EQ(qtree->getDataId(a), -1);
+    // children merged into root
+    testLeaf(qtree, 0);
+    testCount(qtree, 0, 1);
+    testObjectsInQuadNode(qtree, 0, {1});
+
+    qtree->remove(b);
+    EXPECT_EQ(qtree->dataSize(), 0);
+    testCount(qtree, 0, 0);
+    EXPECT_THROW(qtree->remove(b), cRuntimeError);
+    EXPECT_THROW(qtree->remove(idA), cRuntimeError);
+
+    // freed quadrants are reused
+    qtree->insert(getData(), {4.5, 4.5});
+    qtree->insert(getData(), {35.0, 35.0});
+    EXPECT_EQ(qtree->treeNodes.size(), 5);
+}
+
+TEST_F(QuadTreeTestF, removeDeep){
+    // 5 splits needed (see insertion4)
+    int id = qtree->insert(getData(), {4.5, 4.5});
+    qtree->insert(getData(), {7.0, 7.0});
+    EXPECT_EQ(qtree->treeNodes.size(), 1+5*4);
+    qtree->remove(id);
+    testLeaf(qtree, 0);
+    testCount(qtree, 0, 1);
+    // all 5 quadrant blocks reused
+    qtree->insert(getData(), {4.5, 4.5});
+    EXPECT_EQ(qtree->treeNodes.size(), 1+5*4);
+    EXPECT_EQ(qtree->queryRadius({5.0, 5.0}, 3.0).size(), 2);
+}
+
+TEST_F(QuadTreeTestF, maxDepth){
+    // same position: do not split beyond max_depth
+    qtree->insert(getData(), {4.5, 4.5});
+    qtree->insert(getData(), {4.5, 4.5});
+    qtree->insert(getData(), {4.5, 4.5});
+    EXPECT_EQ(qtree->dataSize(), 3);
+    EXPECT_EQ(qtree->treeNodes.size(), 1+10*4);
+    EXPECT_EQ(qtree->queryRadius({4.5, 4.5}, 0.0).size(), 3);
+}
+
+TEST_F(QuadTreeTestF, move){
+    auto a = getData();
+    int idA = qtree->insert(a, {4.5, 4.5});
+    int idB = qtree->insert(getData(), {35.0, 35.0});
+
+    // same quadrant
+    qtree->move(a, {5.0, 5.0});
+    EXPECT_EQ(qtree->getElement(idA).pos, Coord(5.0, 5.0));
+    EXPECT_EQ(qtree->treeNodes.size(), 5);
+
+    // other quadrant. Index stays valid
+    qtree->move(idA, {40.0, 40.0});
+    EXPECT_EQ(qtree->getDataId(a), idA);
+    EXPECT_EQ(qtree->getElement(idA).pos, Coord(40.0, 40.0));
+    EXPECT_EQ(qtree->dataSize(), 2);
+    auto r = qtree->queryRect({32.0, 32.0}, {64.0, 64.0});
+    std::sort(r.begin(), r.end());
+    EXPECT_EQ(r, std::vector<int>({std::min(idA, idB), std::max(idA, idB)}));
+    EXPECT_TRUE(qtree->queryRect({0.0, 0.0}, {31.0, 31.0}).empty());
+
+    EXPECT_THROW(qtree->move(idA, {65.0, 5.0}), cRuntimeError);
+    EXPECT_THROW(qtree->insert(a, {1.0, 1.0}), cRuntimeError);  // already inserted
+}
+
+namespace {
+
+std::vector<int> linearRadius(const std::vector<Coord>& points, const Coord& c, double r){
+    std::vector<int> ret;
+    for (int i = 0; i < (int)points.size(); i++){
+        double dx = points[i].x - c.x, dy = points[i].y - c.y;
+        if (dx*dx + dy*dy <= r*r) ret.push_back(i);
+    }
+    return ret;
+}
+
+std::vector<int> linearRect(const std::vector<Coord>& points, const Coord& min, const Coord& max){
+    std::vector<int> ret;
+    for (int i = 0; i < (int)points.size(); i++){
+        const auto& p = points[i];
+        if (p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y) ret.push_back(i);
+    }
+    return ret;
+}
+
+double sqrDist(const Coord& a, const Coord& b){
+    return (a.x - b.x)*(a.x - b.x) + (a.y - b.y)*(a.y - b.y);
+}
+
+}
+
+TEST_F(QuadTreeTestF, queriesMatchLinearScan){
+    resetCapacit(4);
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> u(0.0, 64.0);
+    std::vector<Coord> points;
+    std::vector<int> ids;
+    for (int i = 0; i < 500; i++){
+        points.push_back(Coord(u(rng), u(rng)));
+        ids.push_back(qtree->insert(getData(), points.back()));
+        EXPECT_EQ(ids.back(), i);
+    }
+    // move and remove some
+    std::vector<bool> removed(points.size(), false);
+    for (int i = 0; i < 500; i += 3){
+        points[i] = Coord(u(rng), u(rng));
+        qtree->move(ids[i], points[i]);
+    }
+    for (int i = 0; i < 500; i += 7){
+        qtree->remove(ids[i]);
+        removed[i] = true;
+    }
+    auto alive = [&](std::vector<int> v){
+        v.erase(std::remove_if(v.begin(), v.end(), [&](int i){return removed[i];}), v.end());
+        return v;
+    };
+
+    for (int q = 0; q < 50; q++){
+        Coord c(u(rng), u(rng));
+        double r = u(rng) / 4;
+        auto tree = qtree->queryRadius(c, r);
+        std::sort(tree.begin(), tree.end());
+        EXPECT_EQ(tree, alive(linearRadius(points, c, r)));
+
+        Coord min(u(rng), u(rng));
+        Coord max(min.x + r, min.y + 2*r);
+        tree = qtree->queryRect(min, max);
+        std::sort(tree.begin(), tree.end());
+        EXPECT_EQ(tree, alive(linearRect(points, min, max)));
+
+        int k = 1 + q % 10;
+        auto knn = qtree->kNearest(c, k);
+        ASSERT_EQ(knn.size(), k);
+        std::vector<double> expected;
+        for (int i : alive(linearRadius(points, c, 200.0))) expected.push_back(sqrDist(points[i], c));
+        std::sort(expected.begin(), expected.end());
+        for (int i = 0; i < k; i++){
+            EXPECT_DOUBLE_EQ(sqrDist(qtree->getElement(knn[i]).pos, c), expected[i]);
+        }
+    }
+    EXPECT_EQ(qtree->kNearest({0.0, 0.0}, 1000).size(), qtree->dataSize());
+    EXPECT_TRUE(qtree->kNearest({0.0, 0.0}, 0).empty());
+}
@@ -0,0 +1,183 @@
+/*
+ * ControlTraCiApiTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "crownet/control/ControlTraCiApi.h"
+#include "crownet/fake_traci.h"
+#include "main_test.h"
+
+using namespace crownet;
+using namespace libsumo;
+namespace tc = traci::constants;
+
+namespace {
+
+// acknowledgment of the external controller with its next step time
+void sendAck(FakeTraCiServer& controller, double nextTime) {
+  tcpip::Storage content;
+  content.writeUnsignedByte(TYPE_DOUBLE);
+  content.writeDouble(nextTime);
+  tcpip::Storage msg;
+  FakeTraCiServer::writeCommand(msg, tc::CMD_CONTROL, tc::VAR_STEP_ASYNC, "", content);
+  controller.write(msg);
+}
+
+class RecordingHandler : public ControlHandler {
+ public:
+  void handleActionCommand(const ControlCmd& cmd) override {
+    actions.push_back(cmd);
+  }
+  void getDensityMap(const DensityMapCmd& cmd, DensityMapSnapshot& snapshot) override {
+    snapshot.clear();
+    snapshot.gridSizeX = 100.0;
+    snapshot.gridSizeY = 50.0;
+    snapshot.cellSizeX = 5.0;
+    snapshot.cellSizeY = 5.0;
+    snapshot.add(1, 2, 3.0);
+    snapshot.add(19, 9, 1.0);
+    maps.push_back(cmd.nodeId);
+  }
+  std::vector<ControlCmd> actions;
+  std::vector<std::string> maps;
+};
+
+// forwarded VAR_EXTERNAL_INPUT command as sent by the controller
+tcpip::Storage actionCommand(const std::string& node) {
+  tcpip::Storage inner;
+  inner.writeUnsignedByte(TYPE_COMPOUND);
+  inner.writeInt(3);
+  for (const auto& s : {node, std::string("model"), std::string("{}")}) {
+    inner.writeUnsignedByte(TYPE_STRING);
+    inner.writeString(s);
+  }
+  tcpip::Storage payload;
+  FakeTraCiServer::writeCommand(payload, tc::CMD_CONTROL,
+                               tc::VAR_EXTERNAL_INPUT, "", inner);
+  tcpip::Storage msg;
+  FakeTraCiServer::writeCommand(msg, tc::CMD_CONTROL, tc::VAR_FORWARD,
+                               tc::SIMULATOR_OPP, payload);
+  return msg;
+}
+
+}  // namespace
+
+TEST(DensityMapSnapshotTest, packedReadWrite) {
+  DensityMapSnapshot map;
+  map.gridSizeX = 100.0;
+  map.gridSizeY = 50.0;
+  map.cellSizeX = 5.0;
+  map.cellSizeY = 2.5;
+  map.add(0, 0, 1.0);
+  map.add(19, 9, 2.5);
+  map.add(3, 7, 0.0);
+
+  tcpip::Storage buf;
+  map.write(buf);
+  // header 1 + 4*8 + 4, 8 byte per cell
+  EXPECT_EQ(buf.size(), 37 + 3 * 8);
+
+  EXPECT_EQ(buf.readUnsignedByte(), tc::TYPE_DENSITY_MAP_PACKED);
+  DensityMapSnapshot read;
+  read.read(buf);
+  EXPECT_DOUBLE_EQ(read.cellSizeY, 2.5);
+  ASSERT_EQ(read.cells.size(), 3);
+  EXPECT_EQ(read.cells[1].x, 19);
+  EXPECT_EQ(read.cells[1].y, 9);
+  EXPECT_DOUBLE_EQ(read.cells[1].count, 2.5);
+
+  std::vector<double> flat = {100.0, 50.0, 5.0, 2.5, 0, 0, 1.0, 19, 9, 2.5, 3, 7, 0.0};
+  EXPECT_EQ(read.toDoubleList(), flat);
+}
+
+TEST(DensityMapSnapshotTest, cellOutOfRange) {
+  DensityMapSnapshot map;
+  map.add(40000, 1, 1.0);
+  tcpip::Storage buf;
+  EXPECT_THROW(map.write(buf), omnetpp::cRuntimeError);
+}
+
+TEST(ControlTraCiApiTest, asyncStepWithLookahead) {
+  std::promise<void> release;
+  auto released = release.get_future();
+  std::promise<void> acked;
+  std::vector<double> stepTimes;
+  std::vector<int> mapCells;
+  int forwardStatus = -1;
+
+  FakeTraCiServer controller([&](FakeTraCiServer& c) {
+    // two steps arrive without the controller answering
+    for (int i = 0; i < 2; i++) {
+      auto step = c.read();
+      EXPECT_EQ(FakeTraCiServer::readCommand(step, tc::CMD_CONTROL), tc::VAR_STEP_ASYNC);
+      EXPECT_EQ(step.readUnsignedByte(), TYPE_COMPOUND);
+      EXPECT_EQ(step.readInt(), 4);
+      step.readUnsignedByte();
+      stepTimes.push_back(step.readDouble());
+      step.readUnsignedByte();
+      EXPECT_EQ(step.readInt(), 1);
+      step.readUnsignedByte();
+      EXPECT_EQ(step.readString(), "node1");
+      EXPECT_EQ(step.readUnsignedByte(), tc::TYPE_DENSITY_MAP_PACKED);
+      DensityMapSnapshot map;
+      map.read(step);
+      mapCells.push_back((int)map.cells.size());
+    }
+    released.wait();
+    // command for the next step and acknowledgment of the first step
+    auto action = actionCommand("node1.app");
+    c.write(action);
+    sendAck(c, -1.0);
+    auto response = c.read();
+    response.readUnsignedByte();
+    EXPECT_EQ(response.readUnsignedByte(), tc::CMD_CONTROL);
+    forwardStatus = response.readUnsignedByte();
+    // third step is sent after the first acknowledgment
+    auto step = c.read();
+    EXPECT_EQ(FakeTraCiServer::readCommand(step, tc::CMD_CONTROL), tc::VAR_STEP_ASYNC);
+    step.readUnsignedByte();
+    step.readInt();
+    step.readUnsignedByte();
+    stepTimes.push_back(step.readDouble());
+    sendAck(c, -1.0);
+    sendAck(c, 6.0);
+    acked.set_value();
+    c.read();  // fourth step
+  });
+
+  RecordingHandler handler;
+  ControlTraCiApi api;
+  api.setControlHandler(&handler);
+  api.connect("localhost", controller.getPort());
+  api.enableAsync(2, {"node1"});
+
+  // controller is busy: steps must not block within the lookahead
+  EXPECT_DOUBLE_EQ(api.handleSimStep(1.0), -1.0);
+  EXPECT_DOUBLE_EQ(api.handleSimStep(2.0), -1.0);
+  EXPECT_EQ(api.getPendingSteps(), 2);
+  EXPECT_TRUE(handler.actions.empty());
+
+  // lookahead exhausted: waits for the first acknowledgment and applies the
+  // command received before it.
+  release.set_value();
+  EXPECT_DOUBLE_EQ(api.handleSimStep(3.0), -1.0);
+  EXPECT_EQ(api.getPendingSteps(), 2);
+  ASSERT_EQ(handler.actions.size(), 1);
+  EXPECT_EQ(handler.actions[0].sendingNode, "node1.app");
+
+  acked.get_future().wait();
+  EXPECT_DOUBLE_EQ(api.handleSimStep(4.0), 6.0);
+  EXPECT_EQ(api.getPendingSteps(), 1);
+  controller.join();
+
+  EXPECT_EQ(stepTimes, std::vector<double>({1.0, 2.0, 3.0}));
+  EXPECT_EQ(mapCells, std::vector<int>({2, 2}));
+  EXPECT_EQ(handler.maps.size(), 4);
+  EXPECT_EQ(forwardStatus, RTYPE_OK);
+}
@@ -0,0 +1,64 @@
+/*
+ * CellDistanceTableTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <memory>
+
+#include "main_test.h"
+#include "crownet/common/RegularGridInfo.h"
+#include "crownet/dcd/identifier/CellDistanceTable.h"
+#include "inet/common/geometry/common/Coord.h"
+
+using namespace crownet;
+
+TEST(CellDistanceTableTest, sameAsGridInfo) {
+  inet::Coord cellSize{3.0, 7.5};
+  RegularGridInfo grid{inet::Coord{30.0, 75.0}, cellSize};
+  CellDistanceTable table{cellSize, 10, 10};
+  for (int x1 = -2; x1 < 12; x1 += 3) {
+    for (int y1 = -2; y1 < 12; y1 += 2) {
+      for (int x2 = 0; x2 < 14; x2++) {
+        for (int y2 = 0; y2 < 14; y2++) {
+          GridCellID c1{x1, y1}, c2{x2, y2};
+          EXPECT_DOUBLE_EQ(grid.cellCenterDist(c1, c2), table.cellCenterDist(c1, c2));
+          EXPECT_EQ(table.cellCenterDist(c1, c2), table.cellCenterDist(c2, c1));
+        }
+      }
+    }
+  }
+  EXPECT_EQ(0.0, table.cellCenterDist(GridCellID{4, 4}, GridCellID{4, 4}));
+}
+
+TEST(CellDistanceTableTest, hitMiss) {
+  CellDistanceTable table{inet::Coord{5.0, 5.0}, 4, 4};
+  EXPECT_EQ(5.0, table.cellCenterDist(GridCellID{0, 0}, GridCellID{1, 0}));
+  EXPECT_EQ(25.0, table.cellCenterDist(GridCellID{0, 0}, GridCellID{3, 4}));  // outside
+  EXPECT_EQ(50.0, table.cellCenterDist(GridCellID{2, 2}, GridCellID{8, 10}));  // outside
+  EXPECT_EQ(1, table.getHits());
+  EXPECT_EQ(2, table.getMisses());
+}
+
+TEST(CellDistanceTableTest, bounded) {
+  CellDistanceTable table{inet::Coord{1.0, 1.0}, 1000, 1000, 100};
+  EXPECT_EQ(10, table.getSizeX());
+  EXPECT_EQ(10, table.getSizeY());
+  EXPECT_EQ(5.0, table.cellCenterDist(GridCellID{0, 0}, GridCellID{3, 4}));
+  EXPECT_EQ(500.0, table.cellCenterDist(GridCellID{0, 0}, GridCellID{300, 400}));
+  EXPECT_EQ(1, table.getHits());
+  EXPECT_EQ(1, table.getMisses());
+
+  CellDistanceTable narrow{inet::Coord{1.0, 1.0}, 5, 1000, 100};
+  EXPECT_EQ(5, narrow.getSizeX());
+  EXPECT_EQ(20, narrow.getSizeY());
+}
+
+TEST(CellDistanceTableTest, shared) {
+  auto a = CellDistanceTable::get(inet::Coord{5.0, 5.0}, inet::Coord{20.0, 20.0});
+  auto b = CellDistanceTable::get(inet::Coord{5.0, 5.0}, inet::Coord{20.0, 20.0});
+  auto c = CellDistanceTable::get(inet::Coord{2.0, 5.0}, inet::Coord{20.0, 20.0});
+  EXPECT_EQ(a.get(), b.get());
+  EXPECT_NE(a.get(), c.get());
+}
@@ -0,0 +1,155 @@
+/*
+ * CellIdStreamTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "main_test.h"
+#include "crownet/crownet_testutil.h"
+
+#include "crownet/common/Entry.h"
+#include "crownet/dcd/regularGrid/MapCellAggregationAlgorithms.h"
+#include "crownet/dcd/regularGrid/RegularDcdMap.h"
+
+using namespace crownet;
+
+namespace {
+
+DcdFactoryProvider f = DcdFactoryProvider(
+        inet::Coord(.0, .0),
+        inet::Coord(20.0, 20.0),
+        1.0
+);
+std::shared_ptr<RegularDcdMapFactory> dcdFactory = f.dcdFactory;
+
+}
+
+class CellIdStreamTest : public BaseOppTest {
+ public:
+  using Entry = IEntry<IntIdentifer, omnetpp::simtime_t>;
+
+  void set(RegularDcdMapPtr map, int x, double count, IntIdentifer source = IntIdentifer(7)){
+      map->setEntry(GridCellID(x, 0), std::make_shared<Entry>(count, simTime(), simTime(), source));
+  }
+  void compute(RegularDcdMapPtr map){
+      auto v = std::make_shared<YmfVisitor>(simTime());
+      map->computeValues(v);
+  }
+  // same as BaseDensityMapApp::buildPayload
+  std::vector<int> send(RegularDcdMapPtr map, int maxCount){
+      std::vector<int> ret;
+      auto stream = map->getCellKeyStream();
+      for (int i = 0; i < maxCount; i++){
+          if (!stream->hasNext(simTime())){
+              break;
+          }
+          auto& cell = stream->nextCell(simTime());
+          cell.sentAt(simTime());
+          ret.push_back(cell.getCellId().x());
+      }
+      return ret;
+  }
+};
+
+TEST_F(CellIdStreamTest, roundRobinSameAsInsertionOrder) {
+    auto mapA = dcdFactory->create_shared_ptr(IntIdentifer(1), "insertionOrder");
+    auto mapB = dcdFactory->create_shared_ptr(IntIdentifer(1), "roundRobin");
+    auto streamA = mapA->getCellKeyStream();
+    auto streamB = mapB->getCellKeyStream();
+    std::mt19937 rng(4711);
+    int cells = 0;
+
+    for (int step = 1; step < 300; step++){
+        setSimTime((double)step);
+        int add = rng() % 3;
+        for (int i = 0; i < add && cells < 20; i++, cells++){
+            mapA->getCell(GridCellID(cells, 0));
+            mapB->getCell(GridCellID(cells, 0));
+        }
+        for (int x = 0; x < cells; x++){
+            double count = 1 + rng() % 5;
+            bool valid = rng() % 4 != 0;
+            for (auto map : {mapA, mapB}){
+                set(map, x, count);
+                if (!valid){
+                    map->getEntry<>(GridCellID(x, 0), IntIdentifer(7))->reset(simTime());
+                }
+            }
+        }
+        compute(mapA);
+        compute(mapB);
+
+        for (int pkt = 0; pkt < 2; pkt++){
+            int maxCount = 1 + rng() % 6;
+            ASSERT_EQ(streamA->size(simTime()), streamB->size(simTime())) << "step " << step;
+            auto peekA = streamA->peekCellIds(simTime(), maxCount);
+            auto peekB = streamB->peekCellIds(simTime(), maxCount);
+            ASSERT_EQ(peekA, peekB) << "step " << step;
+            ASSERT_EQ(send(mapA, maxCount), send(mapB, maxCount)) << "step " << step;
+        }
+    }
+}
+
+TEST_F(CellIdStreamTest, oldestSentFirst) {
+    auto map = dcdFactory->create_shared_ptr(IntIdentifer(1), "oldestSentFirst");
+    setSimTime(1.0);
+    for (int x = 0; x < 6; x++){
+        set(map, x, 1.0);
+    }
+    compute(map);
+    // never sent, newest cell first.
+    EXPECT_EQ(send(map, 3), std::vector<int>({5, 4, 3}));
+    EXPECT_EQ(map->getCellKeyStream()->size(simTime()), 3);
+
+    setSimTime(2.0);
+    compute(map);
+    EXPECT_EQ(map->getCellKeyStream()->size(simTime()), 6);
+    EXPECT_EQ(map->getCellKeyStream()->peekCellIds(simTime(), 4).size(), 4);
+    EXPECT_EQ(send(map, 4), std::vector<int>({2, 1, 0, 5}));
+
+    setSimTime(3.0);
+    compute(map);
+    EXPECT_EQ(send(map, 6), std::vector<int>({4, 3, 2, 1, 0, 5}));
+    EXPECT_FALSE(map->getCellKeyStream()->hasNext(simTime()));
+    EXPECT_EQ(map->getCellKeyStream()->size(simTime()), 0);
+}
+
+TEST_F(CellIdStreamTest, highestChangeFirst) {
+    auto map = dcdFactory->create_shared_ptr(IntIdentifer(1), "highestChangeFirst");
+    setSimTime(1.0);
+    for (int x = 0; x < 4; x++){
+        set(map, x, 10.0);
+    }
+    compute(map);
+    EXPECT_EQ(send(map, 4), std::vector<int>({3, 2, 1, 0}));
+
+    setSimTime(2.0);
+    set(map, 0, 11.0);
+    set(map, 1, 20.0);
+    set(map, 2, 10.0);
+    set(map, 3, 5.0);
+    set(map, 4, 1.0); // never sent
+    compute(map);
+    EXPECT_EQ(send(map, 2), std::vector<int>({4, 1}));
+    EXPECT_EQ(map->getCellKeyStream()->peekCellIds(simTime(), 3), std::vector<GridCellID>(
+            {GridCellID(3, 0), GridCellID(0, 0), GridCellID(2, 0)}));
+    EXPECT_EQ(send(map, 3), std::vector<int>({3, 0, 2}));
+}
+
+TEST_F(CellIdStreamTest, defaultType) {
+    using RoundRobin = SendStateCellIdStream<GridCellID, IntIdentifer, omnetpp::simtime_t>;
+    auto map = dcdFactory->create_shared_ptr(IntIdentifer(1), "default");
+    auto stream = std::dynamic_pointer_cast<RoundRobin>(map->getCellKeyStream());
+    ASSERT_NE(nullptr, stream);
+    EXPECT_EQ(CellIdStreamPolicy::ROUND_ROBIN, stream->getPolicy());
+}
+
+TEST_F(CellIdStreamTest, unknownType) {
+    EXPECT_THROW(dcdFactory->create_shared_ptr(IntIdentifer(1), "foo"), omnetpp::cRuntimeError);
+}
@@ -17,7 +17,9 @@
 #include "crownet/dcd/regularGrid/RegularCellVisitors.h"
 #include "crownet/dcd/regularGrid/RegularDcdMap.h"
 #include "crownet/dcd/regularGrid/MapCellAggregationAlgorithms.h"
+#include "crownet/dcd/generic/AggregationKernels.h"
 #include <iostream>
+#include <random>
 #include <fstream>
 #include <boost/predef/other/endian.h>
 #include <boost/endian/conversion.hpp>
@@ -322,3 +324,84 @@ TEST_F(DPMM_CellAggregationAlgTest, ymfPlusDistStep_two_element_with_rank_disagg
 }
 
 
+
+TEST_F(DPMM_CellAggregationAlgTest, median_measure_time_from_time) {
+
+    GridCellID cell{5, 5};
+    setSimTime(10.0);
+    update(mapFull, cell, 100, 2, simTime(), 100);
+    setSimTime(20.0);
+    update(mapFull, cell, 101, 8, simTime(), 100);
+    setSimTime(30.0);
+    update(mapFull, cell, 102, 4, simTime(), 100);
+    setSimTime(40.0);
+    update(mapFull, cell, 103, 6, simTime(), 100);
+    MedianVisitor v {simTime()};
+    mapFull->computeValues(&v);
+    auto selected_value = mapFull->getCell(cell).val();
+
+    EXPECT_EQ(selected_value->getCount(), 5.0);             // (4 + 6)/2
+    EXPECT_EQ(selected_value->getMeasureTime(), 25.0);      // (20 + 30)/2
+    EXPECT_EQ(selected_value->getReceivedTime(), 25.0);
+    EXPECT_STREQ(selected_value->getSelectedIn().c_str(), "median");
+}
+
+TEST(AggregationKernels, median) {
+    std::vector<double> odd {5.0, 1.0, 3.0};
+    EXPECT_EQ(aggregation::median(odd.data(), odd.size()), 3.0);
+    std::vector<double> even {9.0, 1.0, 7.0, 3.0};
+    EXPECT_EQ(aggregation::median(even.data(), even.size()), 5.0);
+    std::vector<double> one {4.0};
+    EXPECT_EQ(aggregation::median(one.data(), one.size()), 4.0);
+}
+
+TEST(AggregationKernels, argMinFirst) {
+    std::vector<double> v {3.0, 1.0, 2.0, 1.0};
+    EXPECT_EQ(aggregation::argMin(v.data(), v.size()), 1);
+    EXPECT_EQ(aggregation::argMax(v.data(), v.size()), 0);
+    EXPECT_EQ(aggregation::argMin(v.data(), 0), 0);
+}
+
+/**
+ * Kernel (AVX2 if the CPU supports it) and the scalar fallback must match the
+ * per entry code bitwise. Timing: tests/benchmark (BM_AggregationKernels_*)
+ */
+TEST(AggregationKernels, ageDistRankSameAsScalar) {
+    const std::size_t N = 1003; // not a multiple of the vector width
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> u(0.0, 500.0);
+    std::vector<double> age(N), dist(N), rank(N), expected(N);
+    double ageMin = std::numeric_limits<double>::max();
+    double ageSum = 0.0, distSum = 0.0;
+    for (std::size_t i = 0; i < N; ++i){
+        age[i] = u(gen);
+        dist[i] = u(gen);
+        ageMin = std::min(ageMin, age[i]);
+        ageSum += age[i];
+        distSum += dist[i];
+    }
+    ageSum = ageSum - N*ageMin;
+    const double alpha = 0.3;
+
+    for (std::size_t i = 0; i < N; ++i){
+        double ageRank = (ageSum == 0) ? 1.0 : (age[i] - ageMin)/ageSum;
+        double distRank = (distSum == 0) ? 1.0 : dist[i]/distSum;
+        expected[i] = alpha * ageRank + (1-alpha) * distRank;
+    }
+
+    aggregation::detail::ageDistRankScalar(age.data(), dist.data(), rank.data(), 0, N, ageMin, ageSum, distSum, alpha);
+    for (std::size_t i = 0; i < N; ++i){
+        ASSERT_EQ(rank[i], expected[i]) << "scalar at " << i;
+    }
+    std::fill(rank.begin(), rank.end(), 0.0);
+    aggregation::ageDistRank(age.data(), dist.data(), rank.data(), N, ageMin, ageSum, distSum, alpha);
+    for (std::size_t i = 0; i < N; ++i){
+        ASSERT_EQ(rank[i], expected[i]) << "at " << i;
+    }
+
+    // constant ranks (single entry or all entries equal)
+    aggregation::ageDistRank(age.data(), dist.data(), rank.data(), N, ageMin, 0.0, 0.0, alpha);
+    for (std::size_t i = 0; i < N; ++i){
+        ASSERT_EQ(rank[i], alpha * 1.0 + (1-alpha) * 1.0);
+    }
+}
@@ -0,0 +1,315 @@
+/*
+ * DcDMapCellStoreTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "main_test.h"
+#include "crownet/crownet_testutil.h"
+
+#include "crownet/common/Entry.h"
+#include "crownet/dcd/generic/CellStore.h"
+#include "crownet/dcd/regularGrid/RegularCell.h"
+#include "crownet/dcd/regularGrid/RegularCellVisitors.h"
+#include "crownet/dcd/regularGrid/RegularDcdMap.h"
+#include "crownet/dcd/regularGrid/MapCellAggregationAlgorithms.h"
+
+using namespace crownet;
+
+namespace {
+
+DcdFactoryProvider f = DcdFactoryProvider(
+        inet::Coord(.0, .0),
+        inet::Coord(200.0, 200.0),
+        1.0
+);
+std::shared_ptr<RegularDcdMapFactory> dcdFactory = f.dcdFactory;
+
+std::set<std::pair<int, int>> cellIds(RegularDcdMap& map){
+    std::set<std::pair<int, int>> ret;
+    for (const auto& e : map){
+        ret.insert(e.first.val());
+    }
+    return ret;
+}
+
+}
+
+TEST(CellStore, flatStableReferences) {
+    CellStore<GridCellID, std::string> store(CellStoreType::FLAT);
+    std::vector<std::string*> refs;
+    for (int i = 0; i < 1000; i++){
+        auto ret = store.emplace(GridCellID(i, i % 7), std::to_string(i));
+        EXPECT_TRUE(ret.second);
+        refs.push_back(&ret.first->second);
+    }
+    EXPECT_EQ(1000, store.size());
+    for (int i = 0; i < 1000; i++){
+        auto iter = store.find(GridCellID(i, i % 7));
+        ASSERT_NE(store.end(), iter);
+        // element was not moved while growing
+        EXPECT_EQ(refs[i], &iter->second);
+        EXPECT_EQ(std::to_string(i), iter->second);
+    }
+    EXPECT_EQ(store.end(), store.find(GridCellID(1, 2)));
+}
+
+TEST(CellStore, flatNoDuplicates) {
+    CellStore<IntIdentifer, int> store(CellStoreType::FLAT);
+    store[IntIdentifer(3)] = 3;
+    store[IntIdentifer(5)] = 5;
+    auto ret = store.emplace(IntIdentifer(3), 33);
+    EXPECT_FALSE(ret.second);
+    EXPECT_EQ(3, ret.first->second);
+    EXPECT_EQ(2, store.size());
+    EXPECT_EQ(1, store.count(IntIdentifer(5)));
+    EXPECT_EQ(0, store.count(IntIdentifer(6)));
+}
+
+TEST(CellStore, flatInsertionOrder) {
+    CellStore<IntIdentifer, int> store(CellStoreType::FLAT);
+    std::vector<int> keys{9, 1, 5, 3, 100, 12, 7, 4, 22, 8, 2};  // > LINEAR_SCAN_LIMIT
+    for (auto k : keys){
+        store[IntIdentifer(k)] = k;
+    }
+    std::vector<int> iterated;
+    for (const auto& e : store){
+        iterated.push_back(e.first.value());
+    }
+    EXPECT_EQ(keys, iterated);
+}
+
+TEST(CellStore, copyAndMove) {
+    for (auto type : {CellStoreType::ORDERED, CellStoreType::FLAT}){
+        CellStore<IntIdentifer, int> store(type);
+        for (int i = 0; i < 50; i++){
+            store[IntIdentifer(i)] = 2*i;
+        }
+        CellStore<IntIdentifer, int> copy(store);
+        copy[IntIdentifer(1)] = -1;
+        EXPECT_EQ(2, store[IntIdentifer(1)]);
+        EXPECT_EQ(-1, copy[IntIdentifer(1)]);
+        EXPECT_EQ(type, copy.type());
+
+        CellStore<IntIdentifer, int> moved(std::move(copy));
+        EXPECT_EQ(50, moved.size());
+        EXPECT_EQ(98, moved[IntIdentifer(49)]);
+    }
+}
+
+/**
+ * Same map operations as in DcDMapTest.cc executed for each CellStore backend.
+ */
+class DcDMapCellStoreTest : public BaseOppTest,
+                            public ::testing::WithParamInterface<std::string> {
+ public:
+  using Entry = IEntry<IntIdentifer, omnetpp::simtime_t>;
+  DcDMapCellStoreTest()
+      : mapEmpty(dcdFactory->create(1, "default", GetParam())),
+        mapLocal(dcdFactory->create(2, "default", GetParam())),
+        mapFull(dcdFactory->create(3, "default", GetParam())) {}
+
+  void incr(RegularDcdMap& map, double x, double y, int i, double t) {
+    // local entry!
+    map.getEntry<>(traci::TraCIPosition(x, y))->incrementCount(t);
+    map.addToNeighborhood(IntIdentifer(i), traci::TraCIPosition(x, y));
+  }
+  void update(RegularDcdMap& map, int x, int y, int id, int count, double t) {
+    auto e = std::make_shared<Entry>(count, t, t, IntIdentifer(id));
+    map.setEntry(GridCellID(x, y), std::move(e));
+  }
+
+  void SetUp() override {
+    setSimTime(0.0);
+    // [1, 1] count 2
+    incr(mapLocal, 1.2, 1.2, 100, 30.0);
+    incr(mapLocal, 1.5, 1.5, 101, 30.0);
+    // [3, 3] count 3
+    incr(mapLocal, 3.2, 3.2, 200, 32.0);
+    incr(mapLocal, 3.5, 3.5, 201, 32.0);
+    incr(mapLocal, 3.5, 3.5, 202, 32.0);
+    // [4, 4] count 1
+    incr(mapLocal, 4.2, 4.5, 300, 34.0);
+
+    // [1, 1] Local = 2 / Ohter = 4
+    incr(mapFull, 1.2, 1.2, 100, 30.0);
+    incr(mapFull, 1.5, 1.5, 101, 30.0);
+    update(mapFull, 1, 1, 800, 4, 31.0);
+    // [3, 3] count 3 / Other = 3
+    incr(mapFull, 3.2, 3.2, 200, 32.0);
+    incr(mapFull, 3.5, 3.5, 201, 32.0);
+    incr(mapFull, 3.5, 3.5, 202, 32.0);
+    update(mapFull, 4, 4, 801, 3, 32.0);
+    // [4, 4] count 2 / Other = 0
+    incr(mapFull, 4.2, 4.5, 300, 34.0);
+    incr(mapFull, 4.2, 4.5, 301, 34.0);
+    // [6, 3] count 0 / Other = [5, 7, 9]
+    update(mapFull, 6, 3, 803, 5, 33.0);
+    update(mapFull, 6, 3, 805, 7, 31.0);
+    update(mapFull, 6, 3, 808, 9, 39.0);
+  }
+
+ protected:
+  RegularDcdMap mapEmpty;
+  RegularDcdMap mapLocal;
+  RegularDcdMap mapFull;
+};
+
+TEST_P(DcDMapCellStoreTest, storeType) {
+  EXPECT_EQ(dcdFactory->getCellStoreType(GetParam()), mapFull.getCellStoreType());
+  EXPECT_EQ(mapFull.getCellStoreType(), mapFull.getCell(GridCellID(1, 1)).getData().type());
+}
+
+TEST_P(DcDMapCellStoreTest, getCells) {
+  EXPECT_EQ(0, mapEmpty.getCells().size());
+  EXPECT_EQ(3, mapLocal.getCells().size());
+  EXPECT_EQ(4, mapFull.getCells().size());
+  std::set<std::pair<int, int>> expected{{1, 1}, {3, 3}, {4, 4}, {6, 3}};
+  EXPECT_EQ(expected, cellIds(mapFull));
+}
+
+TEST_P(DcDMapCellStoreTest, hasCell) {
+  EXPECT_FALSE(mapEmpty.hasCell(GridCellID(3, 3)));
+  EXPECT_FALSE(mapFull.hasCell(GridCellID(99, 3)));
+  EXPECT_TRUE(mapFull.hasCell(GridCellID(1, 1)));
+  EXPECT_TRUE(mapFull.hasCell(GridCellID(3, 3)));
+  EXPECT_TRUE(mapFull.hasCell(GridCellID(4, 4)));
+  EXPECT_TRUE(mapFull.hasCell(GridCellID(6, 3)));
+}
+
+TEST_P(DcDMapCellStoreTest, hasDataFrom) {
+  EXPECT_FALSE(mapEmpty.hasDataFrom(GridCellID(3, 3), IntIdentifer(4)));
+  EXPECT_EQ(0, mapEmpty.getCells().size());
+
+  EXPECT_FALSE(mapLocal.hasDataFrom(GridCellID(1, 1), IntIdentifer(4)));
+  EXPECT_EQ(1, mapLocal.getCell(GridCellID(1, 1)).getData().size());
+  EXPECT_TRUE(mapLocal.hasDataFrom(GridCellID(1, 1), IntIdentifer(2)));
+
+  EXPECT_FALSE(mapFull.hasDataFrom(GridCellID(6, 3), IntIdentifer(3)));
+  EXPECT_TRUE(mapFull.hasDataFrom(GridCellID(6, 3), IntIdentifer(803)));
+  EXPECT_TRUE(mapFull.hasDataFrom(GridCellID(6, 3), IntIdentifer(805)));
+  EXPECT_TRUE(mapFull.hasDataFrom(GridCellID(6, 3), IntIdentifer(808)));
+}
+
+TEST_P(DcDMapCellStoreTest, str) {
+  EXPECT_STREQ("{map_owner: 1 cell_count: 0 local_cell_count: 0}", mapEmpty.str().c_str());
+  EXPECT_STREQ("{map_owner: 2 cell_count: 3 local_cell_count: 3}", mapLocal.str().c_str());
+  EXPECT_STREQ("{map_owner: 3 cell_count: 4 local_cell_count: 3}", mapFull.str().c_str());
+}
+
+TEST_P(DcDMapCellStoreTest, getAndCreateCell) {
+  EXPECT_FALSE(mapLocal.hasCell(GridCellID(3, 2)));
+  auto& cell = mapLocal.getCell(GridCellID(3, 2));
+  EXPECT_EQ(GridCellID(3, 2), cell.getCellId());
+  EXPECT_TRUE(mapLocal.hasCell(GridCellID(3, 2)));
+
+  // do not create new object if it exists.
+  auto& cell2 = mapLocal.createCell(GridCellID(3, 2));
+  EXPECT_EQ(&cell, &cell2);
+  EXPECT_EQ(4, mapLocal.getCells().size());
+}
+
+TEST_P(DcDMapCellStoreTest, cellReferenceStable) {
+  auto& cell = mapEmpty.getCell(GridCellID(0, 0));
+  // grow map well beyond first chunk and hash index capacity.
+  for (int x = 0; x < 100; x++){
+      for (int y = 0; y < 20; y++){
+          mapEmpty.getEntry<>(GridCellID(x, y))->incrementCount(1.0);
+      }
+  }
+  EXPECT_EQ(2000, mapEmpty.getCells().size());
+  EXPECT_EQ(&cell, &mapEmpty.getCell(GridCellID(0, 0)));
+  EXPECT_EQ(2000, mapEmpty.validCellCount());
+  EXPECT_EQ(2000, mapEmpty.validLocalCellCount());
+}
+
+TEST_P(DcDMapCellStoreTest, getEntry) {
+  auto e = mapFull.getEntry<>(GridCellID(1, 1));
+  EXPECT_EQ(2, e->getCount());
+  auto other = mapFull.getEntry<>(GridCellID(6, 3), IntIdentifer(805));
+  EXPECT_EQ(7, other->getCount());
+  // create missing entry
+  auto created = mapFull.getEntry<>(GridCellID(6, 3), IntIdentifer(999));
+  EXPECT_EQ(0, created->getCount());
+  EXPECT_EQ(4, mapFull.getCell(GridCellID(6, 3)).getData().size());
+  EXPECT_TRUE(mapFull.hasEntry(GridCellID(6, 3), IntIdentifer(999)));
+  EXPECT_FALSE(mapFull.hasEntry(GridCellID(6, 3)));
+}
+
+TEST_P(DcDMapCellStoreTest, validIterators) {
+  EXPECT_EQ(4, mapFull.validCellCount());
+  EXPECT_EQ(3, mapFull.validLocalCellCount());
+  EXPECT_EQ(3, mapFull.allLocalCellCount());
+
+  std::set<std::pair<int, int>> localCells;
+  for (const auto& e : mapFull.validLocal()){
+      localCells.insert(e.first.val());
+  }
+  std::set<std::pair<int, int>> expected{{1, 1}, {3, 3}, {4, 4}};
+  EXPECT_EQ(expected, localCells);
+
+  mapFull.visitCells(ResetVisitor{35.0});
+  EXPECT_EQ(0, mapFull.validCellCount());
+  EXPECT_EQ(0, mapFull.validLocalCellCount());
+  EXPECT_EQ(3, mapFull.allLocalCellCount());
+}
+
+TEST_P(DcDMapCellStoreTest, computeValues) {
+  setSimTime(40.0);
+  auto ymf = std::make_shared<YmfVisitor>(simTime());
+  mapFull.computeValues(ymf);
+  EXPECT_EQ(4, mapFull.getCell(GridCellID(1, 1)).val()->getCount());  // local (30) vs. 800 (31) -> 800 younger
+  EXPECT_EQ(9, mapFull.getCell(GridCellID(6, 3)).val()->getCount());  // 808 is youngest
+}
+
+TEST_P(DcDMapCellStoreTest, neighborhood) {
+  EXPECT_EQ(6, mapLocal.sizeOfNeighborhood());
+  EXPECT_EQ(7, mapFull.sizeOfNeighborhood());
+  mapLocal.removeFromNeighborhood(GridCellID(1, 1));
+  EXPECT_FALSE(mapLocal.isInNeighborhood(100));
+  EXPECT_FALSE(mapLocal.isInNeighborhood(101));
+  mapLocal.moveNeighborTo(200, GridCellID(4, 4));
+  EXPECT_EQ(GridCellID(4, 4), mapLocal.getNeighborCell(200));
+  EXPECT_EQ(2, mapLocal.getEntry<>(GridCellID(3, 3))->getCount());
+  EXPECT_EQ(2, mapLocal.getEntry<>(GridCellID(4, 4))->getCount());
+}
+
+TEST_P(DcDMapCellStoreTest, updateMove) {
+  using RegularEntry = IEntry<IntIdentifer, omnetpp::simtime_t>;
+  auto m1 = std::make_shared<RegularEntry>(5, 4., 3., IntIdentifer(40));
+  auto m2 = std::make_shared<RegularEntry>(3, 2., 1., IntIdentifer(50));
+  auto m3 = std::make_shared<RegularEntry>(19, 18., 17., IntIdentifer(40));
+
+  auto cellId1 = GridCellID(5, 4);
+  EXPECT_FALSE(mapEmpty.hasCell(cellId1));
+  mapEmpty.setEntry(cellId1, std::move(m1));
+  mapEmpty.setEntry(cellId1, std::move(m2));
+  mapEmpty.setEntry(cellId1, m3);
+  EXPECT_TRUE(mapEmpty.hasCell(cellId1));
+
+  EXPECT_EQ(2, mapEmpty.getCell(cellId1).getData().size());
+  EXPECT_EQ(*m3, *mapEmpty.getCell(cellId1).get(IntIdentifer(40)));
+  EXPECT_FALSE(m1);
+  EXPECT_FALSE(m2);
+  EXPECT_TRUE(m3);
+}
+
+TEST_P(DcDMapCellStoreTest, moveMap) {
+  auto& cell = mapFull.getCell(GridCellID(1, 1));
+  RegularDcdMap moved(std::move(mapFull));
+  EXPECT_EQ(4, moved.getCells().size());
+  EXPECT_EQ(dcdFactory->getCellStoreType(GetParam()), moved.getCellStoreType());
+  // cells are not relocated by a move.
+  EXPECT_EQ(&cell, &moved.getCell(GridCellID(1, 1)));
+  moved.getEntry<>(GridCellID(1, 1))->incrementCount(50.0);
+  EXPECT_EQ(3, moved.getEntry<>(GridCellID(1, 1))->getCount());
+}
+
+INSTANTIATE_TEST_CASE_P(CellStoreBackends, DcDMapCellStoreTest,
+                        ::testing::Values("ordered", "flat"));
@@ -499,3 +499,21 @@ TEST(RegularMap, update2) {
   EXPECT_EQ(mCount1, 2);
   EXPECT_EQ(mCount2, 3);
 }
+
+TEST_F(RegularDcDMapTest, visitCellsAt_explicitTime) {
+  // simulation time is not used (may run on worker threads)
+  setSimTime(0.0);
+  auto ttl = std::make_shared<TTLCellAgeHandler>(std::shared_ptr<RegularDcdMap>(&mapFull, [](RegularDcdMap*){}), 5.0);
+  ttl->setTime(37.0);
+  mapFull.visitCellsAt(*ttl, 37.0);
+  EXPECT_EQ(37.0, ttl->getLastCallTime());
+  // measured at 30.0 and 31.0 -> older than ttl
+  EXPECT_FALSE(mapFull.getCell(GridCellID(1, 1)).hasValid());
+  // measured at 34.0 and 32.0 -> still valid
+  EXPECT_TRUE(mapFull.getCell(GridCellID(4, 4)).hasValid());
+
+  auto ymf = std::make_shared<YmfVisitor>();
+  ymf->setTime(40.0);
+  mapFull.computeValuesAt(ymf, 40.0);
+  EXPECT_EQ(808, mapFull.getCell(GridCellID(6, 3)).val()->getSource().value());
+}
@@ -0,0 +1,172 @@
+/*
+ * DcDMapValidIndexTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "main_test.h"
+#include "crownet/crownet_testutil.h"
+
+#include "crownet/common/Entry.h"
+#include "crownet/dcd/regularGrid/RegularCell.h"
+#include "crownet/dcd/regularGrid/RegularCellVisitors.h"
+#include "crownet/dcd/regularGrid/RegularDcdMap.h"
+
+using namespace crownet;
+
+namespace {
+
+DcdFactoryProvider f = DcdFactoryProvider(
+        inet::Coord(.0, .0),
+        inet::Coord(20.0, 20.0),
+        1.0
+);
+std::shared_ptr<RegularDcdMapFactory> dcdFactory = f.dcdFactory;
+
+/**
+ * Reference implementation: full scan over all cells and entries
+ * (equal to the implementation before the ValidCellIndex was introduced)
+ */
+struct ScanResult {
+    std::vector<GridCellID> valid;
+    std::vector<GridCellID> validLocal;
+    std::vector<GridCellID> local;
+    std::vector<GridCellID> validIter;
+    std::vector<GridCellID> validLocalIter;
+    std::vector<GridCellID> allLocalIter;
+};
+
+ScanResult scan(RegularDcdMapPtr map){
+    ScanResult r;
+    for (const auto& c : *map){
+        const auto& cell = c.second;
+        if (cell.hasValid()) r.valid.push_back(c.first);
+        if (cell.hasValidLocal()) r.validLocal.push_back(c.first);
+        if (cell.hasLocal()) r.local.push_back(c.first);
+    }
+    // index based iterators must visit the same cells in store order.
+    for (const auto& c : map->valid()) r.validIter.push_back(c.first);
+    for (const auto& c : map->validLocal()) r.validLocalIter.push_back(c.first);
+    for (const auto& c : map->allLocal()) r.allLocalIter.push_back(c.first);
+    return r;
+}
+
+}
+
+class DcDMapValidIndexTest : public BaseOppTest,
+                             public ::testing::WithParamInterface<std::string> {
+ public:
+  using Entry = IEntry<IntIdentifer, omnetpp::simtime_t>;
+
+  void expectIndexMatchesScan(RegularDcdMapPtr map, int step){
+      auto r = scan(map);
+      ASSERT_EQ((int)r.valid.size(), map->validCellCount()) << "step " << step;
+      ASSERT_EQ((int)r.validLocal.size(), map->validLocalCellCount()) << "step " << step;
+      ASSERT_EQ((int)r.local.size(), map->allLocalCellCount()) << "step " << step;
+      ASSERT_EQ((int)r.valid.size(), map->valid().distance()) << "step " << step;
+      ASSERT_EQ(r.valid, r.validIter) << "step " << step;
+      ASSERT_EQ(r.validLocal, r.validLocalIter) << "step " << step;
+      ASSERT_EQ(r.local, r.allLocalIter) << "step " << step;
+  }
+};
+
+TEST_P(DcDMapValidIndexTest, emptyMap) {
+    auto map = dcdFactory->create_shared_ptr(IntIdentifer(1), "default", GetParam());
+    EXPECT_EQ(0, map->validCellCount());
+    EXPECT_EQ(0, map->validLocalCellCount());
+    EXPECT_EQ(0, map->allLocalCellCount());
+    // cell without entries
+    map->getCell(GridCellID(2, 2));
+    expectIndexMatchesScan(map, 0);
+}
+
+TEST_P(DcDMapValidIndexTest, replaceEntry) {
+    auto map = dcdFactory->create_shared_ptr(IntIdentifer(1), "default", GetParam());
+    auto e1 = std::make_shared<Entry>(3, 1.0, 1.0, IntIdentifer(7));
+    map->setEntry(GridCellID(1, 1), e1);
+    EXPECT_EQ(1, map->validCellCount());
+    auto e2 = std::make_shared<Entry>(3, 2.0, 2.0, IntIdentifer(7));
+    e2->reset(2.0);
+    map->setEntry(GridCellID(1, 1), e2);
+    EXPECT_EQ(0, map->validCellCount());
+    // replaced entry is not tracked anymore.
+    e1->touch(3.0);
+    EXPECT_EQ(0, map->validCellCount());
+    e2->touch(3.0);
+    EXPECT_EQ(1, map->validCellCount());
+    // a copy of an entry is not part of the cell
+    auto copy = std::make_shared<Entry>(*e2);
+    copy->reset();
+    EXPECT_EQ(1, map->validCellCount());
+    expectIndexMatchesScan(map, 0);
+}
+
+TEST_P(DcDMapValidIndexTest, randomized) {
+    auto map = dcdFactory->create_shared_ptr(IntIdentifer(1), "default", GetParam());
+    auto ttlHandler = std::make_shared<TTLCellAgeHandler>(map, 20.0, 0.0);
+    std::mt19937 rng(4711);
+    std::vector<std::shared_ptr<Entry>> handles;
+    double t = 0.0;
+
+    for (int step = 0; step < 5000; step++){
+        t += 0.1;
+        setSimTime(t);
+        GridCellID cellId(rng() % 20, rng() % 20);
+        IntIdentifer source = (rng() % 3 == 0) ? map->getOwnerId() : IntIdentifer(2 + rng() % 8);
+
+        switch (rng() % 10) {
+        case 0:  // local count (DensityMapAppSimple)
+        case 1:
+            map->getEntry<>(cellId)->incrementCount(t);
+            break;
+        case 2: {  // received entry (mergeReceivedMap)
+            auto e = std::make_shared<Entry>(1 + rng() % 5, t, t, source);
+            if (rng() % 4 == 0) e->reset(t);
+            map->setEntry(cellId, std::move(e));
+            break;
+        }
+        case 3:
+            map->getEntry<>(cellId, source)->touch(t);
+            break;
+        case 4:
+            handles.push_back(map->getEntry<>(cellId, source));
+            break;
+        case 5:  // mutate entry outside of the map
+            if (!handles.empty()){
+                auto& e = handles[rng() % handles.size()];
+                if (rng() % 2) e->reset(t); else e->incrementCount(t);
+            }
+            break;
+        case 6:
+            map->applyVisitorTo(cellId, ResetVisitor{t});
+            break;
+        case 7:
+            if (rng() % 20 == 0) map->visitCells(ResetLocalVisitor{t});
+            else map->applyVisitorTo(cellId, ClearVisitor{t});
+            break;
+        case 8:
+            ttlHandler->setTime(simTime());
+            map->visitCells(*ttlHandler);
+            break;
+        case 9:
+            map->getEntry<>(cellId, source)->setValue(t, rng() % 4);
+            break;
+        }
+        expectIndexMatchesScan(map, step);
+    }
+    EXPECT_GT(map->validCellCount(), 0);
+    EXPECT_GT(map->allLocalCellCount(), 0);
+
+    map->visitCells(ResetVisitor{t});
+    EXPECT_EQ(0, map->validCellCount());
+    expectIndexMatchesScan(map, -1);
+}
+
+INSTANTIATE_TEST_CASE_P(CellStoreBackends, DcDMapValidIndexTest,
+                        ::testing::Values("ordered", "flat"));
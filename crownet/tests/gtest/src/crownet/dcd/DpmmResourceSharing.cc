@@ -212,3 +212,34 @@ TEST_F(DpmmResourceSharingIdTest, RsdNeighborhoodCountVisitor_ValidCount) {
 
 }
 
+
+TEST_F(DpmmResourceSharingIdTest, NeighborhoodCountByRsdVisitor_SameAsRsdCount) {
+    std::shared_ptr<YmfVisitor> ymf_v = std::make_shared<YmfVisitor>();
+    std::shared_ptr<ApplyRessourceSharingDomainIdVisitor> rsd_v = std::make_shared<ApplyRessourceSharingDomainIdVisitor>();
+    NeighborhoodCountByRsdVisitor all_v;
+
+    mapFull->setOwnerCell(GridCellID(3, 3));
+    setSimTime(1.4);
+    ymf_v->setTime(simTime());
+    rsd_v->setTime(simTime());
+    mapFull->computeValues(ymf_v);
+    mapFull->visitCells(*rsd_v);
+
+    all_v.reset();
+    mapFull->visitCells(all_v);
+
+    for (int rsdid : {ownRessourceSharingDomainId, otherRessourceSharingDomainId, -1, 4242}){
+        // fresh visitor, count visitors are idempotent per time step.
+        RsdNeighborhoodCountVisitor rsdCount_v(simTime(), rsdid);
+        mapFull->visitCells(rsdCount_v);
+        EXPECT_EQ(all_v.getCount(rsdid), rsdCount_v.getCount()) << "rsdid " << rsdid;
+    }
+    FullNeighborhoodCountVisitor fullCount_v(simTime());
+    mapFull->visitCells(fullCount_v);
+    EXPECT_EQ(all_v.getCount(), fullCount_v.getCount());
+    EXPECT_EQ(all_v.getCount(ownRessourceSharingDomainId), 9);
+
+    all_v.reset();
+    EXPECT_EQ(all_v.getCount(), 0);
+    EXPECT_EQ(all_v.getCount(-1), 0);
+}
@@ -0,0 +1,117 @@
+/*
+ * fake_traci.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include "fake_traci.h"
+
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <stdexcept>
+
+namespace crownet {
+
+FakeTraCiServer::FakeTraCiServer(Script script) : script(std::move(script)) {
+  listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+  bind(listenFd, (sockaddr*)&addr, sizeof(addr));
+  socklen_t len = sizeof(addr);
+  getsockname(listenFd, (sockaddr*)&addr, &len);
+  port = ntohs(addr.sin_port);
+  listen(listenFd, 1);
+  worker = std::thread([this]() {
+    fd = accept(listenFd, nullptr, nullptr);
+    try {
+      this->script(*this);
+    } catch (const std::exception& e) {
+      ADD_FAILURE() << "fake TraCI server: " << e.what();
+    }
+    close(fd);
+  });
+}
+
+FakeTraCiServer::FakeTraCiServer(std::vector<tcpip::Storage> responses)
+    : FakeTraCiServer([responses](FakeTraCiServer& s) mutable {
+        for (auto& response : responses) {
+          s.requests.push_back(s.readRaw());
+          s.write(response);
+        }
+      }) {}
+
+FakeTraCiServer::~FakeTraCiServer() {
+  join();
+  close(listenFd);
+}
+
+void FakeTraCiServer::join() {
+  if (worker.joinable()) worker.join();
+}
+
+std::string FakeTraCiServer::readRaw() {
+  unsigned char lenBuf[4];
+  readExact((char*)lenBuf, 4);
+  uint32_t len = (lenBuf[0] << 24) | (lenBuf[1] << 16) | (lenBuf[2] << 8) | lenBuf[3];
+  std::string msg(len - 4, '\0');
+  readExact(&msg[0], msg.size());
+  return msg;
+}
+
+tcpip::Storage FakeTraCiServer::read() {
+  auto msg = readRaw();
+  tcpip::Storage ret;
+  ret.writePacket(std::vector<unsigned char>(msg.begin(), msg.end()));
+  return ret;
+}
+
+void FakeTraCiServer::write(tcpip::Storage& msg) {
+  tcpip::Storage out;
+  out.writeInt((int)msg.size() + 4);
+  out.writeStorage(msg);
+  std::string bytes(out.begin(), out.end());
+  if (::write(fd, bytes.data(), bytes.size()) != (ssize_t)bytes.size()) {
+    throw std::runtime_error("write failed");
+  }
+}
+
+void FakeTraCiServer::writeCommand(tcpip::Storage& out, int cmd, int var,
+                                   const std::string& id, tcpip::Storage& content) {
+  int len = 1 + 1 + 1 + 4 + (int)id.size() + (int)content.size();
+  if (len <= 255) {
+    out.writeUnsignedByte(len);
+  } else {
+    out.writeUnsignedByte(0);
+    out.writeInt(len + 4);
+  }
+  out.writeUnsignedByte(cmd);
+  out.writeUnsignedByte(var);
+  out.writeString(id);
+  out.writeStorage(content);
+}
+
+int FakeTraCiServer::readCommand(tcpip::Storage& in, int cmd) {
+  if (in.readUnsignedByte() == 0) in.readInt();
+  EXPECT_EQ(in.readUnsignedByte(), cmd);
+  int var = in.readUnsignedByte();
+  in.readString();
+  return var;
+}
+
+void FakeTraCiServer::readExact(char* buf, std::size_t n) {
+  while (n > 0) {
+    auto r = ::read(fd, buf, n);
+    if (r <= 0) throw std::runtime_error("connection closed");
+    buf += r;
+    n -= r;
+  }
+}
+
+}  // namespace crownet
@@ -0,0 +1,66 @@
+/*
+ * fake_traci.h
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <traci/sumo/utils/traci/TraCIAPI.h>
+
+namespace crownet {
+
+/**
+ * Local TraCI peer for API tests (Vadere, external controller). Listens on
+ * a free loopback port, accepts one connection and runs the given script on
+ * it in a background thread. Messages are read and written with the TraCI
+ * length prefix. Exceptions of the script are reported as test failure.
+ */
+class FakeTraCiServer {
+ public:
+  using Script = std::function<void(FakeTraCiServer&)>;
+
+  explicit FakeTraCiServer(Script script);
+  // answer each request with the next recorded response. Received requests
+  // are kept for inspection (see getRequests).
+  explicit FakeTraCiServer(std::vector<tcpip::Storage> responses);
+  ~FakeTraCiServer();
+  FakeTraCiServer(const FakeTraCiServer&) = delete;
+  FakeTraCiServer& operator=(const FakeTraCiServer&) = delete;
+
+  // wait until the script is done
+  void join();
+
+  int getPort() const { return port; }
+  // raw requests (without length prefix) of the response replay
+  const std::vector<std::string>& getRequests() const { return requests; }
+
+  // read one message (without length prefix). Throws if the connection is closed.
+  tcpip::Storage read();
+  std::string readRaw();
+  void write(tcpip::Storage& msg);
+
+  // write TraCI command (length, command, variable, object id, content)
+  static void writeCommand(tcpip::Storage& out, int cmd, int var,
+                           const std::string& id, tcpip::Storage& content);
+  // read command header and check command id. Returns variable id.
+  static int readCommand(tcpip::Storage& in, int cmd);
+
+ private:
+  void readExact(char* buf, std::size_t n);
+
+  Script script;
+  std::vector<std::string> requests;
+  int listenFd;
+  int fd = -1;
+  int port;
+  std::thread worker;
+};
+
+}  // namespace crownet
@@ -0,0 +1,177 @@
+/*
+ * BeaconTransportTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <string>
+#include <vector>
+
+#include "crownet/mec/BeaconBinary.h"
+#include "crownet/mec/BeaconBinaryTransport.h"
+#include "crownet/mec/BeaconJSON.h"
+#include "crownet/mec/BeaconRepository.h"
+#include "main_test.h"
+
+namespace {
+
+SimpleMECBeacon makeBeacon(int id, double x, double y, int type = 1) {
+  SimpleMECBeacon beacon;
+  beacon.setNodeId(id);
+  beacon.setNodeType(type);
+  beacon.setXPos(x);
+  beacon.setYPos(y);
+  return beacon;
+}
+
+}  // namespace
+
+TEST(BeaconBinaryTest, base64) {
+  EXPECT_EQ(beacon_binary::encodeBase64("Man"), "TWFu");
+  EXPECT_EQ(beacon_binary::encodeBase64("Ma"), "TWE=");
+  EXPECT_EQ(beacon_binary::encodeBase64("M"), "TQ==");
+  std::string raw("\0\xff\x10\x00", 4);
+  auto text = beacon_binary::encodeBase64(raw);
+  EXPECT_EQ(text.find('\0'), std::string::npos);
+  EXPECT_EQ(beacon_binary::decodeBase64(text), raw);
+  EXPECT_THROW(beacon_binary::decodeBase64("TW?u"), omnetpp::cRuntimeError);
+}
+
+TEST(BeaconBinaryTest, readWrite) {
+  std::vector<SimpleMECBeacon> beacons = {makeBeacon(-1, 0.5, 10.25, 0),
+                                          makeBeacon(7, 350.123456789, 470.1, 2)};
+  auto body = beacon_binary::serializeBeacons(beacons, 42);
+
+  std::vector<SimpleMECBeacon> read;
+  EXPECT_EQ(beacon_binary::parseBeacons(body, read), 42);
+  ASSERT_EQ(read.size(), 2);
+  EXPECT_EQ(read[0].getNodeId(), -1);
+  EXPECT_EQ(read[0].getNodeType(), 0);
+  EXPECT_EQ(read[1].getNodeType(), 2);
+  EXPECT_DOUBLE_EQ(read[1].getXPos(), 350.123456789);
+  EXPECT_DOUBLE_EQ(read[1].getYPos(), 470.1);
+
+  // truncated body
+  EXPECT_THROW(beacon_binary::parseBeacons(body.substr(0, body.size() - 8), read),
+               omnetpp::cRuntimeError);
+  EXPECT_THROW(beacon_binary::serializeBeacons({makeBeacon(1, 0, 0, 256)}),
+               omnetpp::cRuntimeError);
+}
+
+TEST(BeaconRepositoryTest, getSince) {
+  BeaconRepository repo;
+  repo.add(makeBeacon(1, 1.0, 1.0));
+  repo.add(makeBeacon(2, 2.0, 2.0));
+  repo.add(makeBeacon(3, 3.0, 3.0));
+  EXPECT_EQ(repo.getSequenceNumber(), 3);
+
+  std::vector<const SimpleMECBeacon*> delta;
+  repo.getSince(0, delta);
+  EXPECT_EQ(delta.size(), 3);
+
+  // update of node 1 moves it to the end of the update order
+  repo.add(makeBeacon(1, 1.5, 1.5));
+  repo.getSince(2, delta);
+  ASSERT_EQ(delta.size(), 2);
+  EXPECT_EQ(delta[0]->getNodeId(), 3);
+  EXPECT_EQ(delta[1]->getNodeId(), 1);
+  EXPECT_DOUBLE_EQ(delta[1]->getXPos(), 1.5);
+
+  repo.getSince(repo.getSequenceNumber(), delta);
+  EXPECT_TRUE(delta.empty());
+  EXPECT_EQ(repo.size(), 3);
+  EXPECT_EQ(repo.getAll().size(), 3);
+}
+
+TEST(BeaconTransportTest, delta) {
+  BeaconRepository repo;
+  BeaconBinaryService service(repo);
+  BeaconBinaryClient client;
+  client.setBatchSize(2);
+
+  EXPECT_FALSE(client.addBeacon(makeBeacon(1, 1.0, 1.0)));
+  EXPECT_TRUE(client.addBeacon(makeBeacon(2, 2.0, 2.0)));
+  EXPECT_EQ(service.receiveBatch(client.takeBatch()), 2);
+  EXPECT_FALSE(client.hasPending());
+
+  EXPECT_EQ(client.getSinceParams(), "seq=0");
+  auto beacons = client.merge(service.getSince(client.getSinceParams()));
+  EXPECT_EQ(beacons.size(), 2);
+  EXPECT_EQ(client.getLastSeq(), 2);
+
+  // only the update of node 1 is sent, the client keeps node 2
+  client.addBeacon(makeBeacon(1, 1.5, 1.5));
+  service.receiveBatch(client.takeBatch());
+  std::vector<SimpleMECBeacon> delta;
+  EXPECT_EQ(beacon_binary::parseBeacons(service.getSince(client.getSinceParams()), delta), 3);
+  ASSERT_EQ(delta.size(), 1);
+  beacons = client.merge(service.getSince(client.getSinceParams()));
+  ASSERT_EQ(beacons.size(), 2);
+  EXPECT_EQ(beacons[0].getNodeId(), 1);
+  EXPECT_DOUBLE_EQ(beacons[0].getXPos(), 1.5);
+  EXPECT_EQ(beacons[1].getNodeId(), 2);
+
+  // nothing new
+  delta.clear();
+  beacon_binary::parseBeacons(service.getSince(client.getSinceParams()), delta);
+  EXPECT_TRUE(delta.empty());
+  // missing parameter: all beacons
+  delta.clear();
+  beacon_binary::parseBeacons(service.getSince(""), delta);
+  EXPECT_EQ(delta.size(), 2);
+}
+
+/**
+ * Beacon exchange between MEC apps and the repository of the MEC host
+ * (BeaconService) without network: N nodes send one beacon per period, each
+ * app polls the repository once per period. Half of the nodes move per
+ * period. Apps see the same beacons with both transports.
+ * Body bytes and encode/decode time: tests/benchmark (BM_BeaconTransport_*)
+ */
+TEST(BeaconTransportTest, sameState) {
+  const int nodes = 50;
+  const int periods = 5;
+  const int apps = 4;
+
+  // JSON: one POST per beacon, GET /all
+  BeaconRepository jsonRepo;
+  std::vector<SimpleMECBeacon> jsonReceived;
+  for (int p = 0; p < periods; p++) {
+    for (int n = 0; n < nodes; n++) {
+      if (p > 0 && n % 2 == p % 2) continue;
+      std::string body = beacon_json::serializeBeacon(makeBeacon(n, n + p, p)).dump();
+      jsonRepo.add(beacon_json::parseBeaconString(body));
+    }
+    std::string body = beacon_json::serializeBeacons(jsonRepo.getAll()).dump();
+    jsonReceived = beacon_json::parseBeaconsString(body);
+  }
+
+  // binary: batched POST (one per app), GET /since
+  BeaconRepository binRepo;
+  BeaconBinaryService service(binRepo);
+  std::vector<BeaconBinaryClient> clients(apps);
+  std::vector<SimpleMECBeacon> binReceived;
+  for (auto& client : clients) client.setBatchSize(nodes);
+  for (int p = 0; p < periods; p++) {
+    for (int a = 0; a < apps; a++) {
+      for (int n = a; n < nodes; n += apps) {
+        if (p > 0 && n % 2 == p % 2) continue;
+        clients[a].addBeacon(makeBeacon(n, n + p, p));
+      }
+      service.receiveBatch(clients[a].takeBatch());
+    }
+    for (int a = 0; a < apps; a++) {
+      binReceived = clients[a].merge(service.getSince(clients[a].getSinceParams()));
+      EXPECT_EQ(clients[a].getLastSeq(), binRepo.getSequenceNumber());
+    }
+  }
+
+  ASSERT_EQ(jsonReceived.size(), (std::size_t)nodes);
+  ASSERT_EQ(binReceived.size(), jsonReceived.size());
+  for (int n = 0; n < nodes; n++) {
+    EXPECT_EQ(binReceived[n].getNodeId(), jsonReceived[n].getNodeId());
+    EXPECT_DOUBLE_EQ(binReceived[n].getXPos(), jsonReceived[n].getXPos());
+    EXPECT_DOUBLE_EQ(binReceived[n].getYPos(), jsonReceived[n].getYPos());
+  }
+}
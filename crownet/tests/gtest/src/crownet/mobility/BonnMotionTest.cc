@@ -13,6 +13,9 @@
 #include "main_test.h"
 
 #include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
 namespace fs = boost::filesystem;
 
 
@@ -27,7 +30,18 @@ class BonnMotionTest : public BaseOppTest {
         bmFile1.loadFile((dir / "bmFile1.bonnMotion").c_str());
         bmFile2.loadFile((dir / "bmFile2.bonnMotion").c_str());
     }
+    void TearDown() override {
+        for (const auto& p : tmpFiles){
+            fs::remove(p);
+        }
+    }
+    // unique temporary file, removed after the test
+    fs::path tmpFile(const std::string& name){
+        tmpFiles.push_back(fs::temp_directory_path() / fs::unique_path("%%%%-%%%%-" + name));
+        return tmpFiles.back();
+    }
  protected:
+    std::vector<fs::path> tmpFiles;
     BonnMotionServerFile bmFile1;
     BonnMotionServerFile bmFile2;
 };
@@ -60,3 +74,46 @@ TEST_F(BonnMotionTest, getNextTest){
 
 
 
+namespace {
+
+std::string toBinary(const fs::path& src, const fs::path& dst, bool is3D=false){
+    std::ifstream in(src.c_str());
+    std::ofstream out(dst.c_str(), std::ios::binary);
+    crownet::bmbin::convertText(in, out, is3D);
+    return dst.string();
+}
+
+}
+
+TEST_F(BonnMotionTest, binaryTimeLine){
+    fs::path dir = fs::absolute(__FILE__).parent_path();
+    BonnMotionServerFile bin;
+    bin.loadFile(toBinary(dir / "bmFile2.bonnMotion", tmpFile("bmFile2.bmbin")).c_str());
+    EXPECT_TRUE(bin.isBinary());
+    EXPECT_EQ(bin.getLoadedTraceCount(), 0); // nothing read before node creation
+
+    // same order as text file (stable sorted by start time)
+    while(bmFile2.hasNextTimeLineIndex()){
+        auto t = bmFile2.peekAtNextTimeLineIndex();
+        ASSERT_TRUE(bin.hasNextTimeLineIndex());
+        EXPECT_EQ(bin.peekAtNextTimeLineIndex(), t);
+        setSimTime(t.second);
+        bmFile2.getNextTimeLineIndex(simTime());
+        bin.getNextTimeLineIndex(simTime());
+        EXPECT_EQ(*bin.getTrace(t.first), *bmFile2.getTrace(t.first));
+    }
+    EXPECT_FALSE(bin.hasNextTimeLineIndex());
+    EXPECT_EQ(bin.getLoadedTraceCount(), 3);
+
+    bin.releaseTrace(2);
+    EXPECT_EQ(bin.getLoadedTraceCount(), 2);
+    // can be read again
+    EXPECT_EQ(*bin.getTrace(2), *bmFile2.getTrace(2));
+}
+
+TEST_F(BonnMotionTest, binaryDimensionMismatch){
+    fs::path dir = fs::absolute(__FILE__).parent_path();
+    BonnMotionServerFile bin;
+    auto path = toBinary(dir / "bmFile1.bonnMotion", tmpFile("bmFile1.bmbin"));
+    EXPECT_THROW(bin.loadFile(path.c_str(), true), cRuntimeError);
+}
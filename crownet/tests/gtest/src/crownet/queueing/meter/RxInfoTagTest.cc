@@ -0,0 +1,181 @@
+/*
+ * RxInfoTagTest.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ */
+
+#include <memory>
+
+#include "crownet/applications/beacon/BeaconReceptionInfo.h"
+#include "crownet/applications/beacon/Beacon_m.h"
+#include "crownet/applications/common/AppCommon_m.h"
+#include "crownet/applications/common/info/InfoTags_m.h"
+#include "crownet/neighbourhood/NeighborhoodTable.h"
+#include "crownet/queueing/meter/ApplicationPacketMeterIn.h"
+#include "crownet/crownet_testutil.h"
+#include "main_test.h"
+
+using namespace crownet;
+
+namespace {
+
+// count copies made of the per source info object
+class CountingInfo : public BeaconReceptionInfo {
+ public:
+    CountingInfo() : BeaconReceptionInfo() {}
+    CountingInfo(const CountingInfo& other) : BeaconReceptionInfo(other) { copies++; }
+    virtual CountingInfo *dup() const override { return new CountingInfo(*this); }
+    static int copies;
+};
+int CountingInfo::copies = 0;
+
+// meter without module setup (parameters, GenericPacketMeter)
+class TestMeter : public ApplicationPacketMeterIn {
+ public:
+    TestMeter() {
+        hostId = 1;
+        appendAppInfo = true;
+        emaSmoothingJitter = 1.0/16;
+        emaSmoothingPacketSize = 1.0/16;
+        appLevelInfo = new AppRxInfoPerSource();
+        take(appLevelInfo);
+    }
+    using ApplicationPacketMeterIn::meterSource;
+    const std::shared_ptr<AppRxInfoPerSource>& getState(int sourceId) { return appInfos.at(sourceId); }
+
+ protected:
+    virtual std::shared_ptr<AppRxInfoPerSource>& getOrCreate(int sourceId) override {
+        auto& info = appInfos[sourceId];
+        if (!info){
+            auto newInfo = new CountingInfo();
+            newInfo->setNodeId(sourceId);
+            releaseOwnership(newInfo);
+            info.reset(newInfo);
+        }
+        return info;
+    }
+};
+
+class TestTable : public NeighborhoodTable {
+ public:
+    TestTable(std::shared_ptr<OsgCoordinateConverter> converter) {
+        cellKeyProvider = std::make_shared<GridCellIDKeyProvider>(converter);
+        setMaxAge(3.0);
+    }
+};
+
+}
+
+class RxInfoTagTest : public BaseOppTest {
+ public:
+    RxInfoTagTest() {}
+
+    Packet *create(int seq, inet::Coord pos = {1.0, 2.0}, int id=42){
+        const auto& chunk = makeShared<DynamicBeaconPacket>();
+        chunk->setSequenceNumber(seq);
+        chunk->setSourceId(id);
+        chunk->setTimestamp((uint32_t)simTime().inUnit(SimTimeUnit::SIMTIME_MS));
+        chunk->setPos(pos);
+        chunk->setEpsilon({0.0, 0.0});
+        chunk->addTagIfAbsent<HostIdTag>()->setHostId(id);
+        auto packet = new Packet();
+        packet->insertAtFront(chunk);
+        return packet;
+    }
+
+    // BeaconDynamic::handleDataArrived
+    void handOver(INeighborhoodTablePacketProcessor& table, Packet* packet){
+        auto state = shareState(packet->getTag<AppRxInfoPerSourceTag>()->getPacketInfo());
+        table.processInfo(std::dynamic_pointer_cast<BeaconReceptionInfo>(state));
+    }
+};
+
+TEST_F(RxInfoTagTest, snapshotNotChangedByNextPacket) {
+    TestMeter meter;
+    CountingInfo::copies = 0;
+
+    setSimTime(1.0);
+    auto p1 = create(1);
+    meter.meterSource(p1);
+    auto s1 = p1->getTag<AppRxInfoPerSourceTag>()->getPacketInfo();
+    EXPECT_EQ(s1.get(), meter.getState(42).get());
+    EXPECT_EQ(p1->getTag<RxInfoTag>()->getPerSrcPktCount(), 1);
+    EXPECT_EQ(2, p1->getNumTags());
+
+    // p1 still alive: meter must copy before the update.
+    setSimTime(2.0);
+    auto p2 = create(2);
+    meter.meterSource(p2);
+    EXPECT_EQ(CountingInfo::copies, 1);
+    EXPECT_NE(s1.get(), meter.getState(42).get());
+    EXPECT_EQ(s1->getPacketsReceivedCount(), 1);
+    EXPECT_EQ(meter.getState(42)->getPacketsReceivedCount(), 2);
+    EXPECT_EQ(p2->getTag<RxInfoTag>()->getPerSrcPktCount(), 2);
+
+    // packets consumed: no copy needed for the next packet.
+    s1.reset();
+    delete p1;
+    delete p2;
+    setSimTime(3.0);
+    auto p3 = create(3);
+    meter.meterSource(p3);
+    EXPECT_EQ(CountingInfo::copies, 1);
+    EXPECT_EQ(meter.getState(42)->getPacketsReceivedCount(), 3);
+    delete p3;
+}
+
+TEST_F(RxInfoTagTest, tableSharesMeterState) {
+    DcdFactoryProvider f;
+    TestMeter meter;
+    TestTable table(f.converter);
+    CountingInfo::copies = 0;
+
+    setSimTime(1.0);
+    auto p = create(1, {1.5, 1.5});
+    meter.meterSource(p);
+    handOver(table, p);
+    delete p;
+    auto entry = table.find(42);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(meter.getState(42).get(), entry);
+    EXPECT_EQ(nullptr, entry->getPrioData());
+
+    // the table holds the state, no copy for the next beacons.
+    for (int seq = 2; seq < 5; seq++){
+        setSimTime(seq);
+        p = create(seq, {1.5 + seq, 1.5});
+        meter.meterSource(p);
+        handOver(table, p);
+        delete p;
+        ASSERT_EQ(meter.getState(42).get(), table.find(42));
+        EXPECT_EQ(seq, (int)table.find(42)->getCurrentData()->getSequenceNumber());
+        EXPECT_EQ(seq - 1, (int)table.find(42)->getPrioData()->getSequenceNumber());
+        EXPECT_DOUBLE_EQ(1.5 + seq - 1, table.find(42)->getPrioData()->getPosition().x);
+    }
+    EXPECT_EQ(0, CountingInfo::copies);
+    EXPECT_EQ(1, (int)table.getTable().size());
+
+    // out of order: state of seq 4 stays in the table
+    p = create(3);
+    meter.meterSource(p);
+    handOver(table, p);
+    delete p;
+    EXPECT_EQ(4, (int)table.find(42)->getCurrentData()->getSequenceNumber());
+
+    // ttl reached: table releases the state, the meter keeps it.
+    setSimTime(10.0);
+    table.checkAllTimeToLive();
+    EXPECT_EQ(nullptr, table.find(42));
+    EXPECT_EQ(4, (int)meter.getState(42)->getCurrentData()->getSequenceNumber());
+
+    // new entry in table: no prio data
+    setSimTime(11.0);
+    p = create(5);
+    meter.meterSource(p);
+    handOver(table, p);
+    delete p;
+    ASSERT_NE(nullptr, table.find(42));
+    EXPECT_EQ(nullptr, table.find(42)->getPrioData());
+    EXPECT_EQ(0, CountingInfo::copies);
+}
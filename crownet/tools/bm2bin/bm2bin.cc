@@ -0,0 +1,58 @@
+/*
+ * bm2bin.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ *
+ * Convert BonnMotion text traces (optionally gzip compressed) into the binary
+ * trace format read by BonnMotionMobilityServer (see BonnMotionBinaryFormat.h).
+ *
+ * usage: bm2bin [--3d] <input.bonnMotion[.gz]> <output.bmbin>
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "crownet/mobility/BonnMotionBinaryFormat.h"
+
+int main(int argc, char** argv) {
+  bool is3D = false;
+  int arg = 1;
+  if (argc > 1 && std::string(argv[1]) == "--3d") {
+    is3D = true;
+    arg++;
+  }
+  if (argc - arg != 2) {
+    std::cerr << "usage: " << argv[0] << " [--3d] <input.bonnMotion[.gz]> <output.bmbin>" << std::endl;
+    return 1;
+  }
+  std::string inPath(argv[arg]);
+  std::ifstream file(inPath, std::ios::binary);
+  if (!file) {
+    std::cerr << "cannot open " << inPath << std::endl;
+    return 1;
+  }
+  boost::iostreams::filtering_istream in;
+  if (inPath.size() > 3 && inPath.compare(inPath.size() - 3, 3, ".gz") == 0) {
+    in.push(boost::iostreams::gzip_decompressor());
+  }
+  in.push(file);
+
+  std::ofstream out(argv[arg + 1], std::ios::binary);
+  if (!out) {
+    std::cerr << "cannot open " << argv[arg + 1] << std::endl;
+    return 1;
+  }
+  try {
+    auto n = crownet::bmbin::convertText(in, out, is3D);
+    std::cerr << "converted " << n << " traces" << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << inPath << ": " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,65 @@
+/*
+ * colbin2csv.cc
+ *
+ *  Created on: Oct 16, 2026
+ *      Author: sts
+ *
+ * Convert binary columnar files written by BinaryColumnFileWriter into the
+ * csv layout of ActiveFileWriter (metadata line, header line, rows).
+ *
+ * usage: colbin2csv <input.bin> [output.csv] [separator]
+ *        (output defaults to stdout, separator to ';')
+ */
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "crownet/common/util/ColumnFormat.h"
+
+using namespace crownet::colfmt;
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 4) {
+    std::cerr << "usage: " << argv[0] << " <input.bin> [output.csv] [separator]" << std::endl;
+    return 1;
+  }
+  std::ifstream in(argv[1], std::ios::binary);
+  if (!in) {
+    std::cerr << "cannot open " << argv[1] << std::endl;
+    return 1;
+  }
+  std::ofstream file;
+  if (argc > 2 && std::string(argv[2]) != "-") {
+    file.open(argv[2]);
+    if (!file) {
+      std::cerr << "cannot open " << argv[2] << std::endl;
+      return 1;
+    }
+  }
+  std::ostream& out = file.is_open() ? file : std::cout;
+  std::string sep = argc > 3 ? argv[3] : ";";
+
+  try {
+    ColumnFileReader reader(in);
+    reader.readHeader();
+    out << "#" << reader.getMetadata() << "\n";
+    const auto& columns = reader.getColumns();
+    for (std::size_t c = 0; c < columns.size(); c++) {
+      out << (c > 0 ? sep : "") << columns[c].name;
+    }
+    out << "\n";
+    while (reader.readChunk()) {
+      for (uint32_t r = 0; r < reader.getRows(); r++) {
+        for (std::size_t c = 0; c < columns.size(); c++) {
+          out << (c > 0 ? sep : "") << reader.str(r, (int)c);
+        }
+        out << "\n";
+      }
+    }
+  } catch (const std::exception& e) {
+    std::cerr << argv[1] << ": " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}